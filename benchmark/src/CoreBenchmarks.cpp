@@ -0,0 +1,347 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <AccessorFramework/Accessor.h>
+#include <AccessorFramework/Host.h>
+#include "Director.h"
+#include "GeneratedModel.h"
+
+// Description
+// Microbenchmarks for the operations that every model leans on: scheduling and clearing callbacks on the Director with
+// many callbacks already queued, sending one event to many input ports, passing an event through nested composite
+// accessors, reacting to inputs on many ports at once, setting up a generated model (see GeneratedModel.h), and how
+// reactions scale with the number of threads when independent lanes run in parallel inside one composite. Except for
+// the Director and setup benchmarks, each model is driven with Poll() one round per iteration, so the timings cover
+// whole rounds without any waiting or thread hand-offs. Nothing is ever handed to an executor: the hosts that run and
+// the Director are given one that drops tasks, and the generated models are only set up.
+//
+namespace CoreBenchmarks
+{
+    class NullExecutor : public Executor
+    {
+    public:
+        void Execute(std::function<void()> /*task*/) override
+        {
+        }
+
+        void ExecuteAfter(long long /*delayInMilliseconds*/, std::function<void()> /*task*/) override
+        {
+        }
+    };
+
+    // Outputs a value on each of its outputs every millisecond
+    class Source : public AtomicAccessor
+    {
+    public:
+        Source(const std::string& name, int numberOfOutputs) :
+            AtomicAccessor(name)
+        {
+            for (int i = 0; i < numberOfOutputs; ++i)
+            {
+                this->m_outputPortNames.push_back(GetOutputPortName(i));
+            }
+
+            this->AddSpontaneousOutputPorts(this->m_outputPortNames);
+        }
+
+        static std::string GetOutputPortName(int index)
+        {
+            return "Output" + std::to_string(index);
+        }
+
+    private:
+        void Initialize() override
+        {
+            this->ScheduleCallback(
+                [this]()
+                {
+                    auto event = std::make_shared<Event<int>>(this->m_count++);
+                    for (const auto& outputPortName : this->m_outputPortNames)
+                    {
+                        this->SendOutput(outputPortName, event);
+                    }
+                },
+                1,
+                true /*repeat*/);
+        }
+
+        std::vector<std::string> m_outputPortNames;
+        int m_count = 0;
+    };
+
+    // Adds up the values it receives on all of its inputs
+    class Sink : public AtomicAccessor
+    {
+    public:
+        Sink(const std::string& name, int numberOfInputs) :
+            AtomicAccessor(name)
+        {
+            for (int i = 0; i < numberOfInputs; ++i)
+            {
+                std::string inputPortName = GetInputPortName(i);
+                this->AddInputPort(inputPortName);
+                this->AddInputHandler(inputPortName,
+                    [this](IEvent* event)
+                    {
+                        this->m_sum += static_cast<Event<int>*>(event)->payload;
+                    });
+            }
+        }
+
+        static std::string GetInputPortName(int index)
+        {
+            return "Input" + std::to_string(index);
+        }
+
+    private:
+        long long m_sum = 0;
+    };
+
+    // Passes its input to a child that is either another NestedComposite or, at the bottom, a Sink
+    class NestedComposite : public CompositeAccessor
+    {
+    public:
+        NestedComposite(const std::string& name, int depth) :
+            CompositeAccessor(name, { Input })
+        {
+            // A child cannot have its parent's name
+            std::string childName = "Level" + std::to_string(depth - 1);
+            if (depth > 1)
+            {
+                this->AddChild(std::make_unique<NestedComposite>(childName, depth - 1));
+                this->ConnectMyInputToChildInput(Input, childName, Input);
+            }
+            else
+            {
+                this->AddChild(std::make_unique<Sink>(childName, 1));
+                this->ConnectMyInputToChildInput(Input, childName, Sink::GetInputPortName(0));
+            }
+        }
+
+        static constexpr const char* Input = "Input";
+    };
+
+    // Passes each value on after a fixed amount of arithmetic, standing in for a reaction that does real work
+    class Worker : public AtomicAccessor
+    {
+    public:
+        Worker(const std::string& name, int workPerEvent) :
+            AtomicAccessor(name, { Input }, { Output }),
+            m_workPerEvent(workPerEvent)
+        {
+            this->AddInputHandler(Input,
+                [this](IEvent* event)
+                {
+                    int value = static_cast<Event<int>*>(event)->payload;
+                    for (int i = 0; i < this->m_workPerEvent; ++i)
+                    {
+                        this->m_state = this->m_state * 6364136223846793005ULL + static_cast<unsigned long long>(value);
+                    }
+
+                    benchmark::DoNotOptimize(this->m_state);
+                    this->SendOutput(Output, std::make_shared<Event<int>>(value));
+                });
+        }
+
+        static constexpr const char* Input = "Input";
+        static constexpr const char* Output = "Output";
+
+    private:
+        int m_workPerEvent;
+        unsigned long long m_state = 1ULL;
+    };
+
+    // Holds lanes that are not connected to one another, each a source followed by a chain of workers and a sink
+    class ParallelLanes : public CompositeAccessor
+    {
+    public:
+        ParallelLanes(const std::string& name, int numberOfLanes, int numberOfStages, int workPerEvent) :
+            CompositeAccessor(name)
+        {
+            for (int lane = 0; lane < numberOfLanes; ++lane)
+            {
+                std::string laneName = "Lane" + std::to_string(lane);
+                std::string previousName = laneName + "Source";
+                std::string previousOutput = Source::GetOutputPortName(0);
+                this->AddChild(std::make_unique<Source>(previousName, 1));
+                for (int stage = 0; stage < numberOfStages; ++stage)
+                {
+                    std::string workerName = laneName + "Worker" + std::to_string(stage);
+                    this->AddChild(std::make_unique<Worker>(workerName, workPerEvent));
+                    this->ConnectChildren(previousName, previousOutput, workerName, Worker::Input);
+                    previousName = workerName;
+                    previousOutput = Worker::Output;
+                }
+
+                this->AddChild(std::make_unique<Sink>(laneName + "Sink", 1));
+                this->ConnectChildren(previousName, previousOutput, laneName + "Sink", Sink::GetInputPortName(0));
+            }
+        }
+    };
+
+    class BenchmarkHost : public Host
+    {
+    public:
+        explicit BenchmarkHost(const std::string& name) :
+            Host(name, std::make_shared<NullExecutor>())
+        {
+        }
+
+        using Host::AddChild;
+        using Host::ConnectChildren;
+
+        // Executes the next round right away
+        void ExecuteRound()
+        {
+            this->m_pollTime += std::chrono::milliseconds(1);
+            this->Poll(this->m_pollTime);
+        }
+
+    private:
+        std::chrono::system_clock::time_point m_pollTime = std::chrono::system_clock::now();
+    };
+
+    // QueueScheduledCallback() walks the queue to find each callback's place, so every schedule costs O(queue length)
+    static void BM_DirectorScheduleAndClearCallback(benchmark::State& state)
+    {
+        const int queueLength = static_cast<int>(state.range(0));
+        Director director;
+        director.SetExecutor(std::make_shared<NullExecutor>());
+        for (int i = 0; i < queueLength; ++i)
+        {
+            director.ScheduleCallback([]() {}, 1000 + i, false, i % 16);
+        }
+
+        // The new callback lands in the middle of the queue
+        int delayInMilliseconds = 1000 + queueLength / 2;
+        for (auto _ : state)
+        {
+            int callbackId = director.ScheduleCallback([]() {}, delayInMilliseconds, false, 8);
+            director.ClearScheduledCallback(callbackId);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void BM_SendDataFanOut(benchmark::State& state)
+    {
+        const int numberOfDestinations = static_cast<int>(state.range(0));
+        BenchmarkHost host("Host");
+        host.AddChild(std::make_unique<Source>("Source", 1));
+        for (int i = 0; i < numberOfDestinations; ++i)
+        {
+            std::string sinkName = "Sink" + std::to_string(i);
+            host.AddChild(std::make_unique<Sink>(sinkName, 1));
+            host.ConnectChildren("Source", Source::GetOutputPortName(0), sinkName, Sink::GetInputPortName(0));
+        }
+
+        host.Setup();
+        for (auto _ : state)
+        {
+            host.ExecuteRound();
+        }
+
+        state.SetItemsProcessed(state.iterations() * numberOfDestinations);
+    }
+
+    static void BM_CompositeNestingDepth(benchmark::State& state)
+    {
+        BenchmarkHost host("Host");
+        host.AddChild(std::make_unique<Source>("Source", 1));
+        host.AddChild(std::make_unique<NestedComposite>("Composite", static_cast<int>(state.range(0))));
+        host.ConnectChildren("Source", Source::GetOutputPortName(0), "Composite", NestedComposite::Input);
+        host.Setup();
+        for (auto _ : state)
+        {
+            host.ExecuteRound();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Each output is queued as a callback of its own through the linear QueueScheduledCallback(), so a round costs
+    // O(ports^2): in a Release build of the baseline, 18.7 us at 16 ports and 6.4 ms at 256
+    static void BM_ProcessInputsManyPorts(benchmark::State& state)
+    {
+        const int numberOfPorts = static_cast<int>(state.range(0));
+        BenchmarkHost host("Host");
+        host.AddChild(std::make_unique<Source>("Source", numberOfPorts));
+        host.AddChild(std::make_unique<Sink>("Sink", numberOfPorts));
+        for (int i = 0; i < numberOfPorts; ++i)
+        {
+            host.ConnectChildren("Source", Source::GetOutputPortName(i), "Sink", Sink::GetInputPortName(i));
+        }
+
+        host.Setup();
+        for (auto _ : state)
+        {
+            host.ExecuteRound();
+        }
+
+        state.SetItemsProcessed(state.iterations() * numberOfPorts);
+    }
+
+    // A generated model eight layers deep is built before each setup; its layers are connected during the setup
+    static void BM_HostSetup(benchmark::State& state)
+    {
+        const int NumberOfLayers = 8;
+        const int numberOfAccessors = static_cast<int>(state.range(0));
+        GeneratedModel::ModelParameters parameters{};
+        parameters.width = numberOfAccessors / NumberOfLayers;
+        parameters.depth = NumberOfLayers;
+        parameters.fanIn = std::min(parameters.width, 2);
+        parameters.fanOut = parameters.fanIn;
+        parameters.nestingDepth = 0;
+        parameters.payloadSizeInBytes = 0;
+        parameters.sourceIntervalInMilliseconds = 1;
+        parameters.seed = 1U;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto host = std::make_unique<GeneratedModel::GeneratedModelHost>("Host", parameters);
+            state.ResumeTiming();
+            host->Setup();
+            state.PauseTiming();
+            host.reset();
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * numberOfAccessors);
+    }
+
+    // Eight lanes of four workers each react once per round; an argument of 1 runs the reactions sequentially
+    static void BM_ParallelReactionScaling(benchmark::State& state)
+    {
+        const int NumberOfLanes = 8;
+        const int NumberOfStages = 4;
+        const int WorkPerEvent = 20000;
+        const unsigned int numberOfThreads = static_cast<unsigned int>(state.range(0));
+        BenchmarkHost host("Host");
+        host.AddChild(std::make_unique<ParallelLanes>("Lanes", NumberOfLanes, NumberOfStages, WorkPerEvent));
+        if (numberOfThreads > 1)
+        {
+            host.EnableParallelReactions(numberOfThreads);
+        }
+
+        host.Setup();
+        for (auto _ : state)
+        {
+            host.ExecuteRound();
+        }
+
+        state.SetItemsProcessed(state.iterations() * NumberOfLanes * NumberOfStages);
+    }
+
+    BENCHMARK(BM_DirectorScheduleAndClearCallback)->RangeMultiplier(16)->Range(16, 4096);
+    BENCHMARK(BM_SendDataFanOut)->RangeMultiplier(8)->Range(1, 1024);
+    BENCHMARK(BM_CompositeNestingDepth)->RangeMultiplier(4)->Range(1, 64);
+    BENCHMARK(BM_ProcessInputsManyPorts)->RangeMultiplier(16)->Range(1, 256);
+    BENCHMARK(BM_HostSetup)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(BM_ParallelReactionScaling)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef GENERATED_MODEL_H
+#define GENERATED_MODEL_H
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <AccessorFramework/Accessor.h>
+#include <AccessorFramework/Host.h>
+
+// Description
+// A generator of synthetic models shaped like a layered directed acyclic graph. The first layer holds width spontaneous
+// sources that emit an event every few milliseconds; every later layer holds nodes with fanIn inputs, each connected to
+// a different node of the layer before it, and one output. Every node feeds fanOut different nodes of the next layer,
+// so each layer is fanOut / fanIn times as wide as the one before it: equal fan-in and fan-out keep the width, a larger
+// fan-out broadcasts and a larger fan-in reduces. Connections are picked at random from a seed. The parameters are
+// checked when the model is built, and an invalid_argument exception is thrown if the layers cannot be connected that
+// way (e.g. a layer narrower than fanIn, or a width that does not divide evenly). A node reacts by sending one event that carries a payload
+// of the given size and the time at which the oldest of its inputs left its source; nodes in the last layer record how
+// long each input took to get to them from its source. Each node other than a source can be wrapped in nestingDepth
+// composite accessors that pass its inputs and output through.
+//
+namespace GeneratedModel
+{
+    struct ModelParameters
+    {
+        int width;
+        int depth; // number of layers, including the sources
+        int fanIn;
+        int fanOut;
+        int nestingDepth;
+        int payloadSizeInBytes;
+        int sourceIntervalInMilliseconds;
+        unsigned int seed;
+    };
+
+    struct Payload
+    {
+        long long originTimeInNanoseconds;
+        std::vector<unsigned char> data;
+    };
+
+    static long long GetSteadyTimeInNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static std::string GetInputPortName(int index)
+    {
+        return "In" + std::to_string(index);
+    }
+
+    static const char* OutputPortName = "Out";
+
+    class Source : public AtomicAccessor
+    {
+    public:
+        Source(const std::string& name, const ModelParameters& parameters) :
+            AtomicAccessor(name, {}, {}, { OutputPortName }),
+            m_intervalInMilliseconds(parameters.sourceIntervalInMilliseconds),
+            m_payloadSizeInBytes(parameters.payloadSizeInBytes)
+        {
+        }
+
+    private:
+        void Initialize() override
+        {
+            this->ScheduleCallback(
+                [this]()
+                {
+                    Payload payload{ GetSteadyTimeInNanoseconds(), std::vector<unsigned char>(this->m_payloadSizeInBytes) };
+                    this->SendOutput(OutputPortName, std::make_shared<Event<Payload>>(std::move(payload)));
+                },
+                this->m_intervalInMilliseconds,
+                true /*repeat*/);
+        }
+
+        int m_intervalInMilliseconds;
+        int m_payloadSizeInBytes;
+    };
+
+    class Node : public AtomicAccessor
+    {
+    public:
+        Node(const std::string& name, const ModelParameters& parameters, bool isSink) :
+            AtomicAccessor(name),
+            m_payloadSizeInBytes(parameters.payloadSizeInBytes),
+            m_isSink(isSink),
+            m_oldestOriginTime(0LL),
+            m_numberOfInputsThisReaction(0),
+            m_numberOfEventsReceived(0ULL)
+        {
+            for (int i = 0; i < parameters.fanIn; ++i)
+            {
+                this->AddInputPort(GetInputPortName(i));
+                this->AddInputHandler(GetInputPortName(i),
+                    [this](IEvent* event)
+                    {
+                        this->HandleInput(static_cast<Event<Payload>*>(event)->payload);
+                    });
+            }
+
+            if (!isSink)
+            {
+                this->AddOutputPort(OutputPortName);
+            }
+        }
+
+        unsigned long long GetNumberOfEventsReceived() const
+        {
+            return this->m_numberOfEventsReceived;
+        }
+
+        const std::vector<long long>& GetLatenciesInNanoseconds() const
+        {
+            return this->m_latenciesInNanoseconds;
+        }
+
+    private:
+        void HandleInput(const Payload& payload)
+        {
+            ++this->m_numberOfEventsReceived;
+            if (this->m_isSink)
+            {
+                this->m_latenciesInNanoseconds.push_back(GetSteadyTimeInNanoseconds() - payload.originTimeInNanoseconds);
+            }
+            else if (this->m_numberOfInputsThisReaction++ == 0 || payload.originTimeInNanoseconds < this->m_oldestOriginTime)
+            {
+                this->m_oldestOriginTime = payload.originTimeInNanoseconds;
+            }
+        }
+
+        void Fire() override
+        {
+            if (this->m_isSink || this->m_numberOfInputsThisReaction == 0)
+            {
+                return;
+            }
+
+            Payload payload{ this->m_oldestOriginTime, std::vector<unsigned char>(this->m_payloadSizeInBytes) };
+            this->SendOutput(OutputPortName, std::make_shared<Event<Payload>>(std::move(payload)));
+            this->m_numberOfInputsThisReaction = 0;
+        }
+
+        int m_payloadSizeInBytes;
+        bool m_isSink;
+        long long m_oldestOriginTime;
+        int m_numberOfInputsThisReaction;
+        unsigned long long m_numberOfEventsReceived;
+        std::vector<long long> m_latenciesInNanoseconds;
+    };
+
+    // Passes the inputs and output of its only child through
+    class Wrapper : public CompositeAccessor
+    {
+    public:
+        Wrapper(const std::string& name, std::unique_ptr<Accessor> child, const std::string& childName, int fanIn, bool hasOutput) :
+            CompositeAccessor(name)
+        {
+            this->AddChild(std::move(child));
+            for (int i = 0; i < fanIn; ++i)
+            {
+                this->AddInputPort(GetInputPortName(i));
+                this->ConnectMyInputToChildInput(GetInputPortName(i), childName, GetInputPortName(i));
+            }
+
+            if (hasOutput)
+            {
+                this->AddOutputPort(OutputPortName);
+                this->ConnectChildOutputToMyOutput(childName, OutputPortName, OutputPortName);
+            }
+        }
+    };
+
+    class GeneratedModelHost : public Host
+    {
+    public:
+        GeneratedModelHost(const std::string& name, const ModelParameters& parameters) :
+            Host(name),
+            m_parameters(parameters),
+            m_layerWidths(ComputeLayerWidths(parameters))
+        {
+            for (int layer = 0; layer < parameters.depth; ++layer)
+            {
+                for (int index = 0; index < this->m_layerWidths[layer]; ++index)
+                {
+                    std::string nodeName = GetNodeName(layer, index);
+                    if (layer == 0)
+                    {
+                        this->AddChild(std::make_unique<Source>(nodeName, parameters));
+                        continue;
+                    }
+
+                    // The outermost accessor takes the node's name; a child cannot have its parent's name
+                    bool isSink = (layer == parameters.depth - 1);
+                    std::string accessorName = (parameters.nestingDepth == 0 ? nodeName : "Node");
+                    auto node = std::make_unique<Node>(accessorName, parameters, isSink);
+                    this->m_nodes.push_back(node.get());
+                    std::unique_ptr<Accessor> accessor = std::move(node);
+                    for (int level = 0; level < parameters.nestingDepth; ++level)
+                    {
+                        std::string wrapperName = (level == parameters.nestingDepth - 1 ? nodeName : "Wrapper" + std::to_string(level));
+                        accessor = std::make_unique<Wrapper>(wrapperName, std::move(accessor), accessorName, parameters.fanIn, !isSink);
+                        accessorName = wrapperName;
+                    }
+
+                    this->AddChild(std::move(accessor));
+                }
+            }
+        }
+
+        unsigned long long GetNumberOfEventsReceived() const
+        {
+            unsigned long long numberOfEventsReceived = 0ULL;
+            for (const Node* node : this->m_nodes)
+            {
+                numberOfEventsReceived += node->GetNumberOfEventsReceived();
+            }
+
+            return numberOfEventsReceived;
+        }
+
+        void CollectLatencies(std::vector<long long>& latenciesInNanoseconds) const
+        {
+            for (const Node* node : this->m_nodes)
+            {
+                const auto& nodeLatencies = node->GetLatenciesInNanoseconds();
+                latenciesInNanoseconds.insert(latenciesInNanoseconds.end(), nodeLatencies.begin(), nodeLatencies.end());
+            }
+        }
+
+    protected:
+        // The connections between two layers are numbered k = j * fanIn + i, for input i of node j, and connection k
+        // comes from predecessor k mod (width of the previous layer). The inputs of a node then come from fanIn
+        // consecutive predecessors, which are different because no layer is narrower than fanIn, and each predecessor
+        // feeds every (previous width)-th connection, fanOut of them in all, which land on different nodes because the
+        // previous width is at least fanIn. Both layers are shuffled first, so the model is random but keeps that shape.
+        void AdditionalSetup() override
+        {
+            std::mt19937 random(this->m_parameters.seed);
+            for (int layer = 1; layer < this->m_parameters.depth; ++layer)
+            {
+                std::vector<int> predecessors = ShuffledIndices(this->m_layerWidths[layer - 1], random);
+                std::vector<int> successors = ShuffledIndices(this->m_layerWidths[layer], random);
+                for (int index = 0; index < this->m_layerWidths[layer]; ++index)
+                {
+                    for (int input = 0; input < this->m_parameters.fanIn; ++input)
+                    {
+                        int connection = index * this->m_parameters.fanIn + input;
+                        int predecessor = predecessors[connection % this->m_layerWidths[layer - 1]];
+                        this->ConnectChildren(GetNodeName(layer - 1, predecessor), OutputPortName, GetNodeName(layer, successors[index]), GetInputPortName(input));
+                    }
+                }
+            }
+        }
+
+    private:
+        static std::vector<int> ComputeLayerWidths(const ModelParameters& parameters)
+        {
+            std::ostringstream exceptionMessage;
+            if (parameters.width < 1 || parameters.depth < 1 || parameters.fanIn < 1 || parameters.fanOut < 1 || parameters.nestingDepth < 0)
+            {
+                exceptionMessage << "A generated model needs a width, depth, fan-in and fan-out of at least 1 and a nesting depth of at least 0";
+                throw std::invalid_argument(exceptionMessage.str());
+            }
+
+            std::vector<int> layerWidths{ parameters.width };
+            for (int layer = 1; layer < parameters.depth; ++layer)
+            {
+                long long previousWidth = layerWidths.back();
+                if (previousWidth < parameters.fanIn || (previousWidth * parameters.fanOut) % parameters.fanIn != 0)
+                {
+                    exceptionMessage << "Layer " << (layer - 1) << " of a generated model has " << previousWidth << " nodes, which cannot feed "
+                        << parameters.fanOut << " nodes each with every node of the next layer taking " << parameters.fanIn << " inputs";
+                    throw std::invalid_argument(exceptionMessage.str());
+                }
+
+                layerWidths.push_back(static_cast<int>(previousWidth * parameters.fanOut / parameters.fanIn));
+            }
+
+            return layerWidths;
+        }
+
+        static std::vector<int> ShuffledIndices(int count, std::mt19937& random)
+        {
+            std::vector<int> indices(count);
+            std::iota(indices.begin(), indices.end(), 0);
+            std::shuffle(indices.begin(), indices.end(), random);
+            return indices;
+        }
+
+        static std::string GetNodeName(int layer, int index)
+        {
+            return "L" + std::to_string(layer) + "N" + std::to_string(index);
+        }
+
+        const ModelParameters m_parameters;
+        const std::vector<int> m_layerWidths;
+        std::vector<const Node*> m_nodes;
+    };
+}
+
+#endif // GENERATED_MODEL_H
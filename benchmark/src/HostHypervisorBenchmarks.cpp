@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <AccessorFramework/Accessor.h>
+#include <AccessorFramework/Host.h>
+
+// Description
+// Compares hosts that each run on a thread of their own with the same hosts sharing a HostHypervisor's thread pool.
+// Every host contains a few accessors with periodic timers that do almost no work, so the cost being measured is that of
+// scheduling. Each run reports the number of OS threads in the process while the hosts are running, along with how late
+// the timers fired (relative to their first firing) at the 50th and 99th percentiles and at worst.
+//
+namespace HostHypervisorBenchmarks
+{
+    static const int TimerIntervalInMilliseconds = 10;
+    static const int TimersPerHost = 4;
+    static const auto RunDuration = std::chrono::milliseconds(1000);
+
+    class TickProbe : public AtomicAccessor
+    {
+    public:
+        explicit TickProbe(const std::string& name) :
+            AtomicAccessor(name)
+        {
+        }
+
+        const std::vector<long long>& GetLatenessInMicroseconds() const
+        {
+            return this->m_latenessInMicroseconds;
+        }
+
+    private:
+        void Initialize() override
+        {
+            this->ScheduleCallback(
+                [this]()
+                {
+                    auto now = std::chrono::steady_clock::now();
+                    if (this->m_numberOfTicks == 0)
+                    {
+                        this->m_firstTick = now;
+                    }
+                    else
+                    {
+                        auto expectedTime = this->m_firstTick + std::chrono::milliseconds(this->m_numberOfTicks * TimerIntervalInMilliseconds);
+                        auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - expectedTime).count();
+                        this->m_latenessInMicroseconds.push_back(std::max<long long>(lateness, 0LL));
+                    }
+
+                    ++this->m_numberOfTicks;
+                },
+                TimerIntervalInMilliseconds,
+                true /*repeat*/);
+        }
+
+        std::chrono::steady_clock::time_point m_firstTick;
+        long long m_numberOfTicks = 0;
+        std::vector<long long> m_latenessInMicroseconds;
+    };
+
+    class TickHost : public Host
+    {
+    public:
+        explicit TickHost(const std::string& name) :
+            Host(name)
+        {
+            for (int i = 0; i < TimersPerHost; ++i)
+            {
+                auto probe = std::make_unique<TickProbe>("Probe" + std::to_string(i));
+                this->m_probes.push_back(probe.get());
+                this->AddChild(std::move(probe));
+            }
+        }
+
+        void CollectLateness(std::vector<long long>& latenessInMicroseconds) const
+        {
+            for (const TickProbe* probe : this->m_probes)
+            {
+                const auto& probeLateness = probe->GetLatenessInMicroseconds();
+                latenessInMicroseconds.insert(latenessInMicroseconds.end(), probeLateness.begin(), probeLateness.end());
+            }
+        }
+
+    private:
+        std::vector<const TickProbe*> m_probes;
+    };
+
+    // Returns the number of threads in this process, or -1 where that is not supported
+    static int GetNumberOfThreads()
+    {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 8, "Threads:") == 0)
+            {
+                return std::stoi(line.substr(8));
+            }
+        }
+#endif
+        return -1;
+    }
+
+    static void ReportLateness(benchmark::State& state, std::vector<long long>& latenessInMicroseconds, int numberOfThreads)
+    {
+        state.counters["threads"] = numberOfThreads;
+        if (latenessInMicroseconds.empty())
+        {
+            return;
+        }
+
+        std::sort(latenessInMicroseconds.begin(), latenessInMicroseconds.end());
+        auto percentile = [&latenessInMicroseconds](double fraction)
+        {
+            size_t index = static_cast<size_t>(fraction * (latenessInMicroseconds.size() - 1));
+            return static_cast<double>(latenessInMicroseconds[index]);
+        };
+
+        state.counters["late_p50_us"] = percentile(0.50);
+        state.counters["late_p99_us"] = percentile(0.99);
+        state.counters["late_max_us"] = static_cast<double>(latenessInMicroseconds.back());
+        state.counters["ticks"] = static_cast<double>(latenessInMicroseconds.size());
+    }
+
+    static void BM_StandaloneHosts(benchmark::State& state)
+    {
+        const int numberOfHosts = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            std::vector<std::unique_ptr<TickHost>> hosts;
+            for (int i = 0; i < numberOfHosts; ++i)
+            {
+                hosts.push_back(std::make_unique<TickHost>("Host" + std::to_string(i)));
+                hosts.back()->Setup();
+            }
+
+            for (auto& host : hosts)
+            {
+                host->Run();
+            }
+
+            std::this_thread::sleep_for(RunDuration);
+            int numberOfThreads = GetNumberOfThreads();
+            for (auto& host : hosts)
+            {
+                host->Exit();
+            }
+
+            std::vector<long long> latenessInMicroseconds;
+            for (const auto& host : hosts)
+            {
+                host->CollectLateness(latenessInMicroseconds);
+            }
+
+            ReportLateness(state, latenessInMicroseconds, numberOfThreads);
+        }
+    }
+
+    static void BM_HypervisorHosts(benchmark::State& state)
+    {
+        const int numberOfHosts = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            HostHypervisor hypervisor;
+            std::vector<const TickHost*> hosts;
+            for (int i = 0; i < numberOfHosts; ++i)
+            {
+                auto host = std::make_unique<TickHost>("Host" + std::to_string(i));
+                hosts.push_back(host.get());
+                hypervisor.AddHost(std::move(host));
+            }
+
+            hypervisor.SetupHosts();
+            hypervisor.RunHosts();
+            std::this_thread::sleep_for(RunDuration);
+            int numberOfThreads = GetNumberOfThreads();
+            hypervisor.PauseHosts();
+
+            std::vector<long long> latenessInMicroseconds;
+            for (const TickHost* host : hosts)
+            {
+                host->CollectLateness(latenessInMicroseconds);
+            }
+
+            ReportLateness(state, latenessInMicroseconds, numberOfThreads);
+            hypervisor.RemoveAllHosts();
+        }
+    }
+
+    BENCHMARK(BM_StandaloneHosts)->Arg(1)->Arg(8)->Arg(32)->Arg(128)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_HypervisorHosts)->Arg(1)->Arg(8)->Arg(32)->Arg(128)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
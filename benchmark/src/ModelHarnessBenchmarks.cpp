@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "GeneratedModel.h"
+
+// Description
+// Runs generated models (see GeneratedModel.h) on a host for a fixed time and reports the number of events delivered
+// to accessors per second, along with how long events took to get from a source to the last layer at the 50th, 99th,
+// and 99.9th percentiles. The arguments are, in order: width, depth, fan-in, fan-out, nesting depth, payload size in
+// bytes, and source interval in milliseconds. Add a configuration that looks like a real workload to size a deployment
+// for it.
+//
+namespace ModelHarnessBenchmarks
+{
+    static const auto RunDuration = std::chrono::milliseconds(2000);
+    static const unsigned int Seed = 12345;
+
+    static void BM_GeneratedModel(benchmark::State& state)
+    {
+        GeneratedModel::ModelParameters parameters{};
+        parameters.width = static_cast<int>(state.range(0));
+        parameters.depth = static_cast<int>(state.range(1));
+        parameters.fanIn = static_cast<int>(state.range(2));
+        parameters.fanOut = static_cast<int>(state.range(3));
+        parameters.nestingDepth = static_cast<int>(state.range(4));
+        parameters.payloadSizeInBytes = static_cast<int>(state.range(5));
+        parameters.sourceIntervalInMilliseconds = static_cast<int>(state.range(6));
+        parameters.seed = Seed;
+        for (auto _ : state)
+        {
+            GeneratedModel::GeneratedModelHost host("Host", parameters);
+            host.Setup();
+            auto startTime = std::chrono::steady_clock::now();
+            host.Run();
+            std::this_thread::sleep_for(RunDuration);
+            host.Exit();
+            double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            std::vector<long long> latenciesInNanoseconds;
+            host.CollectLatencies(latenciesInNanoseconds);
+            state.counters["events_per_second"] = static_cast<double>(host.GetNumberOfEventsReceived()) / elapsedSeconds;
+            if (latenciesInNanoseconds.empty())
+            {
+                continue;
+            }
+
+            std::sort(latenciesInNanoseconds.begin(), latenciesInNanoseconds.end());
+            auto percentile = [&latenciesInNanoseconds](double fraction)
+            {
+                size_t index = static_cast<size_t>(fraction * (latenciesInNanoseconds.size() - 1));
+                return static_cast<double>(latenciesInNanoseconds[index]) / 1000.0;
+            };
+
+            state.counters["latency_p50_us"] = percentile(0.50);
+            state.counters["latency_p99_us"] = percentile(0.99);
+            state.counters["latency_p999_us"] = percentile(0.999);
+            state.counters["samples"] = static_cast<double>(latenciesInNanoseconds.size());
+        }
+    }
+
+    BENCHMARK(BM_GeneratedModel)
+        ->ArgNames({ "width", "depth", "fanIn", "fanOut", "nesting", "payload", "interval" })
+        ->Args({ 4, 4, 2, 2, 0, 16, 10 })
+        ->Args({ 64, 4, 4, 4, 0, 16, 10 })
+        ->Args({ 4, 32, 2, 2, 0, 16, 10 })
+        ->Args({ 8, 4, 2, 2, 4, 16, 10 })
+        ->Args({ 8, 4, 2, 2, 0, 4096, 10 })
+        ->Args({ 16, 8, 4, 4, 1, 256, 1 })
+        ->Args({ 2, 5, 1, 2, 0, 16, 10 }) // broadcast: each layer twice as wide as the last
+        ->Args({ 64, 5, 4, 2, 0, 16, 10 }) // reduction: each layer half as wide as the last
+        ->Iterations(1)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <AccessorFramework/Accessor.h>
+#include <AccessorFramework/Host.h>
+
+// Description
+// Measures what the per-accessor profiling counters cost. A ticker with a 1 ms timer feeds a chain of relays that pass
+// every value along, so each round runs one reaction per accessor and moves one event across every connection. The host
+// is driven with Poll() far enough ahead to execute 100 rounds per iteration without waiting, once with profiling enabled
+// and once with it disabled; the difference between the two is the overhead of profiling. Build in Release to compare.
+//
+namespace ProfilingBenchmarks
+{
+    static const int RoundsPerIteration = 100;
+
+    class Ticker : public AtomicAccessor
+    {
+    public:
+        explicit Ticker(const std::string& name) :
+            AtomicAccessor(name, {}, {}, { Output })
+        {
+        }
+
+        static constexpr const char* Output = "Output";
+
+    private:
+        void Initialize() override
+        {
+            this->ScheduleCallback(
+                [this]()
+                {
+                    this->SendOutput(Output, std::make_shared<Event<int>>(this->m_count++));
+                },
+                1,
+                true /*repeat*/);
+        }
+
+        int m_count = 0;
+    };
+
+    class Relay : public AtomicAccessor
+    {
+    public:
+        explicit Relay(const std::string& name) :
+            AtomicAccessor(name, { Input }, { Output })
+        {
+            this->AddInputHandler(Input,
+                [this](IEvent* event)
+                {
+                    this->m_latestInput = static_cast<Event<int>*>(event)->payload;
+                });
+        }
+
+        static constexpr const char* Input = "Input";
+        static constexpr const char* Output = "Output";
+
+    private:
+        void Fire() override
+        {
+            this->SendOutput(Output, std::make_shared<Event<int>>(this->m_latestInput));
+        }
+
+        int m_latestInput = 0;
+    };
+
+    class RelayChainHost : public Host
+    {
+    public:
+        RelayChainHost(const std::string& name, int numberOfRelays) :
+            Host(name),
+            m_numberOfRelays(numberOfRelays)
+        {
+            this->AddChild(std::make_unique<Ticker>("Ticker"));
+            for (int i = 0; i < numberOfRelays; ++i)
+            {
+                this->AddChild(std::make_unique<Relay>("Relay" + std::to_string(i)));
+            }
+        }
+
+        void AdditionalSetup() override
+        {
+            this->ConnectChildren("Ticker", Ticker::Output, "Relay0", Relay::Input);
+            for (int i = 1; i < this->m_numberOfRelays; ++i)
+            {
+                this->ConnectChildren("Relay" + std::to_string(i - 1), Relay::Output, "Relay" + std::to_string(i), Relay::Input);
+            }
+        }
+
+    private:
+        int m_numberOfRelays;
+    };
+
+    static void RunRelayChain(benchmark::State& state, bool profilingEnabled)
+    {
+        Host::SetProfilingEnabled(profilingEnabled);
+        RelayChainHost host("Host", static_cast<int>(state.range(0)));
+        host.Setup();
+        auto pollTime = std::chrono::system_clock::now();
+        for (auto _ : state)
+        {
+            pollTime += std::chrono::milliseconds(RoundsPerIteration);
+            host.Poll(pollTime);
+        }
+
+        state.SetItemsProcessed(state.iterations() * RoundsPerIteration * (state.range(0) + 1));
+        Host::SetProfilingEnabled(true);
+    }
+
+    static void BM_RelayChainProfilingEnabled(benchmark::State& state)
+    {
+        RunRelayChain(state, true);
+    }
+
+    static void BM_RelayChainProfilingDisabled(benchmark::State& state)
+    {
+        RunRelayChain(state, false);
+    }
+
+    BENCHMARK(BM_RelayChainProfilingDisabled)->Arg(4)->Arg(32)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(BM_RelayChainProfilingEnabled)->Arg(4)->Arg(32)->Unit(benchmark::kMicrosecond);
+}
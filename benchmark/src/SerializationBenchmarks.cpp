@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <AccessorFramework/EventSerializer.h>
+
+// Description
+// Compares the throughput of the event serializer with that of memcpy. A flat payload of 64 bytes and a vector of
+// doubles of the given size are each serialized into a buffer that is reused across iterations, deserialized into a new
+// event, and viewed in place; the memcpy benchmarks copy the same number of payload bytes. Build in Release to compare.
+//
+namespace SerializationBenchmarks
+{
+    struct Sample
+    {
+        long long timestamp;
+        double values[7];
+    };
+}
+
+template<> struct EventTypeId<SerializationBenchmarks::Sample> : std::integral_constant<IEvent::TypeId, 1> {};
+template<> struct EventTypeId<std::vector<double>> : std::integral_constant<IEvent::TypeId, 2> {};
+
+namespace SerializationBenchmarks
+{
+    static EventSerializer& GetSerializer()
+    {
+        static EventSerializer serializer;
+        static bool isRegistered = false;
+        if (!isRegistered)
+        {
+            serializer.Register<Sample>();
+            serializer.Register<std::vector<double>>();
+            isRegistered = true;
+        }
+
+        return serializer;
+    }
+
+    static void BM_MemcpyFlatPayload(benchmark::State& state)
+    {
+        Sample sample{};
+        std::vector<unsigned char> buffer(sizeof(Sample));
+        for (auto _ : state)
+        {
+            std::memcpy(buffer.data(), &sample, sizeof(Sample));
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * sizeof(Sample));
+    }
+
+    static void BM_SerializeFlatPayload(benchmark::State& state)
+    {
+        const EventSerializer& serializer = GetSerializer();
+        Event<Sample> event(Sample{});
+        std::vector<unsigned char> buffer;
+        for (auto _ : state)
+        {
+            buffer.clear();
+            serializer.Serialize(event, buffer);
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * sizeof(Sample));
+    }
+
+    static void BM_DeserializeFlatPayload(benchmark::State& state)
+    {
+        const EventSerializer& serializer = GetSerializer();
+        std::vector<unsigned char> buffer;
+        serializer.Serialize(Event<Sample>(Sample{}), buffer);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializer.Deserialize(buffer.data(), buffer.size()));
+        }
+
+        state.SetBytesProcessed(state.iterations() * sizeof(Sample));
+    }
+
+    static void BM_ViewFlatPayload(benchmark::State& state)
+    {
+        const EventSerializer& serializer = GetSerializer();
+        std::vector<unsigned char> buffer;
+        serializer.Serialize(Event<Sample>(Sample{}), buffer);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializer.View<Sample>(buffer.data(), buffer.size()));
+        }
+
+        state.SetBytesProcessed(state.iterations() * sizeof(Sample));
+    }
+
+    static void BM_MemcpyVector(benchmark::State& state)
+    {
+        std::vector<double> values(static_cast<size_t>(state.range(0)), 1.0);
+        std::vector<unsigned char> buffer(values.size() * sizeof(double));
+        for (auto _ : state)
+        {
+            std::memcpy(buffer.data(), values.data(), buffer.size());
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * buffer.size());
+    }
+
+    static void BM_SerializeVector(benchmark::State& state)
+    {
+        const EventSerializer& serializer = GetSerializer();
+        Event<std::vector<double>> event(std::vector<double>(static_cast<size_t>(state.range(0)), 1.0));
+        std::vector<unsigned char> buffer;
+        for (auto _ : state)
+        {
+            buffer.clear();
+            serializer.Serialize(event, buffer);
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * event.payload.size() * sizeof(double));
+    }
+
+    static void BM_DeserializeVector(benchmark::State& state)
+    {
+        const EventSerializer& serializer = GetSerializer();
+        std::vector<unsigned char> buffer;
+        serializer.Serialize(Event<std::vector<double>>(std::vector<double>(static_cast<size_t>(state.range(0)), 1.0)), buffer);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(serializer.Deserialize(buffer.data(), buffer.size()));
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+    }
+
+    BENCHMARK(BM_MemcpyFlatPayload);
+    BENCHMARK(BM_SerializeFlatPayload);
+    BENCHMARK(BM_DeserializeFlatPayload);
+    BENCHMARK(BM_ViewFlatPayload);
+    BENCHMARK(BM_MemcpyVector)->Arg(1024)->Arg(65536);
+    BENCHMARK(BM_SerializeVector)->Arg(1024)->Arg(65536);
+    BENCHMARK(BM_DeserializeVector)->Arg(1024)->Arg(65536);
+}
@@ -6,6 +6,7 @@
 
 #include "Event.h"
 #include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <queue>
@@ -127,6 +128,8 @@ public:
         const std::map<std::string, std::vector<InputHandler>>& inputHandlers = {});
 
 protected:
+    AtomicAccessor(std::unique_ptr<Impl> impl);
+
     // Declares an input port that changes this accessor's state
     void AccessorStateDependsOn(const std::string& inputPortName);
 
@@ -144,6 +147,23 @@ protected:
 
     // Called once per reaction (base implementation does nothing)
     virtual void Fire();
+
+    // Runs the work on a pool of worker threads shared by all hosts, then delivers its result to one of this accessor's
+    // input ports the given number of milliseconds of logical time after the call. If the work has not finished by then,
+    // the round waits for it, so the result never arrives at a different logical time. The work runs concurrently with
+    // the model and must not touch any accessor. An exception thrown by the work is rethrown when its result is
+    // delivered. Returns false, without running the work, if the offload queue is full (see
+    // Host::SetOffloadQueueCapacity()).
+    bool Offload(std::function<std::shared_ptr<IEvent>()> work, const std::string& completionPortName, int delayInMilliseconds = 0);
+
+    // Called when the host is checkpointed, to write any state of the accessor's own (base implementation writes nothing)
+    virtual void SaveState(std::ostream& stream) const;
+
+    // Called instead of Initialize() when the host is restored from a checkpoint, with what SaveState() wrote. Callbacks
+    // scheduled here take the place, in order, of those the accessor had scheduled when the checkpoint was taken, and
+    // resume their timing. Outputs waiting to be sent at the checkpoint are sent again, so none should be sent here.
+    // (base implementation calls Initialize())
+    virtual void RestoreState(std::istream& stream);
 };
 
 #endif //ACCESSOR_H
@@ -4,16 +4,63 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 // Description
-// An Event is a data structure that is passed between ports. It may or may not contain a payload.
+// An Event is a data structure that is passed between ports. It may or may not contain a payload. Every Event<T> carries
+// the type ID of T, so that code that only sees an IEvent, such as an EventSerializer, can tell what type of payload it
+// holds without RTTI. A payload type is given an ID by specializing EventTypeId<T> next to the type's definition, so the
+// ID is the same in every shared object and every run, and it identifies the type in serialized events. The
+// specialization must be visible wherever Event<T> is used. IDs from 1 to 0x7fffffff are for applications; the framework
+// declares IDs above that for arithmetic types and std::string. Events of any other type, and an IEvent constructed
+// directly, have type ID 0.
 //
-class IEvent {};
+class IEvent
+{
+public:
+    using TypeId = uint32_t;
+
+    IEvent() : m_typeId(0) {}
+    TypeId GetTypeId() const { return this->m_typeId; }
+
+protected:
+    explicit IEvent(TypeId typeId) : m_typeId(typeId) {}
+
+private:
+    TypeId m_typeId;
+};
+
+template <class T>
+struct EventTypeId : std::integral_constant<IEvent::TypeId, 0>
+{
+};
+
+template <> struct EventTypeId<bool> : std::integral_constant<IEvent::TypeId, 0x80000001> {};
+template <> struct EventTypeId<char> : std::integral_constant<IEvent::TypeId, 0x80000002> {};
+template <> struct EventTypeId<signed char> : std::integral_constant<IEvent::TypeId, 0x80000003> {};
+template <> struct EventTypeId<unsigned char> : std::integral_constant<IEvent::TypeId, 0x80000004> {};
+template <> struct EventTypeId<short> : std::integral_constant<IEvent::TypeId, 0x80000005> {};
+template <> struct EventTypeId<unsigned short> : std::integral_constant<IEvent::TypeId, 0x80000006> {};
+template <> struct EventTypeId<int> : std::integral_constant<IEvent::TypeId, 0x80000007> {};
+template <> struct EventTypeId<unsigned int> : std::integral_constant<IEvent::TypeId, 0x80000008> {};
+template <> struct EventTypeId<long> : std::integral_constant<IEvent::TypeId, 0x80000009> {};
+template <> struct EventTypeId<unsigned long> : std::integral_constant<IEvent::TypeId, 0x8000000a> {};
+template <> struct EventTypeId<long long> : std::integral_constant<IEvent::TypeId, 0x8000000b> {};
+template <> struct EventTypeId<unsigned long long> : std::integral_constant<IEvent::TypeId, 0x8000000c> {};
+template <> struct EventTypeId<float> : std::integral_constant<IEvent::TypeId, 0x8000000d> {};
+template <> struct EventTypeId<double> : std::integral_constant<IEvent::TypeId, 0x8000000e> {};
+template <> struct EventTypeId<long double> : std::integral_constant<IEvent::TypeId, 0x8000000f> {};
+template <> struct EventTypeId<std::string> : std::integral_constant<IEvent::TypeId, 0x80000010> {};
 
 template <class T>
 class Event : public IEvent
 {
 public:
-    Event(const T& payload) : payload(payload) {}
+    Event(const T& payload) : IEvent(EventTypeId<T>::value), payload(payload) {}
+    Event(T&& payload) : IEvent(EventTypeId<T>::value), payload(std::move(payload)) {}
     const T payload;
 };
 
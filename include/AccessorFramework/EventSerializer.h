@@ -0,0 +1,419 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EVENT_SERIALIZER_H
+#define EVENT_SERIALIZER_H
+
+#include "Event.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Description
+// An EventSerializer turns events into bytes and back, for features that carry events out of the process or keep them
+// for later. Each payload type to be serialized must have a type ID (see Event.h), which identifies the type in
+// serialized events, and is registered with a schema version. A serialized event is a 16-byte record header, which holds
+// the type ID, the version, and the size of the payload, followed by the payload, padded to a multiple of 8 bytes so
+// that records written one after another stay aligned.
+//
+// Payloads are written and read by Serializer<T>. It copies trivially copyable types as they are, and it handles
+// std::string, std::vector, std::array, std::pair, std::map, and std::unordered_map of serializable types, copying a
+// vector of trivially copyable elements in one go. Other payload types need a specialization of Serializer<T> with a
+// static Write() and Read() of their own; Read() returns false if the bytes are not valid, and every element of a
+// container must take at least one byte. Bytes are in the native byte order, so they are only portable between
+// processes on machines of the same architecture.
+//
+// When a payload type changes, its version is raised and the function given for reading older versions is used to read
+// events serialized before the change. Events with a version newer than the registered one cannot be read. Deserialize()
+// checks everything it reads, so it can be given bytes from an untrusted source. For trivially copyable payloads, and
+// vectors of them, View() and ViewArray() return the payload in place instead of copying it into a new event.
+//
+// Types must all be registered before the serializer is used; after that, it can be used from several threads at once.
+//
+template<class T>
+struct IsFlat : std::integral_constant<bool, std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>
+{
+};
+
+class ByteWriter
+{
+public:
+    explicit ByteWriter(std::vector<unsigned char>& buffer) : m_buffer(buffer) {}
+
+    void Write(const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        this->m_buffer.insert(this->m_buffer.end(), bytes, bytes + size);
+    }
+
+private:
+    std::vector<unsigned char>& m_buffer;
+};
+
+class ByteReader
+{
+public:
+    ByteReader(const unsigned char* data, size_t size) : m_position(data), m_end(data + size) {}
+
+    size_t GetRemainingSize() const
+    {
+        return static_cast<size_t>(this->m_end - this->m_position);
+    }
+
+    // Returns null, and reads nothing, if fewer bytes remain
+    const unsigned char* ReadBytes(uint64_t size)
+    {
+        if (size > this->GetRemainingSize())
+        {
+            return nullptr;
+        }
+
+        const unsigned char* data = this->m_position;
+        this->m_position += size;
+        return data;
+    }
+
+    bool Read(void* destination, size_t size)
+    {
+        const unsigned char* data = this->ReadBytes(size);
+        if (data == nullptr)
+        {
+            return false;
+        }
+
+        std::memcpy(destination, data, size);
+        return true;
+    }
+
+    // Fails if there are not enough bytes left for that many elements of at least one byte each
+    bool ReadElementCount(uint64_t& count)
+    {
+        return (this->Read(&count, sizeof(count)) && count <= this->GetRemainingSize());
+    }
+
+private:
+    const unsigned char* m_position;
+    const unsigned char* m_end;
+};
+
+template<class T, class Enable = void>
+struct Serializer;
+
+template<class T>
+struct Serializer<T, typename std::enable_if<IsFlat<T>::value>::type>
+{
+    static void Write(ByteWriter& writer, const T& value)
+    {
+        writer.Write(&value, sizeof(T));
+    }
+
+    static bool Read(ByteReader& reader, T& value)
+    {
+        return reader.Read(&value, sizeof(T));
+    }
+};
+
+template<>
+struct Serializer<std::string>
+{
+    static void Write(ByteWriter& writer, const std::string& value)
+    {
+        uint64_t size = value.size();
+        writer.Write(&size, sizeof(size));
+        writer.Write(value.data(), value.size());
+    }
+
+    static bool Read(ByteReader& reader, std::string& value)
+    {
+        uint64_t size = 0;
+        const unsigned char* data = nullptr;
+        if (!reader.Read(&size, sizeof(size)) || (data = reader.ReadBytes(size)) == nullptr)
+        {
+            return false;
+        }
+
+        value.assign(reinterpret_cast<const char*>(data), static_cast<size_t>(size));
+        return true;
+    }
+};
+
+template<class T, class Allocator>
+struct Serializer<std::vector<T, Allocator>>
+{
+    static void Write(ByteWriter& writer, const std::vector<T, Allocator>& value)
+    {
+        uint64_t count = value.size();
+        writer.Write(&count, sizeof(count));
+        WriteElements(writer, value, IsCopiedInOneGo{});
+    }
+
+    static bool Read(ByteReader& reader, std::vector<T, Allocator>& value)
+    {
+        uint64_t count = 0;
+        return (reader.ReadElementCount(count) && ReadElements(reader, count, value, IsCopiedInOneGo{}));
+    }
+
+private:
+    // std::vector<bool> does not store its elements as an array of bool
+    using IsCopiedInOneGo = std::integral_constant<bool, IsFlat<T>::value && !std::is_same<T, bool>::value>;
+
+    static void WriteElements(ByteWriter& writer, const std::vector<T, Allocator>& value, std::true_type)
+    {
+        writer.Write(value.data(), value.size() * sizeof(T));
+    }
+
+    static void WriteElements(ByteWriter& writer, const std::vector<T, Allocator>& value, std::false_type)
+    {
+        for (const T& element : value)
+        {
+            Serializer<T>::Write(writer, element);
+        }
+    }
+
+    static bool ReadElements(ByteReader& reader, uint64_t count, std::vector<T, Allocator>& value, std::true_type)
+    {
+        if (count > reader.GetRemainingSize() / sizeof(T))
+        {
+            return false;
+        }
+
+        value.resize(static_cast<size_t>(count));
+        return reader.Read(value.data(), value.size() * sizeof(T));
+    }
+
+    static bool ReadElements(ByteReader& reader, uint64_t count, std::vector<T, Allocator>& value, std::false_type)
+    {
+        value.clear();
+        value.reserve(static_cast<size_t>(count));
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            T element{};
+            if (!Serializer<T>::Read(reader, element))
+            {
+                return false;
+            }
+
+            value.push_back(std::move(element));
+        }
+
+        return true;
+    }
+};
+
+template<class T, size_t N>
+struct Serializer<std::array<T, N>, typename std::enable_if<!IsFlat<std::array<T, N>>::value>::type>
+{
+    static void Write(ByteWriter& writer, const std::array<T, N>& value)
+    {
+        for (const T& element : value)
+        {
+            Serializer<T>::Write(writer, element);
+        }
+    }
+
+    static bool Read(ByteReader& reader, std::array<T, N>& value)
+    {
+        for (T& element : value)
+        {
+            if (!Serializer<T>::Read(reader, element))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+template<class First, class Second>
+struct Serializer<std::pair<First, Second>, typename std::enable_if<!IsFlat<std::pair<First, Second>>::value>::type>
+{
+    static void Write(ByteWriter& writer, const std::pair<First, Second>& value)
+    {
+        Serializer<First>::Write(writer, value.first);
+        Serializer<Second>::Write(writer, value.second);
+    }
+
+    static bool Read(ByteReader& reader, std::pair<First, Second>& value)
+    {
+        return (Serializer<First>::Read(reader, value.first) && Serializer<Second>::Read(reader, value.second));
+    }
+};
+
+template<class Map>
+struct MapSerializer
+{
+    static void Write(ByteWriter& writer, const Map& value)
+    {
+        uint64_t count = value.size();
+        writer.Write(&count, sizeof(count));
+        for (const auto& entry : value)
+        {
+            Serializer<typename Map::key_type>::Write(writer, entry.first);
+            Serializer<typename Map::mapped_type>::Write(writer, entry.second);
+        }
+    }
+
+    static bool Read(ByteReader& reader, Map& value)
+    {
+        uint64_t count = 0;
+        if (!reader.ReadElementCount(count))
+        {
+            return false;
+        }
+
+        value.clear();
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            typename Map::key_type key{};
+            typename Map::mapped_type mapped{};
+            if (!Serializer<typename Map::key_type>::Read(reader, key) || !Serializer<typename Map::mapped_type>::Read(reader, mapped))
+            {
+                return false;
+            }
+
+            value.emplace(std::move(key), std::move(mapped));
+        }
+
+        return true;
+    }
+};
+
+template<class Key, class Value, class Compare, class Allocator>
+struct Serializer<std::map<Key, Value, Compare, Allocator>> : MapSerializer<std::map<Key, Value, Compare, Allocator>>
+{
+};
+
+template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+struct Serializer<std::unordered_map<Key, Value, Hash, KeyEqual, Allocator>> : MapSerializer<std::unordered_map<Key, Value, Hash, KeyEqual, Allocator>>
+{
+};
+
+// A view of an array that stays in the buffer it was serialized into
+template<class T>
+class ArrayView
+{
+public:
+    ArrayView() : m_data(nullptr), m_size(0) {}
+    ArrayView(const T* data, size_t size) : m_data(data), m_size(size) {}
+    const T* GetData() const { return this->m_data; }
+    size_t GetSize() const { return this->m_size; }
+    bool IsValid() const { return (this->m_data != nullptr); }
+    const T& operator[](size_t index) const { return this->m_data[index]; }
+    const T* begin() const { return this->m_data; }
+    const T* end() const { return this->m_data + this->m_size; }
+
+private:
+    const T* m_data;
+    size_t m_size;
+};
+
+class EventSerializer
+{
+public:
+    class Impl;
+
+    EventSerializer();
+    ~EventSerializer();
+    Impl* GetImpl() const;
+
+    // Registers the payload type T. Events of an older version are read with readOlderVersion, if it is given; otherwise,
+    // they cannot be read.
+    template<class T>
+    void Register(uint32_t version = 1, std::function<bool(ByteReader& reader, uint32_t version, T& payload)> readOlderVersion = nullptr)
+    {
+        static_assert(EventTypeId<T>::value != 0, "Only payload types with a type ID can be serialized");
+        Codec codec;
+        codec.typeId = EventTypeId<T>::value;
+        codec.version = version;
+        codec.encode = [](const IEvent& event, ByteWriter& writer)
+        {
+            Serializer<T>::Write(writer, static_cast<const Event<T>&>(event).payload);
+        };
+
+        codec.decode = [version, readOlderVersion](ByteReader& reader, uint32_t eventVersion) -> std::shared_ptr<IEvent>
+        {
+            T payload{};
+            bool payloadIsValid = (eventVersion == version ?
+                Serializer<T>::Read(reader, payload) :
+                (readOlderVersion && readOlderVersion(reader, eventVersion, payload)));
+            return (payloadIsValid ? std::make_shared<Event<T>>(std::move(payload)) : nullptr);
+        };
+
+        this->AddCodec(std::move(codec));
+    }
+
+    bool CanSerialize(const IEvent& event) const;
+
+    // Appends the event to the buffer and returns the number of bytes appended; throws if its type is not registered
+    size_t Serialize(const IEvent& event, std::vector<unsigned char>& buffer) const;
+
+    // Reads one event, or returns null, having read nothing, if the bytes do not hold a readable event of a registered type
+    std::shared_ptr<IEvent> Deserialize(ByteReader& reader) const;
+    std::shared_ptr<IEvent> Deserialize(const unsigned char* data, size_t size) const;
+
+    // Returns the payload of an event of type T in place, or null if the bytes do not hold one of the current version or
+    // the payload is not aligned for T
+    template<class T>
+    const T* View(const unsigned char* data, size_t size) const
+    {
+        static_assert(IsFlat<T>::value, "Only trivially copyable payloads can be viewed in place");
+        size_t payloadSize = 0;
+        const unsigned char* payload = this->FindPayload(EventTypeId<T>::value, data, size, payloadSize);
+        if (payload == nullptr || payloadSize != sizeof(T) || reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0)
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const T*>(payload);
+    }
+
+    // Returns the elements of an event of type std::vector<T> in place, or an invalid view if the bytes do not hold one of
+    // the current version or the elements are not aligned for T
+    template<class T>
+    ArrayView<T> ViewArray(const unsigned char* data, size_t size) const
+    {
+        static_assert(IsFlat<T>::value && !std::is_same<T, bool>::value, "Only vectors of trivially copyable elements can be viewed in place");
+        size_t payloadSize = 0;
+        uint64_t count = 0;
+        const unsigned char* payload = this->FindPayload(EventTypeId<std::vector<T>>::value, data, size, payloadSize);
+        if (payload == nullptr || payloadSize < sizeof(count))
+        {
+            return ArrayView<T>();
+        }
+
+        std::memcpy(&count, payload, sizeof(count));
+        const unsigned char* elements = payload + sizeof(count);
+        if (count != (payloadSize - sizeof(count)) / sizeof(T) || (payloadSize - sizeof(count)) % sizeof(T) != 0 ||
+            reinterpret_cast<uintptr_t>(elements) % alignof(T) != 0)
+        {
+            return ArrayView<T>();
+        }
+
+        return ArrayView<T>(reinterpret_cast<const T*>(elements), static_cast<size_t>(count));
+    }
+
+private:
+    struct Codec
+    {
+        IEvent::TypeId typeId;
+        uint32_t version;
+        void (*encode)(const IEvent& event, ByteWriter& writer);
+        std::function<std::shared_ptr<IEvent>(ByteReader& reader, uint32_t version)> decode;
+    };
+
+    void AddCodec(Codec codec);
+    const unsigned char* FindPayload(IEvent::TypeId typeId, const unsigned char* data, size_t size, size_t& payloadSize) const;
+
+    std::unique_ptr<Impl> m_impl;
+};
+
+#endif // EVENT_SERIALIZER_H
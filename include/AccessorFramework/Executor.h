@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <functional>
+#include <utility>
+
+// Description
+// An Executor runs a host's work: the rounds in which the host's Director executes scheduled callbacks, and the timed
+// waits between them. By default, every task gets a thread of its own. Applications that already have an event loop or
+// a thread pool can implement this interface and pass it to the host, which gives them control over the number, names,
+// and affinity of the threads that run the model. Tasks may run on any thread, but a task passed to ExecuteAfter() must
+// not start before its delay has elapsed. Tasks do not throw. Tasks that have not run when the executor is destroyed may
+// be discarded.
+//
+// A host withdraws a delayed task when it no longer needs it to run, e.g. when the next round is rescheduled. Executors
+// that can remove such a task from their queue override ExecuteCancelableAfter(), which returns a nonzero ID for the
+// task, and Cancel(), which removes the task if it has not started. By default the task goes to ExecuteAfter() and
+// cannot be withdrawn; it still runs once its delay has elapsed, but the host makes sure that it does nothing.
+//
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+    virtual void Execute(std::function<void()> task) = 0;
+    virtual void ExecuteAfter(long long delayInMilliseconds, std::function<void()> task) = 0;
+
+    virtual unsigned long long ExecuteCancelableAfter(long long delayInMilliseconds, std::function<void()> task)
+    {
+        this->ExecuteAfter(delayInMilliseconds, std::move(task));
+        return 0ULL;
+    }
+
+    virtual void Cancel(unsigned long long /*taskId*/) // ignores an ID of 0, and tasks that have started or were canceled
+    {
+    }
+};
+
+#endif // EXECUTOR_H
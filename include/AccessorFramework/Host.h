@@ -5,8 +5,14 @@
 #define HOST_H
 
 #include "Accessor.h"
+#include "Executor.h"
+#include <chrono>
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <vector>
+
+class EventSerializer;
 
 // Description
 // The host contains and drives the accessor model. It can be thought of as a composite accessor without any input or
@@ -14,6 +20,137 @@
 // passes along any exceptions thrown by the model. It defines an EventListener interface so that other entities can
 // subscribe to be notified when the model changes state or throws an exception.
 //
+// Listeners are notified asynchronously, so a slow listener never holds up the host. Each notification is posted to a
+// bounded queue without taking a lock, and a delivery task on the listener executor (by default, a new thread for each
+// burst of notifications) delivers the queued notifications in the order in which they were posted. Listeners are never
+// called concurrently. A notification posted while the queue is full is dropped, and GetListenerMetrics() counts it.
+// Listeners can be added and removed from any thread, including from a listener. WaitForEventListeners() blocks until
+// the notifications posted so far have been delivered. A listener that has expired or throws an exception is removed.
+//
+// By default, the host processes every reaction on a single thread. EnableParallelReactions() lets reactions of atomic
+// accessors that are not connected to one another, directly or indirectly, run at the same time on a pool of worker
+// threads, wherever the accessors are in the hierarchy of composites. The results are identical to those of sequential
+// execution. It must be called before the host is set up.
+//
+// The host does its work on an executor, which can be given when the host is constructed or when it is run. Run()
+// returns as soon as the work has been handed to the executor. Without an executor, every round of execution runs on a
+// new thread. RunOnCurrentThread() blocks the calling thread until the host stops, but still uses the executor.
+//
+// Alternatively, an application with an event loop of its own can drive the host with Poll(), which executes everything
+// due at or before the given time on the calling thread and returns the time at which it next needs to be called. Once
+// a host is polled, it hands no work to its executor until it is run again.
+//
+// SetThreadSettings() names the threads the framework creates for the host (those of the default executor, the
+// parallel reaction pool, and the I/O loop) and, on Linux, gives them a CPU affinity, scheduling policy, and priority,
+// e.g. to run a control loop on isolated cores with SCHED_FIFO. It must be called before the host is set up. Threads of
+// an executor given by the application are left to it. Settings that a thread lacks the privilege to apply are logged
+// as a warning and otherwise ignored. A HostHypervisor runs its hosts on one thread pool per NUMA node the process may
+// run on, giving them to the nodes in turn, and a host stays on its node. A host with thread settings keeps its own
+// threads instead, and the pools stay off the CPUs it lists while it belongs to the hypervisor; AddHost() throws if that
+// would leave them no CPU.
+//
+// Atomic accessors can offload heavy work to a pool of worker threads shared by all hosts (see AtomicAccessor::Offload()).
+// GetOffloadMetrics() reports how much work the host's accessors have offloaded, how long it waited for a worker, how
+// much was rejected because too much work was already waiting, and how long rounds waited for results that were not
+// ready when they were due. A result is always delivered at the logical time it was due, so a round that reaches it
+// before the work has finished waits for it. SetOffloadQueueCapacity() sets how many offloads may wait for a worker.
+//
+// The host keeps profiling counters for each of its atomic accessors and their ports, which GetProfile() copies. They
+// count reactions and the events each port sends and receives, and record the longest each input queue has been. They
+// also time the input handlers and Fire() function of one reaction in every 16 (starting with the first), since reading
+// the clock on every reaction would cost more than many reactions do. The total times are therefore estimates: the time
+// of the timed reactions scaled up to all reactions. The maximum times are the longest among the timed reactions, so a
+// rare spike can be missed. The counters can be read and reset while the host is running, but not while children are
+// being added or removed. They cost little enough to be left on, but they can be turned off for the whole process with
+// SetProfilingEnabled().
+//
+// StartTracing() records a timeline of every host in the process until StopTracing() is called: each round of execution
+// (with its logical time and how far wall time was ahead of it), each scheduled callback (named after the accessor that
+// scheduled it), each reaction, and each event sent from one port to another. WriteTrace() writes what was recorded as
+// Chrome trace-event JSON, which can be opened in chrome://tracing or the Perfetto UI. Every thread keeps its most recent
+// events in a fixed-size buffer. Tracing can be started and stopped at any time, and costs next to nothing while it is
+// stopped.
+//
+// AddLatencyProbe() measures how long outputs sent from an atomic accessor's output port take to reach the input
+// handlers of an atomic accessor downstream of it, in both wall-clock and logical time. Sends are measured in order, each
+// when the input port's handlers run for it, so outputs that queue up on the way are measured against their own sends.
+// Sends and arrivals that cannot be paired, e.g. because outputs are filtered out on the way or pile up faster than
+// they arrive, are counted as dropped samples instead of being measured.
+// GetLatencyProbes() reports percentiles from histograms that are accurate to within about 2%, and can be called, as can
+// ResetLatencyProbes(), while the host is running. Probes can only be added and removed while it is not running, or
+// between calls to Poll().
+//
+// In a library built with ALLOCATION_ACCOUNTING on, GetAllocationProfile() counts the heap allocations made while the
+// host does its work: by its director, by its ports (sending and queuing events), by the scheduling of reactions, and
+// by each accessor's own code, which includes the events it creates. Once warmed up, a host driven by Poll() makes no
+// allocations of its own, so any allocations counted outside of accessors point to a regression. Without
+// ALLOCATION_ACCOUNTING, nothing is counted and AllocationAccountingIsEnabled() returns false.
+//
+// ExportGraph() writes the model as Graphviz DOT or JSON once the host is set up: its hierarchy of accessors, the
+// priority and depth of each accessor, the depth of each port, and every connection between ports. The depths are the
+// ones computed along with the priorities, when the host was last set up or restored or its model last changed, so
+// exporting the graph never renumbers the ports of a running host. With traffic included, each connection is labelled
+// with the number of events sent over it, and each port (in JSON) with its event counts, from the profiling counters.
+// Like the profile, the graph can be exported while the host is running, but not while children are being added or
+// removed.
+//
+// StartCriticalPathAnalysis() times every reaction of the host's atomic accessors and, for each logical time step (tick)
+// in which any of them reacted, finds the critical path: the longest chain of reactions, each of an accessor connected
+// to an input port of the next, and its total time. The slack of each depth of the model (see ExportGraph()) is how
+// much longer the reactions at that depth could have taken before the tick's critical path grew; a depth with no slack
+// lies on it. GetCriticalPathReport() returns the most recent ticks, the tick with the longest critical path, and how
+// often each accessor was on a critical path. While the host is running, the tick in progress is left out. Timing every
+// reaction costs far more than the profiling counters, so the analysis is off until it is started. It can only be
+// started and stopped while the host is not running, or between calls to Poll().
+//
+// A HostHypervisor can connect an atomic accessor's output port in one of its hosts to an atomic accessor's input port
+// in another with ConnectHosts(), so that a large model can be split across hosts that run on different cores. Every
+// output the port sends is stamped with its host's logical time and passed through a lock-free ring of fixed capacity;
+// an output sent while the ring is full is dropped. The receiving host delivers the events at the start of its next
+// round whose logical time is at least the stamp, so an event is never seen before the time at which it was sent, but
+// may be seen later: the sender wakes an idle receiving host, which then starts a round at the time it was woken. A
+// channel can also be given a polling interval, at which the receiving host checks its channels even if it is not woken;
+// by default it is not polled. Waking relies on Linux eventfds, so on other platforms a channel must be polled. A host
+// that is polled sees the events on its next call to Poll(). The input port must not have a source of its own. Channels
+// can only be connected and disconnected while neither host is running (or between calls to Poll()), and GetChannels()
+// reports how many events each has carried and dropped at any time. Events are shared with the receiving host, so they
+// must not be changed once sent.
+//
+// StartRecording() appends every event that enters the host to a binary recording, with the logical time at which it
+// entered: every output sent by a spontaneous output port, which includes the outputs of I/O accessors, and every event
+// delivered from a channel. Each port is a stream of the recording, named by the port's full name. Events are serialized
+// with the given EventSerializer, and events of types it does not know are skipped. A ReplaySource feeds a recording
+// back into a model (see ReplaySource.h). Recording can only be started and stopped while the host is not running, or
+// between calls to Poll(), and GetRecordingReport() can be called at any time. The recording is complete once recording
+// has stopped or the host has been destroyed.
+//
+// StartFingerprinting() hashes what the host does in each logical time step (tick): the logical time, relative to when
+// the director last started counting time, the priority of each callback executed, and for each event sent by a port of
+// an atomic accessor, the port, the priority of its accessor, and the event. Events are hashed by their bytes as
+// serialized by the given EventSerializer; without one, or for payload types it does not know, only whether an event
+// was sent is hashed. Each tick's hash also covers every tick before it, so two runs of a deterministic model, or two
+// replicas of one, can be compared by their final hashes, and FindFirstDivergentTick() finds the first tick in which
+// they differ. Events sent in one tick are hashed in any order, except that the events sent by each port stay in
+// order, so a host gives the same fingerprint with parallel reactions as without. While the host is recording, each
+// tick's hash is also written to the recording (see ReplaySource::GetFingerprint()). Fingerprinting costs a few atomic
+// additions per event, plus serializing it, so it is off until it is started, and it can only be started and stopped
+// while the host is not running, or between calls to Poll().
+//
+// Checkpoint() writes the state of a host that has been set up, so that Restore() can bring a new host of the same
+// model to that state in place of Setup(), e.g. to fail over to a standby host or to fork a long simulation. The
+// checkpoint holds the priority of every accessor, the connections between their ports, and, for each atomic accessor,
+// how long until each of its scheduled callbacks is next due and its period, the events queued on its input ports and
+// waiting on its output ports (serialized with the given EventSerializer), and the state that its SaveState() writes.
+// The checkpoint starts with its own size, and Restore() reads exactly that much, so it can be one record in a larger
+// stream. Restore() calls AdditionalSetup(), as Setup() does, and then checks the checkpoint against the model before
+// anything is restored; a checkpoint that does not match leaves the host still needing setup, and AdditionalSetup() is
+// not called again when it is set up. The accessors are then given the priorities they had, and instead of being
+// initialized, each atomic accessor is given its state through RestoreState(), and the callbacks it schedules there
+// resume the timing of the ones it had (see AtomicAccessor::RestoreState()). A host whose accessor fails to restore its
+// state is corrupted. Logical time carries on from the time of the checkpoint. A host can only be checkpointed while it
+// is not running, or between calls to Poll(), and not while any of its accessors has offloaded work in progress.
+// Callbacks scheduled by composite accessors, including the host, are not captured.
+//
 // Note: Hosts are not allowed to have ports; calls to inherited Add__Port() methods will throw an exception.
 //
 class Host : public CompositeAccessor
@@ -21,6 +158,28 @@ class Host : public CompositeAccessor
 public:
     class Impl;
 
+    enum class GraphFormat
+    {
+        Dot,
+        Json
+    };
+
+    enum class SchedulingPolicy
+    {
+        Default, // inherited from the thread that created the host's threads
+        Fifo,
+        RoundRobin,
+        Batch
+    };
+
+    struct ThreadSettings
+    {
+        std::string name; // given to each thread, followed by its role; empty uses the host's name
+        std::vector<int> cpus; // that the threads may run on; empty leaves their affinity as it is
+        SchedulingPolicy schedulingPolicy = SchedulingPolicy::Default;
+        int priority = 0; // 1 (lowest) to 99 for Fifo and RoundRobin, otherwise 0
+    };
+
     enum class State
     {
         NeedsSetup,
@@ -40,22 +199,207 @@ public:
         virtual void NotifyOfStateChange(Host::State oldState, Host::State newState) = 0;
     };
 
+    struct ListenerMetrics
+    {
+        unsigned long long numberOfNotificationsPosted;
+        unsigned long long numberOfNotificationsDelivered;
+        unsigned long long numberOfNotificationsDropped; // because the queue was full
+        size_t queueCapacity;
+    };
+
+    struct OffloadMetrics
+    {
+        unsigned long long numberOfOffloads;
+        unsigned long long numberOfCompletedOffloads;
+        unsigned long long numberOfRejectedOffloads; // because the queue was full
+        unsigned long long numberOfLateResults; // results that were not ready when they were due
+        size_t queueDepth; // offloads waiting for a worker
+        size_t maxQueueDepth;
+        std::chrono::microseconds totalQueueLatency; // from the offload until a worker starts the work
+        std::chrono::microseconds maxQueueLatency;
+        std::chrono::microseconds totalOffloadLatency; // from the offload until the work finishes
+        std::chrono::microseconds maxOffloadLatency;
+        std::chrono::microseconds totalWaitTime; // that rounds waited for late results
+    };
+
+    struct PortProfile
+    {
+        std::string name; // full name
+        unsigned long long numberOfEventsSent;
+        unsigned long long numberOfEventsReceived;
+        unsigned long long maxInputQueueLength; // always 0 for output ports
+    };
+
+    struct AccessorProfile
+    {
+        std::string name; // full name
+        unsigned long long numberOfReactions;
+        unsigned long long numberOfTimedReactions;
+        std::chrono::nanoseconds totalInputHandlerTime; // estimated for all reactions from the timed ones
+        std::chrono::nanoseconds maxInputHandlerTime; // in a single timed reaction
+        std::chrono::nanoseconds totalFireTime; // estimated for all reactions from the timed ones
+        std::chrono::nanoseconds maxFireTime; // in a single timed reaction
+        std::vector<PortProfile> inputPorts;
+        std::vector<PortProfile> outputPorts;
+    };
+
+    struct LatencyDistribution
+    {
+        unsigned long long count;
+        std::chrono::nanoseconds min;
+        std::chrono::nanoseconds p50;
+        std::chrono::nanoseconds p90;
+        std::chrono::nanoseconds p99;
+        std::chrono::nanoseconds p999;
+        std::chrono::nanoseconds max;
+    };
+
+    struct LatencyProbeReport
+    {
+        int id;
+        std::string outputPortName; // full name
+        std::string inputPortName; // full name
+        LatencyDistribution wallClockLatency;
+        LatencyDistribution logicalLatency;
+        unsigned long long numberOfDroppedSamples; // sends and arrivals that could not be paired with one another
+    };
+
+    struct AllocationCounts
+    {
+        unsigned long long numberOfAllocations;
+        unsigned long long numberOfBytes;
+    };
+
+    struct AccessorAllocationCounts
+    {
+        std::string name; // full name
+        AllocationCounts allocations;
+    };
+
+    struct AllocationProfile
+    {
+        AllocationCounts total;
+        AllocationCounts director; // scheduling and executing callbacks
+        AllocationCounts ports; // sending, receiving, and queuing events
+        AllocationCounts reactions; // scheduling and ordering reactions
+        std::vector<AccessorAllocationCounts> accessors; // their input handlers, Fire() functions, and callbacks
+    };
+
+    struct CriticalPathLevel
+    {
+        int depth;
+        size_t numberOfAccessors; // that reacted in the tick
+        std::chrono::nanoseconds maxReactionTime; // of one accessor, over the tick
+        std::chrono::nanoseconds slack;
+    };
+
+    struct CriticalPathTick
+    {
+        long long logicalTime; // in milliseconds since the epoch
+        std::chrono::nanoseconds totalReactionTime; // of every reaction in the tick
+        std::chrono::nanoseconds criticalPathTime;
+        std::vector<std::string> criticalPath; // full names of atomic accessors, upstream first
+        std::vector<CriticalPathLevel> levels; // of the depths at which accessors reacted, in order
+    };
+
+    struct CriticalPathAccessor
+    {
+        std::string name; // full name
+        unsigned long long numberOfTicksOnCriticalPath;
+        std::chrono::nanoseconds totalTimeOnCriticalPath; // its reactions in those ticks
+    };
+
+    struct CriticalPathReport
+    {
+        unsigned long long numberOfTicks; // analysed since the analysis was started or reset
+        CriticalPathTick longestTick;
+        std::vector<CriticalPathTick> recentTicks; // oldest first
+        std::vector<CriticalPathAccessor> accessors; // most often on a critical path first
+    };
+
+    struct RecordingReport
+    {
+        std::string filePath;
+        bool isRecording; // false once stopped, or if the file could not be written
+        std::vector<std::string> streams; // full names of the recorded ports
+        unsigned long long numberOfEventsRecorded;
+        unsigned long long numberOfEventsSkipped; // of payload types the serializer does not know
+        unsigned long long numberOfBytesWritten; // to the file so far
+    };
+
+    struct FingerprintTick
+    {
+        long long logicalTime; // in milliseconds since the director last started counting time
+        unsigned long long numberOfEvents; // sent by ports of atomic accessors in the tick
+        unsigned long long hash; // of this tick and every tick before it
+    };
+
+    struct FingerprintReport
+    {
+        bool isFingerprinting;
+        unsigned long long numberOfTicks; // since fingerprinting started
+        unsigned long long hash; // of every tick so far
+        std::vector<FingerprintTick> ticks; // the first ones, up to the number kept
+    };
+
     ~Host();
     State GetState() const;
     bool EventListenerIsRegistered(int listenerId) const;
     int AddEventListener(std::weak_ptr<EventListener> listener);
     void RemoveEventListener(int listenerId);
+    void SetListenerExecutor(std::shared_ptr<Executor> executor); // nullptr restores the default; not while the host is running
+    void WaitForEventListeners() const; // must not be called by a listener
+    ListenerMetrics GetListenerMetrics() const;
+    void EnableParallelReactions(unsigned int numberOfThreads = 0); // 0 uses one thread per hardware thread
+    void SetThreadSettings(const ThreadSettings& settings);
+    ThreadSettings GetThreadSettings() const;
     void Setup();
     void Iterate(int numberOfIterations = 1);
     void Pause();
     void Run();
+    void Run(std::shared_ptr<Executor> executor);
     void RunOnCurrentThread();
+    std::chrono::system_clock::time_point Poll(std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
     void Exit();
+    OffloadMetrics GetOffloadMetrics() const;
+    std::vector<AccessorProfile> GetProfile() const;
+    void ResetProfile();
+    int AddLatencyProbe(const std::string& outputPortFullName, const std::string& inputPortFullName);
+    void RemoveLatencyProbe(int probeId);
+    std::vector<LatencyProbeReport> GetLatencyProbes() const;
+    void ResetLatencyProbes();
+    AllocationProfile GetAllocationProfile() const;
+    void ResetAllocationProfile();
+    void ExportGraph(std::ostream& stream, GraphFormat format, bool includeTraffic = false) const;
+    void StartCriticalPathAnalysis(size_t numberOfRecentTicks = 64); // discards any earlier analysis
+    void StopCriticalPathAnalysis();
+    CriticalPathReport GetCriticalPathReport() const;
+    void ResetCriticalPathAnalysis();
+    void StartRecording(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer); // replaces the file
+    void StopRecording();
+    RecordingReport GetRecordingReport() const;
+    void StartFingerprinting(std::shared_ptr<const EventSerializer> serializer = nullptr, size_t numberOfTicksKept = 1 << 20);
+    void StopFingerprinting();
+    FingerprintReport GetFingerprintReport() const;
+    void Checkpoint(std::ostream& stream, std::shared_ptr<const EventSerializer> serializer = nullptr) const;
+    void Restore(std::istream& stream, std::shared_ptr<const EventSerializer> serializer = nullptr); // in place of Setup()
+
+    static void SetProfilingEnabled(bool enabled); // profiling is enabled by default
+    static void SetOffloadQueueCapacity(size_t capacity); // 1024 by default; shared by all hosts
+    static void StartTracing(size_t eventsPerThread = 16384); // discards any events recorded earlier
+    static void StopTracing();
+    static void WriteTrace(std::ostream& stream);
+    static bool AllocationAccountingIsEnabled();
+
+    // Returns false if the runs match for as many ticks as either has; otherwise, the index of the first tick that
+    // differs, which is the number of ticks in the shorter run if it matches the start of the longer one
+    static bool FindFirstDivergentTick(const std::vector<FingerprintTick>& expected, const std::vector<FingerprintTick>& actual, size_t& tickIndex);
 
 protected:
     Host(const std::string& name);
+    Host(const std::string& name, std::shared_ptr<Executor> executor);
 
-    // Called during Setup() (base implementation does nothing)
+    // Called once, during Setup() or Restore() (base implementation does nothing)
     virtual void AdditionalSetup();
 
 private:
@@ -70,6 +414,20 @@ private:
 class HostHypervisor
 {
 public:
+    struct ChannelReport
+    {
+        int id;
+        int sourceHostId;
+        std::string outputPortName; // full name
+        int destinationHostId;
+        std::string inputPortName; // full name
+        size_t capacity;
+        unsigned long long numberOfEventsSent;
+        unsigned long long numberOfEventsReceived;
+        unsigned long long numberOfEventsDropped; // sent while the channel was full
+        long long maxLogicalLatency; // in milliseconds, from the sender's logical time to the receiver's
+    };
+
     HostHypervisor();
     ~HostHypervisor();
 
@@ -89,6 +447,16 @@ public:
     void RunHosts() const;
     void RunHostsOnCurrentThread() const;
 
+    int ConnectHosts(
+        int sourceHostId,
+        const std::string& outputPortFullName,
+        int destinationHostId,
+        const std::string& inputPortFullName,
+        size_t capacity = 1024, // rounded up to a power of two
+        int pollingIntervalInMilliseconds = 0); // 0 only receives when the sender wakes the receiving host
+    void DisconnectHosts(int channelId);
+    std::vector<ChannelReport> GetChannels() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef IO_ACCESSOR_H
+#define IO_ACCESSOR_H
+
+#ifdef __linux__
+
+#include "Accessor.h"
+
+// Description
+// An I/O accessor is an atomic accessor that wraps a device reached through file descriptors, such as a socket, a serial
+// port, or a pipe. Rather than reading on a thread of its own, it asks its host to watch its file descriptors. The host
+// watches the file descriptors of all of its I/O accessors on one thread using epoll, and it runs its Director on the
+// same thread, with timers driven by a timerfd. When a watched file descriptor becomes ready, its handler is called at
+// the current logical time, just like a scheduled callback, so it can safely send outputs. The handler is not called
+// again for that file descriptor until the previous call has returned, and it is only called while the host is running.
+//
+// An I/O accessor can start watching file descriptors once it belongs to a host (e.g. in Initialize()). A host that has
+// I/O accessors always runs on its own I/O thread; it cannot be given another executor or be polled, and the first file
+// descriptor must be watched before the host starts running. I/O accessors are only available on Linux.
+//
+class IOAccessor : public AtomicAccessor
+{
+public:
+    class Impl;
+
+    // I/O events, which can be combined
+    static constexpr unsigned int Readable = 0x1;
+    static constexpr unsigned int Writable = 0x2;
+    static constexpr unsigned int HungUp = 0x4;
+    static constexpr unsigned int Error = 0x8;
+
+    using IOHandler = std::function<void(unsigned int /*ioEvents*/)>;
+
+    IOAccessor(
+        const std::string& name,
+        const std::vector<std::string>& inputPortNames = {},
+        const std::vector<std::string>& outputPortNames = {},
+        const std::vector<std::string>& spontaneousOutputPortNames = {},
+        const std::map<std::string, std::vector<InputHandler>>& inputHandlers = {});
+
+protected:
+    // Calls the handler whenever the file descriptor is ready for any of the given events. HungUp and Error are always
+    // reported. The accessor does not take ownership of the file descriptor, which must stay open while it is watched.
+    void WatchFileDescriptor(int fileDescriptor, unsigned int ioEvents, IOHandler handler);
+    void UnwatchFileDescriptor(int fileDescriptor);
+};
+
+#endif // __linux__
+
+#endif // IO_ACCESSOR_H
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef REPLAY_SOURCE_H
+#define REPLAY_SOURCE_H
+
+#include "Accessor.h"
+#include "EventSerializer.h"
+#include "Host.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class RecordingReader;
+
+// Description
+// A ReplaySource feeds a recording made with Host::StartRecording() back into a model, e.g. to reproduce an incident in
+// a regression run. Each recorded stream is named by the full name of the port it was recorded from, and the streams to
+// replay are mapped to the names of the replay source's spontaneous output ports; events of other streams, and events
+// that the serializer cannot read, are skipped and counted. GetStreamNames() lists the streams in a recording, and
+// GetFingerprint() reads the fingerprint of each tick recorded while the host was also fingerprinting, which can be
+// compared with that of a later run (see Host::FindFirstDivergentTick()).
+//
+// Every event is sent at the same logical time, relative to the start of the recording, as it was recorded at, and
+// events recorded at the same time are sent in the same round in the order in which they were recorded. A host that
+// is run waits for wall-clock time to catch up with each event, as it did while recording. A host that is polled, each
+// time with the time that Poll() last returned, executes its rounds one after another without waiting, so a recording
+// replays in virtual time, as fast as it can be read. The recording is mapped into memory (on Linux) and read once, in
+// order; the replay source is finished once it has sent its last event.
+//
+class ReplaySource : public AtomicAccessor
+{
+public:
+    ReplaySource(
+        const std::string& name,
+        const std::string& filePath,
+        std::shared_ptr<const EventSerializer> serializer,
+        const std::map<std::string, std::string>& outputPortNamesByStream);
+    ~ReplaySource();
+    bool IsFinished() const;
+    unsigned long long GetNumberOfEventsReplayed() const;
+    unsigned long long GetNumberOfEventsSkipped() const;
+
+    static std::vector<std::string> GetStreamNames(const std::string& filePath);
+    static std::vector<Host::FingerprintTick> GetFingerprint(const std::string& filePath);
+
+protected:
+    void Initialize() override;
+
+private:
+    bool FindNextEvent(long long& logicalTime); // reads stream entries up to the next event
+    void ReplayEvents(long long logicalTime);
+    void ScheduleNextReplay(long long currentLogicalTime);
+
+    std::unique_ptr<RecordingReader> m_reader;
+    std::shared_ptr<const EventSerializer> m_serializer;
+    std::map<std::string, std::string> m_outputPortNamesByStream;
+    std::vector<const std::string*> m_outputPortNames; // by stream ID; null for streams that are not replayed
+    std::atomic<bool> m_isFinished;
+    std::atomic<unsigned long long> m_numberOfEventsReplayed;
+    std::atomic<unsigned long long> m_numberOfEventsSkipped;
+};
+
+#endif // REPLAY_SOURCE_H
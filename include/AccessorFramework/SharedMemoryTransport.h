@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SHARED_MEMORY_TRANSPORT_H
+#define SHARED_MEMORY_TRANSPORT_H
+
+#ifdef __linux__
+
+#include "EventSerializer.h"
+#include "IOAccessor.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Description
+// A shared-memory transport carries events from a host in one process to a host in another on the same machine, e.g. to
+// keep untrusted accessors in a process of their own. A SharedMemoryTransport is a ring buffer in a memfd shared by the
+// two processes, along with an eventfd that wakes the receiving process. Each transport goes one way, from one sender to
+// one receiver. The process that creates a transport passes both file descriptors to the other process, either by
+// forking or over a Unix domain socket (SCM_RIGHTS), and the other process opens the transport with them.
+//
+// Each end of a transport appears in its host as a proxy accessor. A SharedMemorySender has a single input port, and it
+// writes every event it receives to the ring. A SharedMemoryReceiver is an I/O accessor with a single spontaneous output
+// port, which sends every event read from the ring. Events are turned into bytes and back by an EventSerializer, which
+// must have the same payload types registered at both ends. Neither end ever blocks the other: an event that does not
+// fit in the ring, that serializes to more than a quarter of the ring, or whose type is not registered, is dropped and
+// counted. The sender only writes to the eventfd when the receiver has announced that it is about to wait, so a busy
+// receiver is not woken once per event.
+//
+// The receiver does not trust the sender: everything it reads from shared memory is checked before it is used, and a
+// transport whose ring is found to be corrupt is closed. Each event is copied out of shared memory before it is
+// deserialized, so the sender cannot change its bytes while they are being read. Shared-memory transports are only
+// available on Linux.
+//
+class SharedMemoryTransport
+{
+public:
+    class Impl;
+
+    ~SharedMemoryTransport();
+
+    // The capacity is rounded up to a power of two
+    static std::shared_ptr<SharedMemoryTransport> Create(size_t capacityInBytes = 1 << 20);
+
+    // Duplicates the file descriptors, which the caller still owns
+    static std::shared_ptr<SharedMemoryTransport> Open(int memoryFileDescriptor, int wakeFileDescriptor);
+
+    int GetMemoryFileDescriptor() const;
+    int GetWakeFileDescriptor() const;
+    size_t GetCapacity() const; // in bytes
+    Impl* GetImpl() const;
+
+private:
+    explicit SharedMemoryTransport(std::unique_ptr<Impl> impl);
+
+    std::unique_ptr<Impl> m_impl;
+};
+
+class SharedMemorySender : public AtomicAccessor
+{
+public:
+    SharedMemorySender(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, std::shared_ptr<const EventSerializer> serializer);
+    unsigned long long GetNumberOfEventsSent() const;
+    unsigned long long GetNumberOfEventsDropped() const;
+
+    static constexpr const char* Input = "Input";
+
+private:
+    void Send(const IEvent& event);
+
+    std::shared_ptr<SharedMemoryTransport> m_transport;
+    std::shared_ptr<const EventSerializer> m_serializer;
+    std::vector<unsigned char> m_buffer;
+    std::atomic<unsigned long long> m_numberOfEventsSent;
+    std::atomic<unsigned long long> m_numberOfEventsDropped;
+};
+
+class SharedMemoryReceiver : public IOAccessor
+{
+public:
+    SharedMemoryReceiver(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, std::shared_ptr<const EventSerializer> serializer);
+    ~SharedMemoryReceiver();
+    unsigned long long GetNumberOfEventsReceived() const;
+    unsigned long long GetNumberOfEventsDropped() const; // that could not be deserialized
+
+    static constexpr const char* Output = "Output";
+
+protected:
+    void Initialize() override;
+
+private:
+    void Receive();
+
+    std::shared_ptr<SharedMemoryTransport> m_transport;
+    std::shared_ptr<const EventSerializer> m_serializer;
+    std::vector<unsigned char> m_record;
+    bool m_isWatching;
+    std::atomic<unsigned long long> m_numberOfEventsReceived;
+    std::atomic<unsigned long long> m_numberOfEventsDropped;
+};
+
+#endif // __linux__
+
+#endif // SHARED_MEMORY_TRANSPORT_H
@@ -5,7 +5,7 @@
 #include "AccessorImpl.h"
 #include "AtomicAccessorImpl.h"
 #include "CompositeAccessorImpl.h"
-#include "PrintDebug.h"
+#include "Logger.h"
 #include <algorithm>
 
 Accessor::~Accessor() = default;
@@ -159,6 +159,13 @@ AtomicAccessor::AtomicAccessor(
     const std::map<std::string, std::vector<InputHandler>>& inputHandlers)
     : Accessor(std::make_unique<AtomicAccessor::Impl>(name, this, &AtomicAccessor::Initialize, inputPortNames, outputPortNames, spontaneousOutputPortNames, inputHandlers, &AtomicAccessor::Fire))
 {
+    static_cast<AtomicAccessor::Impl*>(this->GetImpl())->SetStateFunctions(&AtomicAccessor::SaveState, &AtomicAccessor::RestoreState);
+}
+
+AtomicAccessor::AtomicAccessor(std::unique_ptr<AtomicAccessor::Impl> impl) :
+    Accessor(std::move(impl))
+{
+    static_cast<AtomicAccessor::Impl*>(this->GetImpl())->SetStateFunctions(&AtomicAccessor::SaveState, &AtomicAccessor::RestoreState);
 }
 
 void AtomicAccessor::AccessorStateDependsOn(const std::string& inputPortName)
@@ -196,7 +203,22 @@ void AtomicAccessor::AddInputHandlers(const std::string& inputPortName, const st
     static_cast<AtomicAccessor::Impl*>(this->GetImpl())->AddInputHandlers(inputPortName, handlers);
 }
 
+bool AtomicAccessor::Offload(std::function<std::shared_ptr<IEvent>()> work, const std::string& completionPortName, int delayInMilliseconds)
+{
+    return static_cast<AtomicAccessor::Impl*>(this->GetImpl())->Offload(std::move(work), completionPortName, delayInMilliseconds);
+}
+
 void AtomicAccessor::Fire()
 {
     // base implementation does nothing
+}
+
+void AtomicAccessor::SaveState(std::ostream& /*stream*/) const
+{
+    // base implementation writes nothing
+}
+
+void AtomicAccessor::RestoreState(std::istream& /*stream*/)
+{
+    this->Initialize();
 }
\ No newline at end of file
@@ -4,7 +4,8 @@
 #include "AccessorImpl.h"
 #include "CompositeAccessorImpl.h"
 #include "Director.h"
-#include "PrintDebug.h"
+#include "LatencyProbe.h"
+#include "Logger.h"
 
 const int Accessor::Impl::DefaultAccessorPriority = INT_MAX;
 
@@ -40,7 +41,7 @@ int Accessor::Impl::GetPriority() const
 
 void Accessor::Impl::SetPriority(int priority)
 {
-    PRINT_VERBOSE("%s now has priority %d", this->GetFullName().c_str(), priority);
+    LOG_VERBOSE("%s now has priority %d", this->GetFullName().c_str(), priority);
     this->m_priority = priority;
 }
 
@@ -62,6 +63,32 @@ Director* Accessor::Impl::GetDirector() const
     }
 }
 
+IOLoop* Accessor::Impl::GetIOLoop()
+{
+    auto myParent = static_cast<CompositeAccessor::Impl*>(this->GetParent());
+    if (myParent == nullptr)
+    {
+        return nullptr;
+    }
+    else
+    {
+        return myParent->GetIOLoop();
+    }
+}
+
+std::shared_ptr<OffloadPool::Statistics> Accessor::Impl::GetOffloadStatistics() const
+{
+    auto myParent = static_cast<CompositeAccessor::Impl*>(this->GetParent());
+    if (myParent == nullptr)
+    {
+        return nullptr;
+    }
+    else
+    {
+        return myParent->GetOffloadStatistics();
+    }
+}
+
 bool Accessor::Impl::HasInputPorts() const
 {
     return !(this->m_inputPorts.empty());
@@ -101,6 +128,11 @@ void Accessor::Impl::AlertNewInput()
     }
 }
 
+AllocationCounters& Accessor::Impl::GetAllocationCounters()
+{
+    return this->m_allocationCounters;
+}
+
 bool Accessor::Impl::operator<(const Accessor::Impl& other) const
 {
     return (this->m_priority < other.GetPriority());
@@ -120,7 +152,9 @@ int Accessor::Impl::ScheduleCallback(
         callback,
         delayInMilliseconds,
         repeat,
-        this->m_priority);
+        this->m_priority,
+        &(this->m_allocationCounters),
+        this);
     this->m_callbackIds.insert(callbackId);
     return callbackId;
 }
@@ -138,6 +172,15 @@ void Accessor::Impl::ClearAllScheduledCallbacks()
         int callbackId = *(this->m_callbackIds.begin());
         this->ClearScheduledCallback(callbackId);
     }
+
+    for (OutputPort* outputPort : this->m_orderedOutputPorts)
+    {
+        while (outputPort->HasPendingOutput())
+        {
+            this->GetDirector()->ClearScheduledCallback(outputPort->GetPendingOutputCallbackId());
+            outputPort->DropPendingOutput();
+        }
+    }
 }
 
 bool Accessor::Impl::NewPortNameIsValid(const std::string& newPortName) const
@@ -150,7 +193,7 @@ bool Accessor::Impl::NewPortNameIsValid(const std::string& newPortName) const
 
 void Accessor::Impl::AddInputPort(const std::string& portName)
 {
-    PRINT_VERBOSE("%s is creating a new input port \'%s\'", this->GetName().c_str(), portName.c_str());
+    LOG_VERBOSE("%s is creating a new input port \'%s\'", this->GetName().c_str(), portName.c_str());
     this->ValidatePortName(portName);
     this->m_inputPorts.emplace(portName, std::make_unique<InputPort>(portName, this));
     this->m_orderedInputPorts.push_back(this->m_inputPorts.at(portName).get());
@@ -199,13 +242,28 @@ void Accessor::Impl::SendOutput(const std::string& outputPortName, std::shared_p
         throw std::logic_error("Outputs cannot be sent until the accessor is initialized");
     }
 
-    this->ScheduleCallback(
-        [this, outputPortName, output]()
+    OutputPort* outputPort = this->GetOutputPort(outputPortName);
+    if (!(outputPort->GetLatencyProbes().empty()))
+    {
+        long long logicalTime = this->GetDirector()->GetCurrentLogicalTime();
+        for (auto& latencyProbe : outputPort->GetLatencyProbes())
+        {
+            latencyProbe->Stamp(logicalTime);
+        }
+    }
+
+    // The output waits on the port, so the callback only captures the port and fits in std::function without allocating
+    int callbackId = this->GetDirector()->ScheduleCallback(
+        [outputPort]()
         {
-            this->GetOutputPort(outputPortName)->SendData(output);
+            outputPort->SendPendingOutput();
         },
         0 /*delayInMilliseconds*/,
-        false /*repeat*/);
+        false /*repeat*/,
+        this->m_priority,
+        nullptr /*allocationCounters*/,
+        this);
+    outputPort->QueuePendingOutput(callbackId, std::move(output));
 }
 
 Accessor::Impl::Impl(
@@ -234,12 +292,12 @@ size_t Accessor::Impl::GetNumberOfOutputPorts() const
     return this->m_orderedOutputPorts.size();
 }
 
-std::vector<InputPort*> Accessor::Impl::GetOrderedInputPorts() const
+const std::vector<InputPort*>& Accessor::Impl::GetOrderedInputPorts() const
 {
     return this->m_orderedInputPorts;
 }
 
-std::vector<OutputPort*> Accessor::Impl::GetOrderedOutputPorts() const
+const std::vector<OutputPort*>& Accessor::Impl::GetOrderedOutputPorts() const
 {
     return this->m_orderedOutputPorts;
 }
@@ -256,12 +314,34 @@ bool Accessor::Impl::HasOutputPortWithName(const std::string& portName) const
 
 void Accessor::Impl::AddOutputPort(const std::string& portName, bool isSpontaneous)
 {
-    PRINT_VERBOSE("Accessor '%s' is creating a new%s output port \'%s\'", this->GetName().c_str(), isSpontaneous ? " spontaneous" : "", portName.c_str());
+    LOG_VERBOSE("Accessor '%s' is creating a new%s output port \'%s\'", this->GetName().c_str(), isSpontaneous ? " spontaneous" : "", portName.c_str());
     this->ValidatePortName(portName);
     this->m_outputPorts.emplace(portName, std::make_unique<OutputPort>(portName, this, isSpontaneous));
     this->m_orderedOutputPorts.push_back(this->m_outputPorts.at(portName).get());
 }
 
+// Callback IDs are handed out in increasing order, and the IDs of callbacks that have run and not repeated are skipped
+std::vector<int> Accessor::Impl::GetScheduledCallbackIds() const
+{
+    std::vector<int> callbackIds{};
+    Director* director = this->GetDirector();
+    Director::CallbackTiming timing{};
+    for (int callbackId : this->m_callbackIds)
+    {
+        if (director->GetCallbackTiming(callbackId, timing))
+        {
+            callbackIds.push_back(callbackId);
+        }
+    }
+
+    return callbackIds;
+}
+
+void Accessor::Impl::SetInitialized()
+{
+    this->m_initialized = true;
+}
+
 void Accessor::Impl::ValidatePortName(const std::string& portName) const
 {
     if (!this->NewPortNameIsValid(portName))
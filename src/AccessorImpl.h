@@ -6,8 +6,11 @@
 
 #include "AccessorFramework/Accessor.h"
 #include "Director.h"
+#include "OffloadPool.h"
 #include "Port.h"
 
+class IOLoop;
+
 // Description
 // The Accessor::Impl class implements the Accessor class defined in Accessor.h. In addition, it exposes additional
 // functionality for internal use, such as public methods for getting the accessor's ports or parent objects.
@@ -23,12 +26,17 @@ public:
     void SetPriority(int priority);
     virtual void ResetPriority();
     virtual Director* GetDirector() const;
+    virtual IOLoop* GetIOLoop();
+    virtual std::shared_ptr<OffloadPool::Statistics> GetOffloadStatistics() const;
     bool HasInputPorts() const;
     bool HasOutputPorts() const;
+    size_t GetNumberOfInputPorts() const;
+    size_t GetNumberOfOutputPorts() const;
     InputPort* GetInputPort(const std::string& portName) const;
     OutputPort* GetOutputPort(const std::string& portName) const;
     std::vector<const InputPort*> GetInputPorts() const;
     std::vector<const OutputPort*> GetOutputPorts() const;
+    AllocationCounters& GetAllocationCounters();
     bool operator<(const Accessor::Impl& other) const;
     bool operator>(const Accessor::Impl& other) const;
 
@@ -58,16 +66,17 @@ protected:
         std::function<void(Accessor&)> initializeFunction,
         const std::vector<std::string>& inputPortNames = {},
         const std::vector<std::string>& connectedOutputPortNames = {});
-    size_t GetNumberOfInputPorts() const;
-    size_t GetNumberOfOutputPorts() const;
-    std::vector<InputPort*> GetOrderedInputPorts() const;
-    std::vector<OutputPort*> GetOrderedOutputPorts() const;
+    const std::vector<InputPort*>& GetOrderedInputPorts() const;
+    const std::vector<OutputPort*>& GetOrderedOutputPorts() const;
     bool HasInputPortWithName(const std::string& portName) const;
     bool HasOutputPortWithName(const std::string& portName) const;
     void AddOutputPort(const std::string& portName, bool isSpontaneous);
+    std::vector<int> GetScheduledCallbackIds() const; // that are still scheduled, in the order they were first scheduled
+    void SetInitialized(); // for an accessor initialized some other way than by Initialize()
 
     int m_priority;
     Accessor* const m_container;
+    AllocationCounters m_allocationCounters;
 
 private:
     friend class Accessor;
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "AllocationAccounting.h"
+
+#ifdef ACCESSOR_FRAMEWORK_ALLOCATION_ACCOUNTING
+
+#include <cstdlib>
+#include <new>
+
+thread_local AllocationScope::Current AllocationScope::s_current = { nullptr, nullptr };
+
+void AllocationScope::RecordAllocation(size_t numberOfBytes)
+{
+    const Current& current = s_current;
+    if (current.account != nullptr)
+    {
+        current.account->total.Record(numberOfBytes);
+        current.counters->Record(numberOfBytes);
+    }
+}
+
+// The replacements below are the hook: every allocation in the process passes through them, and those made within an
+// AllocationScope are counted before being handed to malloc
+static void* Allocate(size_t numberOfBytes)
+{
+    AllocationScope::RecordAllocation(numberOfBytes);
+    if (numberOfBytes == 0)
+    {
+        numberOfBytes = 1;
+    }
+
+    void* block = std::malloc(numberOfBytes);
+    while (block == nullptr)
+    {
+        std::new_handler newHandler = std::get_new_handler();
+        if (newHandler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        newHandler();
+        block = std::malloc(numberOfBytes);
+    }
+
+    return block;
+}
+
+void* operator new(size_t numberOfBytes)
+{
+    return Allocate(numberOfBytes);
+}
+
+void* operator new[](size_t numberOfBytes)
+{
+    return Allocate(numberOfBytes);
+}
+
+void* operator new(size_t numberOfBytes, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return Allocate(numberOfBytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t numberOfBytes, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return Allocate(numberOfBytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, size_t /*numberOfBytes*/) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block, size_t /*numberOfBytes*/) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept
+{
+    std::free(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept
+{
+    std::free(block);
+}
+
+#endif // ACCESSOR_FRAMEWORK_ALLOCATION_ACCOUNTING
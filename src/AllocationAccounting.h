@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef ALLOCATION_ACCOUNTING_H
+#define ALLOCATION_ACCOUNTING_H
+
+#include "AccessorFramework/Host.h"
+#include <atomic>
+#include <cstddef>
+
+// Description
+// When the library is built with ALLOCATION_ACCOUNTING on, it replaces the global operator new with one that counts each
+// allocation made by a thread while it is doing a host's work. The allocation is counted against the host and against
+// whatever was at work: the director, the ports, the scheduling of reactions, or an accessor's own code. An
+// AllocationScope marks that work, and nests: the innermost scope on a thread gets the allocation, and a scope without
+// an account of its own leaves the host unchanged. In builds without accounting, scopes are empty and cost nothing.
+//
+class AllocationCounters
+{
+public:
+    AllocationCounters() :
+        m_numberOfAllocations(0ULL),
+        m_numberOfBytes(0ULL)
+    {
+    }
+
+    void Record(size_t numberOfBytes)
+    {
+        this->m_numberOfAllocations.fetch_add(1ULL, std::memory_order_relaxed);
+        this->m_numberOfBytes.fetch_add(numberOfBytes, std::memory_order_relaxed);
+    }
+
+    Host::AllocationCounts Get() const
+    {
+        return Host::AllocationCounts{ this->m_numberOfAllocations.load(std::memory_order_relaxed), this->m_numberOfBytes.load(std::memory_order_relaxed) };
+    }
+
+    void Reset()
+    {
+        this->m_numberOfAllocations.store(0ULL, std::memory_order_relaxed);
+        this->m_numberOfBytes.store(0ULL, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<unsigned long long> m_numberOfAllocations;
+    std::atomic<unsigned long long> m_numberOfBytes;
+};
+
+enum class AllocationSubsystem
+{
+    Director,
+    Ports,
+    Reactions,
+    Count
+};
+
+// Owned by a host's director, which opens a scope on it for every round
+struct AllocationAccount
+{
+    AllocationCounters total;
+    AllocationCounters subsystems[static_cast<size_t>(AllocationSubsystem::Count)];
+
+    void Reset()
+    {
+        this->total.Reset();
+        for (auto& counters : this->subsystems)
+        {
+            counters.Reset();
+        }
+    }
+};
+
+#ifdef ACCESSOR_FRAMEWORK_ALLOCATION_ACCOUNTING
+
+class AllocationScope
+{
+public:
+    AllocationScope(AllocationAccount* account, AllocationSubsystem subsystem) :
+        m_previous(s_current)
+    {
+        s_current.account = account;
+        s_current.counters = &(account->subsystems[static_cast<size_t>(subsystem)]);
+    }
+
+    explicit AllocationScope(AllocationSubsystem subsystem) :
+        m_previous(s_current)
+    {
+        if (s_current.account != nullptr)
+        {
+            s_current.counters = &(s_current.account->subsystems[static_cast<size_t>(subsystem)]);
+        }
+    }
+
+    explicit AllocationScope(AllocationCounters* accessorCounters) :
+        m_previous(s_current)
+    {
+        if (accessorCounters != nullptr)
+        {
+            s_current.counters = accessorCounters;
+        }
+    }
+
+    ~AllocationScope()
+    {
+        s_current = this->m_previous;
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    static void RecordAllocation(size_t numberOfBytes);
+
+private:
+    struct Current
+    {
+        AllocationAccount* account;
+        AllocationCounters* counters;
+    };
+
+    const Current m_previous;
+
+    static thread_local Current s_current;
+};
+
+#else
+
+class AllocationScope
+{
+public:
+    AllocationScope(AllocationAccount* /*account*/, AllocationSubsystem /*subsystem*/)
+    {
+    }
+
+    explicit AllocationScope(AllocationSubsystem /*subsystem*/)
+    {
+    }
+
+    explicit AllocationScope(AllocationCounters* /*accessorCounters*/)
+    {
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#endif // ACCESSOR_FRAMEWORK_ALLOCATION_ACCOUNTING
+
+#endif // ALLOCATION_ACCOUNTING_H
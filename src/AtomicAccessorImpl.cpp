@@ -3,16 +3,13 @@
 
 #include "AtomicAccessorImpl.h"
 #include "CompositeAccessorImpl.h"
-#include "PrintDebug.h"
-
-template<class Key>
-static void SetSubtract(std::set<Key>& minuend, const std::set<Key>& subtrahend)
-{
-    for (const auto& element : subtrahend)
-    {
-        minuend.erase(element);
-    }
-}
+#include "Director.h"
+#include "LatencyProbe.h"
+#include "Logger.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
 
 AtomicAccessor::Impl::Impl(
     const std::string& name,
@@ -26,63 +23,98 @@ AtomicAccessor::Impl::Impl(
         Accessor::Impl(name, container, initializeFunction, inputPortNames, connectedOutputPortNames),
         m_inputHandlers(inputHandlers),
         m_fireFunction(fireFunction),
-        m_stateDependsOnInputPort(false)
+        m_stateDependsOnInputPort(false),
+        m_dependenciesAreCompiled(false),
+        m_criticalPathAnalyzer(nullptr),
+        m_criticalPathIndex(0)
 {
     this->AddSpontaneousOutputPorts(spontaneousOutputPortNames);
 }
 
+// Offloaded work that is still running is left to finish, but its result is never delivered
+AtomicAccessor::Impl::~Impl()
+{
+    Director* director = this->GetDirector();
+    if (director != nullptr)
+    {
+        for (const auto& pendingOffload : this->m_pendingOffloads)
+        {
+            director->ClearScheduledCallback(pendingOffload->callbackId);
+        }
+    }
+}
+
 bool AtomicAccessor::Impl::IsComposite() const
 {
     return false;
 }
 
-std::vector<const InputPort*> AtomicAccessor::Impl::GetEquivalentPorts(const InputPort* inputPort) const
+const std::vector<const InputPort*>& AtomicAccessor::Impl::GetEquivalentPorts(const InputPort* inputPort) const
 {
-    if (this->m_forwardPrunedDependencies.empty() || this->GetNumberOfInputPorts() == 1 || this->GetNumberOfOutputPorts() == 0)
+    const CompiledDependencies& dependencies = this->GetCompiledDependencies();
+    if (!dependencies.hasPrunedDependencies)
     {
-        return this->GetInputPorts();
+        return dependencies.inputPorts;
     }
 
-    std::set<const InputPort*> equivalentPorts{};
-    std::set<const OutputPort*> dependentPorts{};
-    this->FindEquivalentPorts(inputPort, equivalentPorts, dependentPorts);
-    return std::vector<const InputPort*>(equivalentPorts.begin(), equivalentPorts.end());
+    return dependencies.equivalenceClasses[dependencies.equivalenceClassIndices[dependencies.portIndices.at(inputPort)]];
 }
 
-std::vector<const InputPort*> AtomicAccessor::Impl::GetInputPortDependencies(const OutputPort* outputPort) const
+const std::vector<const InputPort*>& AtomicAccessor::Impl::GetInputPortDependencies(const OutputPort* outputPort) const
 {
-    const std::vector<const InputPort*>& allInputPorts = this->GetInputPorts();
-    if (this->m_backwardPrunedDependencies.find(outputPort) == this->m_backwardPrunedDependencies.end())
+    const CompiledDependencies& dependencies = this->GetCompiledDependencies();
+    if (!dependencies.hasPrunedDependencies)
     {
-        return allInputPorts;
+        return dependencies.inputPorts;
     }
 
-    std::set<const InputPort*> inputPortDependencies(allInputPorts.begin(), allInputPorts.end());
-    SetSubtract(inputPortDependencies, this->m_backwardPrunedDependencies.at(outputPort));
-    return std::vector<const InputPort*>(inputPortDependencies.begin(), inputPortDependencies.end());
+    return dependencies.inputPortDependencies[dependencies.portIndices.at(outputPort)];
 }
 
-std::vector<const OutputPort*> AtomicAccessor::Impl::GetDependentOutputPorts(const InputPort* inputPort) const
+const std::vector<const OutputPort*>& AtomicAccessor::Impl::GetDependentOutputPorts(const InputPort* inputPort) const
 {
-    const std::vector<const OutputPort*>& allOutputPorts = this->GetOutputPorts();
-    if (this->m_forwardPrunedDependencies.find(inputPort) == this->m_forwardPrunedDependencies.end())
+    const CompiledDependencies& dependencies = this->GetCompiledDependencies();
+    if (!dependencies.hasPrunedDependencies)
     {
-        return allOutputPorts;
+        return dependencies.outputPorts;
     }
 
-    std::set<const OutputPort*> dependentOutputPorts(allOutputPorts.begin(), allOutputPorts.end());
-    SetSubtract(dependentOutputPorts, this->m_forwardPrunedDependencies.at(inputPort));
-    return std::vector<const OutputPort*>(dependentOutputPorts.begin(), dependentOutputPorts.end());
+    return dependencies.dependentOutputPorts[dependencies.portIndices.at(inputPort)];
 }
 
 void AtomicAccessor::Impl::ProcessInputs()
 {
-    PRINT_DEBUG("%s is reacting to inputs on all ports", this->GetName().c_str());
-    auto inputPorts = this->GetOrderedInputPorts();
-    for (InputPort* inputPort : inputPorts)
+    AllocationScope allocationScope(&(this->m_allocationCounters));
+    LOG_DEBUG("%s is reacting to inputs on all ports", this->GetName().c_str());
+    TraceRecorder::Scope traceScope{};
+    if (TraceRecorder::IsRecording())
     {
+        traceScope.Begin("reaction", this->GetTraceName());
+    }
+
+    // Reading the clock costs about as much as a small input handler, so only one reaction in every TimedReactionInterval
+    // is timed, and the time spent handling inputs is measured as a whole (along with the bookkeeping between handlers)
+    const bool isProfiling = ProfilingCounter::ProfilingIsEnabled();
+    const bool isTiming = (isProfiling && this->m_reactionCounters.numberOfReactions.Get() % TimedReactionInterval == 0ULL);
+    CriticalPathAnalyzer* criticalPathAnalyzer = this->m_criticalPathAnalyzer;
+    std::chrono::steady_clock::time_point startTime;
+    if (isTiming || criticalPathAnalyzer != nullptr)
+    {
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    // Indexed, since input handlers could add input ports
+    const auto& inputPorts = this->GetOrderedInputPorts();
+    for (size_t i = 0; i < inputPorts.size(); ++i)
+    {
+        InputPort* inputPort = inputPorts[i];
         if (inputPort->IsWaitingForInputHandler())
         {
+            for (auto& latencyProbe : inputPort->GetLatencyProbes())
+            {
+                latencyProbe->Measure(this->GetDirector()->GetCurrentLogicalTime());
+            }
+
             this->InvokeInputHandlers(inputPort->GetName());
             inputPort->DequeueLatestInput();
             if (inputPort->IsWaitingForInputHandler())
@@ -99,12 +131,235 @@ void AtomicAccessor::Impl::ProcessInputs()
         }
     }
 
+    std::chrono::steady_clock::time_point inputHandlersFinishedTime;
+    if (isTiming)
+    {
+        inputHandlersFinishedTime = std::chrono::steady_clock::now();
+    }
+
+    std::chrono::steady_clock::time_point fireFinishedTime = inputHandlersFinishedTime;
     if (this->m_fireFunction != nullptr)
     {
         this->m_fireFunction(*(static_cast<AtomicAccessor*>(this->m_container)));
+        if (isTiming)
+        {
+            fireFinishedTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    if (isProfiling)
+    {
+        this->m_reactionCounters.numberOfReactions.Increment();
+    }
+
+    if (isTiming)
+    {
+        auto inputHandlerNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(inputHandlersFinishedTime - startTime).count();
+        auto fireNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(fireFinishedTime - inputHandlersFinishedTime).count();
+        this->m_reactionCounters.numberOfTimedReactions.Increment();
+        this->m_reactionCounters.totalInputHandlerNanoseconds.Add(inputHandlerNanoseconds);
+        this->m_reactionCounters.maxInputHandlerNanoseconds.RaiseTo(inputHandlerNanoseconds);
+        this->m_reactionCounters.totalFireNanoseconds.Add(fireNanoseconds);
+        this->m_reactionCounters.maxFireNanoseconds.RaiseTo(fireNanoseconds);
+    }
+
+    if (criticalPathAnalyzer != nullptr)
+    {
+        auto finishTime = (isTiming ? fireFinishedTime : std::chrono::steady_clock::now());
+        criticalPathAnalyzer->RecordReaction(this->m_criticalPathIndex, std::chrono::duration_cast<std::chrono::nanoseconds>(finishTime - startTime).count());
+    }
+
+    LOG_DEBUG("%s has finished reacting to all inputs", this->GetName().c_str());
+}
+
+void AtomicAccessor::Impl::SetCriticalPathAnalyzer(CriticalPathAnalyzer* criticalPathAnalyzer, size_t accessorIndex)
+{
+    this->m_criticalPathAnalyzer = criticalPathAnalyzer;
+    this->m_criticalPathIndex = accessorIndex;
+}
+
+void AtomicAccessor::Impl::SetStateFunctions(
+    std::function<void(const AtomicAccessor&, std::ostream&)> saveStateFunction,
+    std::function<void(AtomicAccessor&, std::istream&)> restoreStateFunction)
+{
+    this->m_saveStateFunction = std::move(saveStateFunction);
+    this->m_restoreStateFunction = std::move(restoreStateFunction);
+}
+
+// Ports are written in order, each with its name, so a checkpoint can only be restored into an accessor with the same
+// ports
+void AtomicAccessor::Impl::SaveCheckpoint(std::vector<unsigned char>& buffer, const EventSerializer* serializer) const
+{
+    if (!(this->m_pendingOffloads.empty()))
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Accessor " << this->GetFullName() << " cannot be checkpointed while it has offloaded work in progress";
+        throw std::logic_error(exceptionMessage.str());
+    }
+
+    ByteWriter writer(buffer);
+    Director* director = this->GetDirector();
+    std::vector<int> callbackIds = this->GetScheduledCallbackIds();
+    Serializer<uint64_t>::Write(writer, callbackIds.size());
+    for (int callbackId : callbackIds)
+    {
+        Director::CallbackTiming timing{};
+        director->GetCallbackTiming(callbackId, timing);
+        Serializer<int64_t>::Write(writer, timing.delayInMilliseconds);
+        Serializer<int32_t>::Write(writer, timing.periodInMilliseconds);
+        Serializer<uint8_t>::Write(writer, timing.isPeriodic ? 1 : 0);
+    }
+
+    Serializer<uint64_t>::Write(writer, this->GetOrderedInputPorts().size());
+    for (InputPort* inputPort : this->GetOrderedInputPorts())
+    {
+        this->WriteQueuedEvents(buffer, inputPort, inputPort->GetQueuedInputs(), serializer);
+    }
+
+    Serializer<uint64_t>::Write(writer, this->GetOrderedOutputPorts().size());
+    for (OutputPort* outputPort : this->GetOrderedOutputPorts())
+    {
+        this->WriteQueuedEvents(buffer, outputPort, outputPort->GetPendingOutputs(), serializer);
+    }
+
+    std::ostringstream state;
+    this->m_saveStateFunction(*static_cast<const AtomicAccessor*>(this->m_container), state);
+    Serializer<std::string>::Write(writer, state.str());
+}
+
+void AtomicAccessor::Impl::ReadCheckpoint(ByteReader& reader, const EventSerializer* serializer, CheckpointData& checkpoint) const
+{
+    uint64_t numberOfCallbacks = 0;
+    if (!(reader.ReadElementCount(numberOfCallbacks)))
+    {
+        this->ThrowCorruptCheckpoint();
+    }
+
+    std::vector<Director::CallbackTiming> callbackTimings(static_cast<size_t>(numberOfCallbacks));
+    for (Director::CallbackTiming& timing : callbackTimings)
+    {
+        int64_t delayInMilliseconds = 0;
+        int32_t periodInMilliseconds = 0;
+        uint8_t isPeriodic = 0;
+        if (!(Serializer<int64_t>::Read(reader, delayInMilliseconds)) ||
+            !(Serializer<int32_t>::Read(reader, periodInMilliseconds)) ||
+            !(Serializer<uint8_t>::Read(reader, isPeriodic)) ||
+            delayInMilliseconds < 0 ||
+            isPeriodic > 1)
+        {
+            this->ThrowCorruptCheckpoint();
+        }
+
+        timing = Director::CallbackTiming{ delayInMilliseconds, periodInMilliseconds, isPeriodic == 1 };
+    }
+
+    uint64_t numberOfInputPorts = 0;
+    if (!(reader.ReadElementCount(numberOfInputPorts)) || numberOfInputPorts != this->GetOrderedInputPorts().size())
+    {
+        this->ThrowCorruptCheckpoint();
+    }
+
+    std::vector<std::vector<std::shared_ptr<IEvent>>> queuedInputs{};
+    for (InputPort* inputPort : this->GetOrderedInputPorts())
+    {
+        queuedInputs.push_back(this->ReadQueuedEvents(reader, inputPort, serializer));
+    }
+
+    uint64_t numberOfOutputPorts = 0;
+    if (!(reader.ReadElementCount(numberOfOutputPorts)) || numberOfOutputPorts != this->GetOrderedOutputPorts().size())
+    {
+        this->ThrowCorruptCheckpoint();
+    }
+
+    std::vector<std::vector<std::shared_ptr<IEvent>>> pendingOutputs{};
+    for (OutputPort* outputPort : this->GetOrderedOutputPorts())
+    {
+        pendingOutputs.push_back(this->ReadQueuedEvents(reader, outputPort, serializer));
+    }
+
+    std::string savedState{};
+    if (!(Serializer<std::string>::Read(reader, savedState)))
+    {
+        this->ThrowCorruptCheckpoint();
+    }
+
+    checkpoint.callbackTimings = std::move(callbackTimings);
+    checkpoint.queuedInputs = std::move(queuedInputs);
+    checkpoint.pendingOutputs = std::move(pendingOutputs);
+    checkpoint.savedState = std::move(savedState);
+}
+
+void AtomicAccessor::Impl::RestoreCheckpoint(CheckpointData&& checkpoint)
+{
+    const std::vector<Director::CallbackTiming>& callbackTimings = checkpoint.callbackTimings;
+    std::vector<std::vector<std::shared_ptr<IEvent>>>& queuedInputs = checkpoint.queuedInputs;
+    std::vector<std::vector<std::shared_ptr<IEvent>>>& pendingOutputs = checkpoint.pendingOutputs;
+    std::vector<int> earlierCallbackIds = this->GetScheduledCallbackIds();
+    std::istringstream state(checkpoint.savedState);
+    this->m_restoreStateFunction(*static_cast<AtomicAccessor*>(this->m_container), state);
+    this->SetInitialized();
+    std::vector<int> callbackIds{};
+    for (int callbackId : this->GetScheduledCallbackIds())
+    {
+        if (std::find(earlierCallbackIds.begin(), earlierCallbackIds.end(), callbackId) == earlierCallbackIds.end())
+        {
+            callbackIds.push_back(callbackId);
+        }
+    }
+
+    if (callbackIds.size() != callbackTimings.size())
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Accessor " << this->GetFullName() << " scheduled " << callbackIds.size() << " callbacks while it was restored, but had "
+            << callbackTimings.size() << " when it was checkpointed";
+        throw std::logic_error(exceptionMessage.str());
+    }
+
+    Director* director = this->GetDirector();
+    for (size_t i = 0; i < callbackIds.size(); ++i)
+    {
+        director->SetCallbackTiming(callbackIds[i], callbackTimings[i]);
+    }
+
+    for (size_t i = 0; i < queuedInputs.size(); ++i)
+    {
+        for (auto& input : queuedInputs[i])
+        {
+            this->GetOrderedInputPorts()[i]->ReceiveData(std::move(input));
+        }
+    }
+
+    for (size_t i = 0; i < pendingOutputs.size(); ++i)
+    {
+        for (auto& output : pendingOutputs[i])
+        {
+            this->SendOutput(this->GetOrderedOutputPorts()[i]->GetName(), std::move(output));
+        }
+    }
+}
+
+const AtomicAccessor::Impl::ReactionCounters& AtomicAccessor::Impl::GetReactionCounters() const
+{
+    return this->m_reactionCounters;
+}
+
+void AtomicAccessor::Impl::ResetCounters()
+{
+    this->m_reactionCounters.numberOfReactions.Reset();
+    this->m_reactionCounters.numberOfTimedReactions.Reset();
+    this->m_reactionCounters.totalInputHandlerNanoseconds.Reset();
+    this->m_reactionCounters.maxInputHandlerNanoseconds.Reset();
+    this->m_reactionCounters.totalFireNanoseconds.Reset();
+    this->m_reactionCounters.maxFireNanoseconds.Reset();
+    for (InputPort* inputPort : this->GetOrderedInputPorts())
+    {
+        inputPort->ResetCounters();
     }
 
-    PRINT_DEBUG("%s has finished reacting to all inputs", this->GetName().c_str());
+    for (OutputPort* outputPort : this->GetOrderedOutputPorts())
+    {
+        outputPort->ResetCounters();
+    }
 }
 
 void AtomicAccessor::Impl::AccessorStateDependsOn(const std::string& inputPortName)
@@ -122,7 +377,7 @@ void AtomicAccessor::Impl::RemoveDependency(const std::string& inputPortName, co
     const InputPort* inputPort = this->GetInputPort(inputPortName);
     const OutputPort* outputPort = this->GetOutputPort(outputPortName);
     this->m_forwardPrunedDependencies[inputPort].insert(outputPort);
-    this->m_backwardPrunedDependencies[outputPort].insert(inputPort);
+    this->m_dependenciesAreCompiled = false;
 }
 
 void AtomicAccessor::Impl::RemoveDependencies(const std::string& inputPortName, const std::vector<std::string>& outputPortNames)
@@ -171,30 +426,273 @@ void AtomicAccessor::Impl::AddInputHandlers(const std::string& inputPortName, co
     this->m_inputHandlers[inputPortName].insert(this->m_inputHandlers[inputPortName].end(), handlers.begin(), handlers.end());
 }
 
-void AtomicAccessor::Impl::FindEquivalentPorts(const InputPort* inputPort, std::set<const InputPort*>& equivalentPorts, std::set<const OutputPort*>& dependentPorts) const
+// The result is delivered by a callback that is scheduled when the work is offloaded, so it arrives at a logical time that
+// depends only on the logical time of the offload. Like IOAccessor, the callback is scheduled on the Director directly
+// and tracked separately, so that the ids of delivered results do not accumulate with the accessor's callbacks.
+bool AtomicAccessor::Impl::Offload(OffloadPool::Work work, const std::string& completionPortName, int delayInMilliseconds)
+{
+    if (!this->HasInputPortWithName(completionPortName))
+    {
+        throw std::invalid_argument("Input port not found");
+    }
+
+    Director* director = this->GetDirector();
+    if (director == nullptr)
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Accessor " << this->GetFullName() << " must belong to a host before it can offload work";
+        throw std::logic_error(exceptionMessage.str());
+    }
+
+    auto pendingOffload = std::make_shared<PendingOffload>();
+    pendingOffload->completionPort = this->GetInputPort(completionPortName);
+    pendingOffload->result = OffloadPool::GetDefault().Submit(std::move(work), this->GetOffloadStatistics());
+
+    if (!(pendingOffload->result.valid()))
+    {
+        LOG_DEBUG("%s could not offload work because the offload queue is full", this->GetName().c_str());
+        return false;
+    }
+
+    pendingOffload->callbackId = director->ScheduleCallback(
+        [this, pendingOffload]()
+        {
+            this->DeliverOffloadResult(pendingOffload);
+        },
+        delayInMilliseconds,
+        false /*isPeriodic*/,
+        this->m_priority,
+        nullptr /*allocationCounters*/,
+        this);
+    this->m_pendingOffloads.insert(pendingOffload);
+    return true;
+}
+
+const AtomicAccessor::Impl::CompiledDependencies& AtomicAccessor::Impl::GetCompiledDependencies() const
+{
+    if (!this->m_dependenciesAreCompiled ||
+        this->m_compiledDependencies.numberOfInputPorts != this->GetNumberOfInputPorts() ||
+        this->m_compiledDependencies.numberOfOutputPorts != this->GetNumberOfOutputPorts())
+    {
+        this->CompileDependencies();
+    }
+
+    return this->m_compiledDependencies;
+}
+
+void AtomicAccessor::Impl::CompileDependencies() const
 {
-    if (equivalentPorts.find(inputPort) == equivalentPorts.end())
+    CompiledDependencies dependencies{};
+    dependencies.inputPorts = this->GetInputPorts();
+    dependencies.outputPorts = this->GetOutputPorts();
+    dependencies.hasPrunedDependencies = !this->m_forwardPrunedDependencies.empty();
+    const std::vector<const InputPort*>& inputPorts = dependencies.inputPorts;
+    const std::vector<const OutputPort*>& outputPorts = dependencies.outputPorts;
+    const size_t numberOfInputPorts = inputPorts.size();
+    const size_t numberOfOutputPorts = outputPorts.size();
+    dependencies.numberOfInputPorts = numberOfInputPorts;
+    dependencies.numberOfOutputPorts = numberOfOutputPorts;
+    if (!dependencies.hasPrunedDependencies)
+    {
+        this->m_compiledDependencies = std::move(dependencies);
+        this->m_dependenciesAreCompiled = true;
+        return;
+    }
+
+    dependencies.portIndices.reserve(numberOfInputPorts + numberOfOutputPorts);
+    for (size_t i = 0; i < numberOfInputPorts; ++i)
+    {
+        dependencies.portIndices.emplace(inputPorts[i], i);
+    }
+
+    for (size_t i = 0; i < numberOfOutputPorts; ++i)
+    {
+        dependencies.portIndices.emplace(outputPorts[i], i);
+    }
+
+    // Every output port depends on every input port unless the dependency was removed
+    dependencies.dependentOutputPortBits.assign(numberOfInputPorts, dynamic_bitset(numberOfOutputPorts, true));
+    dependencies.inputPortDependencyBits.assign(numberOfOutputPorts, dynamic_bitset(numberOfInputPorts, true));
+    for (const auto& entry : this->m_forwardPrunedDependencies)
+    {
+        size_t inputIndex = dependencies.portIndices.at(entry.first);
+        for (auto outputPort : entry.second)
+        {
+            size_t outputIndex = dependencies.portIndices.at(outputPort);
+            dependencies.dependentOutputPortBits[inputIndex].reset(outputIndex);
+            dependencies.inputPortDependencyBits[outputIndex].reset(inputIndex);
+        }
+    }
+
+    dependencies.dependentOutputPorts.resize(numberOfInputPorts);
+    for (size_t i = 0; i < numberOfInputPorts; ++i)
+    {
+        dependencies.dependentOutputPortBits[i].for_each([&dependencies, &outputPorts, i](size_t outputIndex)
+        {
+            dependencies.dependentOutputPorts[i].push_back(outputPorts[outputIndex]);
+        });
+    }
+
+    dependencies.inputPortDependencies.resize(numberOfOutputPorts);
+    for (size_t i = 0; i < numberOfOutputPorts; ++i)
+    {
+        dependencies.inputPortDependencyBits[i].for_each([&dependencies, &inputPorts, i](size_t inputIndex)
+        {
+            dependencies.inputPortDependencies[i].push_back(inputPorts[inputIndex]);
+        });
+    }
+
+    // Union-find over input ports: all input ports that an output port depends on are equivalent. An accessor without
+    // output ports has no causal path through it, so all of its input ports are treated as a single class.
+    std::vector<size_t> parents(numberOfInputPorts);
+    for (size_t i = 0; i < numberOfInputPorts; ++i)
+    {
+        parents[i] = (numberOfOutputPorts == 0 ? 0 : i);
+    }
+
+    auto findRoot = [&parents](size_t i)
     {
-        equivalentPorts.insert(inputPort);
-        const std::vector<const OutputPort*>& dependentOutputPorts = this->GetDependentOutputPorts(inputPort);
-        for (auto dependentOutputPort : dependentOutputPorts)
+        while (parents[i] != i)
         {
-            if (dependentPorts.find(dependentOutputPort) == dependentPorts.end())
+            parents[i] = parents[parents[i]];
+            i = parents[i];
+        }
+
+        return i;
+    };
+
+    for (size_t i = 0; i < numberOfOutputPorts; ++i)
+    {
+        size_t firstRoot = numberOfInputPorts;
+        dependencies.inputPortDependencyBits[i].for_each([&parents, &findRoot, &firstRoot](size_t inputIndex)
+        {
+            size_t root = findRoot(inputIndex);
+            if (firstRoot == parents.size())
             {
-                dependentPorts.insert(dependentOutputPort);
-                const std::vector<const InputPort*>& inputPortDependencies = this->GetInputPortDependencies(dependentOutputPort);
-                for (auto inputPortDependency : inputPortDependencies)
-                {
-                    this->FindEquivalentPorts(inputPortDependency, equivalentPorts, dependentPorts);
-                }
+                firstRoot = root;
+            }
+            else if (root != firstRoot)
+            {
+                parents[std::max(root, firstRoot)] = std::min(root, firstRoot);
+                firstRoot = std::min(root, firstRoot);
             }
+        });
+    }
+
+    // Classes are numbered in order of their first input port
+    const size_t unassigned = numberOfInputPorts;
+    std::vector<size_t> rootClassIndices(numberOfInputPorts, unassigned);
+    dependencies.equivalenceClassIndices.resize(numberOfInputPorts);
+    for (size_t i = 0; i < numberOfInputPorts; ++i)
+    {
+        size_t root = findRoot(i);
+        if (rootClassIndices[root] == unassigned)
+        {
+            rootClassIndices[root] = dependencies.equivalenceClasses.size();
+            dependencies.equivalenceClasses.emplace_back();
+        }
+
+        dependencies.equivalenceClassIndices[i] = rootClassIndices[root];
+        dependencies.equivalenceClasses[rootClassIndices[root]].push_back(inputPorts[i]);
+    }
+
+    this->m_compiledDependencies = std::move(dependencies);
+    this->m_dependenciesAreCompiled = true;
+}
+
+void AtomicAccessor::Impl::DeliverOffloadResult(const std::shared_ptr<PendingOffload>& pendingOffload)
+{
+    this->m_pendingOffloads.erase(pendingOffload);
+    if (pendingOffload->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        LOG_DEBUG("%s is waiting for the result of offloaded work that is late", this->GetName().c_str());
+        auto dueTime = std::chrono::steady_clock::now();
+        pendingOffload->result.wait();
+        this->GetOffloadStatistics()->RecordWait(std::chrono::steady_clock::now() - dueTime);
+    }
+
+    pendingOffload->completionPort->ReceiveData(pendingOffload->result.get());
+}
+
+// Each event is preceded by whether it is null
+void AtomicAccessor::Impl::WriteQueuedEvents(
+    std::vector<unsigned char>& buffer,
+    const Port* port,
+    const std::vector<std::shared_ptr<IEvent>>& events,
+    const EventSerializer* serializer) const
+{
+    ByteWriter writer(buffer);
+    Serializer<std::string>::Write(writer, port->GetName());
+    Serializer<uint64_t>::Write(writer, events.size());
+    for (const auto& event : events)
+    {
+        Serializer<uint8_t>::Write(writer, event != nullptr ? 1 : 0);
+        if (event == nullptr)
+        {
+            continue;
+        }
+        else if (serializer == nullptr || !(serializer->CanSerialize(*event)))
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "An event queued on port " << port->GetFullName() << " cannot be checkpointed without a serializer that knows its type";
+            throw std::invalid_argument(exceptionMessage.str());
         }
+
+        serializer->Serialize(*event, buffer);
+    }
+}
+
+std::vector<std::shared_ptr<IEvent>> AtomicAccessor::Impl::ReadQueuedEvents(ByteReader& reader, const Port* port, const EventSerializer* serializer) const
+{
+    std::string portName{};
+    uint64_t numberOfEvents = 0;
+    if (!(Serializer<std::string>::Read(reader, portName)) || portName != port->GetName() || !(reader.ReadElementCount(numberOfEvents)))
+    {
+        this->ThrowCorruptCheckpoint();
     }
+
+    std::vector<std::shared_ptr<IEvent>> events{};
+    for (uint64_t i = 0; i < numberOfEvents; ++i)
+    {
+        uint8_t isPresent = 0;
+        if (!(Serializer<uint8_t>::Read(reader, isPresent)) || isPresent > 1)
+        {
+            this->ThrowCorruptCheckpoint();
+        }
+        else if (isPresent == 0)
+        {
+            events.push_back(nullptr);
+            continue;
+        }
+        else if (serializer == nullptr)
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "The events queued on port " << port->GetFullName() << " cannot be restored without a serializer";
+            throw std::invalid_argument(exceptionMessage.str());
+        }
+
+        std::shared_ptr<IEvent> event = serializer->Deserialize(reader);
+        if (event == nullptr)
+        {
+            this->ThrowCorruptCheckpoint();
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    return events;
+}
+
+void AtomicAccessor::Impl::ThrowCorruptCheckpoint() const
+{
+    std::ostringstream exceptionMessage;
+    exceptionMessage << "The checkpoint of accessor " << this->GetFullName() << " is corrupt or was taken from a different accessor";
+    throw std::invalid_argument(exceptionMessage.str());
 }
 
 void AtomicAccessor::Impl::InvokeInputHandlers(const std::string& inputPortName)
 {
-    PRINT_DEBUG("%s is handling input on input port \"%s\"", this->GetName().c_str(), inputPortName.c_str());
+    LOG_DEBUG("%s is handling input on input port \"%s\"", this->GetName().c_str(), inputPortName.c_str());
     
     IEvent* latestInput = this->GetLatestInput(inputPortName);
     const std::vector<InputHandler>& inputHandlers = this->m_inputHandlers.at(inputPortName);
@@ -4,7 +4,13 @@
 #ifndef ATOMIC_ACCESSOR_IMPL_H
 #define ATOMIC_ACCESSOR_IMPL_H
 
+#include "AccessorFramework/EventSerializer.h"
 #include "AccessorImpl.h"
+#include "CriticalPathAnalyzer.h"
+#include "DynamicBitset.h"
+#include "ProfilingCounter.h"
+#include <iosfwd>
+#include <unordered_map>
 
 // Description
 // The AtomicAccessorImpl implements the public AtomicAccessor interface defined in Accessor.h. In addition, it exposes
@@ -13,6 +19,20 @@
 // using the causality imperitives implied by the model's port connections; in other words, we use a topological sort of
 // the directed graph created by the model's connectivity information. See HostImpl and Director for more details.
 //
+// Each atomic accessor also counts its reactions and times the input handlers and Fire() function it runs in the first
+// reaction and every TimedReactionInterval-th one after it. While its host analyses critical paths, every reaction is
+// timed as a whole and recorded with the host's CriticalPathAnalyzer.
+//
+// When its host is checkpointed, an atomic accessor writes the timing of the callbacks it has scheduled, the events
+// queued on its input ports and waiting on its output ports, and whatever its SaveState() writes. When the host is
+// restored, the accessor is given its part of the checkpoint in place of being initialized: its RestoreState() is
+// called, the callbacks it schedules there are given the timing of the callbacks it had, in order, and its queued
+// events are delivered again. Callbacks are closures, so they cannot be written to a checkpoint, only re-created.
+//
+// The result of offloaded work is delivered by a callback scheduled when the work is offloaded. If the work has not
+// finished when that callback runs, the callback waits for it, so the result always arrives at the logical time it was
+// due and a run of the model does not depend on how fast the workers were.
+//
 class AtomicAccessor::Impl : public Accessor::Impl
 {
 public:
@@ -25,14 +45,50 @@ public:
         const std::vector<std::string>& spontaneousOutputPortNames = {},
         std::map<std::string, std::vector<AtomicAccessor::InputHandler>> inputHandlers = {},
         std::function<void(AtomicAccessor&)> fireFunction = nullptr);
+    ~Impl();
 
     // Internal Methods
     bool IsComposite() const override;
-    std::vector<const InputPort*> GetEquivalentPorts(const InputPort* inputPort) const;
-    std::vector<const InputPort*> GetInputPortDependencies(const OutputPort* outputPort) const;
-    std::vector<const OutputPort*> GetDependentOutputPorts(const InputPort* inputPort) const;
+
+    // References into the compiled dependencies, which are rebuilt whenever a port is added or a dependency removed, so
+    // they must not be held across AddInputPort(), AddOutputPort() or RemoveDependency()
+    const std::vector<const InputPort*>& GetEquivalentPorts(const InputPort* inputPort) const;
+    const std::vector<const InputPort*>& GetInputPortDependencies(const OutputPort* outputPort) const;
+    const std::vector<const OutputPort*>& GetDependentOutputPorts(const InputPort* inputPort) const;
     void ProcessInputs();
 
+    struct ReactionCounters
+    {
+        ProfilingCounter numberOfReactions;
+        ProfilingCounter numberOfTimedReactions;
+        ProfilingCounter totalInputHandlerNanoseconds; // over the timed reactions
+        ProfilingCounter maxInputHandlerNanoseconds; // in a single reaction
+        ProfilingCounter totalFireNanoseconds;
+        ProfilingCounter maxFireNanoseconds;
+    };
+
+    static const unsigned long long TimedReactionInterval = 16ULL;
+    const ReactionCounters& GetReactionCounters() const;
+    void ResetCounters(); // also resets the counters of the accessor's ports
+    void SetCriticalPathAnalyzer(CriticalPathAnalyzer* criticalPathAnalyzer, size_t accessorIndex); // nullptr stops recording
+    void SetStateFunctions(
+        std::function<void(const AtomicAccessor&, std::ostream&)> saveStateFunction,
+        std::function<void(AtomicAccessor&, std::istream&)> restoreStateFunction);
+
+    // An accessor's part of a checkpoint, read and checked before any accessor is restored
+    struct CheckpointData
+    {
+        std::vector<Director::CallbackTiming> callbackTimings;
+        std::vector<std::vector<std::shared_ptr<IEvent>>> queuedInputs; // by input port, in order
+        std::vector<std::vector<std::shared_ptr<IEvent>>> pendingOutputs; // by output port, in order
+        std::string savedState;
+    };
+
+    // Queued events can only be checkpointed if the serializer knows their payload types
+    void SaveCheckpoint(std::vector<unsigned char>& buffer, const EventSerializer* serializer) const;
+    void ReadCheckpoint(ByteReader& reader, const EventSerializer* serializer, CheckpointData& checkpoint) const; // leaves the accessor as it was
+    void RestoreCheckpoint(CheckpointData&& checkpoint); // in place of Initialize()
+
 protected:
     // AtomicAccessor Methods
     void AccessorStateDependsOn(const std::string& inputPortName);
@@ -42,18 +98,59 @@ protected:
     void AddSpontaneousOutputPorts(const std::vector<std::string>& portNames);
     void AddInputHandler(const std::string& inputPortName, AtomicAccessor::InputHandler handler);
     void AddInputHandlers(const std::string& inputPortName, const std::vector<AtomicAccessor::InputHandler>& handlers);
+    bool Offload(OffloadPool::Work work, const std::string& completionPortName, int delayInMilliseconds);
 
 private:
     friend class AtomicAccessor;
 
-    void FindEquivalentPorts(const InputPort* inputPort, std::set<const InputPort*>& equivalentPorts, std::set<const OutputPort*>& dependentPorts) const;
+    // The causal dependencies between this accessor's ports, compiled from the pruned dependencies. Input ports that
+    // share a dependent output port (directly or transitively) are merged into one equivalence class. If no dependency
+    // has been pruned, every port depends on every other port and only the port lists are kept.
+    struct CompiledDependencies
+    {
+        size_t numberOfInputPorts = 0;
+        size_t numberOfOutputPorts = 0;
+        bool hasPrunedDependencies = false;
+        std::vector<const InputPort*> inputPorts;
+        std::vector<const OutputPort*> outputPorts;
+        std::unordered_map<const Port*, size_t> portIndices;
+        std::vector<dynamic_bitset> dependentOutputPortBits;
+        std::vector<dynamic_bitset> inputPortDependencyBits;
+        std::vector<std::vector<const OutputPort*>> dependentOutputPorts;
+        std::vector<std::vector<const InputPort*>> inputPortDependencies;
+        std::vector<size_t> equivalenceClassIndices;
+        std::vector<std::vector<const InputPort*>> equivalenceClasses;
+    };
+
+    // Recompiles the dependencies if a dependency was removed or a port was added since they were last compiled
+    const CompiledDependencies& GetCompiledDependencies() const;
+    void CompileDependencies() const;
     void InvokeInputHandlers(const std::string& inputPortName);
+    // Offloaded work whose result has not been delivered
+    struct PendingOffload
+    {
+        std::future<std::shared_ptr<IEvent>> result;
+        InputPort* completionPort = nullptr;
+        int callbackId = -1; // of the callback that delivers the result when it is due
+    };
+
+    void DeliverOffloadResult(const std::shared_ptr<PendingOffload>& pendingOffload);
+    void WriteQueuedEvents(std::vector<unsigned char>& buffer, const Port* port, const std::vector<std::shared_ptr<IEvent>>& events, const EventSerializer* serializer) const;
+    std::vector<std::shared_ptr<IEvent>> ReadQueuedEvents(ByteReader& reader, const Port* port, const EventSerializer* serializer) const;
+    void ThrowCorruptCheckpoint() const;
 
     std::map<const InputPort*, std::set<const OutputPort*>> m_forwardPrunedDependencies;
-    std::map<const OutputPort*, std::set<const InputPort*>> m_backwardPrunedDependencies;
     std::map<std::string, std::vector<AtomicAccessor::InputHandler>> m_inputHandlers;
     std::function<void(AtomicAccessor&)> m_fireFunction;
+    std::function<void(const AtomicAccessor&, std::ostream&)> m_saveStateFunction;
+    std::function<void(AtomicAccessor&, std::istream&)> m_restoreStateFunction;
     bool m_stateDependsOnInputPort;
+    mutable bool m_dependenciesAreCompiled;
+    mutable CompiledDependencies m_compiledDependencies;
+    std::set<std::shared_ptr<PendingOffload>> m_pendingOffloads;
+    ReactionCounters m_reactionCounters;
+    CriticalPathAnalyzer* m_criticalPathAnalyzer;
+    size_t m_criticalPathIndex;
 };
 
 #endif // ATOMIC_ACCESSOR_IMPL_H
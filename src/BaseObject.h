@@ -4,6 +4,8 @@
 #ifndef BASE_OBJECT_H
 #define BASE_OBJECT_H
 
+#include "TraceRecorder.h"
+#include <atomic>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -12,7 +14,7 @@ class BaseObject
 {
 public:
     virtual ~BaseObject() = default;
-    std::string GetName() const
+    const std::string& GetName() const
     {
         return this->m_name;
     }
@@ -23,6 +25,19 @@ public:
         return parentFullName.append(".").append(this->m_name);
     }
 
+    // The full name, interned the first time it is asked for, so that tracing does not build it for every event
+    const char* GetTraceName() const
+    {
+        const char* traceName = this->m_traceName.load(std::memory_order_acquire);
+        if (traceName == nullptr)
+        {
+            traceName = TraceRecorder::InternName(this->GetFullName());
+            this->m_traceName.store(traceName, std::memory_order_release);
+        }
+
+        return traceName;
+    }
+
     static bool NameIsValid(const std::string& name)
     {
         // A name cannot be empty, cannot contain periods, and cannot contain whitespace
@@ -32,7 +47,8 @@ public:
 protected:
     explicit BaseObject(const std::string& name, BaseObject* parent = nullptr) :
         m_name(name),
-        m_parent(parent)
+        m_parent(parent),
+        m_traceName(nullptr)
     {
     }
 
@@ -66,6 +82,7 @@ protected:
 private:
     const std::string m_name;
     BaseObject* m_parent;
+    mutable std::atomic<const char*> m_traceName;
 };
 
 #endif // BASE_OBJECT_H
@@ -3,7 +3,9 @@
 
 #include "CompositeAccessorImpl.h"
 #include "AtomicAccessorImpl.h"
-#include "PrintDebug.h"
+#include "Logger.h"
+
+thread_local const CompositeAccessor::Impl::ReactionRouting* CompositeAccessor::Impl::s_reactionRouting = nullptr;
 
 CompositeAccessor::Impl::Impl(
     const std::string& name,
@@ -38,6 +40,14 @@ std::vector<Accessor::Impl*> CompositeAccessor::Impl::GetChildren() const
 
 void CompositeAccessor::Impl::ScheduleReaction(Accessor::Impl* child, int priority)
 {
+    AllocationScope allocationScope(AllocationSubsystem::Reactions);
+    const ReactionRouting* reactionRouting = s_reactionRouting;
+    if (reactionRouting != nullptr && !(child->IsComposite()) && this->GetDirector() == reactionRouting->director)
+    {
+        reactionRouting->childEventQueue->push(child);
+        return;
+    }
+
     if (priority == INT_MAX)
     {
         priority = this->GetPriority();
@@ -57,7 +67,9 @@ void CompositeAccessor::Impl::ScheduleReaction(Accessor::Impl* child, int priori
             [this]() { this->ProcessChildEventQueue(); },
             0 /*delayInMilliseconds*/,
             false /*repeat*/,
-            priority);
+            priority,
+            nullptr /*allocationCounters*/,
+            this);
     }
     else
     {
@@ -66,6 +78,14 @@ void CompositeAccessor::Impl::ScheduleReaction(Accessor::Impl* child, int priori
 }
 
 void CompositeAccessor::Impl::ProcessChildEventQueue()
+{
+    AllocationScope allocationScope(AllocationSubsystem::Reactions);
+    ProcessReactions(this->m_childEventQueue);
+    this->m_reactionRequested = false;
+    LOG_DEBUG("%s has finished reacting to all inputs", this->GetName().c_str());
+}
+
+void CompositeAccessor::Impl::TakeQueuedAtomicReactions(std::vector<Accessor::Impl*>& atomicAccessors)
 {
     while (!this->m_childEventQueue.empty())
     {
@@ -73,16 +93,13 @@ void CompositeAccessor::Impl::ProcessChildEventQueue()
         this->m_childEventQueue.pop();
         if (child->IsComposite())
         {
-            static_cast<CompositeAccessor::Impl*>(child)->ProcessChildEventQueue();
+            static_cast<CompositeAccessor::Impl*>(child)->TakeQueuedAtomicReactions(atomicAccessors);
         }
         else
         {
-            static_cast<AtomicAccessor::Impl*>(child)->ProcessInputs();
+            atomicAccessors.push_back(child);
         }
     }
-
-    this->m_reactionRequested = false;
-    PRINT_DEBUG("%s has finished reacting to all inputs", this->GetName().c_str());
 }
 
 void CompositeAccessor::Impl::ResetPriority()
@@ -140,10 +157,12 @@ void CompositeAccessor::Impl::RemoveChild(const std::string& childName)
 
 void CompositeAccessor::Impl::RemoveAllChildren()
 {
-    while (!this->m_orderedChildren.empty())
+    // Children are destroyed in the order in which they were added
+    std::vector<Accessor::Impl*> orderedChildren{};
+    orderedChildren.swap(this->m_orderedChildren);
+    for (auto child : orderedChildren)
     {
-        Accessor::Impl* child = *(this->m_orderedChildren.begin());
-        this->RemoveChild(child->GetName());
+        this->m_children.erase(child->GetName());
     }
 }
 
@@ -191,4 +210,22 @@ void CompositeAccessor::Impl::ResetChildrenPriorities() const
     {
         child->ResetPriority();
     }
+}
+
+// Reactions scheduled while the queue is being processed are processed in the same pass
+void CompositeAccessor::Impl::ProcessReactions(ChildEventQueue& childEventQueue)
+{
+    while (!childEventQueue.empty())
+    {
+        Accessor::Impl* child = childEventQueue.top();
+        childEventQueue.pop();
+        if (child->IsComposite())
+        {
+            static_cast<CompositeAccessor::Impl*>(child)->ProcessChildEventQueue();
+        }
+        else
+        {
+            static_cast<AtomicAccessor::Impl*>(child)->ProcessInputs();
+        }
+    }
 }
\ No newline at end of file
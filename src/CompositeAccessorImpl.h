@@ -13,7 +13,9 @@
 // and scheduling reactions for its children. Children's reactions are handled by storing a pointer to the child
 // requesting a reaction on a private queue and scheduling an immediate callback for invoking reactions for all children
 // on the queue. This mechanism ensures that a child can only schedule one reaction at a time and ensures that children
-// react in priority order.
+// react in priority order. While a host processes a group of reactions on a worker thread, the reactions its atomic
+// accessors request on that thread go straight to the group's queue instead, since other groups may be using the queues
+// of the composites in between.
 //
 class CompositeAccessor::Impl : public Accessor::Impl
 {
@@ -28,8 +30,9 @@ public:
     bool HasChildWithName(const std::string& childName) const;
     Accessor::Impl* GetChild(const std::string& childName) const;
     std::vector<Accessor::Impl*> GetChildren() const;
-    void ScheduleReaction(Accessor::Impl* child, int priority);
-    void ProcessChildEventQueue();
+    virtual void ScheduleReaction(Accessor::Impl* child, int priority);
+    virtual void ProcessChildEventQueue();
+    void TakeQueuedAtomicReactions(std::vector<Accessor::Impl*>& atomicAccessors); // empties this queue and those of queued composites
 
     void ResetPriority() override;
     bool IsComposite() const override;
@@ -50,12 +53,6 @@ protected:
         const std::string& destinationChildInputPortName);
     virtual void ChildrenChanged();
 
-    // Internal Methods
-    void ResetChildrenPriorities() const;
-
-private:
-    friend class CompositeAccessor;
-
     // Returns true if accessor A has lower priority (i.e. higher priority value) than accessor B, and false otherwise.
     // When used in a priority queue, elements will be sorted from highest priority (i.e. lowest priority value) to
     // lowest priority (i.e. highest priority value).
@@ -83,10 +80,28 @@ private:
         }
     };
 
+    using ChildEventQueue = unique_priority_queue<Accessor::Impl*, std::vector<Accessor::Impl*>, GreaterAccessorImplPtrs>;
+
+    // Reactions of atomic accessors under the director that are requested on the current thread go to the queue
+    struct ReactionRouting
+    {
+        const Director* director;
+        ChildEventQueue* childEventQueue;
+    };
+
+    // Internal Methods
+    void ResetChildrenPriorities() const;
+    static void ProcessReactions(ChildEventQueue& childEventQueue);
+
     bool m_reactionRequested;
+    ChildEventQueue m_childEventQueue;
+    static thread_local const ReactionRouting* s_reactionRouting;
+
+private:
+    friend class CompositeAccessor;
+
     std::map<std::string, std::unique_ptr<Accessor>> m_children;
     std::vector<Accessor::Impl*> m_orderedChildren;
-    unique_priority_queue<Accessor::Impl*, std::vector<Accessor::Impl*>, GreaterAccessorImplPtrs> m_childEventQueue;
 };
 
 #endif // COMPOSITE_ACCESSOR_IMPL_H
@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CriticalPathAnalyzer.h"
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <stdexcept>
+
+const size_t CriticalPathAnalyzer::NoPredecessor;
+
+CriticalPathAnalyzer::CriticalPathAnalyzer(size_t numberOfRecentTicks) :
+    m_tickIsOpen(false),
+    m_currentTick(0ULL),
+    m_currentLogicalTime(0LL),
+    m_finishedTick{},
+    m_recentTicks(numberOfRecentTicks),
+    m_nextRecentTick(0),
+    m_numberOfTicks(0ULL),
+    m_longestTick{}
+{
+    if (numberOfRecentTicks == 0)
+    {
+        throw std::invalid_argument("At least one recent tick must be kept");
+    }
+}
+
+void CriticalPathAnalyzer::SetModel(const std::vector<AccessorNode>& accessors)
+{
+    this->m_tickIsOpen = false;
+    this->m_accessors.clear();
+    this->m_accessors.resize(accessors.size());
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_modelNames.clear();
+        for (size_t i = 0; i < accessors.size(); ++i)
+        {
+            this->m_accessors[i].name = &(*(this->m_names.insert(accessors[i].name).first));
+            this->m_modelNames.push_back(this->m_accessors[i].name);
+        }
+
+        this->RemoveUnusedNames();
+    }
+
+    this->m_accessorsByDepth.clear();
+    for (size_t i = 0; i < accessors.size(); ++i)
+    {
+        AccessorState& accessor = this->m_accessors[i];
+        accessor.depth = accessors[i].depth;
+        accessor.upstreamAccessors = accessors[i].upstreamAccessors;
+        accessor.lastTick = 0ULL;
+        for (size_t upstreamAccessor : accessor.upstreamAccessors)
+        {
+            this->m_accessors[upstreamAccessor].downstreamAccessors.push_back(i);
+        }
+
+        this->m_accessorsByDepth.push_back(i);
+    }
+
+    std::stable_sort(
+        this->m_accessorsByDepth.begin(),
+        this->m_accessorsByDepth.end(),
+        [this](size_t a, size_t b) { return this->m_accessors[a].depth < this->m_accessors[b].depth; });
+    this->m_tailNanoseconds.assign(accessors.size(), 0LL);
+}
+
+// A tick lasts as long as the host's passes share a logical time
+void CriticalPathAnalyzer::BeginPass(long long logicalTime)
+{
+    if (this->m_tickIsOpen && logicalTime != this->m_currentLogicalTime)
+    {
+        this->FinishTick();
+    }
+
+    if (!(this->m_tickIsOpen))
+    {
+        this->m_tickIsOpen = true;
+        ++this->m_currentTick;
+        this->m_currentLogicalTime = logicalTime;
+    }
+}
+
+void CriticalPathAnalyzer::RecordReaction(size_t accessorIndex, long long nanoseconds)
+{
+    AccessorState& accessor = this->m_accessors[accessorIndex];
+    if (accessor.lastTick != this->m_currentTick)
+    {
+        accessor.lastTick = this->m_currentTick;
+        accessor.reactionNanoseconds = 0LL;
+        accessor.finishNanoseconds = 0LL;
+        accessor.predecessor = NoPredecessor;
+    }
+
+    // A later reaction of the same accessor follows its earlier ones
+    long long startNanoseconds = accessor.finishNanoseconds;
+    size_t predecessor = accessor.predecessor;
+    for (size_t upstreamAccessor : accessor.upstreamAccessors)
+    {
+        const AccessorState& upstream = this->m_accessors[upstreamAccessor];
+        if (upstream.lastTick == this->m_currentTick && upstream.finishNanoseconds > startNanoseconds)
+        {
+            startNanoseconds = upstream.finishNanoseconds;
+            predecessor = upstreamAccessor;
+        }
+    }
+
+    accessor.reactionNanoseconds += nanoseconds;
+    accessor.finishNanoseconds = startNanoseconds + nanoseconds;
+    accessor.predecessor = predecessor;
+}
+
+void CriticalPathAnalyzer::FinishTick()
+{
+    if (!(this->m_tickIsOpen))
+    {
+        return;
+    }
+
+    this->m_tickIsOpen = false;
+    Tick& tick = this->m_finishedTick;
+    tick.logicalTime = this->m_currentLogicalTime;
+    tick.totalReactionNanoseconds = 0LL;
+    size_t lastAccessor = NoPredecessor;
+    for (size_t i = 0; i < this->m_accessors.size(); ++i)
+    {
+        const AccessorState& accessor = this->m_accessors[i];
+        if (accessor.lastTick == this->m_currentTick)
+        {
+            tick.totalReactionNanoseconds += accessor.reactionNanoseconds;
+            if (lastAccessor == NoPredecessor || accessor.finishNanoseconds > this->m_accessors[lastAccessor].finishNanoseconds)
+            {
+                lastAccessor = i;
+            }
+        }
+    }
+
+    if (lastAccessor == NoPredecessor)
+    {
+        return;
+    }
+
+    // The chain is bounded by the number of accessors in case a causality loop made it circular
+    tick.criticalPathNanoseconds = this->m_accessors[lastAccessor].finishNanoseconds;
+    tick.criticalPath.clear();
+    for (size_t i = lastAccessor; i != NoPredecessor && tick.criticalPath.size() < this->m_accessors.size(); i = this->m_accessors[i].predecessor)
+    {
+        tick.criticalPath.push_back(this->m_accessors[i].name);
+    }
+
+    std::reverse(tick.criticalPath.begin(), tick.criticalPath.end());
+    for (auto it = this->m_accessorsByDepth.rbegin(); it != this->m_accessorsByDepth.rend(); ++it)
+    {
+        long long tailNanoseconds = 0LL;
+        for (size_t downstreamAccessor : this->m_accessors[*it].downstreamAccessors)
+        {
+            const AccessorState& downstream = this->m_accessors[downstreamAccessor];
+            if (downstream.lastTick == this->m_currentTick)
+            {
+                tailNanoseconds = std::max(tailNanoseconds, downstream.reactionNanoseconds + this->m_tailNanoseconds[downstreamAccessor]);
+            }
+        }
+
+        this->m_tailNanoseconds[*it] = tailNanoseconds;
+    }
+
+    tick.levels.clear();
+    for (size_t i : this->m_accessorsByDepth)
+    {
+        const AccessorState& accessor = this->m_accessors[i];
+        if (accessor.lastTick != this->m_currentTick)
+        {
+            continue;
+        }
+
+        if (tick.levels.empty() || tick.levels.back().depth != accessor.depth)
+        {
+            tick.levels.push_back({ accessor.depth, 0, 0LL, LLONG_MAX });
+        }
+
+        Level& level = tick.levels.back();
+        long long slackNanoseconds = tick.criticalPathNanoseconds - (accessor.finishNanoseconds + this->m_tailNanoseconds[i]);
+        ++level.numberOfAccessors;
+        level.maxReactionNanoseconds = std::max(level.maxReactionNanoseconds, accessor.reactionNanoseconds);
+        level.slackNanoseconds = std::max(0LL, std::min(level.slackNanoseconds, slackNanoseconds));
+    }
+
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    ++this->m_numberOfTicks;
+    this->m_recentTicks[this->m_nextRecentTick] = tick;
+    this->m_nextRecentTick = (this->m_nextRecentTick + 1) % this->m_recentTicks.size();
+    if (this->m_numberOfTicks == 1ULL || tick.criticalPathNanoseconds > this->m_longestTick.criticalPathNanoseconds)
+    {
+        this->m_longestTick = tick;
+    }
+
+    for (size_t i = lastAccessor, j = 0; i != NoPredecessor && j < tick.criticalPath.size(); i = this->m_accessors[i].predecessor, ++j)
+    {
+        AccessorTotals& totals = this->m_accessorTotals[this->m_accessors[i].name];
+        ++totals.numberOfTicksOnCriticalPath;
+        totals.totalNanosecondsOnCriticalPath += this->m_accessors[i].reactionNanoseconds;
+    }
+}
+
+Host::CriticalPathReport CriticalPathAnalyzer::GetReport() const
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    Host::CriticalPathReport report{};
+    report.numberOfTicks = this->m_numberOfTicks;
+    if (this->m_numberOfTicks == 0ULL)
+    {
+        return report;
+    }
+
+    report.longestTick = GetTickReport(this->m_longestTick);
+    size_t numberOfRecentTicks = static_cast<size_t>(std::min<unsigned long long>(this->m_numberOfTicks, this->m_recentTicks.size()));
+    size_t firstRecentTick = (numberOfRecentTicks < this->m_recentTicks.size() ? 0 : this->m_nextRecentTick);
+    report.recentTicks.reserve(numberOfRecentTicks);
+    for (size_t i = 0; i < numberOfRecentTicks; ++i)
+    {
+        report.recentTicks.push_back(GetTickReport(this->m_recentTicks[(firstRecentTick + i) % this->m_recentTicks.size()]));
+    }
+
+    report.accessors.reserve(this->m_accessorTotals.size());
+    for (const auto& entry : this->m_accessorTotals)
+    {
+        report.accessors.push_back({ *(entry.first), entry.second.numberOfTicksOnCriticalPath, std::chrono::nanoseconds(entry.second.totalNanosecondsOnCriticalPath) });
+    }
+
+    std::sort(
+        report.accessors.begin(),
+        report.accessors.end(),
+        [](const Host::CriticalPathAccessor& a, const Host::CriticalPathAccessor& b)
+        {
+            return (a.numberOfTicksOnCriticalPath > b.numberOfTicksOnCriticalPath ||
+                (a.numberOfTicksOnCriticalPath == b.numberOfTicksOnCriticalPath && a.totalTimeOnCriticalPath > b.totalTimeOnCriticalPath));
+        });
+    return report;
+}
+
+void CriticalPathAnalyzer::Reset()
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    std::fill(this->m_recentTicks.begin(), this->m_recentTicks.end(), Tick{});
+    this->m_nextRecentTick = 0;
+    this->m_numberOfTicks = 0ULL;
+    this->m_longestTick = Tick{};
+    this->m_accessorTotals.clear();
+    this->RemoveUnusedNames();
+}
+
+void CriticalPathAnalyzer::RemoveUnusedNames()
+{
+    std::set<const std::string*> usedNames(this->m_modelNames.begin(), this->m_modelNames.end());
+    auto addTickNames = [&usedNames](const Tick& tick) { usedNames.insert(tick.criticalPath.begin(), tick.criticalPath.end()); };
+    std::for_each(this->m_recentTicks.begin(), this->m_recentTicks.end(), addTickNames);
+    addTickNames(this->m_longestTick);
+    for (const auto& entry : this->m_accessorTotals)
+    {
+        usedNames.insert(entry.first);
+    }
+
+    for (auto it = this->m_names.begin(); it != this->m_names.end();)
+    {
+        it = (usedNames.count(&(*it)) == 0 ? this->m_names.erase(it) : std::next(it));
+    }
+}
+
+Host::CriticalPathTick CriticalPathAnalyzer::GetTickReport(const Tick& tick)
+{
+    Host::CriticalPathTick tickReport{};
+    tickReport.logicalTime = tick.logicalTime;
+    tickReport.totalReactionTime = std::chrono::nanoseconds(tick.totalReactionNanoseconds);
+    tickReport.criticalPathTime = std::chrono::nanoseconds(tick.criticalPathNanoseconds);
+    tickReport.criticalPath.reserve(tick.criticalPath.size());
+    for (const std::string* name : tick.criticalPath)
+    {
+        tickReport.criticalPath.push_back(*name);
+    }
+
+    tickReport.levels.reserve(tick.levels.size());
+    for (const Level& level : tick.levels)
+    {
+        tickReport.levels.push_back({ level.depth, level.numberOfAccessors, std::chrono::nanoseconds(level.maxReactionNanoseconds), std::chrono::nanoseconds(level.slackNanoseconds) });
+    }
+
+    return tickReport;
+}
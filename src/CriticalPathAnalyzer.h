@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef CRITICAL_PATH_ANALYZER_H
+#define CRITICAL_PATH_ANALYZER_H
+
+#include "AccessorFramework/Host.h"
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Description
+// A CriticalPathAnalyzer finds, for each logical time step (tick) of a host, the longest chain of dependent reactions
+// and the slack at each depth of the model. Every reaction of an atomic accessor is timed and recorded as soon as it
+// finishes: its chain is the longest one finishing with a reaction, earlier in the same tick, of an atomic accessor
+// connected to one of its input ports (or with its own previous reaction in the tick), plus its own time. Reactions
+// are processed in priority order, so each chain is complete when it is extended. When the tick ends, the longest chain
+// is the critical path, and a pass over the accessors in reverse depth order finds the longest chain through each one;
+// the slack of an accessor is how much shorter that chain is than the critical path, and the slack of a depth is the
+// least slack of the accessors at that depth that reacted.
+//
+// Reactions are recorded by the threads processing them, each of which only touches the state of accessors in its own
+// reaction group (which includes every accessor connected to them). Passes and ticks are begun and finished by the
+// thread executing the host's round. The most recent ticks are kept in a ring, and along with the longest tick and the
+// totals for each accessor on a critical path, they can be read and reset from any thread. Accessor names are interned
+// so that ticks outlive changes to the model; a name is dropped once neither the model nor any kept tick or total
+// refers to it, which happens when the model is changed and when the analysis is reset.
+//
+class CriticalPathAnalyzer
+{
+public:
+    struct AccessorNode
+    {
+        std::string name; // full name
+        int depth;
+        std::vector<size_t> upstreamAccessors; // indices of the atomic accessors connected to its input ports
+    };
+
+    explicit CriticalPathAnalyzer(size_t numberOfRecentTicks);
+    void SetModel(const std::vector<AccessorNode>& accessors); // discards the tick in progress
+    void BeginPass(long long logicalTime);
+    void RecordReaction(size_t accessorIndex, long long nanoseconds);
+    void FinishTick();
+    Host::CriticalPathReport GetReport() const;
+    void Reset();
+
+private:
+    static const size_t NoPredecessor = SIZE_MAX;
+
+    struct AccessorState
+    {
+        const std::string* name; // interned, so that finished ticks outlive changes to the model
+        int depth;
+        std::vector<size_t> upstreamAccessors;
+        std::vector<size_t> downstreamAccessors;
+        unsigned long long lastTick; // in which the accessor reacted
+        long long reactionNanoseconds; // over the last tick
+        long long finishNanoseconds; // length of the longest chain ending with its last reaction
+        size_t predecessor; // on that chain
+    };
+
+    struct Level
+    {
+        int depth;
+        size_t numberOfAccessors;
+        long long maxReactionNanoseconds;
+        long long slackNanoseconds;
+    };
+
+    struct Tick
+    {
+        long long logicalTime;
+        long long totalReactionNanoseconds;
+        long long criticalPathNanoseconds;
+        std::vector<const std::string*> criticalPath;
+        std::vector<Level> levels;
+    };
+
+    struct AccessorTotals
+    {
+        unsigned long long numberOfTicksOnCriticalPath;
+        long long totalNanosecondsOnCriticalPath;
+    };
+
+    static Host::CriticalPathTick GetTickReport(const Tick& tick);
+    void RemoveUnusedNames(); // must be called with m_mutex held
+
+    // Only touched by the threads processing the host's round
+    std::vector<AccessorState> m_accessors;
+    std::vector<size_t> m_accessorsByDepth;
+    std::vector<long long> m_tailNanoseconds; // longest chain downstream of each accessor in the tick being finished
+    bool m_tickIsOpen;
+    unsigned long long m_currentTick;
+    long long m_currentLogicalTime;
+    Tick m_finishedTick;
+
+    mutable std::mutex m_mutex;
+    std::set<std::string> m_names;
+    std::vector<const std::string*> m_modelNames; // of the accessors in m_accessors
+    std::vector<Tick> m_recentTicks;
+    size_t m_nextRecentTick;
+    unsigned long long m_numberOfTicks;
+    Tick m_longestTick;
+    std::unordered_map<const std::string*, AccessorTotals> m_accessorTotals;
+};
+
+#endif // CRITICAL_PATH_ANALYZER_H
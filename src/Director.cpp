@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "Director.h"
-#include "PrintDebug.h"
+#include "BaseObject.h"
+#include "ExecutionFingerprint.h"
+#include "Logger.h"
+#include "ThreadExecutor.h"
+#include "TraceRecorder.h"
 #include <algorithm>
 #include <cassert>
 #include <ctime>
@@ -11,13 +15,26 @@
 
 static const long long DefaultNextExecutionTime = LLONG_MAX;
 
+thread_local Director::DeferredOperations* Director::s_deferredOperations = nullptr;
+
 Director::Director() :
     m_nextCallbackId(0),
+    m_nextSequenceNumber(0ULL),
     m_currentLogicalTime(PosixUtcInMilliseconds()),
     m_startTime(this->m_currentLogicalTime),
     m_nextScheduledExecutionTime(DefaultNextExecutionTime),
     m_executionResult(nullptr),
-    m_executionCancellationToken(nullptr)
+    m_executionTask(nullptr),
+    m_stoppedExecutionTask(nullptr),
+    m_executor(ThreadExecutor::GetDefault()),
+    m_exceptionHandler(nullptr),
+    m_roundStartHandler(nullptr),
+    m_fingerprint(nullptr),
+    m_isStarted(false),
+    m_isPolled(false),
+    m_isWakeRequested(false),
+    m_isWaking(false),
+    m_isWakeRoundDue(false)
 {
 }
 
@@ -30,25 +47,76 @@ int Director::ScheduleCallback(
     std::function<void()> callback,
     int delayInMilliseconds,
     bool isPeriodic,
-    int priority)
+    int priority,
+    AllocationCounters* allocationCounters,
+    const BaseObject* owner)
 {
-    ScheduledCallback newCallback{ callback, delayInMilliseconds, isPeriodic, priority };
-    newCallback.nextExecutionTimeInMilliseconds = this->m_currentLogicalTime + delayInMilliseconds;
+    AllocationScope allocationScope(AllocationSubsystem::Director);
+    ScheduledCallback newCallback{ callback, delayInMilliseconds, isPeriodic, priority, 0, allocationCounters, owner };
     int newCallbackId = this->m_nextCallbackId++;
-    this->m_scheduledCallbacks[newCallbackId] = newCallback;
-    this->QueueScheduledCallback(newCallbackId);
-    if (this->m_nextScheduledExecutionTime > newCallback.nextExecutionTimeInMilliseconds)
+    DeferredOperations* deferredOperations = s_deferredOperations;
+    if (deferredOperations != nullptr && deferredOperations->m_director == this)
     {
-        this->StopExecution();
-        this->m_nextScheduledExecutionTime = newCallback.nextExecutionTimeInMilliseconds;
-        this->ScheduleNextExecution();
+        deferredOperations->m_operations.push_back({ newCallbackId, false /*isClear*/, std::move(newCallback) });
+    }
+    else
+    {
+        this->AddScheduledCallback(newCallbackId, std::move(newCallback));
     }
 
     return newCallbackId;
 }
+
+void Director::PostCallback(std::function<void()> callback, int priority)
+{
+    std::unique_lock<std::mutex> lock(this->m_postMutex);
+    this->m_postedCallbacks.push_back({ std::move(callback), priority });
+    this->WakeWaitingRound(lock);
+}
+
+// Posted callbacks and wake requests are picked up together, so a wake request adds nothing while one is waiting
+void Director::Wake()
+{
+    std::unique_lock<std::mutex> lock(this->m_postMutex);
+    this->m_isWakeRequested = true;
+    this->WakeWaitingRound(lock);
+}
+
+// A waiting round is woken by handing it to the executor a second time, so that whichever of its two tasks runs first
+// claims it and the other does nothing. A round that has already been claimed picks up the posted callback or wake
+// request either when it starts or when it schedules the next round.
+void Director::WakeWaitingRound(std::unique_lock<std::mutex>& postLock)
+{
+    if (this->m_isWaking || !(this->m_isStarted.load()) || this->m_executionTask.get() == nullptr)
+    {
+        return;
+    }
+
+    this->m_isWaking = true;
+    std::shared_ptr<ExecutionTask> executionTask = this->m_executionTask;
+    std::shared_ptr<Executor> executor = this->m_executor;
+    postLock.unlock();
+    executor->Execute(
+        [this, executionTask, executor]()
+        {
+            if (executionTask->Begin())
+            {
+                executor->Cancel(executionTask->executorTaskId.load());
+                this->ExecuteInternal(executionTask);
+            }
+        });
+}
  
 void Director::ClearScheduledCallback(int callbackId)
 {
+    AllocationScope allocationScope(AllocationSubsystem::Director);
+    DeferredOperations* deferredOperations = s_deferredOperations;
+    if (deferredOperations != nullptr && deferredOperations->m_director == this)
+    {
+        deferredOperations->m_operations.push_back({ callbackId, true /*isClear*/, ScheduledCallback{} });
+        return;
+    }
+
     for (auto it = this->m_callbackQueue.begin(); it != this->m_callbackQueue.end(); ++it)
     {
         if (*it == callbackId)
@@ -65,6 +133,37 @@ void Director::ClearScheduledCallback(int callbackId)
     }
 }
 
+bool Director::GetCallbackTiming(int callbackId, CallbackTiming& timing) const
+{
+    auto it = this->m_scheduledCallbacks.find(callbackId);
+    if (it == this->m_scheduledCallbacks.end())
+    {
+        return false;
+    }
+
+    timing = CallbackTiming{ it->second.nextExecutionTimeInMilliseconds - this->m_currentLogicalTime, it->second.delayInMilliseconds, it->second.isPeriodic };
+    return true;
+}
+
+// The callback is queued again at its new time, and the next round is rescheduled in case the earliest time changed
+void Director::SetCallbackTiming(int callbackId, const CallbackTiming& timing)
+{
+    ScheduledCallback& callback = this->m_scheduledCallbacks.at(callbackId);
+    callback.delayInMilliseconds = timing.periodInMilliseconds;
+    callback.isPeriodic = timing.isPeriodic;
+    callback.nextExecutionTimeInMilliseconds = this->m_currentLogicalTime + timing.delayInMilliseconds;
+    auto queuedCallback = std::find(this->m_callbackQueue.begin(), this->m_callbackQueue.end(), callbackId);
+    if (queuedCallback != this->m_callbackQueue.end())
+    {
+        this->m_callbackQueue.erase(queuedCallback);
+    }
+
+    this->QueueScheduledCallback(callbackId);
+    this->StopExecution();
+    this->m_nextScheduledExecutionTime = this->GetNextQueuedExecutionTime();
+    this->ScheduleNextExecution();
+}
+
 void Director::HandlePriorityUpdate(int oldPriority, int newPriority)
 {
     for (auto& i : this->m_scheduledCallbacks)
@@ -85,21 +184,49 @@ void Director::HandlePriorityUpdate(int oldPriority, int newPriority)
     }
 }
 
+// Rounds that have already been scheduled still run on the previous executor
+void Director::SetExecutor(std::shared_ptr<Executor> executor)
+{
+    std::lock_guard<std::mutex> lock(this->m_postMutex);
+    this->m_executor = (executor != nullptr ? std::move(executor) : ThreadExecutor::GetDefault());
+}
+
+std::shared_ptr<Executor> Director::GetExecutor() const
+{
+    std::lock_guard<std::mutex> lock(this->m_postMutex);
+    return this->m_executor;
+}
+
+// Starts executing rounds on the executor without blocking. Exceptions thrown by callbacks are passed to the handler
+// on the thread that executed the round, after which execution stops.
+void Director::Start(std::function<void(std::exception_ptr)> exceptionHandler)
+{
+    this->WaitForExecutionToStop();
+    this->UseExecutor();
+    this->m_exceptionHandler = std::move(exceptionHandler);
+    if (this->m_executionTask.get() == nullptr || this->m_executionTask->cancellationToken->IsCanceled())
+    {
+        this->ScheduleNextExecution();
+    }
+}
+
 void Director::Execute(int numberOfIterations)
 {
-    if (this->m_executionCancellationToken.get() == nullptr || this->m_executionCancellationToken->IsCanceled())
+    this->UseExecutor();
+    this->m_exceptionHandler = nullptr;
+    if (this->m_executionTask.get() == nullptr || this->m_executionTask->cancellationToken->IsCanceled())
     {
         this->ScheduleNextExecution();
     }
 
     auto executionResult = this->m_executionResult;
     int currentIteration = 0;
-    while (this->m_executionCancellationToken != nullptr &&
-        !this->m_executionCancellationToken->IsCanceled() &&
+    while (this->m_executionTask != nullptr &&
+        !this->m_executionTask->cancellationToken->IsCanceled() &&
         executionResult->valid() &&
         (numberOfIterations == 0 || currentIteration < numberOfIterations))
     {
-        PRINT_DEBUG("-----NEXT ROUND-----");
+        LOG_DEBUG("-----NEXT ROUND-----");
         bool wasCanceled = executionResult->get();
         if (wasCanceled && this->m_executionResult.get() == nullptr)
         {
@@ -116,15 +243,112 @@ void Director::Execute(int numberOfIterations)
     }
 
     this->StopExecution();
+    this->m_isStarted = false;
 }
 
 void Director::StopExecution()
 {
-    if (this->m_executionCancellationToken.get() != nullptr)
+    if (this->m_executionTask.get() != nullptr)
+    {
+        this->m_executionTask->Cancel();
+
+        // A round still waiting out its delay is withdrawn from executors that support it, rather than left to run idle
+        this->m_executor->Cancel(this->m_executionTask->executorTaskId.load());
+        std::lock_guard<std::mutex> lock(this->m_postMutex);
+        this->m_stoppedExecutionTask = std::move(this->m_executionTask);
+    }
+}
+
+// Waits for a round that was running when execution was stopped. A round that stops execution from one of its own
+// callbacks does not wait for itself.
+void Director::WaitForExecutionToStop()
+{
+    auto stoppedExecutionTask = this->m_stoppedExecutionTask;
+    if (stoppedExecutionTask.get() != nullptr)
+    {
+        stoppedExecutionTask->WaitUntilFinished();
+    }
+}
+
+// Executes every round that is due at or before the given time on the calling thread, then returns the time at which the
+// next round is due (LLONG_MAX if nothing is scheduled). The first call stops any execution on the executor.
+long long Director::Poll(long long currentTimeInMilliseconds)
+{
+    if (!(this->m_isPolled))
+    {
+        this->StopExecution();
+        this->WaitForExecutionToStop();
+        this->m_isStarted = false;
+        this->m_isPolled = true;
+    }
+
+    this->SchedulePostedCallbacks(currentTimeInMilliseconds);
+
+    while (!this->NeedsReset() && this->m_nextScheduledExecutionTime <= currentTimeInMilliseconds)
+    {
+        this->ExecuteCallbacks();
+        this->m_nextScheduledExecutionTime = this->GetNextQueuedExecutionTime();
+    }
+
+    if (this->NeedsReset())
+    {
+        this->Reset();
+    }
+
+    return this->m_nextScheduledExecutionTime;
+}
+
+bool Director::IsPolled() const
+{
+    return this->m_isPolled;
+}
+
+long long Director::GetCurrentLogicalTime() const
+{
+    return this->m_currentLogicalTime;
+}
+
+void Director::SetRoundStartHandler(std::function<void()> handler)
+{
+    this->m_roundStartHandler = std::move(handler);
+}
+
+void Director::SetFingerprint(ExecutionFingerprint* fingerprint)
+{
+    this->m_fingerprint = fingerprint;
+}
+
+AllocationAccount& Director::GetAllocationAccount()
+{
+    return this->m_allocationAccount;
+}
+
+// New callbacks are added before any callbacks are cleared. A callback can only be cleared after it has been scheduled,
+// and adding first keeps the queue from emptying (and the Director from resetting) partway through.
+void Director::ApplyDeferredOperations(DeferredOperations& deferredOperations)
+{
+    for (auto& operation : deferredOperations.m_operations)
+    {
+        if (!operation.isClear)
+        {
+            this->AddScheduledCallback(operation.callbackId, std::move(operation.callback));
+        }
+    }
+
+    for (const auto& operation : deferredOperations.m_operations)
     {
-        this->m_executionCancellationToken->Cancel();
-        this->m_executionCancellationToken = nullptr;
+        if (operation.isClear)
+        {
+            this->ClearScheduledCallback(operation.callbackId);
+        }
     }
+
+    deferredOperations.m_operations.clear();
+}
+
+void Director::DeferOperationsOnCurrentThread(DeferredOperations* deferredOperations)
+{
+    s_deferredOperations = deferredOperations;
 }
 
 long long Director::GetNextQueuedExecutionTime() const
@@ -139,50 +363,46 @@ long long Director::GetNextQueuedExecutionTime() const
     }
 }
 
+// Callbacks that were posted before the round was created are due right away
 void Director::ScheduleNextExecution()
 {
     long long executionDelayInMilliseconds = std::max<long long>(this->m_nextScheduledExecutionTime - PosixUtcInMilliseconds(), 0LL);
-    this->m_executionCancellationToken = std::make_shared<CancellationToken>();
-    auto executionPromise = std::make_unique<std::promise<bool>>();
-    this->m_executionResult = std::make_shared<std::future<bool>>(executionPromise->get_future());
+    auto executionTask = std::make_shared<ExecutionTask>();
+    bool hasPostedCallbacks = false;
+    {
+        std::lock_guard<std::mutex> lock(this->m_postMutex);
+        this->m_executionTask = executionTask;
+        hasPostedCallbacks = (!(this->m_postedCallbacks.empty()) || this->m_isWakeRequested);
+        this->m_isWaking = (hasPostedCallbacks && this->m_isStarted.load());
+    }
 
-    bool retry = false;
-    do
+    this->m_executionResult = std::make_shared<std::future<bool>>(executionTask->GetResult());
+    if (hasPostedCallbacks)
     {
-        retry = false;
-        try
-        {
-            std::thread executionThread(
-                &Director::ExecuteInternal,
-                this,
-                executionDelayInMilliseconds,
-                std::move(executionPromise),
-                this->m_executionCancellationToken);
-
-            executionThread.detach();
-        }
-        catch (const std::system_error& e)
-        {
-            if (e.code() == std::errc::resource_unavailable_try_again)
-            {
-                retry = true;
-            }
-            else
-            {
-                throw;
-            }
-        }
-    } while (retry);
-}
+        executionDelayInMilliseconds = 0LL;
+    }
 
-void Director::ExecuteInternal(long long executionDelayInMilliseconds, std::unique_ptr<std::promise<bool>> executionPromise, std::shared_ptr<CancellationToken> cancellationToken)
-{
-    if (executionDelayInMilliseconds != 0LL)
+    // With nothing scheduled, or until the Director is started, the round only needs to exist so that it can be canceled
+    if ((this->m_nextScheduledExecutionTime != DefaultNextExecutionTime || hasPostedCallbacks) && this->m_isStarted.load())
     {
-        auto executionDelay = std::chrono::milliseconds(executionDelayInMilliseconds);
-        cancellationToken->SleepFor(executionDelay);
+        unsigned long long executorTaskId = this->m_executor->ExecuteCancelableAfter(
+            executionDelayInMilliseconds,
+            [this, executionTask]()
+            {
+                if (executionTask->Begin())
+                {
+                    this->ExecuteInternal(executionTask);
+                }
+            });
+
+        executionTask->executorTaskId.store(executorTaskId);
     }
+}
 
+void Director::ExecuteInternal(const std::shared_ptr<ExecutionTask>& executionTask)
+{
+    const auto& cancellationToken = executionTask->cancellationToken;
+    this->SchedulePostedCallbacks(PosixUtcInMilliseconds());
     while (!cancellationToken->IsCanceled() && !this->NeedsReset() && this->m_nextScheduledExecutionTime <= PosixUtcInMilliseconds())
     {
         try
@@ -191,7 +411,15 @@ void Director::ExecuteInternal(long long executionDelayInMilliseconds, std::uniq
         }
         catch (...)
         {
-            executionPromise->set_exception(std::current_exception());
+            // The handler runs before the round finishes so that nothing waiting on the round can destroy the Director
+            // while the handler is still running
+            std::exception_ptr exception = std::current_exception();
+            if (this->m_exceptionHandler)
+            {
+                this->m_exceptionHandler(exception);
+            }
+
+            executionTask->Fail(exception);
             return;
         }
 
@@ -212,7 +440,50 @@ void Director::ExecuteInternal(long long executionDelayInMilliseconds, std::uniq
         this->ScheduleNextExecution();
     }
 
-    executionPromise->set_value(executionWasCanceled);
+    executionTask->Finish(executionWasCanceled);
+}
+
+// The round created before the Director was started, or while it was polled, was never handed to the executor, so it is
+// canceled to make way for one that is
+void Director::UseExecutor()
+{
+    if (!(this->m_isStarted))
+    {
+        this->StopExecution();
+        this->m_isPolled = false;
+        this->m_isStarted = true;
+    }
+}
+
+// Posted callbacks are due at the given time, or at the current logical time if that is later. The next round is moved
+// up to that time first, so that scheduling them does not stop the round that is executing. A wake request moves the
+// next round up in the same way, with no callback of its own.
+void Director::SchedulePostedCallbacks(long long currentTimeInMilliseconds)
+{
+    std::vector<PostedCallback> postedCallbacks{};
+    bool isWakeRequested = false;
+    {
+        std::lock_guard<std::mutex> lock(this->m_postMutex);
+        postedCallbacks.swap(this->m_postedCallbacks);
+        isWakeRequested = this->m_isWakeRequested;
+        this->m_isWakeRequested = false;
+        this->m_isWaking = false;
+    }
+
+    if (postedCallbacks.empty() && !isWakeRequested)
+    {
+        return;
+    }
+
+    this->m_isWakeRoundDue = (this->m_isWakeRoundDue || isWakeRequested);
+
+    long long delayInMilliseconds = std::min<long long>(std::max<long long>(currentTimeInMilliseconds - this->m_currentLogicalTime, 0LL), INT_MAX);
+    this->m_nextScheduledExecutionTime = std::min(this->m_nextScheduledExecutionTime, this->m_currentLogicalTime + delayInMilliseconds);
+    for (auto& postedCallback : postedCallbacks)
+    {
+        ScheduledCallback newCallback{ std::move(postedCallback.callback), static_cast<int>(delayInMilliseconds), false, postedCallback.priority, 0, nullptr };
+        this->AddScheduledCallback(this->m_nextCallbackId++, std::move(newCallback));
+    }
 }
 
 bool Director::ScheduledCallbackExistsInMap(int scheduledCallbackId) const
@@ -225,7 +496,23 @@ void Director::RemoveScheduledCallbackFromMap(int scheduledCallbackId)
     this->m_scheduledCallbacks.erase(scheduledCallbackId);
 }
 
-// Callbacks are sorted by execution time, then by accessor priority, then by callback ID (i.e. instantiation order)
+void Director::AddScheduledCallback(int newCallbackId, ScheduledCallback newCallback)
+{
+    newCallback.nextExecutionTimeInMilliseconds = this->m_currentLogicalTime + newCallback.delayInMilliseconds;
+    newCallback.sequenceNumber = this->m_nextSequenceNumber++;
+    long long nextExecutionTimeInMilliseconds = newCallback.nextExecutionTimeInMilliseconds;
+    this->m_scheduledCallbacks[newCallbackId] = std::move(newCallback);
+    this->QueueScheduledCallback(newCallbackId);
+    if (this->m_nextScheduledExecutionTime > nextExecutionTimeInMilliseconds)
+    {
+        this->StopExecution();
+        this->m_nextScheduledExecutionTime = nextExecutionTimeInMilliseconds;
+        this->ScheduleNextExecution();
+    }
+}
+
+// Callbacks are sorted by execution time, then by accessor priority, then by sequence number (i.e. the order they were
+// queued in)
 void Director::QueueScheduledCallback(int newCallbackId)
 {
     if (this->m_callbackQueue.empty())
@@ -270,15 +557,15 @@ void Director::QueueScheduledCallback(int newCallbackId)
             else
             {
                 // Priorities are equal
-                // Sort Level 3: Callback ID
-                if (newCallbackId < queuedCallbackId)
+                // Sort Level 3: Sequence Number
+                if (this->m_scheduledCallbacks.at(newCallbackId).sequenceNumber < this->m_scheduledCallbacks.at(queuedCallbackId).sequenceNumber)
                 {
-                    // new callback's ID is lower than queued callback's ID
+                    // new callback was added before queued callback
                     break;
                 }
-                else if (newCallbackId > queuedCallbackId)
+                else if (this->m_scheduledCallbacks.at(newCallbackId).sequenceNumber > this->m_scheduledCallbacks.at(queuedCallbackId).sequenceNumber)
                 {
-                    // new callback's ID is higher than queued callback's ID
+                    // new callback was added after queued callback
                     ++insertionIndex;
                 }
                 else
@@ -298,15 +585,50 @@ void Director::QueueScheduledCallback(int newCallbackId)
 
 void Director::ExecuteCallbacks()
 {
+    AllocationScope roundAllocationScope(&(this->m_allocationAccount), AllocationSubsystem::Director);
     this->m_currentLogicalTime = this->m_nextScheduledExecutionTime;
-    PRINT_DEBUG("Current logical time is t + %lld ms", this->m_currentLogicalTime - this->m_startTime);
+    this->m_isWakeRoundDue = false;
+    LOG_DEBUG("Current logical time is t + %lld ms", this->m_currentLogicalTime - this->m_startTime);
+    TraceRecorder::Scope roundTraceScope{};
+    if (TraceRecorder::IsRecording())
+    {
+        // The gap between wall time and logical time is how late the round started
+        roundTraceScope.Begin("director", "Round");
+        roundTraceScope.SetLogicalTime(this->m_currentLogicalTime - this->m_startTime, PosixUtcInMilliseconds() - this->m_currentLogicalTime);
+    }
+
+    ExecutionFingerprint* fingerprint = this->m_fingerprint;
+    if (fingerprint != nullptr)
+    {
+        fingerprint->BeginTick(this->m_currentLogicalTime, this->m_currentLogicalTime - this->m_startTime);
+    }
+
+    if (this->m_roundStartHandler != nullptr)
+    {
+        this->m_roundStartHandler();
+    }
+
     while (!this->m_callbackQueue.empty() && this->GetNextQueuedExecutionTime() <= this->m_nextScheduledExecutionTime)
     {
         int callbackId = this->m_callbackQueue.front();
         this->m_callbackQueue.erase(this->m_callbackQueue.begin());
         try
         {
-            this->m_scheduledCallbacks.at(callbackId).callbackFunction();
+            ScheduledCallback& callback = this->m_scheduledCallbacks.at(callbackId);
+            TraceRecorder::Scope callbackTraceScope{};
+            if (TraceRecorder::IsRecording())
+            {
+                // Callbacks are named after the accessor that scheduled them; posted callbacks have no owner
+                callbackTraceScope.Begin("callback", callback.owner != nullptr ? callback.owner->GetTraceName() : "Posted callback");
+            }
+
+            if (fingerprint != nullptr)
+            {
+                fingerprint->AddCallback(callback.priority);
+            }
+
+            AllocationScope callbackAllocationScope(callback.allocationCounters);
+            callback.callbackFunction();
         }
         catch (const std::exception& e)
         {
@@ -330,11 +652,17 @@ void Director::ExecuteCallbacks()
             }
         }
     }
+
+    if (fingerprint != nullptr)
+    {
+        fingerprint->FinishTick();
+    }
 }
 
+// A round that is due because the Director was woken runs even with no callbacks to execute
 bool Director::NeedsReset() const
 {
-    return (this->m_callbackQueue.empty() || this->m_scheduledCallbacks.empty());
+    return (!(this->m_isWakeRoundDue) && (this->m_callbackQueue.empty() || this->m_scheduledCallbacks.empty()));
 }
 
 void Director::Reset()
@@ -343,12 +671,74 @@ void Director::Reset()
     this->m_callbackQueue.clear();
     this->m_scheduledCallbacks.clear();
     this->m_nextCallbackId = 0;
+    this->m_nextSequenceNumber = 0ULL;
     this->m_currentLogicalTime = PosixUtcInMilliseconds();
     this->m_startTime = this->m_currentLogicalTime;
-    PRINT_DEBUG("Resetting current logical time to 0");
+    LOG_DEBUG("Resetting current logical time to 0");
     this->m_nextScheduledExecutionTime = DefaultNextExecutionTime;
 }
 
+Director::ExecutionTask::ExecutionTask() :
+    cancellationToken(std::make_shared<CancellationToken>()),
+    executorTaskId(0ULL),
+    m_claimed(false),
+    m_isFinished(false)
+{
+}
+
+std::future<bool> Director::ExecutionTask::GetResult()
+{
+    return this->m_result.get_future();
+}
+
+// Claims the round for the current thread, which must then finish it
+bool Director::ExecutionTask::Begin()
+{
+    if (this->m_claimed.exchange(true))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_executingThread = std::this_thread::get_id();
+    return true;
+}
+
+// A round that has not begun is finished on the spot; a round that is running finishes once it notices the cancellation
+void Director::ExecutionTask::Cancel()
+{
+    this->cancellationToken->Cancel();
+    if (!(this->m_claimed.exchange(true)))
+    {
+        this->Finish(true /*wasCanceled*/);
+    }
+}
+
+void Director::ExecutionTask::Finish(bool wasCanceled)
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_result.set_value(wasCanceled);
+    this->m_isFinished = true;
+    this->m_finished.notify_all();
+}
+
+void Director::ExecutionTask::Fail(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_result.set_exception(exception);
+    this->m_isFinished = true;
+    this->m_finished.notify_all();
+}
+
+void Director::ExecutionTask::WaitUntilFinished()
+{
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    if (this->m_executingThread != std::this_thread::get_id())
+    {
+        this->m_finished.wait(lock, [this]() { return this->m_isFinished; });
+    }
+}
+
 // Returns number of milliseconds elapsed since 01/01/1970 00:00:00 UTC
 long long Director::PosixUtcInMilliseconds()
 {
@@ -4,41 +4,108 @@
 #ifndef DIRECTOR_H
 #define DIRECTOR_H
 
+#include "AccessorFramework/Executor.h"
+#include "AllocationAccounting.h"
 #include "CancellationToken.h"
+#include "RecyclingAllocator.h"
+#include <atomic>
 #include <climits>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+class BaseObject;
+class ExecutionFingerprint;
+
 // Description
 // The Director manages and executes the accessor model's global callback queue. There is only one director per model.
 // The Director prioritizes callbacks first by next execution time, then by the calling accessor's priority, and lastly
-// by a monotonically increasing callback ID. This callback ID enables the calling accessor to cancel the scheduled
-// callback, and it also ensures that two callbacks scheduled in a given order by a single accessor will execute in the
-// order in which they were scheduled. The execution time is calculated using a logical clock loosely tied to physical
-// time. However, while physical time is continuous, logical clocks are discrete; that is, the time on the logical clock
-// "jumps" instantaneously from one time to the next when the callbacks on the queue are executed. This allows the queued
-// callbacks to be executed synchronously while making it appear to the accessors as if they execute atomically and
-// concurrently, enabling asynchronous yet coordinated reactions without explicit thread management or locks.
+// by a monotonically increasing sequence number, given out as each callback is added to the queue. This ensures that
+// two callbacks scheduled in a given order by a single accessor will execute in the order in which they were scheduled.
+// Each callback also has an ID, which enables the calling accessor to cancel the scheduled callback. The execution time
+// is calculated using a logical clock loosely tied to physical time. However, while physical time is continuous,
+// logical clocks are discrete; that is, the time on the logical clock "jumps" instantaneously from one time to the next
+// when the callbacks on the queue are executed. This allows the queued callbacks to be executed synchronously while
+// making it appear to the accessors as if they execute atomically and concurrently, enabling asynchronous yet
+// coordinated reactions without explicit thread management or locks.
+// When reactions run in parallel on worker threads, the Director's queue is left untouched while the workers run.
+// Instead, each worker records the callbacks it schedules and clears in its own DeferredOperations, and the Director
+// applies them once the workers have finished. Callback IDs are still handed out immediately, so they depend on how the
+// workers interleave; the sequence numbers, on the other hand, are only given out as the operations are applied, one
+// worker's operations after another's in an order fixed by the caller. Callbacks with equal times and priorities
+// therefore execute in the same order however the workers ran.
+// Each round of execution runs as a task on the Director's executor, which by default gives every task a thread of its
+// own. Canceling a scheduled round completes it immediately and withdraws its task from the executor if the executor
+// can cancel tasks; if the task runs anyway, it does nothing. Rounds are only handed to the executor once the Director
+// is started by Start() or Execute(), so callbacks scheduled while the model is set up do not start a round of their
+// own. A Director that is polled runs its rounds on the polling thread instead and hands nothing to the executor until
+// it is started again.
+// Other threads cannot schedule callbacks, but they can post one with PostCallback(). Posted callbacks wait in a locked
+// inbox until the Director's thread moves them into the queue, at the logical time at which it does so: at the start of
+// every round executed on the executor, and at the start of every call to Poll(). Posting wakes a started Director that
+// is waiting for its next round by handing the round to the executor right away; a polled Director picks posted
+// callbacks up on the next call to Poll(). Wake() does the same without posting a callback, for when the round start
+// handler has something to do.
+// Scheduled callbacks are kept in nodes that are recycled, so a steady stream of callbacks allocates nothing once warmed
+// up. The Director also keeps the host's allocation account (see AllocationAccounting.h).
+// A round start handler, if set, runs at the start of every round once the logical time has been set, before any of the
+// round's callbacks; the host uses it to bring in events from other hosts.
+// While the host is fingerprinting, each round is a tick of its fingerprint, which is given the round's logical time
+// relative to the start time and the priority of each callback executed.
+// A callback's timing (how long until it is next executed, and its period) can be read and changed without touching the
+// callback itself, which is how a host restored from a checkpoint resumes the callbacks it had when the checkpoint was
+// taken.
 //
 class Director
 {
 public:
+    class DeferredOperations;
+
+    struct CallbackTiming
+    {
+        long long delayInMilliseconds; // until the callback is next executed
+        int periodInMilliseconds; // of a periodic callback, otherwise its original delay
+        bool isPeriodic;
+    };
+
     Director();
     ~Director();
     int ScheduleCallback(
         std::function<void()> callback,
         int delayInMilliseconds,
         bool isPeriodic = false,
-        int priority = INT_MAX);
+        int priority = INT_MAX,
+        AllocationCounters* allocationCounters = nullptr, // counts allocations made by the callback
+        const BaseObject* owner = nullptr); // names the callback in traces
 
+    void PostCallback(std::function<void()> callback, int priority = INT_MAX); // may be called from any thread
+    void Wake(); // runs a round as soon as possible; may be called from any thread
     void ClearScheduledCallback(int callbackId);
+    bool GetCallbackTiming(int callbackId, CallbackTiming& timing) const; // returns false if it is not scheduled
+    void SetCallbackTiming(int callbackId, const CallbackTiming& timing); // should only be called while no round is executing
     void HandlePriorityUpdate(int oldPriority, int newPriority);
+    void SetExecutor(std::shared_ptr<Executor> executor);
+    std::shared_ptr<Executor> GetExecutor() const;
+    void Start(std::function<void(std::exception_ptr)> exceptionHandler);
     void Execute(int numberOfIterations = 0);
     void StopExecution();
+    void WaitForExecutionToStop();
+    long long Poll(long long currentTimeInMilliseconds);
+    bool IsPolled() const;
+    long long GetCurrentLogicalTime() const; // in milliseconds since the epoch
+    void SetRoundStartHandler(std::function<void()> handler); // should only be called while no round is executing
+    void SetFingerprint(ExecutionFingerprint* fingerprint); // should only be called while no round is executing
+    AllocationAccount& GetAllocationAccount();
+    void ApplyDeferredOperations(DeferredOperations& deferredOperations);
+
+    // While set, callbacks scheduled or cleared on the current thread are recorded instead of being applied
+    static void DeferOperationsOnCurrentThread(DeferredOperations* deferredOperations);
 
 private:
     class ScheduledCallback
@@ -49,32 +116,107 @@ private:
         bool isPeriodic = false;
         int priority = INT_MAX;
         long long nextExecutionTimeInMilliseconds = 0;
+        AllocationCounters* allocationCounters = nullptr;
+        const BaseObject* owner = nullptr;
+        unsigned long long sequenceNumber = 0ULL; // given out when the callback is added to the queue
+    };
+
+    using ScheduledCallbackMap = std::map<int, ScheduledCallback, std::less<int>, RecyclingAllocator<std::pair<const int, ScheduledCallback>>>;
+
+    struct PostedCallback
+    {
+        std::function<void()> callback;
+        int priority;
+    };
+
+    // A scheduled round of execution. A round is claimed exactly once, either by the thread that executes it or by
+    // Cancel(), so its result is always set exactly once and a canceled round never waits for its due time.
+    class ExecutionTask
+    {
+    public:
+        ExecutionTask();
+        std::future<bool> GetResult();
+        bool Begin();
+        void Cancel();
+        void Finish(bool wasCanceled);
+        void Fail(std::exception_ptr exception);
+        void WaitUntilFinished();
+
+        const std::shared_ptr<CancellationToken> cancellationToken;
+        std::atomic<unsigned long long> executorTaskId; // 0 until the round is handed to the executor
+
+    private:
+        std::promise<bool> m_result;
+        std::atomic_bool m_claimed;
+        std::mutex m_mutex;
+        std::condition_variable m_finished;
+        bool m_isFinished;
+        std::thread::id m_executingThread;
     };
 
     long long GetNextQueuedExecutionTime() const;
     void ScheduleNextExecution();
-    void ExecuteInternal(
-        long long executionDelayInMilliseconds,
-        std::unique_ptr<std::promise<bool>> executionPromise,
-        std::shared_ptr<CancellationToken> cancellationToken);
+    void ExecuteInternal(const std::shared_ptr<ExecutionTask>& executionTask);
+    void UseExecutor();
+    void WakeWaitingRound(std::unique_lock<std::mutex>& postLock); // unlocks it if the round is handed to the executor
+    void SchedulePostedCallbacks(long long currentTimeInMilliseconds);
 
     bool ScheduledCallbackExistsInMap(int scheduledCallbackId) const;
     void RemoveScheduledCallbackFromMap(int scheduledCallbackId);
+    void AddScheduledCallback(int newCallbackId, ScheduledCallback newCallback);
     void QueueScheduledCallback(int newCallbackId);
     void ExecuteCallbacks();
     bool NeedsReset() const;
     void Reset();
 
-    int m_nextCallbackId;
-    std::map<int, ScheduledCallback> m_scheduledCallbacks;
+    std::atomic_int m_nextCallbackId;
+    unsigned long long m_nextSequenceNumber;
+    ScheduledCallbackMap m_scheduledCallbacks;
     std::vector<int> m_callbackQueue;
     long long m_currentLogicalTime;
     long long m_startTime;
     long long m_nextScheduledExecutionTime;
     std::shared_ptr<std::future<bool>> m_executionResult;
-    std::shared_ptr<CancellationToken> m_executionCancellationToken;
+    std::shared_ptr<ExecutionTask> m_executionTask; // written under m_postMutex, so that PostCallback() can read it
+    std::shared_ptr<ExecutionTask> m_stoppedExecutionTask;
+    std::shared_ptr<Executor> m_executor; // written under m_postMutex
+    std::function<void(std::exception_ptr)> m_exceptionHandler;
+    std::function<void()> m_roundStartHandler;
+    ExecutionFingerprint* m_fingerprint;
+    std::atomic_bool m_isStarted; // rounds are handed to the executor
+    bool m_isPolled;
+    mutable std::mutex m_postMutex;
+    std::vector<PostedCallback> m_postedCallbacks;
+    bool m_isWakeRequested;
+    bool m_isWaking; // a round has been handed to the executor for the posted callbacks
+    bool m_isWakeRoundDue; // the next round runs for a wake request, even with no callbacks
+    AllocationAccount m_allocationAccount;
 
     static long long PosixUtcInMilliseconds();
+    static thread_local DeferredOperations* s_deferredOperations;
+};
+
+// Director operations recorded on one worker thread, in the order in which they were requested
+class Director::DeferredOperations
+{
+public:
+    explicit DeferredOperations(Director* director) :
+        m_director(director)
+    {
+    }
+
+private:
+    friend class Director;
+
+    struct Operation
+    {
+        int callbackId;
+        bool isClear;
+        ScheduledCallback callback;
+    };
+
+    Director* m_director;
+    std::vector<Operation> m_operations;
 };
 
 #endif // DIRECTOR_H
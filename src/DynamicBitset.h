@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef DYNAMIC_BITSET_H
+#define DYNAMIC_BITSET_H
+
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Description
+// A bitset whose size is chosen at runtime. Bits are stored in 64-bit words so that set operations and iteration over
+// set bits touch one word at a time.
+//
+class dynamic_bitset
+{
+public:
+    explicit dynamic_bitset(size_t size = 0, bool value = false) :
+        m_size(size),
+        m_words((size + BitsPerWord - 1) / BitsPerWord, value ? ~0ULL : 0ULL)
+    {
+        this->clear_unused_bits();
+    }
+
+    size_t size() const
+    {
+        return this->m_size;
+    }
+
+    bool test(size_t position) const
+    {
+        return ((this->m_words[position / BitsPerWord] >> (position % BitsPerWord)) & 1ULL) != 0;
+    }
+
+    void set(size_t position)
+    {
+        this->m_words[position / BitsPerWord] |= (1ULL << (position % BitsPerWord));
+    }
+
+    void reset(size_t position)
+    {
+        this->m_words[position / BitsPerWord] &= ~(1ULL << (position % BitsPerWord));
+    }
+
+    bool any() const
+    {
+        for (uint64_t word : this->m_words)
+        {
+            if (word != 0ULL)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Invokes function(position) for every set bit in ascending order
+    template<class Function>
+    void for_each(Function function) const
+    {
+        for (size_t i = 0; i < this->m_words.size(); ++i)
+        {
+            for (uint64_t word = this->m_words[i]; word != 0ULL; word &= (word - 1ULL))
+            {
+                function(i * BitsPerWord + count_trailing_zeros(word));
+            }
+        }
+    }
+
+private:
+    static const size_t BitsPerWord = 64;
+
+    void clear_unused_bits()
+    {
+        if (this->m_size % BitsPerWord != 0)
+        {
+            this->m_words.back() &= ((1ULL << (this->m_size % BitsPerWord)) - 1ULL);
+        }
+    }
+
+    static size_t count_trailing_zeros(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index = 0;
+        _BitScanForward64(&index, word);
+        return static_cast<size_t>(index);
+#else
+        size_t count = 0;
+        while ((word & 1ULL) == 0ULL)
+        {
+            word >>= 1;
+            ++count;
+        }
+
+        return count;
+#endif
+    }
+
+    size_t m_size;
+    std::vector<uint64_t> m_words;
+};
+
+#endif // DYNAMIC_BITSET_H
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "EventRecorder.h"
+#include "Logger.h"
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+static const size_t FlushThreshold = 64 * 1024;
+
+EventRecorder::EventRecorder(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer, long long startLogicalTime) :
+    m_filePath(filePath),
+    m_serializer(std::move(serializer)),
+    m_file(filePath, std::ios::binary | std::ios::trunc),
+    m_isOpen(false)
+{
+    if (this->m_serializer == nullptr)
+    {
+        throw std::invalid_argument("A recording needs a serializer");
+    }
+    else if (!(this->m_file))
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Could not open recording file '" << filePath << "'";
+        throw std::runtime_error(exceptionMessage.str());
+    }
+
+    RecordingFormat::FileHeader header{ RecordingFormat::Magic, RecordingFormat::FormatVersion, 0, startLogicalTime };
+    ByteWriter writer(this->m_buffer);
+    writer.Write(&header, sizeof(header));
+    this->m_buffer.reserve(FlushThreshold * 2);
+    this->m_isOpen.store(true);
+}
+
+EventRecorder::~EventRecorder()
+{
+    this->Close();
+}
+
+uint32_t EventRecorder::AddStream(const std::string& name)
+{
+    auto it = this->m_streamIds.find(name);
+    if (it != this->m_streamIds.end())
+    {
+        return it->second;
+    }
+
+    uint32_t streamId = static_cast<uint32_t>(this->m_streamNames.size());
+    this->m_streamIds.emplace(name, streamId);
+    this->m_streamNames.push_back(name);
+    if (this->m_isOpen.load())
+    {
+        this->AppendEntryHeader(RecordingFormat::StreamEntry, streamId, 0, name.size());
+        ByteWriter writer(this->m_buffer);
+        writer.Write(name.data(), name.size());
+        this->m_buffer.resize(this->m_buffer.size() + RecordingFormat::GetPaddingSize(name.size()), 0);
+    }
+
+    return streamId;
+}
+
+void EventRecorder::Record(uint32_t streamId, long long logicalTime, const IEvent* event)
+{
+    if (!(this->m_isOpen.load(std::memory_order_relaxed)))
+    {
+        return;
+    }
+    else if (event == nullptr || !(this->m_serializer->CanSerialize(*event)))
+    {
+        this->m_numberOfEventsSkipped.Increment();
+        return;
+    }
+
+    size_t headerOffset = this->m_buffer.size();
+    this->AppendEntryHeader(RecordingFormat::EventEntry, streamId, logicalTime, 0);
+    uint64_t size = this->m_serializer->Serialize(*event, this->m_buffer);
+    std::memcpy(this->m_buffer.data() + headerOffset + offsetof(RecordingFormat::EntryHeader, size), &size, sizeof(size));
+    this->m_numberOfEventsRecorded.Increment();
+    if (this->m_buffer.size() >= FlushThreshold)
+    {
+        this->Flush();
+    }
+}
+
+void EventRecorder::RecordFingerprint(long long logicalTime, const Host::FingerprintTick& tick)
+{
+    if (!(this->m_isOpen.load(std::memory_order_relaxed)))
+    {
+        return;
+    }
+
+    RecordingFormat::FingerprintPayload payload{ tick.logicalTime, tick.numberOfEvents, tick.hash };
+    this->AppendEntryHeader(RecordingFormat::FingerprintEntry, 0, logicalTime, sizeof(payload));
+    ByteWriter writer(this->m_buffer);
+    writer.Write(&payload, sizeof(payload));
+    if (this->m_buffer.size() >= FlushThreshold)
+    {
+        this->Flush();
+    }
+}
+
+void EventRecorder::Close()
+{
+    if (this->m_isOpen.load())
+    {
+        this->Flush();
+        this->m_isOpen.store(false);
+        this->m_file.close();
+    }
+}
+
+Host::RecordingReport EventRecorder::GetReport() const
+{
+    return Host::RecordingReport{
+        this->m_filePath,
+        this->m_isOpen.load(),
+        this->m_streamNames,
+        this->m_numberOfEventsRecorded.Get(),
+        this->m_numberOfEventsSkipped.Get(),
+        this->m_numberOfBytesWritten.Get()
+    };
+}
+
+void EventRecorder::AppendEntryHeader(uint32_t kind, uint32_t streamId, long long logicalTime, uint64_t size)
+{
+    RecordingFormat::EntryHeader header{ kind, streamId, logicalTime, size };
+    ByteWriter writer(this->m_buffer);
+    writer.Write(&header, sizeof(header));
+}
+
+void EventRecorder::Flush()
+{
+    this->m_file.write(reinterpret_cast<const char*>(this->m_buffer.data()), static_cast<std::streamsize>(this->m_buffer.size()));
+    this->m_file.flush();
+    if (!(this->m_file))
+    {
+        LOG_ERROR("Could not write to recording file '%s', so recording has stopped", this->m_filePath.c_str());
+        this->m_isOpen.store(false);
+        this->m_file.close();
+    }
+    else
+    {
+        this->m_numberOfBytesWritten.Add(this->m_buffer.size());
+    }
+
+    this->m_buffer.clear();
+}
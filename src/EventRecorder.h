@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EVENT_RECORDER_H
+#define EVENT_RECORDER_H
+
+#include "AccessorFramework/EventSerializer.h"
+#include "AccessorFramework/Host.h"
+#include "ProfilingCounter.h"
+#include "RecordingFormat.h"
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Description
+// An EventRecorder appends the events entering a host to a recording (see RecordingFormat.h). The host attaches it to
+// every spontaneous output port and to the input port of every inbound channel, each of which is a stream of its own.
+// Entries are gathered in a buffer that is written to the file whenever it grows past 64 KiB, and when the recorder is
+// closed, so recording an event usually costs no more than serializing it. Events whose payload type the serializer
+// does not know are skipped and counted. If the file cannot be written, the recorder logs an error and stops recording.
+// While the host is also fingerprinting, the recorder is given the fingerprint of each tick as it finishes.
+//
+// Events are only recorded by the thread executing the host's current round, and streams are only added while the host
+// is not running, but the counters can be read from any thread.
+//
+class EventRecorder
+{
+public:
+    EventRecorder(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer, long long startLogicalTime);
+    ~EventRecorder();
+    uint32_t AddStream(const std::string& name); // returns the stream's ID, which is the same if it was already added
+    void Record(uint32_t streamId, long long logicalTime, const IEvent* event);
+    void RecordFingerprint(long long logicalTime, const Host::FingerprintTick& tick);
+    void Close();
+    Host::RecordingReport GetReport() const;
+
+private:
+    void AppendEntryHeader(uint32_t kind, uint32_t streamId, long long logicalTime, uint64_t size);
+    void Flush();
+
+    const std::string m_filePath;
+    const std::shared_ptr<const EventSerializer> m_serializer;
+    std::ofstream m_file;
+    std::atomic<bool> m_isOpen;
+    std::vector<unsigned char> m_buffer;
+    std::map<std::string, uint32_t> m_streamIds;
+    std::vector<std::string> m_streamNames; // by ID
+    ProfilingCounter m_numberOfEventsRecorded;
+    ProfilingCounter m_numberOfEventsSkipped;
+    ProfilingCounter m_numberOfBytesWritten;
+};
+
+#endif // EVENT_RECORDER_H
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "EventSerializerImpl.h"
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+
+const size_t EventSerializer::Impl::RecordAlignment;
+
+EventSerializer::EventSerializer() :
+    m_impl(std::make_unique<Impl>())
+{
+}
+
+EventSerializer::~EventSerializer() = default;
+
+EventSerializer::Impl* EventSerializer::GetImpl() const
+{
+    return this->m_impl.get();
+}
+
+bool EventSerializer::CanSerialize(const IEvent& event) const
+{
+    return this->m_impl->CanSerialize(event);
+}
+
+size_t EventSerializer::Serialize(const IEvent& event, std::vector<unsigned char>& buffer) const
+{
+    return this->m_impl->Serialize(event, buffer);
+}
+
+std::shared_ptr<IEvent> EventSerializer::Deserialize(ByteReader& reader) const
+{
+    return this->m_impl->Deserialize(reader);
+}
+
+std::shared_ptr<IEvent> EventSerializer::Deserialize(const unsigned char* data, size_t size) const
+{
+    ByteReader reader(data, size);
+    return this->m_impl->Deserialize(reader);
+}
+
+void EventSerializer::AddCodec(Codec codec)
+{
+    this->m_impl->AddCodec(std::move(codec));
+}
+
+const unsigned char* EventSerializer::FindPayload(IEvent::TypeId typeId, const unsigned char* data, size_t size, size_t& payloadSize) const
+{
+    return this->m_impl->FindPayload(typeId, data, size, payloadSize);
+}
+
+void EventSerializer::Impl::AddCodec(Codec codec)
+{
+    if (this->m_codecs.find(codec.typeId) != this->m_codecs.end())
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "A payload type with type ID " << codec.typeId << " is already registered";
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+    else if (codec.version == 0)
+    {
+        throw std::invalid_argument("Versions start at 1");
+    }
+
+    IEvent::TypeId typeId = codec.typeId;
+    this->m_codecs.emplace(typeId, std::move(codec));
+}
+
+bool EventSerializer::Impl::CanSerialize(const IEvent& event) const
+{
+    return (this->m_codecs.find(event.GetTypeId()) != this->m_codecs.end());
+}
+
+size_t EventSerializer::Impl::Serialize(const IEvent& event, std::vector<unsigned char>& buffer) const
+{
+    auto codec = this->m_codecs.find(event.GetTypeId());
+    if (codec == this->m_codecs.end())
+    {
+        throw std::invalid_argument("The event's payload type is not registered");
+    }
+
+    size_t start = buffer.size();
+    RecordHeader header{ codec->second.typeId, codec->second.version, 0 };
+    ByteWriter writer(buffer);
+    writer.Write(&header, sizeof(header));
+    codec->second.encode(event, writer);
+
+    header.size = buffer.size() - start - sizeof(header);
+    std::memcpy(buffer.data() + start + offsetof(RecordHeader, size), &header.size, sizeof(header.size));
+    buffer.resize(buffer.size() + GetPaddingSize(header.size), 0);
+    return buffer.size() - start;
+}
+
+std::shared_ptr<IEvent> EventSerializer::Impl::Deserialize(ByteReader& reader) const
+{
+    ByteReader recordReader = reader;
+    RecordHeader header{};
+    const unsigned char* payload = ReadRecord(recordReader, header);
+    if (payload == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto codec = this->m_codecs.find(header.typeId);
+    if (codec == this->m_codecs.end() || header.version == 0 || header.version > codec->second.version)
+    {
+        return nullptr;
+    }
+
+    ByteReader payloadReader(payload, static_cast<size_t>(header.size));
+    std::shared_ptr<IEvent> event = codec->second.decode(payloadReader, header.version);
+    if (event == nullptr || payloadReader.GetRemainingSize() != 0)
+    {
+        return nullptr;
+    }
+
+    reader = recordReader;
+    return event;
+}
+
+const unsigned char* EventSerializer::Impl::FindPayload(IEvent::TypeId typeId, const unsigned char* data, size_t size, size_t& payloadSize) const
+{
+    ByteReader reader(data, size);
+    RecordHeader header{};
+    const unsigned char* payload = ReadRecord(reader, header);
+    auto codec = this->m_codecs.find(typeId);
+    if (payload == nullptr || codec == this->m_codecs.end() || header.typeId != typeId || header.version != codec->second.version)
+    {
+        return nullptr;
+    }
+
+    payloadSize = static_cast<size_t>(header.size);
+    return payload;
+}
+
+size_t EventSerializer::Impl::GetPaddingSize(uint64_t payloadSize)
+{
+    return static_cast<size_t>((RecordAlignment - payloadSize % RecordAlignment) % RecordAlignment);
+}
+
+const unsigned char* EventSerializer::Impl::ReadRecord(ByteReader& reader, RecordHeader& header)
+{
+    if (!reader.Read(&header, sizeof(header)) || header.size > reader.GetRemainingSize())
+    {
+        return nullptr;
+    }
+
+    return reader.ReadBytes(header.size + GetPaddingSize(header.size));
+}
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EVENT_SERIALIZER_IMPL_H
+#define EVENT_SERIALIZER_IMPL_H
+
+#include "AccessorFramework/EventSerializer.h"
+#include <unordered_map>
+
+// Description
+// The EventSerializer::Impl keeps the registered codecs by type ID, which serializing an event and reading a record both
+// look up. A record is only read if its header, its payload, and its padding all fit in the bytes given, its type ID and
+// version are known, and the codec reads exactly the payload's size.
+//
+class EventSerializer::Impl
+{
+public:
+    void AddCodec(Codec codec);
+    bool CanSerialize(const IEvent& event) const;
+    size_t Serialize(const IEvent& event, std::vector<unsigned char>& buffer) const;
+    std::shared_ptr<IEvent> Deserialize(ByteReader& reader) const;
+    const unsigned char* FindPayload(IEvent::TypeId typeId, const unsigned char* data, size_t size, size_t& payloadSize) const;
+
+private:
+    struct RecordHeader
+    {
+        IEvent::TypeId typeId;
+        uint32_t version;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(RecordHeader) == 16, "Record headers are 16 bytes long");
+
+    static const size_t RecordAlignment = 8;
+
+    static size_t GetPaddingSize(uint64_t payloadSize);
+
+    // Reads a record header and returns its payload, including the padding that follows it, or null if it does not fit
+    static const unsigned char* ReadRecord(ByteReader& reader, RecordHeader& header);
+
+    std::unordered_map<IEvent::TypeId, Codec> m_codecs;
+};
+
+#endif // EVENT_SERIALIZER_IMPL_H
@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ExecutionFingerprint.h"
+#include "EventRecorder.h"
+#include <cstring>
+
+static const uint64_t CallbackKey = 0x63616c6c6261636bULL;
+static const uint64_t NullEventHash = 0x6e756c6c6576656eULL;
+static const uint64_t OpaqueEventHash = 0x6f70617175657665ULL;
+
+ExecutionFingerprint::ExecutionFingerprint(std::shared_ptr<const EventSerializer> serializer, size_t numberOfTicksKept) :
+    m_serializer(std::move(serializer)),
+    m_numberOfTicksKept(numberOfTicksKept),
+    m_recorder(nullptr),
+    m_tickIsOpen(false),
+    m_logicalTime(0LL),
+    m_relativeLogicalTime(0LL),
+    m_tickNumber(0ULL),
+    m_tickSum(0ULL),
+    m_numberOfTickEvents(0ULL),
+    m_hash(0ULL),
+    m_numberOfTicks(0ULL),
+    m_finishedHash(0ULL)
+{
+}
+
+void ExecutionFingerprint::SetRecorder(EventRecorder* recorder)
+{
+    this->m_recorder = recorder;
+}
+
+void ExecutionFingerprint::BeginTick(long long logicalTime, long long relativeLogicalTime)
+{
+    if (this->m_tickIsOpen)
+    {
+        this->FinishTick();
+    }
+
+    this->m_logicalTime = logicalTime;
+    this->m_relativeLogicalTime = relativeLogicalTime;
+    this->m_tickSum.store(0ULL, std::memory_order_relaxed);
+    this->m_numberOfTickEvents.store(0ULL, std::memory_order_relaxed);
+    this->m_tickNumber.store(this->m_tickNumber.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    this->m_tickIsOpen = true;
+}
+
+void ExecutionFingerprint::FinishTick()
+{
+    if (!(this->m_tickIsOpen))
+    {
+        return;
+    }
+
+    this->m_tickIsOpen = false;
+    unsigned long long numberOfEvents = this->m_numberOfTickEvents.load(std::memory_order_relaxed);
+    this->m_hash = Combine(this->m_hash, static_cast<uint64_t>(this->m_relativeLogicalTime));
+    this->m_hash = Combine(this->m_hash, numberOfEvents);
+    this->m_hash = Combine(this->m_hash, this->m_tickSum.load(std::memory_order_relaxed));
+    Host::FingerprintTick tick{ this->m_relativeLogicalTime, numberOfEvents, this->m_hash };
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        if (this->m_ticks.size() < this->m_numberOfTicksKept)
+        {
+            this->m_ticks.push_back(tick);
+        }
+
+        ++(this->m_numberOfTicks);
+        this->m_finishedHash = this->m_hash;
+    }
+
+    if (this->m_recorder != nullptr)
+    {
+        this->m_recorder->RecordFingerprint(this->m_logicalTime, tick);
+    }
+}
+
+unsigned long long ExecutionFingerprint::GetTickNumber() const
+{
+    return this->m_tickNumber.load(std::memory_order_relaxed);
+}
+
+void ExecutionFingerprint::AddCallback(int priority)
+{
+    this->m_tickSum.fetch_add(Combine(CallbackKey, static_cast<uint64_t>(priority)), std::memory_order_relaxed);
+}
+
+void ExecutionFingerprint::AddEvent(uint64_t portKey, int priority, unsigned long long sequenceNumber, const IEvent* event)
+{
+    uint64_t hash = Combine(portKey, static_cast<uint64_t>(priority));
+    hash = Combine(hash, sequenceNumber);
+    hash = Combine(hash, this->HashEvent(event));
+    this->m_tickSum.fetch_add(hash, std::memory_order_relaxed);
+    this->m_numberOfTickEvents.fetch_add(1ULL, std::memory_order_relaxed);
+}
+
+Host::FingerprintReport ExecutionFingerprint::GetReport(bool isFingerprinting) const
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    return Host::FingerprintReport{ isFingerprinting, this->m_numberOfTicks, this->m_finishedHash, this->m_ticks };
+}
+
+uint64_t ExecutionFingerprint::GetPortKey(const std::string& portFullName)
+{
+    return HashBytes(reinterpret_cast<const unsigned char*>(portFullName.data()), portFullName.size());
+}
+
+// Events are serialized into a buffer of the calling thread's own, which stops allocating once it is large enough
+uint64_t ExecutionFingerprint::HashEvent(const IEvent* event) const
+{
+    if (event == nullptr)
+    {
+        return NullEventHash;
+    }
+    else if (this->m_serializer == nullptr || !(this->m_serializer->CanSerialize(*event)))
+    {
+        return OpaqueEventHash;
+    }
+
+    static thread_local std::vector<unsigned char> buffer{};
+    buffer.clear();
+    this->m_serializer->Serialize(*event, buffer);
+    return HashBytes(buffer.data(), buffer.size());
+}
+
+// The finalizer of SplitMix64, which spreads every bit of its input over the whole output
+uint64_t ExecutionFingerprint::Mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+uint64_t ExecutionFingerprint::Combine(uint64_t hash, uint64_t value)
+{
+    return Mix(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
+uint64_t ExecutionFingerprint::HashBytes(const unsigned char* data, size_t size)
+{
+    uint64_t hash = Mix(static_cast<uint64_t>(size));
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = Combine(hash, word);
+    }
+
+    if (i < size)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, size - i);
+        hash = Combine(hash, word);
+    }
+
+    return hash;
+}
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EXECUTION_FINGERPRINT_H
+#define EXECUTION_FINGERPRINT_H
+
+#include "AccessorFramework/EventSerializer.h"
+#include "AccessorFramework/Host.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class EventRecorder;
+
+// Description
+// An ExecutionFingerprint hashes each tick (round of execution) of a host. The host's director begins and finishes each
+// tick and adds the priority of every callback it executes, and every port of an atomic accessor adds the events it
+// sends. Each addition is hashed on its own and added to the tick's sum, so the threads processing parallel reactions
+// can add events at the same time, in any order, without changing the sum. A port numbers the events it sends in each
+// tick, which keeps its own events in order. When the tick finishes, its logical time, number of events, and sum are
+// folded into the running hash, which becomes the tick's hash.
+//
+// Ticks are begun and finished by the thread executing the host's round, and the first ticks, up to the number kept, can
+// be read from any thread. If a recorder is set, the hash of every finished tick is also recorded.
+//
+class ExecutionFingerprint
+{
+public:
+    ExecutionFingerprint(std::shared_ptr<const EventSerializer> serializer, size_t numberOfTicksKept);
+    void SetRecorder(EventRecorder* recorder); // should only be called while no round is executing
+    void BeginTick(long long logicalTime, long long relativeLogicalTime); // finishes a tick left unfinished
+    void FinishTick();
+    unsigned long long GetTickNumber() const;
+    void AddCallback(int priority);
+    void AddEvent(uint64_t portKey, int priority, unsigned long long sequenceNumber, const IEvent* event);
+    Host::FingerprintReport GetReport(bool isFingerprinting) const;
+
+    static uint64_t GetPortKey(const std::string& portFullName);
+
+private:
+    uint64_t HashEvent(const IEvent* event) const;
+
+    static uint64_t Mix(uint64_t value);
+    static uint64_t Combine(uint64_t hash, uint64_t value);
+    static uint64_t HashBytes(const unsigned char* data, size_t size);
+
+    const std::shared_ptr<const EventSerializer> m_serializer;
+    const size_t m_numberOfTicksKept;
+    EventRecorder* m_recorder;
+    bool m_tickIsOpen;
+    long long m_logicalTime;
+    long long m_relativeLogicalTime;
+    std::atomic<unsigned long long> m_tickNumber;
+    std::atomic<uint64_t> m_tickSum;
+    std::atomic<unsigned long long> m_numberOfTickEvents;
+    uint64_t m_hash;
+    mutable std::mutex m_mutex; // guards the ticks and the totals read by GetReport()
+    std::vector<Host::FingerprintTick> m_ticks;
+    unsigned long long m_numberOfTicks;
+    uint64_t m_finishedHash;
+};
+
+#endif // EXECUTION_FINGERPRINT_H
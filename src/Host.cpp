@@ -4,6 +4,8 @@
 #include "AccessorFramework/Host.h"
 #include "HostImpl.h"
 #include "HostHypervisorImpl.h"
+#include "TraceRecorder.h"
+#include <algorithm>
 #include <thread>
 
 Host::~Host() = default;
@@ -28,6 +30,36 @@ void Host::RemoveEventListener(int listenerId)
     static_cast<Impl*>(this->GetImpl())->RemoveEventListener(listenerId);
 }
 
+void Host::SetListenerExecutor(std::shared_ptr<Executor> executor)
+{
+    static_cast<Impl*>(this->GetImpl())->SetListenerExecutor(std::move(executor));
+}
+
+void Host::WaitForEventListeners() const
+{
+    static_cast<Impl*>(this->GetImpl())->WaitForEventListeners();
+}
+
+Host::ListenerMetrics Host::GetListenerMetrics() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetListenerMetrics();
+}
+
+void Host::EnableParallelReactions(unsigned int numberOfThreads)
+{
+    static_cast<Impl*>(this->GetImpl())->EnableParallelReactions(numberOfThreads);
+}
+
+void Host::SetThreadSettings(const ThreadSettings& settings)
+{
+    static_cast<Impl*>(this->GetImpl())->SetThreadSettings(settings);
+}
+
+Host::ThreadSettings Host::GetThreadSettings() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetThreadSettings();
+}
+
 void Host::Setup()
 {
     static_cast<Impl*>(this->GetImpl())->Setup();
@@ -48,16 +80,192 @@ void Host::Run()
     static_cast<Impl*>(this->GetImpl())->Run();
 }
 
+void Host::Run(std::shared_ptr<Executor> executor)
+{
+    static_cast<Impl*>(this->GetImpl())->Run(std::move(executor));
+}
+
 void Host::RunOnCurrentThread()
 {
     static_cast<Impl*>(this->GetImpl())->RunOnCurrentThread();
 }
 
+std::chrono::system_clock::time_point Host::Poll(std::chrono::system_clock::time_point now)
+{
+    return static_cast<Impl*>(this->GetImpl())->Poll(now);
+}
+
 void Host::Exit()
 {
     static_cast<Impl*>(this->GetImpl())->Exit();
 }
 
+Host::OffloadMetrics Host::GetOffloadMetrics() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetOffloadMetrics();
+}
+
+std::vector<Host::AccessorProfile> Host::GetProfile() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetProfile();
+}
+
+void Host::ResetProfile()
+{
+    static_cast<Impl*>(this->GetImpl())->ResetProfile();
+}
+
+int Host::AddLatencyProbe(const std::string& outputPortFullName, const std::string& inputPortFullName)
+{
+    return static_cast<Impl*>(this->GetImpl())->AddLatencyProbe(outputPortFullName, inputPortFullName);
+}
+
+void Host::RemoveLatencyProbe(int probeId)
+{
+    static_cast<Impl*>(this->GetImpl())->RemoveLatencyProbe(probeId);
+}
+
+std::vector<Host::LatencyProbeReport> Host::GetLatencyProbes() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetLatencyProbes();
+}
+
+void Host::ResetLatencyProbes()
+{
+    static_cast<Impl*>(this->GetImpl())->ResetLatencyProbes();
+}
+
+Host::AllocationProfile Host::GetAllocationProfile() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetAllocationProfile();
+}
+
+void Host::ResetAllocationProfile()
+{
+    static_cast<Impl*>(this->GetImpl())->ResetAllocationProfile();
+}
+
+void Host::ExportGraph(std::ostream& stream, GraphFormat format, bool includeTraffic) const
+{
+    static_cast<Impl*>(this->GetImpl())->ExportGraph(stream, format, includeTraffic);
+}
+
+void Host::StartCriticalPathAnalysis(size_t numberOfRecentTicks)
+{
+    static_cast<Impl*>(this->GetImpl())->StartCriticalPathAnalysis(numberOfRecentTicks);
+}
+
+void Host::StopCriticalPathAnalysis()
+{
+    static_cast<Impl*>(this->GetImpl())->StopCriticalPathAnalysis();
+}
+
+Host::CriticalPathReport Host::GetCriticalPathReport() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetCriticalPathReport();
+}
+
+void Host::ResetCriticalPathAnalysis()
+{
+    static_cast<Impl*>(this->GetImpl())->ResetCriticalPathAnalysis();
+}
+
+void Host::StartRecording(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer)
+{
+    static_cast<Impl*>(this->GetImpl())->StartRecording(filePath, std::move(serializer));
+}
+
+void Host::StopRecording()
+{
+    static_cast<Impl*>(this->GetImpl())->StopRecording();
+}
+
+Host::RecordingReport Host::GetRecordingReport() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetRecordingReport();
+}
+
+void Host::StartFingerprinting(std::shared_ptr<const EventSerializer> serializer, size_t numberOfTicksKept)
+{
+    static_cast<Impl*>(this->GetImpl())->StartFingerprinting(std::move(serializer), numberOfTicksKept);
+}
+
+void Host::StopFingerprinting()
+{
+    static_cast<Impl*>(this->GetImpl())->StopFingerprinting();
+}
+
+Host::FingerprintReport Host::GetFingerprintReport() const
+{
+    return static_cast<Impl*>(this->GetImpl())->GetFingerprintReport();
+}
+
+void Host::Checkpoint(std::ostream& stream, std::shared_ptr<const EventSerializer> serializer) const
+{
+    static_cast<Impl*>(this->GetImpl())->Checkpoint(stream, serializer.get());
+}
+
+void Host::Restore(std::istream& stream, std::shared_ptr<const EventSerializer> serializer)
+{
+    static_cast<Impl*>(this->GetImpl())->Restore(stream, serializer.get());
+}
+
+void Host::SetProfilingEnabled(bool enabled)
+{
+    ProfilingCounter::SetProfilingEnabled(enabled);
+}
+
+void Host::SetOffloadQueueCapacity(size_t capacity)
+{
+    OffloadPool::GetDefault().SetQueueCapacity(capacity);
+}
+
+void Host::StartTracing(size_t eventsPerThread)
+{
+    TraceRecorder::Start(eventsPerThread);
+}
+
+void Host::StopTracing()
+{
+    TraceRecorder::Stop();
+}
+
+void Host::WriteTrace(std::ostream& stream)
+{
+    TraceRecorder::WriteChromeTrace(stream);
+}
+
+bool Host::AllocationAccountingIsEnabled()
+{
+#ifdef ACCESSOR_FRAMEWORK_ALLOCATION_ACCOUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Each tick's hash covers every tick before it, so the runs stay apart once they have diverged
+bool Host::FindFirstDivergentTick(const std::vector<FingerprintTick>& expected, const std::vector<FingerprintTick>& actual, size_t& tickIndex)
+{
+    size_t numberOfCommonTicks = std::min(expected.size(), actual.size());
+    for (size_t i = 0; i < numberOfCommonTicks; ++i)
+    {
+        if (expected[i].logicalTime != actual[i].logicalTime || expected[i].numberOfEvents != actual[i].numberOfEvents || expected[i].hash != actual[i].hash)
+        {
+            tickIndex = i;
+            return true;
+        }
+    }
+
+    if (expected.size() != actual.size())
+    {
+        tickIndex = numberOfCommonTicks;
+        return true;
+    }
+
+    return false;
+}
+
 void Host::AdditionalSetup()
 {
     // base implementation does nothing
@@ -68,6 +276,12 @@ Host::Host(const std::string& name) :
 {
 }
 
+Host::Host(const std::string& name, std::shared_ptr<Executor> executor) :
+    Host(name)
+{
+    static_cast<Impl*>(this->GetImpl())->SetExecutor(std::move(executor));
+}
+
 HostHypervisor::HostHypervisor() :
     m_impl(std::make_unique<Impl>())
 {
@@ -146,4 +360,25 @@ void HostHypervisor::RunHosts() const
 void HostHypervisor::RunHostsOnCurrentThread() const
 {
     this->m_impl->RunHostsOnCurrentThread();
+}
+
+int HostHypervisor::ConnectHosts(
+    int sourceHostId,
+    const std::string& outputPortFullName,
+    int destinationHostId,
+    const std::string& inputPortFullName,
+    size_t capacity,
+    int pollingIntervalInMilliseconds)
+{
+    return this->m_impl->ConnectHosts(sourceHostId, outputPortFullName, destinationHostId, inputPortFullName, capacity, pollingIntervalInMilliseconds);
+}
+
+void HostHypervisor::DisconnectHosts(int channelId)
+{
+    this->m_impl->DisconnectHosts(channelId);
+}
+
+std::vector<HostHypervisor::ChannelReport> HostHypervisor::GetChannels() const
+{
+    return this->m_impl->GetChannels();
 }
\ No newline at end of file
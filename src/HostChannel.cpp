@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "HostChannel.h"
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+const size_t HostChannel::CacheLineSize;
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+HostChannel::HostChannel(const std::string& outputPortName, const std::string& inputPortName, size_t capacity) :
+    outputPortName(outputPortName),
+    inputPortName(inputPortName),
+    m_slots(RoundUpToPowerOfTwo(capacity)),
+    m_mask(m_slots.size() - 1),
+    m_isClosed(false),
+    m_wakeupFileDescriptor(-1),
+    m_tail(0),
+    m_cachedHead(0),
+    m_head(0),
+    m_cachedTail(0),
+    m_wakeupIsArmed(true)
+{
+#ifdef __linux__
+    this->m_wakeupFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (this->m_wakeupFileDescriptor < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Could not create the channel's wakeup");
+    }
+#endif
+}
+
+HostChannel::~HostChannel()
+{
+#ifdef __linux__
+    close(this->m_wakeupFileDescriptor);
+#endif
+}
+
+size_t HostChannel::GetCapacity() const
+{
+    return this->m_slots.size();
+}
+
+void HostChannel::Send(std::shared_ptr<IEvent> event, long long logicalTime)
+{
+    if (this->m_isClosed.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    size_t tail = this->m_tail.load(std::memory_order_relaxed);
+    if (tail - this->m_cachedHead == this->m_slots.size())
+    {
+        this->m_cachedHead = this->m_head.load(std::memory_order_acquire);
+        if (tail - this->m_cachedHead == this->m_slots.size())
+        {
+            this->m_numberOfEventsDropped.Increment();
+            return;
+        }
+    }
+
+    Slot& slot = this->m_slots[tail & this->m_mask];
+    slot.event = std::move(event);
+    slot.logicalTime = logicalTime;
+    this->m_tail.store(tail + 1, std::memory_order_release);
+    this->m_numberOfEventsSent.Increment();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_wakeupIsArmed.load(std::memory_order_relaxed) && this->m_wakeupIsArmed.exchange(false, std::memory_order_relaxed))
+    {
+        this->SignalWakeup();
+    }
+}
+
+// The slot's reference to the event is moved out, so the event is released by the receiver rather than when the slot is
+// next written
+bool HostChannel::Receive(long long logicalTime, std::shared_ptr<IEvent>& event)
+{
+    size_t head = this->m_head.load(std::memory_order_relaxed);
+    if (head == this->m_cachedTail)
+    {
+        this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+        if (head == this->m_cachedTail)
+        {
+            return false;
+        }
+    }
+
+    Slot& slot = this->m_slots[head & this->m_mask];
+    if (slot.logicalTime > logicalTime)
+    {
+        return false;
+    }
+
+    event = std::move(slot.event);
+    this->m_maxLogicalLatency.RaiseTo(static_cast<unsigned long long>(logicalTime - slot.logicalTime));
+    this->m_head.store(head + 1, std::memory_order_release);
+    this->m_numberOfEventsReceived.Increment();
+    return true;
+}
+
+bool HostChannel::PeekLogicalTime(long long& logicalTime)
+{
+    size_t head = this->m_head.load(std::memory_order_relaxed);
+    if (head == this->m_cachedTail)
+    {
+        this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+        if (head == this->m_cachedTail)
+        {
+            return false;
+        }
+    }
+
+    logicalTime = this->m_slots[head & this->m_mask].logicalTime;
+    return true;
+}
+
+// The fence orders arming the wakeup before the receiver next reads the tail index
+bool HostChannel::ArmWakeup()
+{
+    bool wasSignaled = !(this->m_wakeupIsArmed.exchange(true, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+    return wasSignaled;
+}
+
+int HostChannel::GetWakeupFileDescriptor() const
+{
+    return this->m_wakeupFileDescriptor;
+}
+
+void HostChannel::ClearWakeup()
+{
+#ifdef __linux__
+    uint64_t numberOfSignals = 0;
+    while (read(this->m_wakeupFileDescriptor, &numberOfSignals, sizeof(numberOfSignals)) < 0 && errno == EINTR)
+    {
+    }
+#endif
+}
+
+void HostChannel::Close()
+{
+    this->m_isClosed.store(true, std::memory_order_relaxed);
+}
+
+bool HostChannel::IsClosed() const
+{
+    return this->m_isClosed.load(std::memory_order_relaxed);
+}
+
+unsigned long long HostChannel::GetNumberOfEventsSent() const
+{
+    return this->m_numberOfEventsSent.Get();
+}
+
+unsigned long long HostChannel::GetNumberOfEventsReceived() const
+{
+    return this->m_numberOfEventsReceived.Get();
+}
+
+unsigned long long HostChannel::GetNumberOfEventsDropped() const
+{
+    return this->m_numberOfEventsDropped.Get();
+}
+
+long long HostChannel::GetMaxLogicalLatency() const
+{
+    return static_cast<long long>(this->m_maxLogicalLatency.Get());
+}
+
+// A signal the receiver has not cleared yet only adds to the eventfd's counter, which ClearWakeup() resets
+void HostChannel::SignalWakeup()
+{
+#ifdef __linux__
+    uint64_t signal = 1;
+    while (write(this->m_wakeupFileDescriptor, &signal, sizeof(signal)) < 0 && errno == EINTR)
+    {
+    }
+#endif
+}
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef HOST_CHANNEL_H
+#define HOST_CHANNEL_H
+
+#include "AccessorFramework/Event.h"
+#include "ProfilingCounter.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Description
+// A HostChannel carries events from an atomic accessor's output port in one host to an atomic accessor's input port in
+// another. It is a single-producer, single-consumer ring of fixed capacity: the sending host's round pushes each event
+// the output port sends, stamped with the sender's logical time, and the receiving host's round takes them out at the
+// start of its next round (see Director::SetRoundStartHandler()). Both ends are wait-free; neither ever blocks the other,
+// and an event sent while the ring is full is dropped and counted instead. The ring's slots are allocated up front, so
+// sending and receiving allocate nothing. An event is only taken out once the receiver's logical time has reached its
+// stamp, so the receiver never sees an event from its own future; events stay in the order in which they were sent.
+// The head and tail indices are kept apart, along with a copy of the other end's index that each end refreshes only when
+// the ring looks full or empty, so the two threads share a cache line only when they have to.
+//
+// The receiver arms the channel's wakeup each time it takes events out, and the first event sent after that signals the
+// channel's wakeup file descriptor (an eventfd), so an idle receiver does not have to poll. The sender only clears an
+// atomic flag and writes to the eventfd: it takes no lock, allocates nothing, and never touches the receiving host. The
+// receiving side watches the file descriptor and wakes its own Director. Each end issues a fence between writing its own
+// index or flag and reading the other's, so that either the sender sees the wakeup armed or the receiver sees the event;
+// a send that finds the wakeup already signaled costs only the fence. On other platforms there is no wakeup, so the
+// receiver has to poll.
+//
+// Closing a channel stops its sender from pushing any more events, for when its receiver has gone away. The counters
+// can be read from any thread.
+//
+class HostChannel
+{
+public:
+    HostChannel(const std::string& outputPortName, const std::string& inputPortName, size_t capacity);
+    ~HostChannel();
+    size_t GetCapacity() const; // the requested capacity rounded up to a power of two
+
+    // Only called by the sending host's round
+    void Send(std::shared_ptr<IEvent> event, long long logicalTime);
+
+    // Only called by the receiving host's round; takes out the oldest event if it is not stamped later than logicalTime
+    bool Receive(long long logicalTime, std::shared_ptr<IEvent>& event);
+
+    // Only called by the receiving host's round; gets the stamp of the oldest event, if there is one
+    bool PeekLogicalTime(long long& logicalTime);
+
+    // Only called by the receiving host's round, before it takes events out; the next event sent signals the wakeup.
+    // Returns true if the wakeup was signaled since it was last armed.
+    bool ArmWakeup();
+
+    // Readable once the wakeup has been signaled, until ClearWakeup() is called; -1 where there is no wakeup
+    int GetWakeupFileDescriptor() const;
+    void ClearWakeup();
+
+    void Close();
+    bool IsClosed() const;
+
+    unsigned long long GetNumberOfEventsSent() const;
+    unsigned long long GetNumberOfEventsReceived() const;
+    unsigned long long GetNumberOfEventsDropped() const;
+    long long GetMaxLogicalLatency() const; // in milliseconds
+
+    const std::string outputPortName; // full name
+    const std::string inputPortName; // full name
+
+private:
+    static const size_t CacheLineSize = 64;
+
+    struct Slot
+    {
+        std::shared_ptr<IEvent> event;
+        long long logicalTime;
+    };
+
+    void SignalWakeup();
+
+    std::vector<Slot> m_slots;
+    const size_t m_mask;
+    std::atomic_bool m_isClosed;
+    int m_wakeupFileDescriptor;
+
+    // Written by the sender
+    char m_senderPadding[CacheLineSize];
+    std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+    ProfilingCounter m_numberOfEventsSent;
+    ProfilingCounter m_numberOfEventsDropped;
+
+    // Written by the receiver
+    char m_receiverPadding[CacheLineSize];
+    std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+    ProfilingCounter m_numberOfEventsReceived;
+    ProfilingCounter m_maxLogicalLatency;
+
+    // Armed by the receiver, disarmed by the sender
+    char m_wakeupPadding[CacheLineSize];
+    std::atomic_bool m_wakeupIsArmed;
+};
+
+#endif // HOST_CHANNEL_H
@@ -2,12 +2,27 @@
 // Licensed under the MIT License.
 
 #include "HostHypervisorImpl.h"
-#include <future>
+#include "HostImpl.h"
+#include "IOLoop.h"
+#include "ThreadConfiguration.h"
+#include <algorithm>
 #include <mutex>
+#include <stdexcept>
 
-HostHypervisor::Impl::Impl()
+HostHypervisor::Impl::Impl() :
+    m_numaNodeCpus(ThreadConfiguration::GetNumaNodeCpus()),
+    m_threadPools{},
+    m_nextNode(0),
+    m_nextChannelId(0),
+    m_channelWakeupLoop(nullptr)
 {
     std::atomic_init<int>(&m_nextHostId, 0);
+    for (const std::vector<int>& nodeCpus : this->m_numaNodeCpus)
+    {
+        this->m_threadPools.push_back(std::make_shared<WorkStealingThreadPool>(nodeCpus.size()));
+    }
+
+    this->PinThreadPoolWorkers();
 }
 
 HostHypervisor::Impl::~Impl() = default;
@@ -15,13 +30,45 @@ HostHypervisor::Impl::~Impl() = default;
 int HostHypervisor::Impl::AddHost(std::unique_ptr<Host> host)
 {
     int hostId = this->m_nextHostId++;
+    Host::ThreadSettings threadSettings = host->GetThreadSettings();
+    bool hasThreadSettings = !(threadSettings.name.empty()) || !(threadSettings.cpus.empty()) ||
+        threadSettings.schedulingPolicy != Host::SchedulingPolicy::Default || threadSettings.priority != 0;
+    if (!(threadSettings.cpus.empty()))
+    {
+        this->m_reservedCpus.emplace(hostId, std::move(threadSettings.cpus));
+        try
+        {
+            this->PinThreadPoolWorkers();
+        }
+        catch (...)
+        {
+            this->m_reservedCpus.erase(hostId);
+            throw;
+        }
+    }
+
+    // A host with its own threads only needs a pool for the hypervisor's operations on it
+    size_t node = static_cast<size_t>(hostId) % this->m_threadPools.size();
+    if (!hasThreadSettings)
+    {
+        node = this->m_nextNode++ % this->m_threadPools.size();
+        static_cast<Host::Impl*>(host->GetImpl())->SetExecutor(this->m_threadPools[node]);
+    }
+
+    this->m_hostNodes.emplace(hostId, node);
     this->m_hosts.emplace(hostId, std::move(host));
     return hostId;
 }
 
 void HostHypervisor::Impl::RemoveHost(int hostId)
 {
+    this->DetachChannelsOfHost(hostId);
     this->m_hosts.erase(hostId);
+    this->m_hostNodes.erase(hostId);
+    if (this->m_reservedCpus.erase(hostId) != 0)
+    {
+        this->PinThreadPoolWorkers();
+    }
 }
 
 std::string HostHypervisor::Impl::GetHostName(int hostId) const
@@ -51,7 +98,19 @@ void HostHypervisor::Impl::RunHost(int hostId) const
 
 void HostHypervisor::Impl::RemoveAllHosts()
 {
+    for (auto& channel : this->m_channels)
+    {
+        channel.second.channel->Close();
+    }
+
+    this->m_channels.clear();
     this->m_hosts.clear();
+    this->m_hostNodes.clear();
+    if (!(this->m_reservedCpus.empty()))
+    {
+        this->m_reservedCpus.clear();
+        this->PinThreadPoolWorkers();
+    }
 }
 
 std::map<int, std::string> HostHypervisor::Impl::GetHostNames() const
@@ -89,23 +148,210 @@ void HostHypervisor::Impl::RunHostsOnCurrentThread() const
     this->m_hosts.begin()->second->RunOnCurrentThread();
 }
 
+int HostHypervisor::Impl::ConnectHosts(
+    int sourceHostId,
+    const std::string& outputPortFullName,
+    int destinationHostId,
+    const std::string& inputPortFullName,
+    size_t capacity,
+    int pollingIntervalInMilliseconds)
+{
+    if (sourceHostId == destinationHostId)
+    {
+        throw std::invalid_argument("Ports in the same host must be connected within its model");
+    }
+
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("A channel must have room for at least one event");
+    }
+
+    auto sourceHost = static_cast<Host::Impl*>(this->m_hosts.at(sourceHostId)->GetImpl());
+    auto destinationHost = static_cast<Host::Impl*>(this->m_hosts.at(destinationHostId)->GetImpl());
+    sourceHost->ValidateChannelsCanChange();
+    auto channel = std::make_shared<HostChannel>(outputPortFullName, inputPortFullName, capacity);
+#ifdef __linux__
+    if (this->m_channelWakeupLoop == nullptr)
+    {
+        this->m_channelWakeupLoop = std::make_shared<IOLoop>();
+        this->m_channelWakeupLoop->SetDispatching(true);
+    }
+#endif
+
+    destinationHost->AttachInboundChannel(channel, pollingIntervalInMilliseconds, this->m_channelWakeupLoop);
+    try
+    {
+        sourceHost->AttachOutboundChannel(channel);
+    }
+    catch (...)
+    {
+        destinationHost->DetachInboundChannel(channel.get());
+        throw;
+    }
+
+    int channelId = this->m_nextChannelId++;
+    this->m_channels.emplace(channelId, Channel{ sourceHostId, destinationHostId, std::move(channel) });
+    return channelId;
+}
+
+void HostHypervisor::Impl::DisconnectHosts(int channelId)
+{
+    auto channel = this->m_channels.find(channelId);
+    if (channel == this->m_channels.end())
+    {
+        return;
+    }
+
+    auto sourceHost = static_cast<Host::Impl*>(this->m_hosts.at(channel->second.sourceHostId)->GetImpl());
+    auto destinationHost = static_cast<Host::Impl*>(this->m_hosts.at(channel->second.destinationHostId)->GetImpl());
+    sourceHost->ValidateChannelsCanChange();
+    destinationHost->ValidateChannelsCanChange();
+    channel->second.channel->Close();
+    sourceHost->DetachOutboundChannel(channel->second.channel.get());
+    destinationHost->DetachInboundChannel(channel->second.channel.get());
+    this->m_channels.erase(channel);
+}
+
+std::vector<HostHypervisor::ChannelReport> HostHypervisor::Impl::GetChannels() const
+{
+    std::vector<HostHypervisor::ChannelReport> reports{};
+    reports.reserve(this->m_channels.size());
+    for (const auto& entry : this->m_channels)
+    {
+        const HostChannel& channel = *(entry.second.channel);
+        HostHypervisor::ChannelReport report{};
+        report.id = entry.first;
+        report.sourceHostId = entry.second.sourceHostId;
+        report.outputPortName = channel.outputPortName;
+        report.destinationHostId = entry.second.destinationHostId;
+        report.inputPortName = channel.inputPortName;
+        report.capacity = channel.GetCapacity();
+        report.numberOfEventsSent = channel.GetNumberOfEventsSent();
+        report.numberOfEventsReceived = channel.GetNumberOfEventsReceived();
+        report.numberOfEventsDropped = channel.GetNumberOfEventsDropped();
+        report.maxLogicalLatency = channel.GetMaxLogicalLatency();
+        reports.push_back(std::move(report));
+    }
+
+    return reports;
+}
+
+// The removed host's end of each channel goes with it; the other end is detached unless that host is running
+void HostHypervisor::Impl::DetachChannelsOfHost(int hostId)
+{
+    for (auto it = this->m_channels.begin(); it != this->m_channels.end();)
+    {
+        const Channel& channel = it->second;
+        if (channel.sourceHostId != hostId && channel.destinationHostId != hostId)
+        {
+            ++it;
+            continue;
+        }
+
+        channel.channel->Close();
+        bool isSource = (channel.sourceHostId == hostId);
+        auto otherHost = static_cast<Host::Impl*>(this->m_hosts.at(isSource ? channel.destinationHostId : channel.sourceHostId)->GetImpl());
+        try
+        {
+            if (isSource)
+            {
+                otherHost->DetachInboundChannel(channel.channel.get());
+            }
+            else
+            {
+                otherHost->DetachOutboundChannel(channel.channel.get());
+            }
+        }
+        catch (const std::logic_error&)
+        {
+        }
+
+        it = this->m_channels.erase(it);
+    }
+}
+
 void HostHypervisor::Impl::RunMethodOnAllHosts(std::function<void(const HostHypervisor::Impl&, int)> hypervisorMethod) const
 {
-    std::vector<std::future<void>> tasks;
+    this->RunTaskForEachHost(
+        [this, &hypervisorMethod](int hostId)
+        {
+            hypervisorMethod(*this, hostId);
+        });
+}
+
+// Runs the task for every host on the thread pool of its node and waits for all of them to finish. As with the futures this
+// replaces, an exception thrown by a task is not passed on to the caller.
+void HostHypervisor::Impl::RunTaskForEachHost(const std::function<void(int)>& task) const
+{
+    std::mutex mutex;
+    std::condition_variable allTasksFinished;
+    size_t numberOfUnfinishedTasks = this->m_hosts.size();
     for (auto it = this->m_hosts.begin(); it != this->m_hosts.end(); ++it)
     {
-        tasks.emplace_back(std::async(
-            std::launch::async,
-            [this, &hypervisorMethod](int hostId)
+        int hostId = it->first;
+        this->m_threadPools[this->m_hostNodes.at(hostId)]->Execute(
+            [&task, &mutex, &allTasksFinished, &numberOfUnfinishedTasks, hostId]()
             {
-                hypervisorMethod(*this, hostId);
-            },
-            it->first));
+                try
+                {
+                    task(hostId);
+                }
+                catch (...)
+                {
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--numberOfUnfinishedTasks == 0)
+                {
+                    allTasksFinished.notify_one();
+                }
+            });
     }
 
-    while (!tasks.empty())
+    std::unique_lock<std::mutex> lock(mutex);
+    allTasksFinished.wait(lock, [&numberOfUnfinishedTasks]() { return numberOfUnfinishedTasks == 0; });
+}
+
+// The workers of a node whose CPUs are all reserved run on the CPUs left on other nodes. If no CPU is left at all, the
+// workers are left as they were and invalid_argument is thrown.
+void HostHypervisor::Impl::PinThreadPoolWorkers()
+{
+    std::vector<std::vector<int>> nodeWorkerCpus{};
+    std::vector<int> allWorkerCpus{};
+    for (const std::vector<int>& nodeCpus : this->m_numaNodeCpus)
     {
-        tasks.back().wait();
-        tasks.pop_back();
+        std::vector<int> cpus{};
+        for (int cpu : nodeCpus)
+        {
+            bool isReserved = std::any_of(
+                this->m_reservedCpus.begin(),
+                this->m_reservedCpus.end(),
+                [cpu](const std::pair<const int, std::vector<int>>& entry)
+                {
+                    return std::find(entry.second.begin(), entry.second.end(), cpu) != entry.second.end();
+                });
+            if (!isReserved)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+
+        allWorkerCpus.insert(allWorkerCpus.end(), cpus.begin(), cpus.end());
+        nodeWorkerCpus.push_back(std::move(cpus));
+    }
+
+    if (allWorkerCpus.empty())
+    {
+        throw std::invalid_argument("Hosts cannot reserve every CPU, since the hypervisor's thread pools need one to run on");
     }
-}
\ No newline at end of file
+
+    for (size_t node = 0; node < this->m_threadPools.size(); ++node)
+    {
+        const std::vector<int>& workerCpus = (nodeWorkerCpus[node].empty() ? allWorkerCpus : nodeWorkerCpus[node]);
+        WorkStealingThreadPool& threadPool = *(this->m_threadPools[node]);
+        for (size_t i = 0; i < threadPool.GetNumberOfThreads(); ++i)
+        {
+            threadPool.SetWorkerAffinity(i, workerCpus);
+        }
+    }
+}
@@ -5,11 +5,31 @@
 #define HOST_HYPERVISOR_IMPL_H
 
 #include <atomic>
-#include <future>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include "AccessorFramework/Host.h"
+#include "HostChannel.h"
+#include "WorkStealingThreadPool.h"
 
+class IOLoop;
+
+// Description
+// The HostHypervisor::Impl owns a set of hosts and one work-stealing thread pool per NUMA node the process may run on,
+// with one worker per CPU of the node. Hosts are given to the nodes' pools in turn as their executor, and since a pool's
+// workers only steal from each other, a host stays on the node it was given. Operations on all hosts are submitted to
+// the pools as one task per host, so the number of threads stays the same however many hosts there are.
+//
+// A host with thread settings (a name, CPUs, or a scheduling policy or priority) keeps its own executor so that they are
+// applied. While it belongs to the hypervisor, the CPUs it lists are reserved for it: the workers of each pool are
+// pinned to the rest of their node, or, if the whole node is reserved, to the CPUs left on other nodes. A host that would
+// leave the pools no CPU at all is rejected.
+//
+// The hypervisor keeps the channels it has connected between its hosts, each of which is attached to the output port of
+// one host and the input port of another. When a host is removed, its channels are closed and detached from the other
+// host; if the other host is running, its end stays attached, closed, until that host is removed too. On Linux, one
+// IOLoop, created with the first channel, watches the wakeups of all the channels and wakes their receiving hosts.
+//
 class HostHypervisor::Impl
 {
 public:
@@ -33,41 +53,59 @@ protected:
     void RunHosts() const;
     void RunHostsOnCurrentThread() const;
 
+    int ConnectHosts(
+        int sourceHostId,
+        const std::string& outputPortFullName,
+        int destinationHostId,
+        const std::string& inputPortFullName,
+        size_t capacity,
+        int pollingIntervalInMilliseconds);
+    void DisconnectHosts(int channelId);
+    std::vector<HostHypervisor::ChannelReport> GetChannels() const;
+
 private:
     friend class HostHypervisor;
 
     void RunMethodOnAllHosts(std::function<void(const HostHypervisor::Impl&, int)> hypervisorMethod) const;
+    void RunTaskForEachHost(const std::function<void(int)>& task) const;
+    void PinThreadPoolWorkers();
+    void DetachChannelsOfHost(int hostId);
 
     template<typename T>
     std::map<int, T> RunMethodOnAllHostsWithResult(std::function<T(const HostHypervisor::Impl&, int)> hypervisorMethod) const
     {
         std::map<int, T> results;
         std::mutex resultsMutex;
-        std::vector<std::future<void>> tasks;
-        for (auto it = this->m_hosts.begin(); it != this->m_hosts.end(); ++it)
-        {
-            tasks.emplace_back(std::async(
-                std::launch::async,
-                [this, &hypervisorMethod, &results, &resultsMutex](int hostId)
-                {
-                    T result = hypervisorMethod(*this, hostId);
-                    std::lock_guard<std::mutex> lock(resultsMutex);
-                    results.emplace(hostId, result);
-                },
-                it->first));
-        }
-
-        while (!tasks.empty())
-        {
-            tasks.back().wait();
-            tasks.pop_back();
-        }
+        this->RunTaskForEachHost(
+            [this, &hypervisorMethod, &results, &resultsMutex](int hostId)
+            {
+                T result = hypervisorMethod(*this, hostId);
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                results.emplace(hostId, result);
+            });
 
         return results;
     }
 
     std::atomic_int m_nextHostId;
+
+    std::vector<std::vector<int>> m_numaNodeCpus;
+    std::vector<std::shared_ptr<WorkStealingThreadPool>> m_threadPools; // by node, in the order of m_numaNodeCpus
+    std::map<int, size_t> m_hostNodes; // the node whose pool runs each host's operations, by host ID
+    size_t m_nextNode;
+    std::map<int, std::vector<int>> m_reservedCpus; // by the ID of the host they are reserved for
     std::map<int, std::unique_ptr<Host>> m_hosts;
+
+    struct Channel
+    {
+        int sourceHostId;
+        int destinationHostId;
+        std::shared_ptr<HostChannel> channel;
+    };
+
+    std::map<int, Channel> m_channels;
+    int m_nextChannelId;
+    std::shared_ptr<IOLoop> m_channelWakeupLoop;
 };
 
 #endif // HOST_HYPERVISOR_IMPL_H
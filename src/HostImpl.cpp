@@ -4,27 +4,75 @@
 #include "AtomicAccessorImpl.h"
 #include "CompositeAccessorImpl.h"
 #include "HostImpl.h"
-#include "PrintDebug.h"
+#include "IOLoop.h"
+#include "Logger.h"
+#include "ThreadExecutor.h"
+#include <algorithm>
 #include <cassert>
+#include <climits>
+#include <numeric>
+#include <queue>
+#include <sstream>
 #include <thread>
+#include <unordered_set>
 
 static const int UpdateModelPriority = 0;
 static const int HostPriority = UpdateModelPriority + 1;
+static const size_t ListenerQueueCapacity = 256;
+
+// Scales the time of the timed reactions up to all reactions
+static std::chrono::nanoseconds EstimateTotalTime(unsigned long long timedNanoseconds, unsigned long long numberOfReactions, unsigned long long numberOfTimedReactions)
+{
+    if (numberOfTimedReactions == 0ULL)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    long double scale = static_cast<long double>(numberOfReactions) / static_cast<long double>(numberOfTimedReactions);
+    return std::chrono::nanoseconds(static_cast<long long>(static_cast<long double>(timedNanoseconds) * scale));
+}
+
 
 Host::Impl::Impl(const std::string& name, Host* container, std::function<void(Accessor&)> initializeFunction) :
     CompositeAccessor::Impl(name, container, initializeFunction),
     m_state(Host::State::NeedsSetup),
+    m_additionalSetupHasRun(false),
     m_director(std::make_unique<Director>()),
-    m_nextListenerId(0)
+    m_ioLoop(nullptr),
+    m_offloadStatistics(std::make_shared<OffloadPool::Statistics>()),
+    m_listenerDispatcher(std::make_shared<ListenerDispatcher>(ListenerQueueCapacity)),
+    m_reactionThreadPool(nullptr),
+    m_threadSettings{},
+    m_threadConfiguration(),
+    m_threadExecutor(nullptr),
+    m_reactionGroupsAreValid(false),
+    m_reactionPass(0),
+    m_nextLatencyProbeId(0),
+    m_criticalPathAnalyzer(nullptr),
+    m_channelPollingCallbackId(-1),
+    m_channelWakeupTime(0),
+    m_recorder(nullptr),
+    m_isRecording(false),
+    m_fingerprint(nullptr),
+    m_isFingerprinting(false)
 {
     this->m_priority = HostPriority;
 }
 
 Host::Impl::~Impl()
 {
+    for (InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        UnwatchChannelWakeup(inboundChannel);
+    }
+
+    this->m_director->StopExecution();
+    this->m_director->WaitForExecutionToStop();
+    this->SetIODispatching(false);
     this->RemoveAllChildren();
     this->ClearAllScheduledCallbacks();
     this->m_director.reset(nullptr);
+    this->m_ioLoop.reset();
 }
 
 Host::State Host::Impl::GetState() const
@@ -34,20 +82,111 @@ Host::State Host::Impl::GetState() const
 
 bool Host::Impl::EventListenerIsRegistered(int listenerId) const
 {
-    bool registered = (this->m_listeners.find(listenerId) != this->m_listeners.end());
-    return registered;
+    return this->m_listenerDispatcher->ListenerIsRegistered(listenerId);
 }
 
 int Host::Impl::AddEventListener(std::weak_ptr<Host::EventListener> listener)
 {
-    int listenerId = this->m_nextListenerId++;
-    this->m_listeners.emplace(listenerId, std::move(listener));
-    return listenerId;
+    return this->m_listenerDispatcher->AddListener(std::move(listener));
 }
 
 void Host::Impl::RemoveEventListener(int listenerId)
 {
-    this->m_listeners.erase(listenerId);
+    this->m_listenerDispatcher->RemoveListener(listenerId);
+}
+
+// Notifications are only posted from other threads while the host is running
+void Host::Impl::SetListenerExecutor(std::shared_ptr<Executor> executor)
+{
+    if (this->m_state.load() == Host::State::Running)
+    {
+        throw std::logic_error("The listener executor cannot be changed while the host is running");
+    }
+
+    this->m_listenerDispatcher->SetExecutor(executor != nullptr ? std::move(executor) : this->m_threadExecutor);
+}
+
+void Host::Impl::WaitForEventListeners() const
+{
+    this->m_listenerDispatcher->WaitForDelivery();
+}
+
+Host::ListenerMetrics Host::Impl::GetListenerMetrics() const
+{
+    return Host::ListenerMetrics{
+        this->m_listenerDispatcher->GetNumberOfNotificationsPosted(),
+        this->m_listenerDispatcher->GetNumberOfNotificationsDelivered(),
+        this->m_listenerDispatcher->GetNumberOfNotificationsDropped(),
+        this->m_listenerDispatcher->GetCapacity()
+    };
+}
+
+void Host::Impl::EnableParallelReactions(unsigned int numberOfThreads)
+{
+    Host::State state = this->m_state.load();
+    if (state != Host::State::NeedsSetup && state != Host::State::SettingUp)
+    {
+        throw std::logic_error("Parallel reactions must be enabled before the host is set up");
+    }
+
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    this->m_reactionThreadPool = (numberOfThreads > 1 ? std::make_unique<ThreadPool>(numberOfThreads, this->m_threadConfiguration) : nullptr);
+    this->m_reactionGroupsAreValid = false;
+}
+
+// Threads that already exist are replaced by ones that apply the settings
+void Host::Impl::SetThreadSettings(const Host::ThreadSettings& settings)
+{
+    Host::State state = this->m_state.load();
+    if (state != Host::State::NeedsSetup && state != Host::State::SettingUp)
+    {
+        throw std::logic_error("Thread settings must be set before the host is set up");
+    }
+    else if (this->m_ioLoop != nullptr)
+    {
+        throw std::logic_error("Thread settings must be set before I/O accessors watch their first file descriptor");
+    }
+
+    this->m_threadConfiguration = ThreadConfiguration(settings, this->GetName());
+    this->m_threadSettings = settings;
+    this->m_threadExecutor = std::make_shared<ThreadExecutor>(this->m_threadConfiguration);
+    if (this->m_director->GetExecutor() == ThreadExecutor::GetDefault())
+    {
+        this->SetExecutor(this->m_threadExecutor);
+    }
+
+    if (this->m_listenerDispatcher->GetExecutor() == ThreadExecutor::GetDefault())
+    {
+        this->m_listenerDispatcher->SetExecutor(this->m_threadExecutor);
+    }
+
+    if (this->m_reactionThreadPool != nullptr)
+    {
+        size_t numberOfThreads = this->m_reactionThreadPool->GetNumberOfThreads();
+        this->m_reactionThreadPool = std::make_unique<ThreadPool>(numberOfThreads, this->m_threadConfiguration);
+    }
+}
+
+Host::ThreadSettings Host::Impl::GetThreadSettings() const
+{
+    return this->m_threadSettings;
+}
+
+// Any round in progress is stopped; the Director hands its rounds to the new executor once the host runs
+void Host::Impl::SetExecutor(std::shared_ptr<Executor> executor)
+{
+    if (this->m_ioLoop != nullptr)
+    {
+        throw std::logic_error("A host with I/O accessors always runs on its own I/O loop");
+    }
+
+    this->m_director->StopExecution();
+    this->m_director->WaitForExecutionToStop();
+    this->m_director->SetExecutor(executor != nullptr ? std::move(executor) : this->m_threadExecutor);
 }
 
 void Host::Impl::Setup()
@@ -58,12 +197,23 @@ void Host::Impl::Setup()
     }
 
     this->SetState(Host::State::SettingUp);
-    static_cast<Host*>(this->m_container)->AdditionalSetup();
+    this->RunAdditionalSetup();
     this->ComputeAccessorPriorities();
     this->Initialize();
     this->SetState(Host::State::ReadyToRun);
 }
 
+// A host whose Restore() was rejected after AdditionalSetup() ran still needs setup, and Setup() must not build the rest
+// of its model a second time
+void Host::Impl::RunAdditionalSetup()
+{
+    if (!(this->m_additionalSetupHasRun))
+    {
+        this->m_additionalSetupHasRun = true;
+        static_cast<Host*>(this->m_container)->AdditionalSetup();
+    }
+}
+
 void Host::Impl::Iterate(int numberOfIterations)
 {
     this->ValidateHostCanRun();
@@ -73,10 +223,10 @@ void Host::Impl::Iterate(int numberOfIterations)
     {
         this->m_director->Execute(numberOfIterations);
     }
-    catch (const std::exception& e)
+    catch (const std::exception&)
     {
         this->m_state.store(Host::State::Corrupted);
-        this->NotifyListenersOfException(e);
+        this->NotifyListenersOfException(std::current_exception());
     }
 
     this->SetState(Host::State::Paused);
@@ -89,60 +239,281 @@ void Host::Impl::Pause()
         throw std::logic_error("Host is not running");
     }
 
+    this->SetIODispatching(false);
     this->m_director->StopExecution();
+    this->m_director->WaitForExecutionToStop();
     this->SetState(Host::State::Paused);
 }
 
 void Host::Impl::Run()
 {
     this->ValidateHostCanRun();
-    bool retry = false;
-    do
-    {
-        retry = false;
-        try
-        {
-            std::thread(&Host::Impl::RunOnCurrentThread, this).detach();
-        }
-        catch (const std::system_error& e)
-        {
-            if (e.code() == std::errc::resource_unavailable_try_again)
-            {
-                retry = true;
-            }
-            else
-            {
-                throw;
-            }
-        }
-    } while (retry);
+    this->SetState(Host::State::Running);
+    this->m_director->Start([this](std::exception_ptr exception) { this->HandleExecutionException(exception); });
+    this->SetIODispatching(true);
+}
+
+void Host::Impl::Run(std::shared_ptr<Executor> executor)
+{
+    this->ValidateHostCanRun();
+    this->SetExecutor(std::move(executor));
+    this->Run();
 }
 
 void Host::Impl::RunOnCurrentThread()
 {
     this->ValidateHostCanRun();
     this->SetState(Host::State::Running);
+    this->SetIODispatching(true);
 
     try
     {
         this->m_director->Execute();
     }
-    catch (const std::exception& e)
+    catch (const std::exception&)
     {
         this->m_state.store(Host::State::Corrupted);
-        this->NotifyListenersOfException(e);
+        this->NotifyListenersOfException(std::current_exception());
     }
 
     this->SetState(Host::State::Paused);
 }
 
+// A host that is being polled stays in the Running state between calls
+std::chrono::system_clock::time_point Host::Impl::Poll(std::chrono::system_clock::time_point now)
+{
+    if (this->m_ioLoop != nullptr)
+    {
+        throw std::logic_error("A host with I/O accessors cannot be polled");
+    }
+
+    if (this->m_state.load() != Host::State::Running || !(this->m_director->IsPolled()))
+    {
+        this->ValidateHostCanRun();
+        this->SetState(Host::State::Running);
+    }
+
+    // A channel's wakeup is handled on another thread, so a polled host looks for sent events itself
+    long long stamp = 0;
+    if (std::any_of(
+        this->m_inboundChannels.begin(),
+        this->m_inboundChannels.end(),
+        [&stamp](const InboundChannel& inboundChannel) { return inboundChannel.channel->PeekLogicalTime(stamp); }))
+    {
+        this->m_director->Wake();
+    }
+
+    long long currentTimeInMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    try
+    {
+        long long nextExecutionTimeInMilliseconds = this->m_director->Poll(currentTimeInMilliseconds);
+        if (nextExecutionTimeInMilliseconds != LLONG_MAX)
+        {
+            return std::chrono::system_clock::time_point(std::chrono::milliseconds(nextExecutionTimeInMilliseconds));
+        }
+    }
+    catch (const std::exception&)
+    {
+        this->m_state.store(Host::State::Corrupted);
+        this->NotifyListenersOfException(std::current_exception());
+        this->SetState(Host::State::Paused);
+    }
+
+    return std::chrono::system_clock::time_point::max();
+}
+
 void Host::Impl::Exit()
 {
     this->SetState(Host::State::Exiting);
     this->m_director->StopExecution();
+    this->m_director->WaitForExecutionToStop();
     this->SetState(Host::State::Finished);
 }
 
+Host::OffloadMetrics Host::Impl::GetOffloadMetrics() const
+{
+    return this->m_offloadStatistics->GetMetrics();
+}
+
+std::vector<Host::AccessorProfile> Host::Impl::GetProfile() const
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(const_cast<Host::Impl*>(this), atomicAccessors);
+    std::vector<Host::AccessorProfile> profile{};
+    profile.reserve(atomicAccessors.size());
+    for (const AtomicAccessor::Impl* atomicAccessor : atomicAccessors)
+    {
+        const auto& counters = atomicAccessor->GetReactionCounters();
+        Host::AccessorProfile accessorProfile{};
+        accessorProfile.name = atomicAccessor->GetFullName();
+        accessorProfile.numberOfReactions = counters.numberOfReactions.Get();
+        accessorProfile.numberOfTimedReactions = counters.numberOfTimedReactions.Get();
+        accessorProfile.totalInputHandlerTime = EstimateTotalTime(counters.totalInputHandlerNanoseconds.Get(), accessorProfile.numberOfReactions, accessorProfile.numberOfTimedReactions);
+        accessorProfile.maxInputHandlerTime = std::chrono::nanoseconds(counters.maxInputHandlerNanoseconds.Get());
+        accessorProfile.totalFireTime = EstimateTotalTime(counters.totalFireNanoseconds.Get(), accessorProfile.numberOfReactions, accessorProfile.numberOfTimedReactions);
+        accessorProfile.maxFireTime = std::chrono::nanoseconds(counters.maxFireNanoseconds.Get());
+        for (const InputPort* inputPort : atomicAccessor->GetInputPorts())
+        {
+            accessorProfile.inputPorts.push_back(GetPortProfile(inputPort));
+        }
+
+        for (const OutputPort* outputPort : atomicAccessor->GetOutputPorts())
+        {
+            accessorProfile.outputPorts.push_back(GetPortProfile(outputPort));
+        }
+
+        profile.push_back(std::move(accessorProfile));
+    }
+
+    return profile;
+}
+
+void Host::Impl::ResetProfile()
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    for (AtomicAccessor::Impl* atomicAccessor : atomicAccessors)
+    {
+        atomicAccessor->ResetCounters();
+    }
+}
+
+// A host that is being polled only executes during calls to Poll(), so probes can be added and removed between them
+int Host::Impl::AddLatencyProbe(const std::string& outputPortFullName, const std::string& inputPortFullName)
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Latency probes cannot be added while the host is running");
+    }
+
+    Port* outputPort = FindAtomicAccessorPort(this, outputPortFullName, false /*isInputPort*/);
+    Port* inputPort = FindAtomicAccessorPort(this, inputPortFullName, true /*isInputPort*/);
+    if (!IsDownstream(inputPort, outputPort))
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Input port " << inputPortFullName << " is not downstream of output port " << outputPortFullName;
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+
+    int probeId = this->m_nextLatencyProbeId++;
+    auto latencyProbe = std::make_shared<LatencyProbe>(probeId, outputPortFullName, inputPortFullName);
+    outputPort->AddLatencyProbe(latencyProbe);
+    inputPort->AddLatencyProbe(latencyProbe);
+    this->m_latencyProbes.emplace(probeId, std::move(latencyProbe));
+    return probeId;
+}
+
+// The probe's ports may have been removed along with their accessors, in which case there is nothing to detach
+void Host::Impl::RemoveLatencyProbe(int probeId)
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Latency probes cannot be removed while the host is running");
+    }
+
+    auto latencyProbe = this->m_latencyProbes.find(probeId);
+    if (latencyProbe == this->m_latencyProbes.end())
+    {
+        return;
+    }
+
+    const std::string* portNames[] = { &latencyProbe->second->outputPortName, &latencyProbe->second->inputPortName };
+    for (int i = 0; i < 2; ++i)
+    {
+        try
+        {
+            FindAtomicAccessorPort(this, *(portNames[i]), i == 1 /*isInputPort*/)->RemoveLatencyProbe(latencyProbe->second.get());
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    this->m_latencyProbes.erase(latencyProbe);
+}
+
+std::vector<Host::LatencyProbeReport> Host::Impl::GetLatencyProbes() const
+{
+    std::vector<Host::LatencyProbeReport> reports{};
+    reports.reserve(this->m_latencyProbes.size());
+    for (const auto& latencyProbe : this->m_latencyProbes)
+    {
+        reports.push_back(latencyProbe.second->GetReport());
+    }
+
+    return reports;
+}
+
+void Host::Impl::ResetLatencyProbes()
+{
+    for (auto& latencyProbe : this->m_latencyProbes)
+    {
+        latencyProbe.second->Reset();
+    }
+}
+
+Host::AllocationProfile Host::Impl::GetAllocationProfile() const
+{
+    const AllocationAccount& account = this->m_director->GetAllocationAccount();
+    Host::AllocationProfile profile{};
+    profile.total = account.total.Get();
+    profile.director = account.subsystems[static_cast<size_t>(AllocationSubsystem::Director)].Get();
+    profile.ports = account.subsystems[static_cast<size_t>(AllocationSubsystem::Ports)].Get();
+    profile.reactions = account.subsystems[static_cast<size_t>(AllocationSubsystem::Reactions)].Get();
+    std::vector<Accessor::Impl*> descendants{};
+    GetDescendants(const_cast<Host::Impl*>(this), descendants);
+    for (Accessor::Impl* descendant : descendants)
+    {
+        profile.accessors.push_back({ descendant->GetFullName(), descendant->GetAllocationCounters().Get() });
+    }
+
+    return profile;
+}
+
+void Host::Impl::ResetAllocationProfile()
+{
+    this->m_director->GetAllocationAccount().Reset();
+    std::vector<Accessor::Impl*> descendants{};
+    GetDescendants(this, descendants);
+    for (Accessor::Impl* descendant : descendants)
+    {
+        descendant->GetAllocationCounters().Reset();
+    }
+}
+
+// The depths are the ones cached when the priorities were last computed, and the lock keeps the director from
+// recomputing them, and renumbering the ports, while the graph is built
+void Host::Impl::ExportGraph(std::ostream& stream, Host::GraphFormat format, bool includeTraffic)
+{
+    Host::State state = this->m_state.load();
+    if (state == Host::State::NeedsSetup || state == Host::State::SettingUp)
+    {
+        throw std::logic_error("The model graph cannot be exported until the host is set up");
+    }
+
+    ModelGraph modelGraph{};
+    modelGraph.includesTraffic = includeTraffic;
+    {
+        std::lock_guard<std::mutex> lock(this->m_modelDepthsMutex);
+        std::unordered_map<const Accessor::Impl*, int> accessorDepths{};
+        for (const AccessorDepth& entry : this->m_accessorDepths)
+        {
+            accessorDepths.emplace(entry.accessor, entry.depth);
+        }
+
+        this->AddToModelGraph(this, -1, this->m_portDepths, accessorDepths, includeTraffic, modelGraph);
+    }
+
+    if (format == Host::GraphFormat::Dot)
+    {
+        modelGraph.WriteDot(stream);
+    }
+    else
+    {
+        modelGraph.WriteJson(stream);
+    }
+}
+
 void Host::Impl::AddInputPort(const std::string& portName)
 {
     throw std::logic_error("Hosts are not allowed to have ports");
@@ -169,7 +540,7 @@ void Host::Impl::ChildrenChanged()
     this->ScheduleCallback(
         [this]()
         {
-            PRINT_DEBUG("%s is updating the model", this->GetName().c_str());
+            LOG_DEBUG("%s is updating the model", this->GetName().c_str());
             this->ComputeAccessorPriorities(true /*updateCallbacks*/);
             for (auto child : this->GetChildren())
             {
@@ -197,6 +568,50 @@ Director* Host::Impl::GetDirector() const
     return this->m_director.get();
 }
 
+std::shared_ptr<OffloadPool::Statistics> Host::Impl::GetOffloadStatistics() const
+{
+    return this->m_offloadStatistics;
+}
+
+IOLoop* Host::Impl::GetIOLoop()
+{
+#ifdef __linux__
+    if (this->m_ioLoop == nullptr)
+    {
+        if (this->m_state.load() == Host::State::Running)
+        {
+            throw std::logic_error("I/O accessors must watch their first file descriptor before the host runs");
+        }
+
+        auto ioLoop = std::make_shared<IOLoop>(this->m_threadConfiguration);
+        this->SetExecutor(ioLoop);
+        this->m_ioLoop = std::move(ioLoop);
+    }
+
+    return this->m_ioLoop.get();
+#else
+    return nullptr;
+#endif
+}
+
+void Host::Impl::ProcessChildEventQueue()
+{
+    AllocationScope allocationScope(AllocationSubsystem::Reactions);
+    if (this->m_criticalPathAnalyzer != nullptr)
+    {
+        this->m_criticalPathAnalyzer->BeginPass(this->m_director->GetCurrentLogicalTime());
+    }
+
+    if (this->ProcessReactionGroupsInParallel())
+    {
+        LOG_DEBUG("%s has finished reacting to all inputs", this->GetName().c_str());
+    }
+    else
+    {
+        CompositeAccessor::Impl::ProcessChildEventQueue();
+    }
+}
+
 void Host::Impl::ValidateHostCanRun() const
 {
     if (this->m_state.load() == Host::State::Running)
@@ -209,8 +624,28 @@ void Host::Impl::ValidateHostCanRun() const
     }
 }
 
+void Host::Impl::HandleExecutionException(std::exception_ptr exception)
+{
+    try
+    {
+        std::rethrow_exception(exception);
+    }
+    catch (const std::exception&)
+    {
+        this->m_state.store(Host::State::Corrupted);
+        this->NotifyListenersOfException(std::current_exception());
+    }
+
+    this->SetState(Host::State::Paused);
+}
+
 void Host::Impl::SetState(Host::State newState)
 {
+    if (newState != Host::State::Running)
+    {
+        this->SetIODispatching(false);
+    }
+
     Host::State oldState = this->m_state.exchange(newState);
     if (oldState != newState)
     {
@@ -218,215 +653,861 @@ void Host::Impl::SetState(Host::State newState)
     }
 }
 
-void Host::Impl::ComputeAccessorPriorities(bool updateCallbacks)
+// The I/O loop schedules callbacks on the Director directly, so readiness is only dispatched once the Director has started
+// and is stopped before anything else stops the Director
+void Host::Impl::SetIODispatching(bool isDispatching)
 {
-    std::map<int, std::vector<Accessor::Impl*>> accessorDepths{};
-    std::map<const Port*, int> portDepths{};
-    this->ComputeCompositeAccessorDepth(this, portDepths, accessorDepths);
-    int priority = HostPriority;
-    for (auto entry : accessorDepths)
+#ifdef __linux__
+    if (this->m_ioLoop != nullptr)
     {
-        priority = std::max(priority, entry.first);
-        for (auto accessor : entry.second)
-        {
-            if (updateCallbacks)
-            {
-                int oldPriority = accessor->GetPriority();
-                this->m_director->HandlePriorityUpdate(oldPriority, priority);
-            }
-            
-            accessor->SetPriority(priority);
-            ++priority;
-        }
+        this->m_ioLoop->SetDispatching(isDispatching);
     }
+#endif
 }
 
-int Host::Impl::ComputeCompositeAccessorDepth(CompositeAccessor::Impl* compositeAccessor, std::map<const Port*, int>& portDepths, std::map<int, std::vector<Accessor::Impl*>>& accessorDepths)
+void Host::Impl::ComputeAccessorPriorities(bool updateCallbacks)
 {
-    int minChildDepth = INT_MAX;
-    for (auto child : compositeAccessor->GetChildren())
+    this->ComputeAccessorDepths();
+    int priority = HostPriority;
+    for (const AccessorDepth& entry : this->m_accessorDepths)
     {
-        int childDepth = 0;
-        if (child->IsComposite())
+        priority = std::max(priority, entry.depth);
+        if (updateCallbacks)
         {
-            childDepth = this->ComputeCompositeAccessorDepth(static_cast<CompositeAccessor::Impl*>(child), portDepths, accessorDepths);
-        }
-        else
-        {
-            childDepth = this->ComputeAtomicAccessorDepth(static_cast<AtomicAccessor::Impl*>(child), portDepths, accessorDepths);
+            int oldPriority = entry.accessor->GetPriority();
+            this->m_director->HandlePriorityUpdate(oldPriority, priority);
         }
 
-        minChildDepth = std::min(minChildDepth, childDepth);
+        entry.accessor->SetPriority(priority);
+        ++priority;
     }
 
-    int accessorDepth = minChildDepth;
-    (accessorDepths[accessorDepth]).insert((accessorDepths[accessorDepth]).begin(), compositeAccessor);
-    return accessorDepth;
+    this->AttachToModel();
 }
 
-int Host::Impl::ComputeAtomicAccessorDepth(AtomicAccessor::Impl* atomicAccessor, std::map<const Port*, int>& portDepths, std::map<int, std::vector<Accessor::Impl*>>& accessorDepths)
+// Only the thread that sets up the host or updates its model writes the cache, so it reads the cache without the lock
+void Host::Impl::ComputeAccessorDepths()
 {
-    int maximumInputDepth = 0;
-    for (auto inputPort : atomicAccessor->GetInputPorts())
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    std::lock_guard<std::mutex> lock(this->m_modelDepthsMutex);
+    this->m_portDepths.clear();
+    this->ComputePortDepths(atomicAccessors, this->m_portDepths);
+    this->m_accessorDepths.clear();
+    this->m_accessorDepths.reserve(atomicAccessors.size());
+    this->ComputeCompositeAccessorDepth(this, this->m_portDepths, this->m_accessorDepths);
+    std::sort(this->m_accessorDepths.begin(), this->m_accessorDepths.end());
+}
+
+void Host::Impl::AttachToModel()
+{
+    this->m_reactionGroupsAreValid = false;
+    if (this->m_criticalPathAnalyzer != nullptr)
     {
-        if (portDepths.find(inputPort) == portDepths.end())
-        {
-            std::set<const InputPort*> visitedInputPorts{};
-            std::set<const OutputPort*> visitedOutputPorts{};
-            this->ComputeAtomicAccessorInputPortDepth(inputPort, portDepths, visitedInputPorts, visitedOutputPorts);
-        }
+        this->AttachCriticalPathAnalyzer(this->m_accessorDepths);
+    }
 
-        if (portDepths.at(inputPort) > maximumInputDepth)
-        {
-            maximumInputDepth = portDepths.at(inputPort);
-        }
+    if (!(this->m_inboundChannels.empty()))
+    {
+        this->FindInboundChannelPorts();
     }
 
-    int minimumOutputDepth = INT_MAX;
-    for (auto outputPort : atomicAccessor->GetOutputPorts())
+    if (this->m_isRecording)
     {
-        if (portDepths.find(outputPort) == portDepths.end())
-        {
-            std::set<const InputPort*> visitedInputPorts{};
-            std::set<const OutputPort*> visitedOutputPorts{};
-            this->ComputeAtomicAccessorOutputPortDepth(outputPort, portDepths, visitedInputPorts, visitedOutputPorts);
-        }
+        this->AttachRecorder(this->m_recorder.get());
+    }
 
-        if (portDepths.at(outputPort) < minimumOutputDepth)
+    if (this->m_isFingerprinting)
+    {
+        this->AttachFingerprint(this->m_fingerprint.get());
+    }
+}
+
+// A null recorder detaches the current one
+void Host::Impl::AttachRecorder(EventRecorder* recorder)
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    for (auto atomicAccessor : atomicAccessors)
+    {
+        for (auto port : atomicAccessor->GetOutputPorts())
         {
-            minimumOutputDepth = portDepths.at(outputPort);
+            if (port->IsSpontaneous())
+            {
+                OutputPort* outputPort = atomicAccessor->GetOutputPort(port->GetName());
+                outputPort->SetRecorder(recorder, recorder != nullptr ? recorder->AddStream(outputPort->GetFullName()) : 0);
+            }
         }
     }
 
-    int accessorDepth = (atomicAccessor->HasOutputPorts() ? minimumOutputDepth : maximumInputDepth);
-    accessorDepths[accessorDepth].push_back(atomicAccessor);
-    return accessorDepth;
+    for (InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        inboundChannel.recordingStreamId = (recorder != nullptr ? recorder->AddStream(inboundChannel.channel->inputPortName) : 0);
+    }
 }
 
-void Host::Impl::ComputeAtomicAccessorInputPortDepth(const InputPort* inputPort, std::map<const Port*, int>& portDepths, std::set<const InputPort*>& visitedInputPorts, std::set<const OutputPort*>& visitedOutputPorts)
+// A null fingerprint detaches the current one
+void Host::Impl::AttachFingerprint(ExecutionFingerprint* fingerprint)
 {
-    int depth = 0;
-    auto equivalentPorts = static_cast<AtomicAccessor::Impl*>(inputPort->GetOwner())->GetEquivalentPorts(inputPort);
-    for (auto equivalentPort : equivalentPorts)
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    for (auto atomicAccessor : atomicAccessors)
     {
-        visitedInputPorts.insert(equivalentPort);
-        if (equivalentPort->IsConnectedToSource())
+        for (auto port : atomicAccessor->GetInputPorts())
+        {
+            atomicAccessor->GetInputPort(port->GetName())->SetFingerprint(fingerprint);
+        }
+
+        for (auto port : atomicAccessor->GetOutputPorts())
         {
-            const OutputPort* sourceOutputPort = GetSourceOutputPort(equivalentPort);
-            if (sourceOutputPort == nullptr)
+            atomicAccessor->GetOutputPort(port->GetName())->SetFingerprint(fingerprint);
+        }
+    }
+
+    this->m_director->SetFingerprint(fingerprint);
+}
+
+// Each atomic accessor's reactions are recorded under its index in the analyzer; an accessor added since the model was
+// last updated is not recorded until it is
+void Host::Impl::AttachCriticalPathAnalyzer(const std::vector<AccessorDepth>& accessorDepths)
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    std::vector<CriticalPathAnalyzer::AccessorNode> nodes{};
+    std::unordered_map<const Accessor::Impl*, size_t> indices{};
+    for (const AccessorDepth& entry : accessorDepths)
+    {
+        if (!(entry.accessor->IsComposite()))
+        {
+            indices.emplace(entry.accessor, nodes.size());
+            atomicAccessors.push_back(static_cast<AtomicAccessor::Impl*>(entry.accessor));
+            nodes.push_back({ entry.accessor->GetFullName(), entry.depth, {} });
+        }
+    }
+
+    for (size_t i = 0; i < atomicAccessors.size(); ++i)
+    {
+        std::vector<size_t>& upstreamAccessors = nodes[i].upstreamAccessors;
+        for (auto inputPort : atomicAccessors[i]->GetInputPorts())
+        {
+            const OutputPort* sourceOutputPort = (inputPort->IsConnectedToSource() ? GetSourceOutputPort(inputPort) : nullptr);
+            auto upstreamAccessor = (sourceOutputPort == nullptr ? indices.end() : indices.find(sourceOutputPort->GetOwner()));
+            if (upstreamAccessor != indices.end() &&
+                std::find(upstreamAccessors.begin(), upstreamAccessors.end(), upstreamAccessor->second) == upstreamAccessors.end())
             {
-                // not connected to source
-                continue;
+                upstreamAccessors.push_back(upstreamAccessor->second);
             }
+        }
+    }
 
-            if (portDepths.find(sourceOutputPort) == portDepths.end())
+    this->m_criticalPathAnalyzer->SetModel(nodes);
+    for (size_t i = 0; i < atomicAccessors.size(); ++i)
+    {
+        atomicAccessors[i]->SetCriticalPathAnalyzer(this->m_criticalPathAnalyzer.get(), i);
+    }
+}
+
+// Every port in the model is given a dense index. The port graph is then reduced to one node per output port and one
+// node per input port equivalence class (represented by the first port in the class). An edge from an output port to an
+// equivalence class has weight 1 (the source depth), and an edge from an equivalence class to a dependent output port
+// has weight 0. Nodes are levelised in topological order; any node that is never reached lies on or downstream of a
+// causality loop.
+void Host::Impl::ComputePortDepths(const std::vector<AtomicAccessor::Impl*>& atomicAccessors, std::vector<int>& portDepths) const
+{
+    std::vector<const Port*> ports{};
+    std::vector<int> representatives{};
+    for (auto atomicAccessor : atomicAccessors)
+    {
+        const std::vector<const InputPort*> inputPorts = atomicAccessor->GetInputPorts();
+        for (auto inputPort : inputPorts)
+        {
+            inputPort->SetModelIndex(-1);
+        }
+
+        for (auto inputPort : inputPorts)
+        {
+            if (inputPort->GetModelIndex() == -1)
             {
-                if (visitedOutputPorts.find(sourceOutputPort) != visitedOutputPorts.end())
+                int representative = static_cast<int>(ports.size());
+                for (auto equivalentPort : atomicAccessor->GetEquivalentPorts(inputPort))
                 {
-                    std::ostringstream exceptionMessage;
-                    exceptionMessage << "Detected causality loop involving port " << sourceOutputPort->GetFullName();
-                    throw std::logic_error(exceptionMessage.str());
+                    equivalentPort->SetModelIndex(static_cast<int>(ports.size()));
+                    ports.push_back(equivalentPort);
+                    representatives.push_back(representative);
                 }
-                else
+            }
+        }
+
+        for (auto outputPort : atomicAccessor->GetOutputPorts())
+        {
+            outputPort->SetModelIndex(static_cast<int>(ports.size()));
+            ports.push_back(outputPort);
+            representatives.push_back(outputPort->GetModelIndex());
+        }
+    }
+
+    struct Edge
+    {
+        int source;
+        int destination;
+        int weight;
+    };
+
+    const int numberOfPorts = static_cast<int>(ports.size());
+    std::vector<Edge> edges{};
+    edges.reserve(numberOfPorts);
+    std::vector<int> lastEdgeSource(numberOfPorts, -1);
+    for (auto atomicAccessor : atomicAccessors)
+    {
+        for (auto inputPort : atomicAccessor->GetInputPorts())
+        {
+            if (!inputPort->IsConnectedToSource())
+            {
+                continue;
+            }
+
+            const OutputPort* sourceOutputPort = GetSourceOutputPort(inputPort);
+            if (sourceOutputPort == nullptr || sourceOutputPort->GetModelIndex() < 0 || sourceOutputPort->GetModelIndex() >= numberOfPorts || ports[sourceOutputPort->GetModelIndex()] != sourceOutputPort)
+            {
+                // not connected to a source in this model
+                continue;
+            }
+
+            edges.push_back({ sourceOutputPort->GetModelIndex(), representatives[inputPort->GetModelIndex()], 1 });
+        }
+
+        for (auto outputPort : atomicAccessor->GetOutputPorts())
+        {
+            int outputIndex = outputPort->GetModelIndex();
+            for (auto inputPort : atomicAccessor->GetInputPortDependencies(outputPort))
+            {
+                // Equivalent input ports share a node, so only one edge per class is needed
+                int representative = representatives[inputPort->GetModelIndex()];
+                if (lastEdgeSource[outputIndex] != representative)
                 {
-                    this->ComputeAtomicAccessorOutputPortDepth(sourceOutputPort, portDepths, visitedInputPorts, visitedOutputPorts);
+                    lastEdgeSource[outputIndex] = representative;
+                    edges.push_back({ representative, outputIndex, 0 });
                 }
             }
+        }
+    }
+
+    // Compressed adjacency lists
+    std::vector<int> edgeOffsets(numberOfPorts + 1, 0);
+    std::vector<int> inDegrees(numberOfPorts, 0);
+    for (const Edge& edge : edges)
+    {
+        ++edgeOffsets[edge.source + 1];
+        ++inDegrees[edge.destination];
+    }
 
-            int newDepth = portDepths.at(sourceOutputPort) + 1;
-            if (depth < newDepth)
+    for (int i = 0; i < numberOfPorts; ++i)
+    {
+        edgeOffsets[i + 1] += edgeOffsets[i];
+    }
+
+    std::vector<int> adjacentEdges(edges.size());
+    std::vector<int> nextEdgeSlot(edgeOffsets.begin(), edgeOffsets.end() - 1);
+    for (int i = 0; i < static_cast<int>(edges.size()); ++i)
+    {
+        adjacentEdges[nextEdgeSlot[edges[i].source]++] = i;
+    }
+
+    // Kahn's algorithm; the ready list doubles as the topological order
+    portDepths.assign(numberOfPorts, 0);
+    std::vector<int> readyNodes{};
+    readyNodes.reserve(numberOfPorts);
+    for (int i = 0; i < numberOfPorts; ++i)
+    {
+        if (inDegrees[i] == 0)
+        {
+            readyNodes.push_back(i);
+        }
+    }
+
+    for (size_t next = 0; next < readyNodes.size(); ++next)
+    {
+        int node = readyNodes[next];
+        for (int i = edgeOffsets[node]; i < edgeOffsets[node + 1]; ++i)
+        {
+            const Edge& edge = edges[adjacentEdges[i]];
+            portDepths[edge.destination] = std::max(portDepths[edge.destination], portDepths[node] + edge.weight);
+            if (--inDegrees[edge.destination] == 0)
             {
-                depth = newDepth;
+                readyNodes.push_back(edge.destination);
             }
         }
     }
 
-    for (auto equivalentPort : equivalentPorts)
+    if (static_cast<int>(readyNodes.size()) < numberOfPorts)
     {
-        PRINT_VERBOSE("Input port '%s' is now priority %d", equivalentPort->GetFullName().c_str(), depth);
-        portDepths[equivalentPort] = depth;
+        // Every unresolved node has at least one unresolved predecessor, so walking backwards through unresolved nodes
+        // must eventually revisit a node on the loop. Every loop passes through at least one output port.
+        std::vector<int> predecessors(numberOfPorts, -1);
+        for (const Edge& edge : edges)
+        {
+            if (inDegrees[edge.source] != 0 && inDegrees[edge.destination] != 0)
+            {
+                predecessors[edge.destination] = edge.source;
+            }
+        }
+
+        int node = 0;
+        while (inDegrees[node] == 0)
+        {
+            ++node;
+        }
+
+        std::vector<bool> visited(numberOfPorts, false);
+        while (!visited[node])
+        {
+            visited[node] = true;
+            node = predecessors[node];
+        }
+
+        while (dynamic_cast<const OutputPort*>(ports[node]) == nullptr)
+        {
+            node = predecessors[node];
+        }
+
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Detected causality loop involving port " << ports[node]->GetFullName();
+        throw std::logic_error(exceptionMessage.str());
+    }
+
+    // Input ports take the depth of their equivalence class
+    for (int i = 0; i < numberOfPorts; ++i)
+    {
+        portDepths[i] = portDepths[representatives[i]];
+        LOG_VERBOSE("Port '%s' is now priority %d", ports[i]->GetFullName().c_str(), portDepths[i]);
     }
 }
 
-void Host::Impl::ComputeAtomicAccessorOutputPortDepth(const OutputPort* outputPort, std::map<const Port*, int>& portDepths, std::set<const InputPort*>& visitedInputPorts, std::set<const OutputPort*>& visitedOutputPorts)
+int Host::Impl::ComputeCompositeAccessorDepth(CompositeAccessor::Impl* compositeAccessor, const std::vector<int>& portDepths, std::vector<AccessorDepth>& accessorDepths)
 {
-    visitedOutputPorts.insert(outputPort);
-    int depth = 0;
-    std::vector<const InputPort*> inputPortDependencies = static_cast<AtomicAccessor::Impl*>(outputPort->GetOwner())->GetInputPortDependencies(outputPort);
-    for (auto inputPort : inputPortDependencies)
+    int minChildDepth = INT_MAX;
+    for (auto child : compositeAccessor->GetChildren())
     {
-        if (portDepths.find(inputPort) == portDepths.end())
+        int childDepth = 0;
+        if (child->IsComposite())
         {
-            if (visitedInputPorts.find(inputPort) != visitedInputPorts.end())
+            childDepth = this->ComputeCompositeAccessorDepth(static_cast<CompositeAccessor::Impl*>(child), portDepths, accessorDepths);
+        }
+        else
+        {
+            childDepth = this->ComputeAtomicAccessorDepth(static_cast<AtomicAccessor::Impl*>(child), portDepths, accessorDepths);
+        }
+
+        minChildDepth = std::min(minChildDepth, childDepth);
+    }
+
+    int accessorDepth = minChildDepth;
+    accessorDepths.push_back({ accessorDepth, -static_cast<int>(accessorDepths.size()) - 1, compositeAccessor });
+    return accessorDepth;
+}
+
+int Host::Impl::ComputeAtomicAccessorDepth(AtomicAccessor::Impl* atomicAccessor, const std::vector<int>& portDepths, std::vector<AccessorDepth>& accessorDepths)
+{
+    int maximumInputDepth = 0;
+    for (auto inputPort : atomicAccessor->GetInputPorts())
+    {
+        maximumInputDepth = std::max(maximumInputDepth, portDepths[inputPort->GetModelIndex()]);
+    }
+
+    int minimumOutputDepth = INT_MAX;
+    for (auto outputPort : atomicAccessor->GetOutputPorts())
+    {
+        minimumOutputDepth = std::min(minimumOutputDepth, portDepths[outputPort->GetModelIndex()]);
+    }
+
+    int accessorDepth = (atomicAccessor->HasOutputPorts() ? minimumOutputDepth : maximumInputDepth);
+    accessorDepths.push_back({ accessorDepth, static_cast<int>(accessorDepths.size()), atomicAccessor });
+    return accessorDepth;
+}
+
+// Groups are computed over the atomic accessors, wherever they are in the hierarchy. Each atomic accessor starts out in
+// a group of its own, and every input port's group is then merged with that of the atomic accessor whose output port is
+// its source, following the connection through any composite accessors in between.
+void Host::Impl::ComputeReactionGroups()
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    std::unordered_map<const Accessor::Impl*, size_t> accessorIndices{};
+    accessorIndices.reserve(atomicAccessors.size());
+    for (size_t i = 0; i < atomicAccessors.size(); ++i)
+    {
+        accessorIndices.emplace(atomicAccessors[i], i);
+    }
+
+    std::vector<size_t> groupParents(atomicAccessors.size());
+    std::iota(groupParents.begin(), groupParents.end(), 0);
+    auto findGroup = [&groupParents](size_t i)
+    {
+        while (groupParents[i] != i)
+        {
+            groupParents[i] = groupParents[groupParents[i]];
+            i = groupParents[i];
+        }
+
+        return i;
+    };
+
+    for (size_t i = 0; i < atomicAccessors.size(); ++i)
+    {
+        for (auto inputPort : atomicAccessors[i]->GetInputPorts())
+        {
+            if (!inputPort->IsConnectedToSource())
             {
-                std::ostringstream exceptionMessage;
-                exceptionMessage << "Detected causality loop involving port " << inputPort->GetFullName();
-                throw std::logic_error(exceptionMessage.str().c_str());
+                continue;
             }
-            else
+
+            const OutputPort* sourceOutputPort = GetSourceOutputPort(inputPort);
+            auto source = (sourceOutputPort == nullptr ? accessorIndices.end() : accessorIndices.find(sourceOutputPort->GetOwner()));
+            if (source != accessorIndices.end())
             {
-                this->ComputeAtomicAccessorInputPortDepth(inputPort, portDepths, visitedInputPorts, visitedOutputPorts);
+                size_t a = findGroup(i);
+                size_t b = findGroup(source->second);
+                groupParents[std::max(a, b)] = std::min(a, b);
             }
         }
+    }
 
-        if (depth < portDepths.at(inputPort))
+    // Groups are numbered in the order of their first atomic accessor
+    this->m_reactionGroupIndices.clear();
+    this->m_reactionGroups.clear();
+    this->m_activeReactionGroups.clear();
+    std::vector<size_t> groupIndices(atomicAccessors.size(), atomicAccessors.size());
+    for (size_t i = 0; i < atomicAccessors.size(); ++i)
+    {
+        size_t group = findGroup(i);
+        if (groupIndices[group] == atomicAccessors.size())
         {
-            depth = portDepths.at(inputPort);
+            groupIndices[group] = this->m_reactionGroups.size();
+            this->m_reactionGroups.emplace_back(this->m_director.get());
         }
+
+        this->m_reactionGroupIndices.emplace(atomicAccessors[i], groupIndices[group]);
     }
 
-    PRINT_VERBOSE("Output port '%s' is now priority %d", outputPort->GetFullName().c_str(), depth);
-    portDepths[outputPort] = depth;
+    LOG_VERBOSE("%s has %d reaction groups", this->GetName().c_str(), static_cast<int>(this->m_reactionGroups.size()));
+    this->m_reactionGroupsAreValid = true;
 }
 
-void Host::Impl::NotifyListenersOfException(const std::exception& e)
+// Every queued reaction is taken out of the queues of the host and the composites in it and given to the group of its
+// atomic accessor. A single active group is processed on this thread, but still defers its director operations, so that
+// the callbacks are ordered the same way however many groups are active. The operations are applied in the order of
+// the groups' indices; the director orders callbacks with equal times and priorities by when they were applied.
+bool Host::Impl::ProcessReactionGroupsInParallel()
 {
-    auto it = this->m_listeners.begin();
-    while (it != this->m_listeners.end())
+    if (this->m_reactionThreadPool == nullptr)
+    {
+        return false;
+    }
+
+    this->m_queuedAtomicAccessors.clear();
+    this->TakeQueuedAtomicReactions(this->m_queuedAtomicAccessors);
+    for (auto atomicAccessor : this->m_queuedAtomicAccessors)
     {
-        if (auto strongListener = it->second.lock())
+        if (this->m_reactionGroupsAreValid && this->m_reactionGroupIndices.count(atomicAccessor) == 0)
         {
-            try
-            {
-                strongListener->NotifyOfException(e);
-                ++it;
-            }
-            catch (const std::exception&)
+            // The model has changed since the groups were computed
+            this->m_reactionGroupsAreValid = false;
+        }
+    }
+
+    if (!this->m_reactionGroupsAreValid)
+    {
+        this->ComputeReactionGroups();
+    }
+
+    ++this->m_reactionPass;
+    this->m_activeReactionGroups.clear();
+    for (auto atomicAccessor : this->m_queuedAtomicAccessors)
+    {
+        ReactionGroup& reactionGroup = this->m_reactionGroups[this->m_reactionGroupIndices.at(atomicAccessor)];
+        if (reactionGroup.lastPass != this->m_reactionPass)
+        {
+            reactionGroup.lastPass = this->m_reactionPass;
+            this->m_activeReactionGroups.push_back(&reactionGroup);
+        }
+
+        reactionGroup.childEventQueue.push(atomicAccessor);
+    }
+
+    if (this->m_activeReactionGroups.size() == 1)
+    {
+        this->ProcessReactionGroup(*(this->m_activeReactionGroups.front()));
+    }
+    else if (this->m_activeReactionGroups.size() > 1)
+    {
+        this->m_reactionThreadPool->ParallelFor(
+            this->m_activeReactionGroups.size(),
+            [this](size_t i)
             {
-                this->m_listeners.erase(it);
-                continue;
-            }
+                this->ProcessReactionGroup(*(this->m_activeReactionGroups[i]));
+            });
+    }
+
+    // The groups are held in one vector, so ordering them by address orders them by index
+    std::sort(this->m_activeReactionGroups.begin(), this->m_activeReactionGroups.end(), std::less<ReactionGroup*>());
+    std::exception_ptr exception = nullptr;
+    for (auto reactionGroup : this->m_activeReactionGroups)
+    {
+        this->m_director->ApplyDeferredOperations(reactionGroup->directorOperations);
+        if (exception == nullptr)
+        {
+            exception = reactionGroup->exception;
         }
-        else
+
+        reactionGroup->exception = nullptr;
+    }
+
+    this->m_reactionRequested = false;
+    if (exception != nullptr)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    return true;
+}
+
+// Reaction groups may be processed on worker threads, which count their allocations against the host as well
+void Host::Impl::ProcessReactionGroup(ReactionGroup& reactionGroup)
+{
+    AllocationScope allocationScope(&(this->m_director->GetAllocationAccount()), AllocationSubsystem::Reactions);
+    const ReactionRouting reactionRouting{ this->m_director.get(), &(reactionGroup.childEventQueue) };
+    s_reactionRouting = &reactionRouting;
+    Director::DeferOperationsOnCurrentThread(&(reactionGroup.directorOperations));
+    try
+    {
+        ProcessReactions(reactionGroup.childEventQueue);
+    }
+    catch (...)
+    {
+        reactionGroup.exception = std::current_exception();
+        while (!reactionGroup.childEventQueue.empty())
         {
-            this->m_listeners.erase(it);
+            reactionGroup.childEventQueue.pop();
         }
     }
+
+    Director::DeferOperationsOnCurrentThread(nullptr);
+    s_reactionRouting = nullptr;
+}
+
+void Host::Impl::NotifyListenersOfException(std::exception_ptr exception)
+{
+    this->m_listenerDispatcher->PostException(std::move(exception));
 }
 
 void Host::Impl::NotifyListenersOfStateChange(Host::State oldState, Host::State newState)
 {
-    auto it = this->m_listeners.begin();
-    while (it != this->m_listeners.end())
+    this->m_listenerDispatcher->PostStateChange(oldState, newState);
+}
+
+void Host::Impl::GetAtomicAccessors(CompositeAccessor::Impl* compositeAccessor, std::vector<AtomicAccessor::Impl*>& atomicAccessors)
+{
+    for (auto child : compositeAccessor->GetChildren())
     {
-        if (auto strongListener = it->second.lock())
+        if (child->IsComposite())
         {
-            try
+            GetAtomicAccessors(static_cast<CompositeAccessor::Impl*>(child), atomicAccessors);
+        }
+        else
+        {
+            atomicAccessors.push_back(static_cast<AtomicAccessor::Impl*>(child));
+        }
+    }
+}
+
+void Host::Impl::StartCriticalPathAnalysis(size_t numberOfRecentTicks)
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Critical path analysis cannot be started while the host is running");
+    }
+
+    this->m_criticalPathAnalyzer = std::make_unique<CriticalPathAnalyzer>(numberOfRecentTicks);
+    Host::State state = this->m_state.load();
+    if (state != Host::State::NeedsSetup && state != Host::State::SettingUp)
+    {
+        // Otherwise, the analyzer is attached when priorities are computed during setup
+        this->AttachCriticalPathAnalyzer(this->m_accessorDepths);
+    }
+}
+
+void Host::Impl::StopCriticalPathAnalysis()
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Critical path analysis cannot be stopped while the host is running");
+    }
+
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    for (auto atomicAccessor : atomicAccessors)
+    {
+        atomicAccessor->SetCriticalPathAnalyzer(nullptr, 0);
+    }
+
+    this->m_criticalPathAnalyzer.reset(nullptr);
+}
+
+// The tick in progress is only known to be finished while no round is being executed
+Host::CriticalPathReport Host::Impl::GetCriticalPathReport() const
+{
+    if (this->m_criticalPathAnalyzer == nullptr)
+    {
+        throw std::logic_error("Critical path analysis has not been started");
+    }
+
+    if (this->m_state.load() != Host::State::Running || this->m_director->IsPolled())
+    {
+        this->m_criticalPathAnalyzer->FinishTick();
+    }
+
+    return this->m_criticalPathAnalyzer->GetReport();
+}
+
+void Host::Impl::ResetCriticalPathAnalysis()
+{
+    if (this->m_criticalPathAnalyzer == nullptr)
+    {
+        throw std::logic_error("Critical path analysis has not been started");
+    }
+
+    this->m_criticalPathAnalyzer->Reset();
+}
+
+// Times in the recording are relative to the Director's logical time when recording starts, which is when the callbacks
+// scheduled during setup are scheduled from if the host has not been set up yet
+void Host::Impl::StartRecording(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer)
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Recording cannot be started while the host is running");
+    }
+    else if (this->m_isRecording)
+    {
+        throw std::logic_error("The host is already recording");
+    }
+
+    this->m_recorder = std::make_shared<EventRecorder>(filePath, std::move(serializer), this->m_director->GetCurrentLogicalTime());
+    this->AttachRecorder(this->m_recorder.get());
+    this->m_isRecording = true;
+    if (this->m_isFingerprinting)
+    {
+        this->m_fingerprint->SetRecorder(this->m_recorder.get());
+    }
+}
+
+void Host::Impl::StopRecording()
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Recording cannot be stopped while the host is running");
+    }
+    else if (!(this->m_isRecording))
+    {
+        return;
+    }
+
+    this->AttachRecorder(nullptr);
+    this->m_isRecording = false;
+    if (this->m_fingerprint != nullptr)
+    {
+        this->m_fingerprint->SetRecorder(nullptr);
+    }
+
+    this->m_recorder->Close();
+}
+
+Host::RecordingReport Host::Impl::GetRecordingReport() const
+{
+    std::shared_ptr<EventRecorder> recorder = this->m_recorder;
+    return (recorder != nullptr ? recorder->GetReport() : Host::RecordingReport{ "", false, {}, 0ULL, 0ULL, 0ULL });
+}
+
+// Starting again discards the earlier fingerprint
+void Host::Impl::StartFingerprinting(std::shared_ptr<const EventSerializer> serializer, size_t numberOfTicksKept)
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Fingerprinting cannot be started while the host is running");
+    }
+
+    auto fingerprint = std::make_shared<ExecutionFingerprint>(std::move(serializer), numberOfTicksKept);
+    if (this->m_isRecording)
+    {
+        fingerprint->SetRecorder(this->m_recorder.get());
+    }
+
+    this->AttachFingerprint(fingerprint.get());
+    this->m_fingerprint = std::move(fingerprint);
+    this->m_isFingerprinting = true;
+}
+
+void Host::Impl::StopFingerprinting()
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Fingerprinting cannot be stopped while the host is running");
+    }
+    else if (!(this->m_isFingerprinting))
+    {
+        return;
+    }
+
+    this->AttachFingerprint(nullptr);
+    this->m_fingerprint->SetRecorder(nullptr);
+    this->m_isFingerprinting = false;
+}
+
+Host::FingerprintReport Host::Impl::GetFingerprintReport() const
+{
+    std::shared_ptr<ExecutionFingerprint> fingerprint = this->m_fingerprint;
+    return (fingerprint != nullptr ? fingerprint->GetReport(this->m_isFingerprinting) : Host::FingerprintReport{ false, 0ULL, 0ULL, {} });
+}
+
+void Host::Impl::AddToModelGraph(
+    Accessor::Impl* accessor,
+    int parent,
+    const std::vector<int>& portDepths,
+    const std::unordered_map<const Accessor::Impl*, int>& accessorDepths,
+    bool includeTraffic,
+    ModelGraph& modelGraph) const
+{
+    int index = static_cast<int>(modelGraph.accessors.size());
+    ModelGraph::AccessorNode node{};
+    node.name = accessor->GetFullName();
+    node.shortName = accessor->GetName();
+    node.parent = parent;
+    node.isComposite = accessor->IsComposite();
+    node.priority = accessor->GetPriority();
+    auto accessorDepth = accessorDepths.find(accessor);
+    node.depth = (accessorDepth == accessorDepths.end() ? ModelGraph::NoDepth : accessorDepth->second);
+    auto addPort = [&portDepths, &node, includeTraffic, &modelGraph](const Port* port, std::vector<ModelGraph::PortNode>& portNodes)
+    {
+        ModelGraph::PortNode portNode{};
+        portNode.name = port->GetFullName();
+        portNode.shortName = port->GetName();
+        int modelIndex = port->GetModelIndex();
+        bool hasDepth = (!(node.isComposite) && modelIndex >= 0 && modelIndex < static_cast<int>(portDepths.size()));
+        portNode.depth = (hasDepth ? portDepths[modelIndex] : ModelGraph::NoDepth);
+        if (includeTraffic)
+        {
+            portNode.numberOfEventsSent = port->GetCounters().numberOfEventsSent.Get();
+            portNode.numberOfEventsReceived = port->GetCounters().numberOfEventsReceived.Get();
+        }
+
+        for (const Port* destination : port->GetDestinations())
+        {
+            modelGraph.connections.push_back({ portNode.name, destination->GetFullName(), portNode.numberOfEventsSent });
+        }
+
+        portNodes.push_back(std::move(portNode));
+    };
+
+    for (const InputPort* inputPort : accessor->GetInputPorts())
+    {
+        addPort(inputPort, node.inputPorts);
+    }
+
+    for (const OutputPort* outputPort : accessor->GetOutputPorts())
+    {
+        addPort(outputPort, node.outputPorts);
+    }
+
+    modelGraph.accessors.push_back(std::move(node));
+    if (accessor->IsComposite())
+    {
+        for (auto child : static_cast<CompositeAccessor::Impl*>(accessor)->GetChildren())
+        {
+            this->AddToModelGraph(child, index, portDepths, accessorDepths, includeTraffic, modelGraph);
+        }
+    }
+}
+
+void Host::Impl::GetDescendants(CompositeAccessor::Impl* compositeAccessor, std::vector<Accessor::Impl*>& descendants)
+{
+    for (auto child : compositeAccessor->GetChildren())
+    {
+        descendants.push_back(child);
+        if (child->IsComposite())
+        {
+            GetDescendants(static_cast<CompositeAccessor::Impl*>(child), descendants);
+        }
+    }
+}
+
+Port* Host::Impl::FindAtomicAccessorPort(CompositeAccessor::Impl* compositeAccessor, const std::string& portFullName, bool isInputPort)
+{
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(compositeAccessor, atomicAccessors);
+    for (AtomicAccessor::Impl* atomicAccessor : atomicAccessors)
+    {
+        if (isInputPort)
+        {
+            for (const InputPort* inputPort : atomicAccessor->GetInputPorts())
             {
-                strongListener->NotifyOfStateChange(oldState, newState);
-                ++it;
+                if (inputPort->GetFullName() == portFullName)
+                {
+                    return atomicAccessor->GetInputPort(inputPort->GetName());
+                }
             }
-            catch (std::exception)
+        }
+        else
+        {
+            for (const OutputPort* outputPort : atomicAccessor->GetOutputPorts())
             {
-                this->m_listeners.erase(it);
-                continue;
+                if (outputPort->GetFullName() == portFullName)
+                {
+                    return atomicAccessor->GetOutputPort(outputPort->GetName());
+                }
             }
         }
-        else
+    }
+
+    std::ostringstream exceptionMessage;
+    exceptionMessage << "No atomic accessor in the model has " << (isInputPort ? "an input" : "an output") << " port named " << portFullName;
+    throw std::invalid_argument(exceptionMessage.str());
+}
+
+// Follows connections from the output port, passing through every atomic accessor that is reached to all of its output
+// ports. This overestimates what is downstream, but only for ports that are in the same reaction group regardless.
+bool Host::Impl::IsDownstream(const Port* inputPort, const Port* outputPort)
+{
+    std::unordered_set<const Port*> visitedPorts{ outputPort };
+    std::queue<const Port*> portsToVisit{};
+    portsToVisit.push(outputPort);
+    while (!portsToVisit.empty())
+    {
+        const Port* port = portsToVisit.front();
+        portsToVisit.pop();
+        for (const Port* destination : port->GetDestinations())
         {
-            this->m_listeners.erase(it);
+            if (destination == inputPort)
+            {
+                return true;
+            }
+
+            std::vector<const Port*> nextPorts{ destination };
+            if (!(destination->GetOwner()->IsComposite()))
+            {
+                auto outputPorts = destination->GetOwner()->GetOutputPorts();
+                nextPorts.assign(outputPorts.begin(), outputPorts.end());
+            }
+
+            for (const Port* nextPort : nextPorts)
+            {
+                if (visitedPorts.insert(nextPort).second)
+                {
+                    portsToVisit.push(nextPort);
+                }
+            }
         }
     }
+
+    return false;
 }
 
 const OutputPort* Host::Impl::GetSourceOutputPort(const InputPort* inputPort)
@@ -443,4 +1524,15 @@ const OutputPort* Host::Impl::GetSourceOutputPort(const InputPort* inputPort)
     }
 
     return static_cast<const OutputPort*>(sourcePort);
+}
+
+Host::PortProfile Host::Impl::GetPortProfile(const Port* port)
+{
+    const auto& counters = port->GetCounters();
+    Host::PortProfile portProfile{};
+    portProfile.name = port->GetFullName();
+    portProfile.numberOfEventsSent = counters.numberOfEventsSent.Get();
+    portProfile.numberOfEventsReceived = counters.numberOfEventsReceived.Get();
+    portProfile.maxInputQueueLength = counters.maxInputQueueLength.Get();
+    return portProfile;
 }
\ No newline at end of file
@@ -5,10 +5,24 @@
 #define HOST_IMPL_H
 
 #include "AccessorFramework/Host.h"
+#include "AtomicAccessorImpl.h"
 #include "CompositeAccessorImpl.h"
+#include "CriticalPathAnalyzer.h"
 #include "Director.h"
+#include "EventRecorder.h"
+#include "ExecutionFingerprint.h"
+#include "HostChannel.h"
+#include "LatencyProbe.h"
+#include "ListenerDispatcher.h"
+#include "ModelGraph.h"
+#include "OffloadPool.h"
+#include "ThreadConfiguration.h"
+#include "ThreadPool.h"
 #include <atomic>
+#include <exception>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 // Description
@@ -17,11 +31,46 @@
 // assigning priorities to the atomic accessors in the model. To do this, it follows the connections between accessor
 // ports, calculating the depth of each port to quantify causal dependencies. At the same time, it also checks the model
 // for causal loops; if there is a cyclic connection such that liveness cannot be established, the HostImpl will throw.
+// Port depths are computed iteratively over dense port indices using Kahn's algorithm, so neither the size of the model
+// nor the length of its longest causal chain is limited by the call stack.
 // The depth of an input port is defined as the maximum depth of all input ports in the same equivalence class. The
 // source depth of an input port is the depth of its source port plus one, or 0 if there is no source. The depth of an
 // output port is defined as the maximum depths of all input ports it depends on, or 0 if it does not depend on any input
 // ports (i.e. is a spontaneous output port).
 //
+// State changes and exceptions are posted to the host's ListenerDispatcher, which notifies the event listeners on the
+// listener executor. Unless the application gives one, the listener executor follows the host's thread settings.
+//
+// When parallel reactions are enabled, the host's children are split into reaction groups: two children are in the same
+// group if a chain of port connections links them. A reaction can only deliver data to children in its own group, so
+// each group's reactions can be processed on a separate thread with a queue of its own. Within a group, reactions run in
+// priority order as usual, and the Director operations requested by each group are applied once all groups have
+// finished. Because priorities are unique, this gives the same results as processing all reactions on one thread.
+//
+// The host's Director executes on the host's executor, so Run() returns immediately instead of dedicating a thread to
+// the host. Pause() and Exit() wait for a running round to finish. On Linux, a host creates an IOLoop when one of its
+// I/O accessors first watches a file descriptor, and from then on the loop is the host's executor. The loop reports
+// readiness only while the host is running.
+//
+// Channels from other hosts are attached to the host by its HostHypervisor. The host takes their events out at the start
+// of each round and delivers them to their input ports, so they are handled in that round like events from within the
+// model. A channel's sender wakes an idle host by posting a callback that does nothing to its Director (see
+// Director::PostCallback()), once per round in which the host took events out of the channel. A channel can also ask
+// for polling, for which the host schedules a periodic callback that does nothing, so that it starts a round every
+// polling interval whether or not it is woken. The channels' input ports are looked up again whenever the model changes;
+// the events of a channel whose input port has been removed are dropped.
+//
+// While the host is recording, its recorder is attached to every spontaneous output port, and it records the events of
+// every inbound channel as they are taken out. Like the channels' input ports, the spontaneous output ports are found
+// again whenever the model changes.
+//
+// While the host is fingerprinting, its fingerprint is attached to its director and to every port of its atomic
+// accessors, which are also found again whenever the model changes, and to its recorder while it is recording.
+//
+// A checkpoint is a header followed by the checkpoint of each atomic accessor (see AtomicAccessorImpl), under the
+// accessor's full name. Restoring follows the steps of Setup(), except that composites are initialized on their own and
+// atomic accessors are restored from their checkpoints, in the order in which Setup() would initialize them.
+//
 // For more information, see "Causality Interfaces for Actor Networks" (Zhou and Lee)
 // http://www.eecs.berkeley.edu/Pubs/TechRpts/2006/EECS-2006-148.html
 //
@@ -32,6 +81,17 @@ public:
     ~Impl();
     void ResetPriority() override;
     Director* GetDirector() const override;
+    IOLoop* GetIOLoop() override;
+    std::shared_ptr<OffloadPool::Statistics> GetOffloadStatistics() const override;
+    void ProcessChildEventQueue() override;
+    void SetExecutor(std::shared_ptr<Executor> executor);
+
+    // Channel ends can only be attached and detached while the host is not running, or between calls to Poll()
+    void ValidateChannelsCanChange() const;
+    void AttachOutboundChannel(std::shared_ptr<HostChannel> channel);
+    void DetachOutboundChannel(const HostChannel* channel);
+    void AttachInboundChannel(std::shared_ptr<HostChannel> channel, int pollingIntervalInMilliseconds, std::shared_ptr<IOLoop> wakeupLoop);
+    void DetachInboundChannel(const HostChannel* channel);
 
 protected:
     // Host Methods
@@ -39,12 +99,42 @@ protected:
     bool EventListenerIsRegistered(int listenerId) const;
     int AddEventListener(std::weak_ptr<Host::EventListener> listener);
     void RemoveEventListener(int listenerId);
+    void SetListenerExecutor(std::shared_ptr<Executor> executor);
+    void WaitForEventListeners() const;
+    Host::ListenerMetrics GetListenerMetrics() const;
+    void EnableParallelReactions(unsigned int numberOfThreads);
+    void SetThreadSettings(const Host::ThreadSettings& settings);
+    Host::ThreadSettings GetThreadSettings() const;
     void Setup();
     void Iterate(int numberOfIterations = 1);
     void Pause();
     void Run();
+    void Run(std::shared_ptr<Executor> executor);
     void RunOnCurrentThread();
+    std::chrono::system_clock::time_point Poll(std::chrono::system_clock::time_point now);
     void Exit();
+    Host::OffloadMetrics GetOffloadMetrics() const;
+    std::vector<Host::AccessorProfile> GetProfile() const;
+    void ResetProfile();
+    int AddLatencyProbe(const std::string& outputPortFullName, const std::string& inputPortFullName);
+    void RemoveLatencyProbe(int probeId);
+    std::vector<Host::LatencyProbeReport> GetLatencyProbes() const;
+    void ResetLatencyProbes();
+    Host::AllocationProfile GetAllocationProfile() const;
+    void ResetAllocationProfile();
+    void ExportGraph(std::ostream& stream, Host::GraphFormat format, bool includeTraffic);
+    void StartCriticalPathAnalysis(size_t numberOfRecentTicks);
+    void StopCriticalPathAnalysis();
+    Host::CriticalPathReport GetCriticalPathReport() const;
+    void ResetCriticalPathAnalysis();
+    void StartRecording(const std::string& filePath, std::shared_ptr<const EventSerializer> serializer);
+    void StopRecording();
+    Host::RecordingReport GetRecordingReport() const;
+    void StartFingerprinting(std::shared_ptr<const EventSerializer> serializer, size_t numberOfTicksKept);
+    void StopFingerprinting();
+    Host::FingerprintReport GetFingerprintReport() const;
+    void Checkpoint(std::ostream& stream, const EventSerializer* serializer);
+    void Restore(std::istream& stream, const EventSerializer* serializer);
 
     // Hosts are not allowed to have ports; these methods will throw
     void AddInputPort(const std::string& portName) final;
@@ -57,38 +147,124 @@ protected:
 private:
     friend class Host;
 
+    // Accessors are prioritized by depth. Within a depth, composites come first (most recently visited first), followed
+    // by atomic accessors in the order in which they were visited.
+    struct AccessorDepth
+    {
+        int depth;
+        int order;
+        Accessor::Impl* accessor;
+
+        bool operator<(const AccessorDepth& other) const
+        {
+            return (this->depth < other.depth || (this->depth == other.depth && this->order < other.order));
+        }
+    };
+
+    struct InboundChannel
+    {
+        std::shared_ptr<HostChannel> channel;
+        InputPort* inputPort; // null if the port has been removed
+        int pollingIntervalInMilliseconds;
+        uint32_t recordingStreamId;
+        std::shared_ptr<IOLoop> wakeupLoop; // watches the channel's wakeup; null where there is none
+    };
+
+    struct ReactionGroup
+    {
+        explicit ReactionGroup(Director* director) :
+            directorOperations(director),
+            exception(nullptr),
+            lastPass(0)
+        {
+        }
+
+        ChildEventQueue childEventQueue;
+        Director::DeferredOperations directorOperations;
+        std::exception_ptr exception;
+        unsigned long long lastPass;
+    };
+
     // Internal Methods
     void ValidateHostCanRun() const;
+    void HandleExecutionException(std::exception_ptr exception);
     void SetState(Host::State newState);
+    void SetIODispatching(bool isDispatching);
     void ComputeAccessorPriorities(bool updateCallbacks = false);
+    void ComputeAccessorDepths(); // caches the depths, with the accessors sorted in order of priority
+    void AttachToModel(); // after the model or its priorities change
+    void ComputePortDepths(const std::vector<AtomicAccessor::Impl*>& atomicAccessors, std::vector<int>& portDepths) const;
     int ComputeCompositeAccessorDepth(
         CompositeAccessor::Impl* compositeAccessor,
-        std::map<const Port*, int>& portDepths,
-        std::map<int, std::vector<Accessor::Impl*>>& accessorDepths);
+        const std::vector<int>& portDepths,
+        std::vector<AccessorDepth>& accessorDepths);
     int ComputeAtomicAccessorDepth(
         AtomicAccessor::Impl* atomicAccessor,
-        std::map<const Port*, int>& portDepths,
-        std::map<int, std::vector<Accessor::Impl*>>& accessorDepths);
-    void ComputeAtomicAccessorInputPortDepth(
-        const InputPort* inputPort,
-        std::map<const Port*, int>& portDepths,
-        std::set<const InputPort*>& visitedInputPorts,
-        std::set<const OutputPort*>& visitedOutputPorts);
-    void ComputeAtomicAccessorOutputPortDepth(
-        const OutputPort* outputPort,
-        std::map<const Port*, int>& portDepths,
-        std::set<const InputPort*>& visitedInputPorts,
-        std::set<const OutputPort*>& visitedOutputPorts);
-
-    void NotifyListenersOfException(const std::exception& e);
+        const std::vector<int>& portDepths,
+        std::vector<AccessorDepth>& accessorDepths);
+
+    void AttachCriticalPathAnalyzer(const std::vector<AccessorDepth>& accessorDepths);
+    void FindInboundChannelPorts();
+    void UpdateChannelPolling();
+    void ReceiveChannelEvents();
+    static void RearmChannelWakeup(const InboundChannel& inboundChannel);
+    static void UnwatchChannelWakeup(const InboundChannel& inboundChannel);
+    void AttachRecorder(EventRecorder* recorder);
+    void AttachFingerprint(ExecutionFingerprint* fingerprint);
+    void RunAdditionalSetup(); // only once, whether by Setup() or Restore()
+    void ReadCheckpoints(
+        const std::map<std::string, int32_t>& priorities,
+        const std::map<std::string, std::string>& connections,
+        const std::map<std::string, std::pair<const unsigned char*, size_t>>& checkpoints,
+        const EventSerializer* serializer,
+        std::unordered_map<const Accessor::Impl*, AtomicAccessor::Impl::CheckpointData>& checkpointData);
+    void RestoreFromCheckpoint(
+        CompositeAccessor::Impl* compositeAccessor,
+        std::unordered_map<const Accessor::Impl*, AtomicAccessor::Impl::CheckpointData>& checkpoints);
+    void ComputeReactionGroups();
+    bool ProcessReactionGroupsInParallel();
+    void ProcessReactionGroup(ReactionGroup& reactionGroup);
+
+    void NotifyListenersOfException(std::exception_ptr exception);
     void NotifyListenersOfStateChange(Host::State oldState, Host::State newState);
 
     std::atomic<Host::State> m_state;
+    bool m_additionalSetupHasRun;
     std::unique_ptr<Director> m_director;
-    std::map<int, std::weak_ptr<Host::EventListener>> m_listeners;
-    int m_nextListenerId;
+    std::shared_ptr<IOLoop> m_ioLoop;
+    std::shared_ptr<OffloadPool::Statistics> m_offloadStatistics;
+    std::shared_ptr<ListenerDispatcher> m_listenerDispatcher;
+    std::unique_ptr<ThreadPool> m_reactionThreadPool;
+    Host::ThreadSettings m_threadSettings;
+    ThreadConfiguration m_threadConfiguration;
+    std::shared_ptr<Executor> m_threadExecutor; // replaces the default executor once thread settings are set
+    bool m_reactionGroupsAreValid;
+    std::unordered_map<const Accessor::Impl*, size_t> m_reactionGroupIndices;
+    std::vector<ReactionGroup> m_reactionGroups;
+    std::vector<Accessor::Impl*> m_queuedAtomicAccessors;
+    std::vector<ReactionGroup*> m_activeReactionGroups;
+    unsigned long long m_reactionPass;
+    std::map<int, std::shared_ptr<LatencyProbe>> m_latencyProbes;
+    int m_nextLatencyProbeId;
+    mutable std::mutex m_modelDepthsMutex; // also guards the ports' model indices
+    std::vector<int> m_portDepths; // by port model index
+    std::vector<AccessorDepth> m_accessorDepths; // sorted in order of priority
+    std::unique_ptr<CriticalPathAnalyzer> m_criticalPathAnalyzer;
+    std::vector<InboundChannel> m_inboundChannels;
+    int m_channelPollingCallbackId;
+    long long m_channelWakeupTime; // of the latest round scheduled for an event stamped later than the round that saw it
+    std::shared_ptr<EventRecorder> m_recorder; // kept once recording stops, for its report
+    bool m_isRecording;
+    std::shared_ptr<ExecutionFingerprint> m_fingerprint; // kept once fingerprinting stops, for its report
+    bool m_isFingerprinting;
 
+    static void GetAtomicAccessors(CompositeAccessor::Impl* compositeAccessor, std::vector<AtomicAccessor::Impl*>& atomicAccessors);
+    void AddToModelGraph(Accessor::Impl* accessor, int parent, const std::vector<int>& portDepths, const std::unordered_map<const Accessor::Impl*, int>& accessorDepths, bool includeTraffic, ModelGraph& modelGraph) const;
+    static void GetDescendants(CompositeAccessor::Impl* compositeAccessor, std::vector<Accessor::Impl*>& descendants);
     static const OutputPort* GetSourceOutputPort(const InputPort* inputPort);
+    static Host::PortProfile GetPortProfile(const Port* port);
+    static Port* FindAtomicAccessorPort(CompositeAccessor::Impl* compositeAccessor, const std::string& portFullName, bool isInputPort);
+    static bool IsDownstream(const Port* inputPort, const Port* outputPort);
 };
 
 #endif // HOST_IMPL_H
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "AccessorFramework/IOAccessor.h"
+#include "HostImpl.h"
+#include "IOLoop.h"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+
+void Host::Impl::AttachOutboundChannel(std::shared_ptr<HostChannel> channel)
+{
+    this->ValidateChannelsCanChange();
+    auto outputPort = static_cast<OutputPort*>(FindAtomicAccessorPort(this, channel->outputPortName, false /*isInputPort*/));
+    outputPort->AddChannel(std::move(channel));
+}
+
+// The channel's output port may have been removed along with its accessor, in which case there is nothing to detach
+void Host::Impl::DetachOutboundChannel(const HostChannel* channel)
+{
+    this->ValidateChannelsCanChange();
+    try
+    {
+        static_cast<OutputPort*>(FindAtomicAccessorPort(this, channel->outputPortName, false /*isInputPort*/))->RemoveChannel(channel);
+    }
+    catch (const std::invalid_argument&)
+    {
+    }
+}
+
+void Host::Impl::AttachInboundChannel(std::shared_ptr<HostChannel> channel, int pollingIntervalInMilliseconds, std::shared_ptr<IOLoop> wakeupLoop)
+{
+    this->ValidateChannelsCanChange();
+    auto inputPort = static_cast<InputPort*>(FindAtomicAccessorPort(this, channel->inputPortName, true /*isInputPort*/));
+    bool hasChannel = std::any_of(
+        this->m_inboundChannels.begin(),
+        this->m_inboundChannels.end(),
+        [inputPort](const InboundChannel& inboundChannel) { return inboundChannel.inputPort == inputPort; });
+    if (inputPort->IsConnectedToSource() || hasChannel)
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Input port " << channel->inputPortName << " is already connected to a source";
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+
+    if (pollingIntervalInMilliseconds < 0)
+    {
+        throw std::invalid_argument("The polling interval must not be negative");
+    }
+
+    // The wakeup loop wakes the Director when the sender signals the channel; the round start handler does the rest
+#ifdef __linux__
+    if (wakeupLoop != nullptr)
+    {
+        Director* director = this->m_director.get();
+        HostChannel* wakingChannel = channel.get();
+        wakeupLoop->Watch(
+            channel->GetWakeupFileDescriptor(),
+            IOAccessor::Readable,
+            [director, wakingChannel](unsigned int /*ioEvents*/)
+            {
+                wakingChannel->ClearWakeup();
+                director->Wake();
+            });
+    }
+#else
+    wakeupLoop.reset();
+#endif
+
+    uint32_t recordingStreamId = (this->m_isRecording ? this->m_recorder->AddStream(channel->inputPortName) : 0);
+    this->m_inboundChannels.push_back({ std::move(channel), inputPort, pollingIntervalInMilliseconds, recordingStreamId, std::move(wakeupLoop) });
+    this->UpdateChannelPolling();
+}
+
+// Events left in the channel are dropped along with it
+void Host::Impl::DetachInboundChannel(const HostChannel* channel)
+{
+    this->ValidateChannelsCanChange();
+    for (InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        if (inboundChannel.channel.get() == channel)
+        {
+            UnwatchChannelWakeup(inboundChannel);
+        }
+    }
+
+    this->m_inboundChannels.erase(
+        std::remove_if(
+            this->m_inboundChannels.begin(),
+            this->m_inboundChannels.end(),
+            [channel](const InboundChannel& inboundChannel) { return inboundChannel.channel.get() == channel; }),
+        this->m_inboundChannels.end());
+    this->UpdateChannelPolling();
+}
+
+void Host::Impl::ValidateChannelsCanChange() const
+{
+    if (this->m_state.load() == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Channels cannot be connected or disconnected while the host is running");
+    }
+}
+
+void Host::Impl::FindInboundChannelPorts()
+{
+    for (InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        try
+        {
+            inboundChannel.inputPort = static_cast<InputPort*>(FindAtomicAccessorPort(this, inboundChannel.channel->inputPortName, true /*isInputPort*/));
+        }
+        catch (const std::invalid_argument&)
+        {
+            inboundChannel.inputPort = nullptr;
+        }
+    }
+}
+
+// The host polls at the shortest interval of any of its channels that asked for polling, and only while it has such
+// channels. Channels that did not are only received from when their senders wake the host (or it runs anyway).
+void Host::Impl::UpdateChannelPolling()
+{
+    if (this->m_channelPollingCallbackId >= 0)
+    {
+        this->ClearScheduledCallback(this->m_channelPollingCallbackId);
+        this->m_channelPollingCallbackId = -1;
+    }
+
+    if (this->m_inboundChannels.empty())
+    {
+        this->m_director->SetRoundStartHandler(nullptr);
+        return;
+    }
+
+    int pollingIntervalInMilliseconds = 0;
+    for (const InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        if (inboundChannel.pollingIntervalInMilliseconds > 0 &&
+            (pollingIntervalInMilliseconds == 0 || inboundChannel.pollingIntervalInMilliseconds < pollingIntervalInMilliseconds))
+        {
+            pollingIntervalInMilliseconds = inboundChannel.pollingIntervalInMilliseconds;
+        }
+    }
+
+    this->m_director->SetRoundStartHandler([this]() { this->ReceiveChannelEvents(); });
+    if (pollingIntervalInMilliseconds > 0)
+    {
+        this->m_channelPollingCallbackId = this->ScheduleCallback([]() {}, pollingIntervalInMilliseconds, true /*repeat*/);
+    }
+}
+
+// Each input port queues its events, so a channel's events all reach the port's handlers in this round, in order. Each
+// channel's wakeup is armed before its events are taken out, and watched again if it was signaled, so an event sent
+// after that wakes the host again. An event stamped later than this round stays in its channel, and since its sender
+// will not wake the host for it, the host schedules a round at the earliest such stamp instead.
+void Host::Impl::ReceiveChannelEvents()
+{
+    long long logicalTime = this->m_director->GetCurrentLogicalTime();
+    long long earliestLaterStamp = LLONG_MAX;
+    std::shared_ptr<IEvent> event{};
+    for (InboundChannel& inboundChannel : this->m_inboundChannels)
+    {
+        if (inboundChannel.channel->ArmWakeup())
+        {
+            RearmChannelWakeup(inboundChannel);
+        }
+
+        while (inboundChannel.channel->Receive(logicalTime, event))
+        {
+            if (inboundChannel.inputPort != nullptr)
+            {
+                if (this->m_isRecording)
+                {
+                    this->m_recorder->Record(inboundChannel.recordingStreamId, logicalTime, event.get());
+                }
+
+                inboundChannel.inputPort->ReceiveData(std::move(event));
+            }
+
+            event.reset();
+        }
+
+        long long stamp = 0;
+        if (inboundChannel.channel->PeekLogicalTime(stamp))
+        {
+            earliestLaterStamp = std::min(earliestLaterStamp, stamp);
+        }
+    }
+
+    // A round already scheduled for an earlier stamp looks again when it runs
+    if (earliestLaterStamp != LLONG_MAX && (earliestLaterStamp < this->m_channelWakeupTime || this->m_channelWakeupTime <= logicalTime))
+    {
+        this->m_channelWakeupTime = earliestLaterStamp;
+        this->m_director->ScheduleCallback([]() {}, static_cast<int>(std::min<long long>(earliestLaterStamp - logicalTime, INT_MAX)), false /*isPeriodic*/);
+    }
+}
+
+// The wakeup loop watches a file descriptor once per signal, so it is watched again once the host has been woken
+void Host::Impl::RearmChannelWakeup(const InboundChannel& inboundChannel)
+{
+#ifdef __linux__
+    if (inboundChannel.wakeupLoop != nullptr)
+    {
+        inboundChannel.wakeupLoop->Rearm(inboundChannel.channel->GetWakeupFileDescriptor());
+    }
+#else
+    (void)inboundChannel;
+#endif
+}
+
+// Once this returns, the wakeup loop no longer wakes the host's Director for the channel
+void Host::Impl::UnwatchChannelWakeup(const InboundChannel& inboundChannel)
+{
+#ifdef __linux__
+    if (inboundChannel.wakeupLoop != nullptr)
+    {
+        inboundChannel.wakeupLoop->Unwatch(inboundChannel.channel->GetWakeupFileDescriptor());
+    }
+#else
+    (void)inboundChannel;
+#endif
+}
@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "HostImpl.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+static const uint64_t CheckpointMagic = 0x3130545048434346ULL; // "FCCHPT01"
+static const uint32_t CheckpointFormatVersion = 3;
+static const size_t CheckpointHeaderSize = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+// The priorities of the accessor and everything it contains, by full name
+static void GetPriorities(const Accessor::Impl* accessor, std::map<std::string, int32_t>& priorities)
+{
+    priorities.emplace(accessor->GetFullName(), static_cast<int32_t>(accessor->GetPriority()));
+    if (accessor->IsComposite())
+    {
+        for (auto child : static_cast<const CompositeAccessor::Impl*>(accessor)->GetChildren())
+        {
+            GetPriorities(child, priorities);
+        }
+    }
+}
+
+static void SetPriorities(Accessor::Impl* accessor, const std::map<std::string, int32_t>& priorities)
+{
+    accessor->SetPriority(static_cast<int>(priorities.at(accessor->GetFullName())));
+    if (accessor->IsComposite())
+    {
+        for (auto child : static_cast<CompositeAccessor::Impl*>(accessor)->GetChildren())
+        {
+            SetPriorities(child, priorities);
+        }
+    }
+}
+
+// The source of every connected port of the accessor and everything it contains, by the port's full name
+static void GetConnections(const Accessor::Impl* accessor, std::map<std::string, std::string>& connections)
+{
+    for (const InputPort* inputPort : accessor->GetInputPorts())
+    {
+        if (inputPort->IsConnectedToSource())
+        {
+            connections.emplace(inputPort->GetFullName(), inputPort->GetSource()->GetFullName());
+        }
+    }
+
+    for (const OutputPort* outputPort : accessor->GetOutputPorts())
+    {
+        if (outputPort->IsConnectedToSource())
+        {
+            connections.emplace(outputPort->GetFullName(), outputPort->GetSource()->GetFullName());
+        }
+    }
+
+    if (accessor->IsComposite())
+    {
+        for (auto child : static_cast<const CompositeAccessor::Impl*>(accessor)->GetChildren())
+        {
+            GetConnections(child, connections);
+        }
+    }
+}
+
+// Grows the buffer as the bytes arrive, so that a corrupt size cannot make it allocate more than the stream holds
+static bool ReadBytes(std::istream& stream, uint64_t size, std::vector<unsigned char>& buffer)
+{
+    const size_t ChunkSize = 1 << 16;
+    buffer.clear();
+    while (buffer.size() < size)
+    {
+        size_t offset = buffer.size();
+        size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(ChunkSize, size - offset));
+        buffer.resize(offset + chunkSize);
+        stream.read(reinterpret_cast<char*>(buffer.data() + offset), static_cast<std::streamsize>(chunkSize));
+        if (static_cast<size_t>(stream.gcount()) != chunkSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Follows the order of CompositeAccessor::Impl::Initialize()
+void Host::Impl::RestoreFromCheckpoint(
+    CompositeAccessor::Impl* compositeAccessor,
+    std::unordered_map<const Accessor::Impl*, AtomicAccessor::Impl::CheckpointData>& checkpoints)
+{
+    compositeAccessor->Accessor::Impl::Initialize();
+    for (auto child : compositeAccessor->GetChildren())
+    {
+        if (child->IsComposite())
+        {
+            this->RestoreFromCheckpoint(static_cast<CompositeAccessor::Impl*>(child), checkpoints);
+            continue;
+        }
+
+        static_cast<AtomicAccessor::Impl*>(child)->RestoreCheckpoint(std::move(checkpoints.at(child)));
+    }
+}
+
+// The checkpoint is a header, which holds the magic number, the format version, and the size of the rest, followed by the
+// priorities, the connections, and the atomic accessors' checkpoints
+void Host::Impl::Checkpoint(std::ostream& stream, const EventSerializer* serializer)
+{
+    Host::State state = this->m_state.load();
+    if (state == Host::State::NeedsSetup || state == Host::State::SettingUp)
+    {
+        throw std::logic_error("Host cannot be checkpointed before it is set up");
+    }
+    else if (state == Host::State::Running && !(this->m_director->IsPolled()))
+    {
+        throw std::logic_error("Host cannot be checkpointed while it is running");
+    }
+
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    std::map<std::string, int32_t> priorities{};
+    GetPriorities(this, priorities);
+    std::map<std::string, std::string> connections{};
+    GetConnections(this, connections);
+    std::vector<unsigned char> buffer{};
+    ByteWriter writer(buffer);
+    Serializer<uint64_t>::Write(writer, CheckpointMagic);
+    Serializer<uint32_t>::Write(writer, CheckpointFormatVersion);
+    Serializer<uint64_t>::Write(writer, 0);
+    Serializer<std::map<std::string, int32_t>>::Write(writer, priorities);
+    Serializer<std::map<std::string, std::string>>::Write(writer, connections);
+    Serializer<uint64_t>::Write(writer, atomicAccessors.size());
+    for (const AtomicAccessor::Impl* atomicAccessor : atomicAccessors)
+    {
+        Serializer<std::string>::Write(writer, atomicAccessor->GetFullName());
+        size_t sizeOffset = buffer.size();
+        Serializer<uint64_t>::Write(writer, 0);
+        atomicAccessor->SaveCheckpoint(buffer, serializer);
+        uint64_t size = buffer.size() - sizeOffset - sizeof(uint64_t);
+        std::memcpy(buffer.data() + sizeOffset, &size, sizeof(size));
+    }
+
+    uint64_t bodySize = buffer.size() - CheckpointHeaderSize;
+    std::memcpy(buffer.data() + CheckpointHeaderSize - sizeof(bodySize), &bodySize, sizeof(bodySize));
+    stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!stream)
+    {
+        throw std::runtime_error("Could not write checkpoint");
+    }
+}
+
+// Exactly the checkpoint is read from the stream, and it is parsed before anything changes. AdditionalSetup() then
+// completes the model, as it does in Setup(), and the checkpoint is matched against that model before anything is
+// restored, so a checkpoint that is rejected leaves the host still needing setup. The model's priorities are not computed
+// again but taken from the checkpoint, so that callbacks and reactions keep the order they had in the original host.
+void Host::Impl::Restore(std::istream& stream, const EventSerializer* serializer)
+{
+    if (this->m_state.load() != Host::State::NeedsSetup)
+    {
+        throw std::logic_error("Host can only be restored in place of setup");
+    }
+
+    std::vector<unsigned char> header{};
+    bool headerWasRead = ReadBytes(stream, CheckpointHeaderSize, header);
+    ByteReader headerReader(header.data(), header.size());
+    uint64_t magic = 0;
+    uint32_t formatVersion = 0;
+    uint64_t bodySize = 0;
+    if (!headerWasRead ||
+        !(Serializer<uint64_t>::Read(headerReader, magic)) || magic != CheckpointMagic ||
+        !(Serializer<uint32_t>::Read(headerReader, formatVersion)) || formatVersion != CheckpointFormatVersion ||
+        !(Serializer<uint64_t>::Read(headerReader, bodySize)))
+    {
+        throw std::invalid_argument("Stream does not hold a host checkpoint");
+    }
+
+    std::vector<unsigned char> buffer{};
+    if (!(ReadBytes(stream, bodySize, buffer)))
+    {
+        throw std::invalid_argument("Host checkpoint is truncated");
+    }
+
+    ByteReader reader(buffer.data(), buffer.size());
+    std::map<std::string, int32_t> priorities{};
+    std::map<std::string, std::string> connections{};
+    uint64_t numberOfAccessors = 0;
+    if (!(Serializer<std::map<std::string, int32_t>>::Read(reader, priorities)) ||
+        !(Serializer<std::map<std::string, std::string>>::Read(reader, connections)) ||
+        !(reader.ReadElementCount(numberOfAccessors)))
+    {
+        throw std::invalid_argument("Host checkpoint is corrupt");
+    }
+
+    std::map<std::string, std::pair<const unsigned char*, size_t>> checkpoints{};
+    for (uint64_t i = 0; i < numberOfAccessors; ++i)
+    {
+        std::string accessorName{};
+        uint64_t size = 0;
+        const unsigned char* data = nullptr;
+        if (!(Serializer<std::string>::Read(reader, accessorName)) ||
+            !(Serializer<uint64_t>::Read(reader, size)) ||
+            (data = reader.ReadBytes(size)) == nullptr ||
+            !(checkpoints.emplace(accessorName, std::make_pair(data, static_cast<size_t>(size))).second))
+        {
+            throw std::invalid_argument("Host checkpoint is corrupt");
+        }
+    }
+
+    if (reader.GetRemainingSize() != 0)
+    {
+        throw std::invalid_argument("Host checkpoint is corrupt");
+    }
+
+    this->SetState(Host::State::SettingUp);
+    try
+    {
+        this->RunAdditionalSetup();
+    }
+    catch (...)
+    {
+        this->SetState(Host::State::Corrupted);
+        throw;
+    }
+
+    std::unordered_map<const Accessor::Impl*, AtomicAccessor::Impl::CheckpointData> checkpointData{};
+    try
+    {
+        this->ReadCheckpoints(priorities, connections, checkpoints, serializer, checkpointData);
+    }
+    catch (...)
+    {
+        this->SetState(Host::State::NeedsSetup);
+        throw;
+    }
+
+    // Restoring an accessor runs its RestoreState(), which can fail in ways no check above can foresee
+    try
+    {
+        SetPriorities(this, priorities);
+        this->ComputeAccessorDepths();
+        this->AttachToModel();
+        this->RestoreFromCheckpoint(this, checkpointData);
+    }
+    catch (...)
+    {
+        this->SetState(Host::State::Corrupted);
+        throw;
+    }
+
+    this->SetState(Host::State::ReadyToRun);
+}
+
+// Matches the checkpoint against the model and reads each atomic accessor's checkpoint, without changing anything
+void Host::Impl::ReadCheckpoints(
+    const std::map<std::string, int32_t>& priorities,
+    const std::map<std::string, std::string>& connections,
+    const std::map<std::string, std::pair<const unsigned char*, size_t>>& checkpoints,
+    const EventSerializer* serializer,
+    std::unordered_map<const Accessor::Impl*, AtomicAccessor::Impl::CheckpointData>& checkpointData)
+{
+    std::map<std::string, int32_t> modelPriorities{};
+    GetPriorities(this, modelPriorities);
+    for (const auto& entry : modelPriorities)
+    {
+        if (priorities.find(entry.first) == priorities.end())
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "Host checkpoint does not hold accessor " << entry.first;
+            throw std::invalid_argument(exceptionMessage.str());
+        }
+    }
+
+    std::vector<AtomicAccessor::Impl*> atomicAccessors{};
+    GetAtomicAccessors(this, atomicAccessors);
+    if (priorities.size() != modelPriorities.size() || checkpoints.size() != atomicAccessors.size())
+    {
+        throw std::invalid_argument("Host checkpoint holds accessors that are not in the host");
+    }
+
+    std::map<std::string, std::string> modelConnections{};
+    GetConnections(this, modelConnections);
+    if (connections != modelConnections)
+    {
+        throw std::invalid_argument("Host checkpoint was taken from a host whose ports are connected differently");
+    }
+
+    for (const AtomicAccessor::Impl* atomicAccessor : atomicAccessors)
+    {
+        auto checkpoint = checkpoints.find(atomicAccessor->GetFullName());
+        if (checkpoint == checkpoints.end())
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "Host checkpoint does not hold accessor " << atomicAccessor->GetFullName();
+            throw std::invalid_argument(exceptionMessage.str());
+        }
+
+        ByteReader accessorReader(checkpoint->second.first, checkpoint->second.second);
+        atomicAccessor->ReadCheckpoint(accessorReader, serializer, checkpointData[atomicAccessor]);
+        if (accessorReader.GetRemainingSize() != 0)
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "The checkpoint of accessor " << atomicAccessor->GetFullName() << " is corrupt or was taken from a different accessor";
+            throw std::invalid_argument(exceptionMessage.str());
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include "IOAccessorImpl.h"
+
+IOAccessor::IOAccessor(
+    const std::string& name,
+    const std::vector<std::string>& inputPortNames,
+    const std::vector<std::string>& outputPortNames,
+    const std::vector<std::string>& spontaneousOutputPortNames,
+    const std::map<std::string, std::vector<InputHandler>>& inputHandlers) :
+    AtomicAccessor(std::make_unique<IOAccessor::Impl>(name, this, &IOAccessor::Initialize, inputPortNames, outputPortNames, spontaneousOutputPortNames, inputHandlers, &IOAccessor::Fire))
+{
+}
+
+void IOAccessor::WatchFileDescriptor(int fileDescriptor, unsigned int ioEvents, IOHandler handler)
+{
+    static_cast<IOAccessor::Impl*>(this->GetImpl())->WatchFileDescriptor(fileDescriptor, ioEvents, std::move(handler));
+}
+
+void IOAccessor::UnwatchFileDescriptor(int fileDescriptor)
+{
+    static_cast<IOAccessor::Impl*>(this->GetImpl())->UnwatchFileDescriptor(fileDescriptor);
+}
+
+#endif // __linux__
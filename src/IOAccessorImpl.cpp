@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include "IOAccessorImpl.h"
+#include "Director.h"
+#include <sstream>
+#include <stdexcept>
+
+const int IOAccessor::Impl::NoPendingCallback = -1;
+
+IOAccessor::Impl::Impl(
+    const std::string& name,
+    IOAccessor* container,
+    std::function<void(Accessor&)> initializeFunction,
+    const std::vector<std::string>& inputPortNames,
+    const std::vector<std::string>& connectedOutputPortNames,
+    const std::vector<std::string>& spontaneousOutputPortNames,
+    std::map<std::string, std::vector<AtomicAccessor::InputHandler>> inputHandlers,
+    std::function<void(AtomicAccessor&)> fireFunction) :
+        AtomicAccessor::Impl(name, container, initializeFunction, inputPortNames, connectedOutputPortNames, spontaneousOutputPortNames, inputHandlers, fireFunction),
+        m_ioLoop(nullptr)
+{
+}
+
+IOAccessor::Impl::~Impl()
+{
+    while (!this->m_watchedFileDescriptors.empty())
+    {
+        this->UnwatchFileDescriptor(this->m_watchedFileDescriptors.begin()->first);
+    }
+}
+
+void IOAccessor::Impl::WatchFileDescriptor(int fileDescriptor, unsigned int ioEvents, IOAccessor::IOHandler handler)
+{
+    if (this->GetDirector() == nullptr)
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Accessor " << this->GetFullName() << " must belong to a host before it can watch file descriptors";
+        throw std::logic_error(exceptionMessage.str());
+    }
+    else if (this->m_watchedFileDescriptors.find(fileDescriptor) != this->m_watchedFileDescriptors.end())
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Accessor " << this->GetFullName() << " is already watching file descriptor " << fileDescriptor;
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+
+    if (this->m_ioLoop == nullptr)
+    {
+        this->m_ioLoop = this->GetIOLoop();
+    }
+
+    this->m_watchedFileDescriptors.emplace(fileDescriptor, WatchedFileDescriptor{ std::move(handler), NoPendingCallback });
+    try
+    {
+        this->m_ioLoop->Watch(
+            fileDescriptor,
+            ioEvents,
+            [this, fileDescriptor](unsigned int readyEvents)
+            {
+                this->ScheduleReadyCallback(fileDescriptor, readyEvents);
+            });
+    }
+    catch (...)
+    {
+        this->m_watchedFileDescriptors.erase(fileDescriptor);
+        throw;
+    }
+}
+
+void IOAccessor::Impl::UnwatchFileDescriptor(int fileDescriptor)
+{
+    auto it = this->m_watchedFileDescriptors.find(fileDescriptor);
+    if (it == this->m_watchedFileDescriptors.end())
+    {
+        return;
+    }
+
+    this->m_ioLoop->Unwatch(fileDescriptor);
+    Director* director = this->GetDirector();
+    if (it->second.pendingCallbackId != NoPendingCallback && director != nullptr)
+    {
+        director->ClearScheduledCallback(it->second.pendingCallbackId);
+    }
+
+    this->m_watchedFileDescriptors.erase(it);
+}
+
+// Runs on the I/O loop's thread, which is also the thread that executes the Director's rounds
+void IOAccessor::Impl::ScheduleReadyCallback(int fileDescriptor, unsigned int ioEvents)
+{
+    auto it = this->m_watchedFileDescriptors.find(fileDescriptor);
+    if (it == this->m_watchedFileDescriptors.end())
+    {
+        return;
+    }
+
+    it->second.pendingCallbackId = this->GetDirector()->ScheduleCallback(
+        [this, fileDescriptor, ioEvents]()
+        {
+            this->HandleReadyFileDescriptor(fileDescriptor, ioEvents);
+        },
+        0 /*delayInMilliseconds*/,
+        false /*isPeriodic*/,
+        this->m_priority,
+        nullptr /*allocationCounters*/,
+        this);
+}
+
+void IOAccessor::Impl::HandleReadyFileDescriptor(int fileDescriptor, unsigned int ioEvents)
+{
+    auto it = this->m_watchedFileDescriptors.find(fileDescriptor);
+    if (it == this->m_watchedFileDescriptors.end())
+    {
+        return;
+    }
+
+    it->second.pendingCallbackId = NoPendingCallback;
+    auto handler = it->second.handler;
+    handler(ioEvents);
+
+    // The handler may have stopped watching the file descriptor
+    if (this->m_watchedFileDescriptors.find(fileDescriptor) != this->m_watchedFileDescriptors.end())
+    {
+        this->m_ioLoop->Rearm(fileDescriptor);
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef IO_ACCESSOR_IMPL_H
+#define IO_ACCESSOR_IMPL_H
+
+#ifdef __linux__
+
+#include "AccessorFramework/IOAccessor.h"
+#include "AtomicAccessorImpl.h"
+#include "IOLoop.h"
+#include <map>
+
+// Description
+// The IOAccessor::Impl implements the public IOAccessor interface defined in IOAccessor.h. Its file descriptors are
+// watched by the host's IOLoop. When one becomes ready, the loop schedules an immediate callback with the accessor's
+// priority, and the callback calls the accessor's handler and then rearms the file descriptor. At most one such callback
+// is pending per file descriptor, and it is cleared along with the file descriptor when the file descriptor is unwatched.
+//
+class IOAccessor::Impl : public AtomicAccessor::Impl
+{
+public:
+    Impl(
+        const std::string& name,
+        IOAccessor* container,
+        std::function<void(Accessor&)> initializeFunction,
+        const std::vector<std::string>& inputPortNames = {},
+        const std::vector<std::string>& connectedOutputPortNames = {},
+        const std::vector<std::string>& spontaneousOutputPortNames = {},
+        std::map<std::string, std::vector<AtomicAccessor::InputHandler>> inputHandlers = {},
+        std::function<void(AtomicAccessor&)> fireFunction = nullptr);
+    ~Impl();
+
+protected:
+    // IOAccessor Methods
+    void WatchFileDescriptor(int fileDescriptor, unsigned int ioEvents, IOAccessor::IOHandler handler);
+    void UnwatchFileDescriptor(int fileDescriptor);
+
+private:
+    friend class IOAccessor;
+
+    struct WatchedFileDescriptor
+    {
+        IOAccessor::IOHandler handler;
+        int pendingCallbackId;
+    };
+
+    void ScheduleReadyCallback(int fileDescriptor, unsigned int ioEvents);
+    void HandleReadyFileDescriptor(int fileDescriptor, unsigned int ioEvents);
+
+    static const int NoPendingCallback;
+
+    IOLoop* m_ioLoop;
+    std::map<int, WatchedFileDescriptor> m_watchedFileDescriptors;
+};
+
+#endif // __linux__
+
+#endif // IO_ACCESSOR_IMPL_H
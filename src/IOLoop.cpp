@@ -0,0 +1,309 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include "IOLoop.h"
+#include "AccessorFramework/IOAccessor.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+static const int MaxEventsPerWait = 64;
+
+IOLoop::IOLoop(ThreadConfiguration threadConfiguration) :
+    m_threadConfiguration(std::move(threadConfiguration)),
+    m_epollFileDescriptor(epoll_create1(EPOLL_CLOEXEC)),
+    m_watchedEpollFileDescriptor(epoll_create1(EPOLL_CLOEXEC)),
+    m_wakeFileDescriptor(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+    m_timerFileDescriptor(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK)),
+    m_nextSequenceNumber(0),
+    m_armedDueTime(std::chrono::steady_clock::time_point::max()),
+    m_stopping(false),
+    m_isDispatching(false)
+{
+    bool isCreated = (this->m_epollFileDescriptor >= 0 && this->m_watchedEpollFileDescriptor >= 0 && this->m_wakeFileDescriptor >= 0 && this->m_timerFileDescriptor >= 0);
+    for (int fileDescriptor : { this->m_wakeFileDescriptor, this->m_timerFileDescriptor })
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fileDescriptor;
+        isCreated = isCreated && (epoll_ctl(this->m_epollFileDescriptor, EPOLL_CTL_ADD, fileDescriptor, &event) == 0);
+    }
+
+    if (!isCreated)
+    {
+        int error = errno;
+        for (int fileDescriptor : { this->m_epollFileDescriptor, this->m_watchedEpollFileDescriptor, this->m_wakeFileDescriptor, this->m_timerFileDescriptor })
+        {
+            if (fileDescriptor >= 0)
+            {
+                close(fileDescriptor);
+            }
+        }
+
+        throw std::system_error(error, std::generic_category(), "Could not create the I/O loop");
+    }
+
+    this->m_thread = std::thread(&IOLoop::Loop, this);
+}
+
+IOLoop::~IOLoop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stopping = true;
+    }
+
+    this->Wake();
+    this->m_thread.join();
+    close(this->m_timerFileDescriptor);
+    close(this->m_wakeFileDescriptor);
+    close(this->m_watchedEpollFileDescriptor);
+    close(this->m_epollFileDescriptor);
+}
+
+void IOLoop::Execute(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_tasks.push_back(std::move(task));
+    }
+
+    this->Wake();
+}
+
+void IOLoop::ExecuteAfter(long long delayInMilliseconds, std::function<void()> task)
+{
+    if (delayInMilliseconds <= 0LL)
+    {
+        this->Execute(std::move(task));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        auto dueTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayInMilliseconds);
+        this->m_timedTasks.push({ dueTime, this->m_nextSequenceNumber++, std::move(task) });
+    }
+
+    // The loop rearms the timer if the new task is due before the others
+    this->Wake();
+}
+
+void IOLoop::Watch(int fileDescriptor, unsigned int ioEvents, ReadyHandler handler)
+{
+    std::lock_guard<std::mutex> lock(this->m_watchMutex);
+    if (this->m_watchedFileDescriptors.find(fileDescriptor) != this->m_watchedFileDescriptors.end())
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "File descriptor " << fileDescriptor << " is already being watched";
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+
+    this->ControlWatchedFileDescriptor(EPOLL_CTL_ADD, fileDescriptor, ioEvents);
+    this->m_watchedFileDescriptors.emplace(fileDescriptor, WatchedFileDescriptor{ ioEvents, std::move(handler) });
+}
+
+void IOLoop::Rearm(int fileDescriptor)
+{
+    std::lock_guard<std::mutex> lock(this->m_watchMutex);
+    auto it = this->m_watchedFileDescriptors.find(fileDescriptor);
+    if (it != this->m_watchedFileDescriptors.end())
+    {
+        this->ControlWatchedFileDescriptor(EPOLL_CTL_MOD, fileDescriptor, it->second.ioEvents);
+    }
+}
+
+void IOLoop::Unwatch(int fileDescriptor)
+{
+    std::lock_guard<std::mutex> lock(this->m_watchMutex);
+    if (this->m_watchedFileDescriptors.erase(fileDescriptor) != 0)
+    {
+        // The file descriptor may already have been closed, which removes it from the epoll instance
+        epoll_ctl(this->m_watchedEpollFileDescriptor, EPOLL_CTL_DEL, fileDescriptor, nullptr);
+    }
+}
+
+// While the host is not running, the epoll instance holding the watched file descriptors is taken out of the loop's own
+// epoll instance, so readiness is neither reported nor allowed to keep waking the loop. Since readiness is dispatched
+// while holding the watch mutex, no handler is running once this returns. Dispatching is stopped while hosts are torn
+// down, so a failure to stop it is logged rather than thrown.
+void IOLoop::SetDispatching(bool isDispatching)
+{
+    std::lock_guard<std::mutex> lock(this->m_watchMutex);
+    if (this->m_isDispatching == isDispatching)
+    {
+        return;
+    }
+
+    if (isDispatching)
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = this->m_watchedEpollFileDescriptor;
+        if (epoll_ctl(this->m_epollFileDescriptor, EPOLL_CTL_ADD, this->m_watchedEpollFileDescriptor, &event) != 0)
+        {
+            ThrowLastError("Could not start dispatching I/O readiness");
+        }
+    }
+    else if (epoll_ctl(this->m_epollFileDescriptor, EPOLL_CTL_DEL, this->m_watchedEpollFileDescriptor, nullptr) != 0)
+    {
+        LOG_ERROR("Could not stop dispatching I/O readiness: %s", std::strerror(errno));
+    }
+
+    this->m_isDispatching = isDispatching;
+}
+
+void IOLoop::Loop()
+{
+    this->m_threadConfiguration.ApplyToCurrentThread("io");
+    epoll_event events[MaxEventsPerWait];
+    std::deque<std::function<void()>> readyTasks;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            if (this->m_stopping)
+            {
+                return;
+            }
+
+            readyTasks.swap(this->m_tasks);
+            auto now = std::chrono::steady_clock::now();
+            while (!this->m_timedTasks.empty() && this->m_timedTasks.top().dueTime <= now)
+            {
+                readyTasks.push_back(std::move(const_cast<TimedTask&>(this->m_timedTasks.top()).task));
+                this->m_timedTasks.pop();
+            }
+
+            this->ArmTimer();
+        }
+
+        if (!readyTasks.empty())
+        {
+            // Tasks often queue more work, so the queues are checked again before waiting
+            for (auto& task : readyTasks)
+            {
+                task();
+            }
+
+            readyTasks.clear();
+            continue;
+        }
+
+        int numberOfEvents = epoll_wait(this->m_epollFileDescriptor, events, MaxEventsPerWait, -1 /*timeout*/);
+        for (int i = 0; i < numberOfEvents; ++i)
+        {
+            int fileDescriptor = events[i].data.fd;
+            if (fileDescriptor == this->m_wakeFileDescriptor || fileDescriptor == this->m_timerFileDescriptor)
+            {
+                uint64_t count = 0;
+                ssize_t bytesRead = read(fileDescriptor, &count, sizeof(count));
+                (void)bytesRead;
+            }
+            else if (fileDescriptor == this->m_watchedEpollFileDescriptor)
+            {
+                this->DispatchReadyFileDescriptors();
+            }
+        }
+    }
+}
+
+void IOLoop::Wake()
+{
+    uint64_t count = 1;
+    ssize_t bytesWritten = write(this->m_wakeFileDescriptor, &count, sizeof(count));
+    (void)bytesWritten;
+}
+
+// Arms the timer for the earliest timed task; must be called while holding the mutex
+void IOLoop::ArmTimer()
+{
+    auto dueTime = (this->m_timedTasks.empty() ? std::chrono::steady_clock::time_point::max() : this->m_timedTasks.top().dueTime);
+    if (dueTime == this->m_armedDueTime)
+    {
+        return;
+    }
+
+    // steady_clock uses CLOCK_MONOTONIC on Linux, so its time points can be used as absolute timer expirations. An all-zero
+    // expiration disarms the timer, so a task that is somehow due at the epoch is rounded up by a nanosecond.
+    itimerspec timerSpec{};
+    if (dueTime != std::chrono::steady_clock::time_point::max())
+    {
+        auto nanosecondsSinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(dueTime.time_since_epoch()).count();
+        timerSpec.it_value.tv_sec = static_cast<time_t>(nanosecondsSinceEpoch / 1000000000LL);
+        timerSpec.it_value.tv_nsec = static_cast<long>(nanosecondsSinceEpoch % 1000000000LL);
+        if (timerSpec.it_value.tv_sec == 0 && timerSpec.it_value.tv_nsec == 0)
+        {
+            timerSpec.it_value.tv_nsec = 1;
+        }
+    }
+
+    timerfd_settime(this->m_timerFileDescriptor, TFD_TIMER_ABSTIME, &timerSpec, nullptr);
+    this->m_armedDueTime = dueTime;
+}
+
+void IOLoop::DispatchReadyFileDescriptors()
+{
+    epoll_event events[MaxEventsPerWait];
+    std::lock_guard<std::mutex> lock(this->m_watchMutex);
+    if (!(this->m_isDispatching))
+    {
+        return;
+    }
+
+    int numberOfEvents = epoll_wait(this->m_watchedEpollFileDescriptor, events, MaxEventsPerWait, 0 /*timeout*/);
+    for (int i = 0; i < numberOfEvents; ++i)
+    {
+        auto it = this->m_watchedFileDescriptors.find(events[i].data.fd);
+        if (it != this->m_watchedFileDescriptors.end())
+        {
+            it->second.handler(ToIOEvents(events[i].events));
+        }
+    }
+}
+
+void IOLoop::ControlWatchedFileDescriptor(int operation, int fileDescriptor, unsigned int ioEvents)
+{
+    epoll_event event{};
+    event.events = ToEpollEvents(ioEvents) | EPOLLONESHOT;
+    event.data.fd = fileDescriptor;
+    if (epoll_ctl(this->m_watchedEpollFileDescriptor, operation, fileDescriptor, &event) != 0)
+    {
+        ThrowLastError("Could not watch file descriptor");
+    }
+}
+
+unsigned int IOLoop::ToEpollEvents(unsigned int ioEvents)
+{
+    unsigned int epollEvents = 0;
+    epollEvents |= ((ioEvents & IOAccessor::Readable) != 0 ? static_cast<unsigned int>(EPOLLIN) : 0U);
+    epollEvents |= ((ioEvents & IOAccessor::Writable) != 0 ? static_cast<unsigned int>(EPOLLOUT) : 0U);
+    epollEvents |= ((ioEvents & IOAccessor::HungUp) != 0 ? static_cast<unsigned int>(EPOLLRDHUP) : 0U);
+    return epollEvents;
+}
+
+unsigned int IOLoop::ToIOEvents(unsigned int epollEvents)
+{
+    unsigned int ioEvents = 0;
+    ioEvents |= ((epollEvents & EPOLLIN) != 0 ? static_cast<unsigned int>(IOAccessor::Readable) : 0U);
+    ioEvents |= ((epollEvents & EPOLLOUT) != 0 ? static_cast<unsigned int>(IOAccessor::Writable) : 0U);
+    ioEvents |= ((epollEvents & (EPOLLHUP | EPOLLRDHUP)) != 0 ? static_cast<unsigned int>(IOAccessor::HungUp) : 0U);
+    ioEvents |= ((epollEvents & EPOLLERR) != 0 ? static_cast<unsigned int>(IOAccessor::Error) : 0U);
+    return ioEvents;
+}
+
+void IOLoop::ThrowLastError(const char* operation)
+{
+    throw std::system_error(errno, std::generic_category(), operation);
+}
+
+#endif // __linux__
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef IO_LOOP_H
+#define IO_LOOP_H
+
+#ifdef __linux__
+
+#include "AccessorFramework/Executor.h"
+#include "ThreadConfiguration.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Description
+// The IOLoop is an executor that runs on a single thread built around epoll. Tasks are queued and the thread is woken
+// through an eventfd; delayed tasks are timed with a timerfd. The loop also watches file descriptors on behalf of I/O
+// accessors, which are kept in an epoll instance of their own so that they can be ignored as a group while the host is
+// not running. File descriptors are watched one-shot: once a file descriptor has been reported ready, it is not reported
+// again until it is rearmed, which the accessor does after it has handled the readiness. A host with I/O accessors uses
+// its IOLoop as its executor, so callbacks, reactions, and readiness are all handled on the same thread.
+//
+class IOLoop : public Executor
+{
+public:
+    using ReadyHandler = std::function<void(unsigned int /*ioEvents*/)>;
+
+    explicit IOLoop(ThreadConfiguration threadConfiguration = ThreadConfiguration());
+    ~IOLoop();
+    void Execute(std::function<void()> task) override;
+    void ExecuteAfter(long long delayInMilliseconds, std::function<void()> task) override;
+    void Watch(int fileDescriptor, unsigned int ioEvents, ReadyHandler handler);
+    void Rearm(int fileDescriptor);
+    void Unwatch(int fileDescriptor);
+    void SetDispatching(bool isDispatching);
+
+private:
+    struct TimedTask
+    {
+        std::chrono::steady_clock::time_point dueTime;
+        unsigned long long sequenceNumber;
+        std::function<void()> task;
+
+        bool operator>(const TimedTask& other) const
+        {
+            return (this->dueTime > other.dueTime || (this->dueTime == other.dueTime && this->sequenceNumber > other.sequenceNumber));
+        }
+    };
+
+    struct WatchedFileDescriptor
+    {
+        unsigned int ioEvents;
+        ReadyHandler handler;
+    };
+
+    void Loop();
+    void Wake();
+    void ArmTimer();
+    void DispatchReadyFileDescriptors();
+    void ControlWatchedFileDescriptor(int operation, int fileDescriptor, unsigned int ioEvents);
+
+    static unsigned int ToEpollEvents(unsigned int ioEvents);
+    static unsigned int ToIOEvents(unsigned int epollEvents);
+    static void ThrowLastError(const char* operation);
+
+    ThreadConfiguration m_threadConfiguration;
+    int m_epollFileDescriptor;
+    int m_watchedEpollFileDescriptor;
+    int m_wakeFileDescriptor;
+    int m_timerFileDescriptor;
+
+    std::mutex m_mutex;
+    std::deque<std::function<void()>> m_tasks;
+    std::priority_queue<TimedTask, std::vector<TimedTask>, std::greater<TimedTask>> m_timedTasks;
+    unsigned long long m_nextSequenceNumber;
+    std::chrono::steady_clock::time_point m_armedDueTime;
+    bool m_stopping;
+
+    std::mutex m_watchMutex;
+    std::unordered_map<int, WatchedFileDescriptor> m_watchedFileDescriptors;
+    bool m_isDispatching;
+
+    std::thread m_thread;
+};
+
+#endif // __linux__
+
+#endif // IO_LOOP_H
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <climits>
+
+const size_t LatencyHistogram::SubBucketCount;
+const size_t LatencyHistogram::NumberOfBuckets;
+
+LatencyHistogram::LatencyHistogram() :
+    m_buckets(new std::atomic<unsigned long long>[NumberOfBuckets]),
+    m_min(LLONG_MAX),
+    m_max(0LL)
+{
+    for (size_t i = 0; i < NumberOfBuckets; ++i)
+    {
+        this->m_buckets[i].store(0ULL, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::Record(long long valueInNanoseconds)
+{
+    long long value = std::max(valueInNanoseconds, 0LL);
+    this->m_buckets[GetBucketIndex(static_cast<unsigned long long>(value))].fetch_add(1ULL, std::memory_order_relaxed);
+
+    long long min = this->m_min.load(std::memory_order_relaxed);
+    while (value < min && !this->m_min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+    {
+    }
+
+    long long max = this->m_max.load(std::memory_order_relaxed);
+    while (value > max && !this->m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Percentiles are reported as the highest value in their bucket, but never more than the maximum
+Host::LatencyDistribution LatencyHistogram::GetDistribution() const
+{
+    Host::LatencyDistribution distribution{};
+    unsigned long long count = 0ULL;
+    for (size_t i = 0; i < NumberOfBuckets; ++i)
+    {
+        count += this->m_buckets[i].load(std::memory_order_relaxed);
+    }
+
+    distribution.count = count;
+    if (count == 0ULL)
+    {
+        return distribution;
+    }
+
+    long long min = this->m_min.load(std::memory_order_relaxed);
+    long long max = this->m_max.load(std::memory_order_relaxed);
+    distribution.min = std::chrono::nanoseconds(min == LLONG_MAX ? 0LL : min);
+    distribution.max = std::chrono::nanoseconds(max);
+
+    const double fractions[] = { 0.50, 0.90, 0.99, 0.999 };
+    std::chrono::nanoseconds* percentiles[] = { &distribution.p50, &distribution.p90, &distribution.p99, &distribution.p999 };
+    size_t nextPercentile = 0;
+    unsigned long long cumulativeCount = 0ULL;
+    for (size_t i = 0; i < NumberOfBuckets && nextPercentile < 4; ++i)
+    {
+        cumulativeCount += this->m_buckets[i].load(std::memory_order_relaxed);
+        while (nextPercentile < 4 && static_cast<double>(cumulativeCount) >= fractions[nextPercentile] * static_cast<double>(count))
+        {
+            long long highestValue = static_cast<long long>(GetHighestValueInBucket(i));
+            *(percentiles[nextPercentile]) = std::chrono::nanoseconds(std::min(highestValue, max));
+            ++nextPercentile;
+        }
+    }
+
+    return distribution;
+}
+
+void LatencyHistogram::Reset()
+{
+    for (size_t i = 0; i < NumberOfBuckets; ++i)
+    {
+        this->m_buckets[i].store(0ULL, std::memory_order_relaxed);
+    }
+
+    this->m_min.store(LLONG_MAX, std::memory_order_relaxed);
+    this->m_max.store(0LL, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::GetBucketIndex(unsigned long long value)
+{
+    if (value < (1ULL << LinearBits))
+    {
+        return static_cast<size_t>(value);
+    }
+
+    int shift = GetHighestSetBit(value) - (LinearBits - 1);
+    size_t subBucket = static_cast<size_t>(value >> shift) - SubBucketCount;
+    return (1ULL << LinearBits) + (shift - 1) * SubBucketCount + subBucket;
+}
+
+unsigned long long LatencyHistogram::GetHighestValueInBucket(size_t bucketIndex)
+{
+    if (bucketIndex < (1ULL << LinearBits))
+    {
+        return bucketIndex;
+    }
+
+    size_t exponentialIndex = bucketIndex - (1ULL << LinearBits);
+    int shift = static_cast<int>(exponentialIndex / SubBucketCount) + 1;
+    unsigned long long subBucket = exponentialIndex % SubBucketCount + SubBucketCount;
+    return ((subBucket + 1ULL) << shift) - 1ULL;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include "AccessorFramework/Host.h"
+#include <atomic>
+#include <memory>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Description
+// A LatencyHistogram counts non-negative durations in nanoseconds in buckets whose width grows with the value, in the
+// manner of an HDR histogram: values below 128 get a bucket each, and above that, every power of two is split into 64
+// buckets, so any value is known to within 1/64th (about 1.6%) from a few kilobytes that cover the full range of a long
+// long. Recording is a relaxed atomic increment, plus updates of the minimum and maximum that only loop when another
+// thread changes them at the same moment, so any thread can record, read, or reset the histogram at any time. A reading
+// taken while values are being recorded or reset may be off by those values.
+//
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+    void Record(long long valueInNanoseconds);
+    Host::LatencyDistribution GetDistribution() const;
+    void Reset();
+
+private:
+    static const int LinearBits = 7; // values below 2^LinearBits get a bucket each
+    static const size_t SubBucketCount = 1ULL << (LinearBits - 1);
+    static const size_t NumberOfBuckets = (1ULL << LinearBits) + (63 - LinearBits) * SubBucketCount;
+
+    static size_t GetBucketIndex(unsigned long long value);
+    static unsigned long long GetHighestValueInBucket(size_t bucketIndex);
+
+    static int GetHighestSetBit(unsigned long long value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        int index = 0;
+        while (value >>= 1)
+        {
+            ++index;
+        }
+
+        return index;
+#endif
+    }
+
+    std::unique_ptr<std::atomic<unsigned long long>[]> m_buckets;
+    std::atomic<long long> m_min;
+    std::atomic<long long> m_max;
+};
+
+#endif // LATENCY_HISTOGRAM_H
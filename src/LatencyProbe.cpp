@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "LatencyProbe.h"
+
+const size_t LatencyProbe::StampCapacity;
+
+LatencyProbe::LatencyProbe(int id, const std::string& outputPortName, const std::string& inputPortName) :
+    id(id),
+    outputPortName(outputPortName),
+    inputPortName(inputPortName),
+    m_stamps(StampCapacity),
+    m_oldestStamp(0),
+    m_numberOfStamps(0)
+{
+}
+
+void LatencyProbe::Stamp(long long logicalTimeInMilliseconds)
+{
+    if (this->m_numberOfStamps == StampCapacity)
+    {
+        this->m_numberOfDroppedSamples.Increment();
+        return;
+    }
+
+    StampRecord& stamp = this->m_stamps[(this->m_oldestStamp + this->m_numberOfStamps) % StampCapacity];
+    stamp.time = std::chrono::steady_clock::now();
+    stamp.logicalTime = logicalTimeInMilliseconds;
+    ++(this->m_numberOfStamps);
+}
+
+void LatencyProbe::Measure(long long logicalTimeInMilliseconds)
+{
+    if (this->m_numberOfStamps == 0)
+    {
+        this->m_numberOfDroppedSamples.Increment();
+        return;
+    }
+
+    const StampRecord& stamp = this->m_stamps[this->m_oldestStamp];
+    if (stamp.logicalTime > logicalTimeInMilliseconds)
+    {
+        // The oldest send has not happened yet as far as this invocation is concerned, so it belongs to a later one
+        this->m_numberOfDroppedSamples.Increment();
+        return;
+    }
+
+    auto wallClockLatency = std::chrono::steady_clock::now() - stamp.time;
+    this->m_wallClockLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(wallClockLatency).count());
+    auto logicalLatency = std::chrono::milliseconds(logicalTimeInMilliseconds - stamp.logicalTime);
+    this->m_logicalLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(logicalLatency).count());
+    this->m_oldestStamp = (this->m_oldestStamp + 1) % StampCapacity;
+    --(this->m_numberOfStamps);
+}
+
+Host::LatencyProbeReport LatencyProbe::GetReport() const
+{
+    Host::LatencyProbeReport report{};
+    report.id = this->id;
+    report.outputPortName = this->outputPortName;
+    report.inputPortName = this->inputPortName;
+    report.wallClockLatency = this->m_wallClockLatency.GetDistribution();
+    report.logicalLatency = this->m_logicalLatency.GetDistribution();
+    report.numberOfDroppedSamples = this->m_numberOfDroppedSamples.Get();
+    return report;
+}
+
+void LatencyProbe::Reset()
+{
+    this->m_wallClockLatency.Reset();
+    this->m_logicalLatency.Reset();
+    this->m_numberOfDroppedSamples.Reset();
+}
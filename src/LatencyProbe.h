@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include "AccessorFramework/Host.h"
+#include "LatencyHistogram.h"
+#include "ProfilingCounter.h"
+#include <string>
+#include <vector>
+
+// Description
+// A LatencyProbe measures how long it takes for an output sent by one atomic accessor to reach the input handlers of a
+// downstream atomic accessor, possibly through other accessors. The output port stamps the probe with the wall-clock and
+// logical time whenever its accessor calls SendOutput(), and the stamps wait in a FIFO ring of fixed capacity until the
+// input port's handlers are invoked. Each invocation takes the oldest stamp and records the time since it in one
+// histogram for wall-clock time and another for logical time, so outputs that queue up on the way are each measured
+// against their own send. Pairing in order assumes every output reaches the input port once and in order, so whenever
+// the probe can tell that it does not, it counts a dropped sample instead of measuring: a send whose stamp does not fit
+// in the ring (the stamps already waiting are kept, since their outputs are the next to arrive), an invocation with no
+// stamp waiting, and an invocation at an earlier logical time than the oldest stamp. A probe whose outputs are filtered
+// out on the way fills its ring and then drops every later send, which shows in the count. Stamps are only taken and
+// measured by the thread executing the host's current round, but the histograms and the count can be read and reset
+// from any thread.
+//
+class LatencyProbe
+{
+public:
+    LatencyProbe(int id, const std::string& outputPortName, const std::string& inputPortName);
+    void Stamp(long long logicalTimeInMilliseconds);
+    void Measure(long long logicalTimeInMilliseconds);
+    Host::LatencyProbeReport GetReport() const;
+    void Reset();
+
+    const int id;
+    const std::string outputPortName; // full name
+    const std::string inputPortName; // full name
+
+private:
+    struct StampRecord
+    {
+        std::chrono::steady_clock::time_point time;
+        long long logicalTime;
+    };
+
+    static const size_t StampCapacity = 256;
+
+    std::vector<StampRecord> m_stamps; // allocated up front, so stamping never allocates
+    size_t m_oldestStamp;
+    size_t m_numberOfStamps;
+    LatencyHistogram m_wallClockLatency;
+    LatencyHistogram m_logicalLatency;
+    ProfilingCounter m_numberOfDroppedSamples;
+};
+
+#endif // LATENCY_PROBE_H
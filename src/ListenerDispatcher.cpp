@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ListenerDispatcher.h"
+#include "ThreadExecutor.h"
+#include <cstdint>
+
+const size_t ListenerDispatcher::CacheLineSize;
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+// A slot whose sequence number equals a producer's ticket is free for that producer; one whose sequence number is one
+// past the consumer's head holds the next notification to deliver
+ListenerDispatcher::ListenerDispatcher(size_t capacity) :
+    m_slots(RoundUpToPowerOfTwo(capacity)),
+    m_mask(m_slots.size() - 1),
+    m_executor(ThreadExecutor::GetDefault()),
+    m_tail(0),
+    m_numberOfNotificationsPosted(0ULL),
+    m_numberOfNotificationsDropped(0ULL),
+    m_isDelivering(false),
+    m_head(0),
+    m_numberOfNotificationsDelivered(0ULL),
+    m_listeners(std::make_shared<const ListenerMap>()),
+    m_nextListenerId(0)
+{
+    for (size_t i = 0; i < this->m_slots.size(); ++i)
+    {
+        this->m_slots[i].sequenceNumber.store(i, std::memory_order_relaxed);
+    }
+}
+
+size_t ListenerDispatcher::GetCapacity() const
+{
+    return this->m_slots.size();
+}
+
+std::shared_ptr<Executor> ListenerDispatcher::GetExecutor() const
+{
+    return this->m_executor;
+}
+
+void ListenerDispatcher::SetExecutor(std::shared_ptr<Executor> executor)
+{
+    this->m_executor = (executor != nullptr ? std::move(executor) : ThreadExecutor::GetDefault());
+}
+
+bool ListenerDispatcher::ListenerIsRegistered(int listenerId) const
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    return (this->m_listeners->find(listenerId) != this->m_listeners->end());
+}
+
+int ListenerDispatcher::AddListener(std::weak_ptr<Host::EventListener> listener)
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    int listenerId = this->m_nextListenerId++;
+    auto listeners = std::make_shared<ListenerMap>(*(this->m_listeners));
+    listeners->emplace(listenerId, std::move(listener));
+    this->m_listeners = std::move(listeners);
+    return listenerId;
+}
+
+void ListenerDispatcher::RemoveListener(int listenerId)
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (this->m_listeners->find(listenerId) == this->m_listeners->end())
+    {
+        return;
+    }
+
+    auto listeners = std::make_shared<ListenerMap>(*(this->m_listeners));
+    listeners->erase(listenerId);
+    this->m_listeners = std::move(listeners);
+}
+
+void ListenerDispatcher::PostStateChange(Host::State oldState, Host::State newState)
+{
+    this->Post(Notification{ oldState, newState, nullptr });
+}
+
+void ListenerDispatcher::PostException(std::exception_ptr exception)
+{
+    this->Post(Notification{ Host::State::Corrupted, Host::State::Corrupted, std::move(exception) });
+}
+
+// Notifications are delivered in the order of their tickets, so once as many have been delivered as tickets had been
+// claimed, every notification posted before the call has been delivered
+void ListenerDispatcher::WaitForDelivery() const
+{
+    unsigned long long numberOfTickets = this->m_tail.load();
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    this->m_deliveryCondition.wait(
+        lock,
+        [this, numberOfTickets]() { return this->m_numberOfNotificationsDelivered.load() >= numberOfTickets; });
+}
+
+unsigned long long ListenerDispatcher::GetNumberOfNotificationsPosted() const
+{
+    return this->m_numberOfNotificationsPosted.load(std::memory_order_relaxed);
+}
+
+unsigned long long ListenerDispatcher::GetNumberOfNotificationsDelivered() const
+{
+    return this->m_numberOfNotificationsDelivered.load(std::memory_order_relaxed);
+}
+
+unsigned long long ListenerDispatcher::GetNumberOfNotificationsDropped() const
+{
+    return this->m_numberOfNotificationsDropped.load(std::memory_order_relaxed);
+}
+
+// A producer claims a ticket, fills the ticket's slot, and only then counts the notification as posted, so a delivery
+// task that sees the count go up will also find the notification. Counting before setting m_isDelivering, which the
+// delivery task clears before it reads the count for the last time, ensures every notification is delivered by either
+// the task that is under way or a new one.
+void ListenerDispatcher::Post(Notification&& notification)
+{
+    size_t tail = this->m_tail.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true)
+    {
+        slot = &(this->m_slots[tail & this->m_mask]);
+        size_t sequenceNumber = slot->sequenceNumber.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequenceNumber) - static_cast<intptr_t>(tail);
+        if (difference == 0)
+        {
+            if (this->m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            this->m_numberOfNotificationsDropped.fetch_add(1ULL, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            tail = this->m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->notification = std::move(notification);
+    slot->sequenceNumber.store(tail + 1, std::memory_order_release);
+    this->m_numberOfNotificationsPosted.fetch_add(1ULL);
+    if (!(this->m_isDelivering.exchange(true)))
+    {
+        std::shared_ptr<ListenerDispatcher> dispatcher = this->shared_from_this();
+        this->m_executor->Execute([dispatcher]() { dispatcher->Deliver(); });
+    }
+}
+
+// Only called by the delivery task. The slot's exception is released here rather than when the slot is next written.
+bool ListenerDispatcher::TryTake(Notification& notification)
+{
+    Slot& slot = this->m_slots[this->m_head & this->m_mask];
+    if (slot.sequenceNumber.load(std::memory_order_acquire) != this->m_head + 1)
+    {
+        return false;
+    }
+
+    notification = std::move(slot.notification);
+    slot.notification.exception = nullptr;
+    slot.sequenceNumber.store(this->m_head + this->m_slots.size(), std::memory_order_release);
+    ++(this->m_head);
+    return true;
+}
+
+// A notification that a producer has claimed but not yet counted may be delivered before it is counted, so the task
+// stops once it has delivered at least as many notifications as have been posted
+void ListenerDispatcher::Deliver()
+{
+    do
+    {
+        Notification notification{};
+        while (this->TryTake(notification))
+        {
+            std::shared_ptr<const ListenerMap> listeners = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                listeners = this->m_listeners;
+            }
+
+            this->Deliver(notification, *listeners);
+            notification.exception = nullptr;
+            this->m_numberOfNotificationsDelivered.fetch_add(1ULL);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+        }
+
+        this->m_deliveryCondition.notify_all();
+        this->m_isDelivering.store(false);
+    } while (this->m_numberOfNotificationsDelivered.load() < this->m_numberOfNotificationsPosted.load() && !(this->m_isDelivering.exchange(true)));
+}
+
+void ListenerDispatcher::Deliver(const Notification& notification, const ListenerMap& listeners)
+{
+    for (const auto& entry : listeners)
+    {
+        auto strongListener = entry.second.lock();
+        if (strongListener == nullptr)
+        {
+            this->RemoveListener(entry.first);
+            continue;
+        }
+
+        try
+        {
+            if (notification.exception == nullptr)
+            {
+                strongListener->NotifyOfStateChange(notification.oldState, notification.newState);
+                continue;
+            }
+
+            try
+            {
+                std::rethrow_exception(notification.exception);
+            }
+            catch (const std::exception& e)
+            {
+                strongListener->NotifyOfException(e);
+            }
+        }
+        catch (const std::exception&)
+        {
+            this->RemoveListener(entry.first);
+        }
+    }
+}
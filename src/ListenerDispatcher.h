@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef LISTENER_DISPATCHER_H
+#define LISTENER_DISPATCHER_H
+
+#include "AccessorFramework/Host.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Description
+// A ListenerDispatcher delivers a host's notifications (state changes and exceptions) to its event listeners away from
+// the thread that posts them, so a slow listener never holds up the host. Any thread may post a notification; posting
+// is lock-free and never waits for a listener. Notifications go into a bounded multi-producer ring, in which each slot
+// carries a sequence number that tells producers and the consumer whose turn it is to use it, and a notification posted
+// while the ring is full is dropped and counted instead. The first notification posted while no delivery is under way
+// hands a delivery task to the dispatcher's executor (the only part of posting that allocates), which delivers
+// everything in the ring, in the order in which it was posted, until the ring is empty. Only one delivery task runs at
+// a time, so listeners are never called concurrently and see notifications in order.
+//
+// Listeners can be added and removed from any thread, including from a listener. The listeners are kept in a map that
+// is copied whenever it changes, so a delivery task only holds the lock long enough to take the current map. A listener
+// that has expired or that throws an exception is removed.
+//
+class ListenerDispatcher : public std::enable_shared_from_this<ListenerDispatcher>
+{
+public:
+    explicit ListenerDispatcher(size_t capacity);
+    size_t GetCapacity() const; // the requested capacity rounded up to a power of two
+    std::shared_ptr<Executor> GetExecutor() const;
+    void SetExecutor(std::shared_ptr<Executor> executor); // nullptr restores the default executor; should only be called while no other thread posts
+
+    bool ListenerIsRegistered(int listenerId) const;
+    int AddListener(std::weak_ptr<Host::EventListener> listener);
+    void RemoveListener(int listenerId);
+
+    // Lock-free; may be called from any thread
+    void PostStateChange(Host::State oldState, Host::State newState);
+    void PostException(std::exception_ptr exception);
+
+    // Blocks until every notification posted before the call has been delivered; must not be called by a listener
+    void WaitForDelivery() const;
+
+    unsigned long long GetNumberOfNotificationsPosted() const;
+    unsigned long long GetNumberOfNotificationsDelivered() const;
+    unsigned long long GetNumberOfNotificationsDropped() const;
+
+private:
+    using ListenerMap = std::map<int, std::weak_ptr<Host::EventListener>>;
+
+    struct Notification
+    {
+        Host::State oldState;
+        Host::State newState;
+        std::exception_ptr exception; // null for a state change
+    };
+
+    struct Slot
+    {
+        std::atomic<size_t> sequenceNumber;
+        Notification notification;
+    };
+
+    static const size_t CacheLineSize = 64;
+
+    void Post(Notification&& notification);
+    bool TryTake(Notification& notification);
+    void Deliver();
+    void Deliver(const Notification& notification, const ListenerMap& listeners);
+
+    std::vector<Slot> m_slots;
+    const size_t m_mask;
+    std::shared_ptr<Executor> m_executor;
+
+    // Claimed by producers
+    char m_producerPadding[CacheLineSize];
+    std::atomic<size_t> m_tail;
+    std::atomic<unsigned long long> m_numberOfNotificationsPosted;
+    std::atomic<unsigned long long> m_numberOfNotificationsDropped;
+    std::atomic_bool m_isDelivering;
+
+    // Only written by the delivery task
+    char m_consumerPadding[CacheLineSize];
+    size_t m_head;
+    std::atomic<unsigned long long> m_numberOfNotificationsDelivered;
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_deliveryCondition;
+    std::shared_ptr<const ListenerMap> m_listeners;
+    int m_nextListenerId;
+};
+
+#endif // LISTENER_DISPATCHER_H
@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static const std::chrono::milliseconds DrainInterval(50);
+
+const size_t Logger::MessagesPerThread;
+const size_t Logger::MaxMessageLength;
+
+thread_local Logger::MessageRingLease Logger::s_currentThreadRing;
+std::atomic<int> Logger::s_level(static_cast<int>(Logger::Level::Verbose));
+
+static const char* GetLevelName(Logger::Level level)
+{
+    switch (level)
+    {
+        case Logger::Level::Verbose:
+            return "VERBOSE";
+        case Logger::Level::Debug:
+            return "DEBUG";
+        case Logger::Level::Info:
+            return "INFO";
+        case Logger::Level::Warning:
+            return "WARNING";
+        case Logger::Level::Error:
+        default:
+            return "ERROR";
+    }
+}
+
+static long long GetNanosecondsSinceEpoch()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Logger::Write(Level level, const char* format, ...)
+{
+    MessageRing* ring = GetInstance().GetCurrentThreadRing();
+    Message* message = ring->BeginWrite();
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    message->timeInNanoseconds = GetNanosecondsSinceEpoch();
+    message->level = level;
+    message->threadIndex = ring->threadIndex;
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(message->text, sizeof(message->text), format, arguments);
+    va_end(arguments);
+    ring->EndWrite();
+}
+
+void Logger::Flush()
+{
+    GetInstance().Drain();
+}
+
+void Logger::SetLevel(Level level)
+{
+    s_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::SetOutput(FILE* output)
+{
+    Logger& logger = GetInstance();
+    logger.Drain();
+    std::lock_guard<std::mutex> lock(logger.m_drainMutex);
+    logger.m_output = (output != nullptr ? output : stderr);
+}
+
+unsigned long long Logger::GetNumberOfDroppedMessages()
+{
+    return GetInstance().m_numberOfDroppedMessages.load(std::memory_order_relaxed);
+}
+
+Logger::MessageRing::MessageRing(unsigned int threadIndex) :
+    threadIndex(threadIndex),
+    m_messages(new Message[MessagesPerThread]),
+    m_head(0),
+    m_tail(0),
+    m_numberOfDroppedMessages(0ULL)
+{
+}
+
+Logger::Message* Logger::MessageRing::BeginWrite()
+{
+    size_t head = this->m_head.load(std::memory_order_relaxed);
+    if (head - this->m_tail.load(std::memory_order_acquire) == MessagesPerThread)
+    {
+        this->m_numberOfDroppedMessages.fetch_add(1ULL, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return &(this->m_messages[head % MessagesPerThread]);
+}
+
+void Logger::MessageRing::EndWrite()
+{
+    this->m_head.store(this->m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void Logger::MessageRing::Drain(std::vector<Message>& messages)
+{
+    size_t tail = this->m_tail.load(std::memory_order_relaxed);
+    size_t head = this->m_head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+    {
+        messages.push_back(this->m_messages[tail % MessagesPerThread]);
+    }
+
+    this->m_tail.store(tail, std::memory_order_release);
+}
+
+unsigned long long Logger::MessageRing::TakeNumberOfDroppedMessages()
+{
+    return this->m_numberOfDroppedMessages.exchange(0ULL, std::memory_order_relaxed);
+}
+
+Logger::MessageRingLease::~MessageRingLease()
+{
+    if (this->ring != nullptr)
+    {
+        Logger& logger = GetInstance();
+        std::lock_guard<std::mutex> lock(logger.m_ringsMutex);
+        logger.m_availableRings.push_back(this->ring);
+    }
+}
+
+Logger::Logger() :
+    m_output(stderr),
+    m_numberOfDroppedMessages(0ULL),
+    m_stopping(false)
+{
+    this->m_writer = std::thread(&Logger::WriterLoop, this);
+    std::atexit(&Logger::Shutdown);
+}
+
+// The logger is never destroyed, so that threads still running while the process exits can log safely
+Logger& Logger::GetInstance()
+{
+    static Logger* instance = new Logger();
+    return *instance;
+}
+
+void Logger::Shutdown()
+{
+    Logger& logger = GetInstance();
+    {
+        std::lock_guard<std::mutex> lock(logger.m_writerMutex);
+        logger.m_stopping = true;
+    }
+
+    logger.m_writerWakeUp.notify_one();
+    if (logger.m_writer.joinable())
+    {
+        logger.m_writer.join();
+    }
+
+    logger.Drain();
+}
+
+Logger::MessageRing* Logger::GetCurrentThreadRing()
+{
+    if (s_currentThreadRing.ring == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(this->m_ringsMutex);
+        if (this->m_availableRings.empty())
+        {
+            this->m_rings.push_back(std::make_unique<MessageRing>(static_cast<unsigned int>(this->m_rings.size() + 1)));
+            s_currentThreadRing.ring = this->m_rings.back().get();
+        }
+        else
+        {
+            s_currentThreadRing.ring = this->m_availableRings.back();
+            this->m_availableRings.pop_back();
+        }
+    }
+
+    return s_currentThreadRing.ring;
+}
+
+void Logger::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(this->m_writerMutex);
+    while (!this->m_stopping)
+    {
+        this->m_writerWakeUp.wait_for(lock, DrainInterval);
+        lock.unlock();
+        this->Drain();
+        lock.lock();
+    }
+}
+
+void Logger::Drain()
+{
+    std::lock_guard<std::mutex> drainLock(this->m_drainMutex);
+    std::vector<MessageRing*> rings{};
+    {
+        std::lock_guard<std::mutex> ringsLock(this->m_ringsMutex);
+        for (const auto& ring : this->m_rings)
+        {
+            rings.push_back(ring.get());
+        }
+    }
+
+    std::vector<Message> messages{};
+    unsigned long long numberOfDroppedMessages = 0ULL;
+    for (MessageRing* ring : rings)
+    {
+        ring->Drain(messages);
+        numberOfDroppedMessages += ring->TakeNumberOfDroppedMessages();
+    }
+
+    if (messages.empty() && numberOfDroppedMessages == 0ULL)
+    {
+        return;
+    }
+
+    this->m_numberOfDroppedMessages.fetch_add(numberOfDroppedMessages, std::memory_order_relaxed);
+    std::stable_sort(messages.begin(), messages.end(),
+        [](const Message& a, const Message& b)
+        {
+            return a.timeInNanoseconds < b.timeInNanoseconds;
+        });
+
+    std::string output{};
+    char line[MaxMessageLength + 64];
+    for (const Message& message : messages)
+    {
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "%lld.%06lld %-7s [%u] %s\n",
+            message.timeInNanoseconds / 1000000000LL,
+            (message.timeInNanoseconds / 1000LL) % 1000000LL,
+            GetLevelName(message.level),
+            message.threadIndex,
+            message.text);
+        output.append(line, std::min(static_cast<size_t>(std::max(length, 0)), sizeof(line) - 1));
+    }
+
+    if (numberOfDroppedMessages != 0ULL)
+    {
+        snprintf(line, sizeof(line), "%s: %llu log messages were dropped because their thread's buffer was full\n", GetLevelName(Level::Warning), numberOfDroppedMessages);
+        output.append(line);
+    }
+
+    fwrite(output.data(), 1, output.size(), this->m_output);
+    fflush(this->m_output);
+}
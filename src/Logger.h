@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Description
+// The Logger writes the framework's diagnostic messages to stderr without making the threads that log them wait for
+// each other or for stderr. A message is formatted on the thread that logs it, straight into a ring buffer owned by that
+// thread; the buffer has a single reader, so adding a message takes no lock. A background thread drains every buffer a
+// few times per second, sorts what it found by time, and writes it out in one go. A message that finds its thread's
+// buffer full is dropped, and the number of dropped messages is reported in the output. When a thread exits, its buffer
+// is handed to the next thread that needs one. Everything still buffered is written when the process exits.
+//
+// Each message has a level. Messages below ACCESSOR_FRAMEWORK_LOG_LEVEL are compiled out entirely. By default, that is
+// DEBUG in debug builds (VERBOSE if VERBOSE is defined) and WARNING when NDEBUG is defined; the LOG_LEVEL CMake option
+// overrides it, e.g. to keep DEBUG messages in an optimized build. Of the messages compiled in, those below the level
+// set with SetLevel() are skipped at run time before their arguments are evaluated, at the cost of one relaxed load.
+//
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_VERBOSE 0
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_DEBUG 1
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_INFO 2
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_WARNING 3
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_ERROR 4
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL_OFF 5
+
+#ifndef ACCESSOR_FRAMEWORK_LOG_LEVEL
+#if defined(VERBOSE)
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL ACCESSOR_FRAMEWORK_LOG_LEVEL_VERBOSE
+#elif defined(NDEBUG)
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL ACCESSOR_FRAMEWORK_LOG_LEVEL_WARNING
+#else
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL ACCESSOR_FRAMEWORK_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#define ACCESSOR_FRAMEWORK_LOG(level, format, ...) do { if (Logger::IsEnabled(level)) { Logger::Write(level, format, ##__VA_ARGS__); } } while (0)
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(format, ...) ACCESSOR_FRAMEWORK_LOG(Logger::Level::Verbose, format, ##__VA_ARGS__)
+#else
+#define LOG_VERBOSE(format, ...) do { } while (0)
+#endif
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) ACCESSOR_FRAMEWORK_LOG(Logger::Level::Debug, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do { } while (0)
+#endif
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) ACCESSOR_FRAMEWORK_LOG(Logger::Level::Info, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do { } while (0)
+#endif
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_WARNING
+#define LOG_WARNING(format, ...) ACCESSOR_FRAMEWORK_LOG(Logger::Level::Warning, format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(format, ...) do { } while (0)
+#endif
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) ACCESSOR_FRAMEWORK_LOG(Logger::Level::Error, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do { } while (0)
+#endif
+
+class Logger
+{
+public:
+    enum class Level
+    {
+        Verbose = ACCESSOR_FRAMEWORK_LOG_LEVEL_VERBOSE,
+        Debug = ACCESSOR_FRAMEWORK_LOG_LEVEL_DEBUG,
+        Info = ACCESSOR_FRAMEWORK_LOG_LEVEL_INFO,
+        Warning = ACCESSOR_FRAMEWORK_LOG_LEVEL_WARNING,
+        Error = ACCESSOR_FRAMEWORK_LOG_LEVEL_ERROR
+    };
+
+    static const size_t MessagesPerThread = 1024;
+
+    static void Write(Level level, const char* format, ...);
+
+    // Writes every buffered message before returning
+    static void Flush();
+
+    // Messages below the level are skipped (Verbose by default, so every message compiled in is written)
+    static void SetLevel(Level level);
+    static bool IsEnabled(Level level)
+    {
+        return static_cast<int>(level) >= s_level.load(std::memory_order_relaxed);
+    }
+
+    // Messages logged before the call are written to the previous output; null restores stderr
+    static void SetOutput(FILE* output);
+
+    // Counted as the buffers are drained, so Flush() first to include the latest
+    static unsigned long long GetNumberOfDroppedMessages();
+
+private:
+    static const size_t MaxMessageLength = 231;
+
+    struct Message
+    {
+        long long timeInNanoseconds;
+        Level level;
+        unsigned int threadIndex;
+        char text[MaxMessageLength + 1];
+    };
+
+    // Written only by the thread that owns it and read only by the thread draining it
+    class MessageRing
+    {
+    public:
+        explicit MessageRing(unsigned int threadIndex);
+        Message* BeginWrite();
+        void EndWrite();
+        void Drain(std::vector<Message>& messages);
+        unsigned long long TakeNumberOfDroppedMessages();
+
+        const unsigned int threadIndex;
+
+    private:
+        std::unique_ptr<Message[]> m_messages;
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+        std::atomic<unsigned long long> m_numberOfDroppedMessages;
+    };
+
+    // Returns the current thread's ring to the pool when the thread exits
+    class MessageRingLease
+    {
+    public:
+        ~MessageRingLease();
+        MessageRing* ring = nullptr;
+    };
+
+    Logger();
+    static Logger& GetInstance();
+    static void Shutdown();
+    MessageRing* GetCurrentThreadRing();
+    void WriterLoop();
+    void Drain();
+
+    std::mutex m_ringsMutex;
+    std::vector<std::unique_ptr<MessageRing>> m_rings;
+    std::vector<MessageRing*> m_availableRings;
+    std::mutex m_drainMutex; // also guards m_output
+    FILE* m_output;
+    std::atomic<unsigned long long> m_numberOfDroppedMessages;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerWakeUp;
+    bool m_stopping;
+    std::thread m_writer;
+
+    static thread_local MessageRingLease s_currentThreadRing;
+    static std::atomic<int> s_level;
+};
+
+#endif // LOGGER_H
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ModelGraph.h"
+#include <map>
+#include <ostream>
+
+const int ModelGraph::NoDepth;
+
+static void WriteEscapedCharacters(std::ostream& stream, const std::string& value)
+{
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            stream << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            stream << ' ';
+        }
+        else
+        {
+            stream << c;
+        }
+    }
+}
+
+static void WriteEscapedString(std::ostream& stream, const std::string& value)
+{
+    stream << '"';
+    WriteEscapedCharacters(stream, value);
+    stream << '"';
+}
+
+// Characters that delimit fields in a DOT record label
+static void WriteRecordField(std::ostream& stream, const std::string& value)
+{
+    for (char c : value)
+    {
+        if (c == '{' || c == '}' || c == '|' || c == '<' || c == '>' || c == '"' || c == '\\' || c == ' ')
+        {
+            stream << '\\';
+        }
+
+        stream << c;
+    }
+}
+
+static void WriteRecordPorts(std::ostream& stream, const std::vector<ModelGraph::PortNode>& ports, char prefix)
+{
+    stream << '{';
+    for (size_t i = 0; i < ports.size(); ++i)
+    {
+        stream << (i == 0 ? "" : "|") << '<' << prefix << i << "> ";
+        WriteRecordField(stream, ports[i].shortName);
+    }
+
+    stream << '}';
+}
+
+static void WriteDotAccessor(
+    std::ostream& stream,
+    const std::vector<ModelGraph::AccessorNode>& accessors,
+    const std::vector<std::vector<size_t>>& children,
+    size_t index,
+    const std::string& indent)
+{
+    const ModelGraph::AccessorNode& accessor = accessors[index];
+    std::string id = "a" + std::to_string(index);
+    if (!(accessor.isComposite))
+    {
+        stream << indent << '"' << id << "\" [label=\"{";
+        if (!(accessor.inputPorts.empty()))
+        {
+            WriteRecordPorts(stream, accessor.inputPorts, 'i');
+            stream << '|';
+        }
+
+        WriteRecordField(stream, accessor.shortName);
+        stream << "\\npriority\\ " << accessor.priority << ",\\ depth\\ " << accessor.depth;
+        if (!(accessor.outputPorts.empty()))
+        {
+            stream << '|';
+            WriteRecordPorts(stream, accessor.outputPorts, 'o');
+        }
+
+        stream << "}\"];\n";
+        return;
+    }
+
+    stream << indent << "subgraph \"cluster_" << id << "\" {\n";
+    stream << indent << "    label=\"";
+    WriteEscapedCharacters(stream, accessor.shortName);
+    stream << "\\npriority " << accessor.priority << ", depth " << accessor.depth << "\";\n";
+    for (size_t i = 0; i < accessor.inputPorts.size(); ++i)
+    {
+        stream << indent << "    \"" << id << ".i" << i << "\" [shape=cds, label=";
+        WriteEscapedString(stream, accessor.inputPorts[i].shortName);
+        stream << "];\n";
+    }
+
+    for (size_t i = 0; i < accessor.outputPorts.size(); ++i)
+    {
+        stream << indent << "    \"" << id << ".o" << i << "\" [shape=cds, label=";
+        WriteEscapedString(stream, accessor.outputPorts[i].shortName);
+        stream << "];\n";
+    }
+
+    for (size_t child : children[index])
+    {
+        WriteDotAccessor(stream, accessors, children, child, indent + "    ");
+    }
+
+    stream << indent << "}\n";
+}
+
+void ModelGraph::WriteDot(std::ostream& stream) const
+{
+    std::vector<std::vector<size_t>> children(this->accessors.size());
+    std::map<std::string, std::string> portEndpoints{};
+    for (size_t i = 0; i < this->accessors.size(); ++i)
+    {
+        const AccessorNode& accessor = this->accessors[i];
+        if (accessor.parent >= 0)
+        {
+            children[static_cast<size_t>(accessor.parent)].push_back(i);
+        }
+
+        std::string id = "a" + std::to_string(i);
+        for (size_t j = 0; j < accessor.inputPorts.size(); ++j)
+        {
+            portEndpoints[accessor.inputPorts[j].name] = (accessor.isComposite ? "\"" + id + ".i" + std::to_string(j) + "\"" : "\"" + id + "\":i" + std::to_string(j));
+        }
+
+        for (size_t j = 0; j < accessor.outputPorts.size(); ++j)
+        {
+            portEndpoints[accessor.outputPorts[j].name] = (accessor.isComposite ? "\"" + id + ".o" + std::to_string(j) + "\"" : "\"" + id + "\":o" + std::to_string(j));
+        }
+    }
+
+    stream << "digraph ";
+    WriteEscapedString(stream, this->accessors.empty() ? std::string("Model") : this->accessors[0].shortName);
+    stream << " {\n    rankdir=LR;\n    node [shape=record];\n";
+    for (size_t i = 0; i < this->accessors.size(); ++i)
+    {
+        if (this->accessors[i].parent < 0)
+        {
+            WriteDotAccessor(stream, this->accessors, children, i, "    ");
+        }
+    }
+
+    for (const Connection& connection : this->connections)
+    {
+        stream << "    " << portEndpoints.at(connection.source) << " -> " << portEndpoints.at(connection.destination);
+        if (this->includesTraffic)
+        {
+            stream << " [label=\"" << connection.numberOfEvents << "\"]";
+        }
+
+        stream << ";\n";
+    }
+
+    stream << "}\n";
+}
+
+static void WriteJsonPorts(std::ostream& stream, const std::vector<ModelGraph::PortNode>& ports, bool includesTraffic)
+{
+    stream << '[';
+    for (size_t i = 0; i < ports.size(); ++i)
+    {
+        const ModelGraph::PortNode& port = ports[i];
+        stream << (i == 0 ? "" : ",") << "{\"name\":";
+        WriteEscapedString(stream, port.name);
+        stream << ",\"depth\":";
+        if (port.depth == ModelGraph::NoDepth)
+        {
+            stream << "null";
+        }
+        else
+        {
+            stream << port.depth;
+        }
+
+        if (includesTraffic)
+        {
+            stream << ",\"eventsSent\":" << port.numberOfEventsSent << ",\"eventsReceived\":" << port.numberOfEventsReceived;
+        }
+
+        stream << '}';
+    }
+
+    stream << ']';
+}
+
+void ModelGraph::WriteJson(std::ostream& stream) const
+{
+    stream << "{\"accessors\":[";
+    for (size_t i = 0; i < this->accessors.size(); ++i)
+    {
+        const AccessorNode& accessor = this->accessors[i];
+        stream << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        WriteEscapedString(stream, accessor.name);
+        stream << ",\"parent\":";
+        if (accessor.parent < 0)
+        {
+            stream << "null";
+        }
+        else
+        {
+            WriteEscapedString(stream, this->accessors[static_cast<size_t>(accessor.parent)].name);
+        }
+
+        stream << ",\"composite\":" << (accessor.isComposite ? "true" : "false");
+        stream << ",\"priority\":" << accessor.priority << ",\"depth\":" << accessor.depth << ",\"inputPorts\":";
+        WriteJsonPorts(stream, accessor.inputPorts, this->includesTraffic);
+        stream << ",\"outputPorts\":";
+        WriteJsonPorts(stream, accessor.outputPorts, this->includesTraffic);
+        stream << '}';
+    }
+
+    stream << "\n],\"connections\":[";
+    for (size_t i = 0; i < this->connections.size(); ++i)
+    {
+        const Connection& connection = this->connections[i];
+        stream << (i == 0 ? "\n" : ",\n") << "{\"source\":";
+        WriteEscapedString(stream, connection.source);
+        stream << ",\"destination\":";
+        WriteEscapedString(stream, connection.destination);
+        if (this->includesTraffic)
+        {
+            stream << ",\"events\":" << connection.numberOfEvents;
+        }
+
+        stream << '}';
+    }
+
+    stream << "\n]}\n";
+}
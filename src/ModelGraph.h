@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef MODEL_GRAPH_H
+#define MODEL_GRAPH_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Description
+// A ModelGraph is a snapshot of a host's model: every accessor (the host first, and every composite before its children)
+// with its priority, depth, and ports, and every connection between two ports. It can be written as Graphviz DOT, where
+// composites are drawn as clusters around their children and atomic accessors as records with a field for each port, or
+// as JSON. When it includes traffic, each port carries its profiling counters and each connection carries the number of
+// events its source port has sent, since a port sends every event to all of its destinations.
+//
+class ModelGraph
+{
+public:
+    static const int NoDepth = -1; // for composite ports, and for anything added since the depths were last computed
+
+    struct PortNode
+    {
+        std::string name; // full name
+        std::string shortName;
+        int depth;
+        unsigned long long numberOfEventsSent;
+        unsigned long long numberOfEventsReceived;
+    };
+
+    struct AccessorNode
+    {
+        std::string name; // full name
+        std::string shortName;
+        int parent; // index in accessors, or -1 for the host
+        bool isComposite;
+        int priority;
+        int depth;
+        std::vector<PortNode> inputPorts;
+        std::vector<PortNode> outputPorts;
+    };
+
+    struct Connection
+    {
+        std::string source; // full port name
+        std::string destination; // full port name
+        unsigned long long numberOfEvents;
+    };
+
+    void WriteDot(std::ostream& stream) const;
+    void WriteJson(std::ostream& stream) const;
+
+    std::vector<AccessorNode> accessors;
+    std::vector<Connection> connections;
+    bool includesTraffic = false;
+};
+
+#endif // MODEL_GRAPH_H
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "OffloadPool.h"
+#include <algorithm>
+
+template<class Duration>
+static std::chrono::microseconds ToMicroseconds(Duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+OffloadPool::Statistics::Statistics() :
+    m_metrics{}
+{
+}
+
+Host::OffloadMetrics OffloadPool::Statistics::GetMetrics() const
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    return this->m_metrics;
+}
+
+void OffloadPool::Statistics::RecordSubmitted()
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    ++this->m_metrics.numberOfOffloads;
+    ++this->m_metrics.queueDepth;
+    this->m_metrics.maxQueueDepth = std::max(this->m_metrics.maxQueueDepth, this->m_metrics.queueDepth);
+}
+
+void OffloadPool::Statistics::RecordStarted(std::chrono::steady_clock::duration queueLatency)
+{
+    auto latency = ToMicroseconds(queueLatency);
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    --this->m_metrics.queueDepth;
+    this->m_metrics.totalQueueLatency += latency;
+    this->m_metrics.maxQueueLatency = std::max(this->m_metrics.maxQueueLatency, latency);
+}
+
+void OffloadPool::Statistics::RecordFinished(std::chrono::steady_clock::duration offloadLatency)
+{
+    auto latency = ToMicroseconds(offloadLatency);
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    ++this->m_metrics.numberOfCompletedOffloads;
+    this->m_metrics.totalOffloadLatency += latency;
+    this->m_metrics.maxOffloadLatency = std::max(this->m_metrics.maxOffloadLatency, latency);
+}
+
+void OffloadPool::Statistics::RecordRejected()
+{
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    ++this->m_metrics.numberOfRejectedOffloads;
+}
+
+void OffloadPool::Statistics::RecordWait(std::chrono::steady_clock::duration waitTime)
+{
+    auto wait = ToMicroseconds(waitTime);
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    ++this->m_metrics.numberOfLateResults;
+    this->m_metrics.totalWaitTime += wait;
+}
+
+OffloadPool::OffloadPool(size_t numberOfThreads, size_t queueCapacity) :
+    m_threadPool(numberOfThreads),
+    m_queueCapacity(queueCapacity),
+    m_queueDepth(0)
+{
+}
+
+size_t OffloadPool::GetQueueCapacity() const
+{
+    return this->m_queueCapacity.load();
+}
+
+void OffloadPool::SetQueueCapacity(size_t queueCapacity)
+{
+    this->m_queueCapacity.store(queueCapacity);
+}
+
+// The work is not tied to the accessor or host that offloaded it, so it can safely finish after either is destroyed. It
+// is counted as finished before its result is made available, so the statistics never lag behind the results. A slot
+// in the queue is claimed before the work is queued and given back as soon as a worker starts it.
+std::future<std::shared_ptr<IEvent>> OffloadPool::Submit(Work work, std::shared_ptr<Statistics> statistics)
+{
+    if (this->m_queueDepth.fetch_add(1) >= this->m_queueCapacity.load())
+    {
+        this->m_queueDepth.fetch_sub(1);
+        statistics->RecordRejected();
+        return std::future<std::shared_ptr<IEvent>>();
+    }
+
+    auto submitTime = std::chrono::steady_clock::now();
+    auto task = std::make_shared<std::packaged_task<std::shared_ptr<IEvent>()>>(
+        [this, work = std::move(work), statistics, submitTime]()
+        {
+            this->m_queueDepth.fetch_sub(1);
+            statistics->RecordStarted(std::chrono::steady_clock::now() - submitTime);
+            try
+            {
+                std::shared_ptr<IEvent> result = work();
+                statistics->RecordFinished(std::chrono::steady_clock::now() - submitTime);
+                return result;
+            }
+            catch (...)
+            {
+                statistics->RecordFinished(std::chrono::steady_clock::now() - submitTime);
+                throw;
+            }
+        });
+
+    auto result = task->get_future();
+    statistics->RecordSubmitted();
+    this->m_threadPool.Execute([task]() { (*task)(); });
+
+    return result;
+}
+
+OffloadPool& OffloadPool::GetDefault()
+{
+    static OffloadPool defaultPool;
+    return defaultPool;
+}
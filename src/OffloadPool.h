@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef OFFLOAD_POOL_H
+#define OFFLOAD_POOL_H
+
+#include "AccessorFramework/Host.h"
+#include "WorkStealingThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+
+// Description
+// The OffloadPool runs work that atomic accessors offload from their host's executor (see AtomicAccessor::Offload()) on
+// a fixed number of worker threads shared by every host in the process. It is kept apart from the pools that execute
+// hosts, so offloaded work never queues behind a round. Every offload is counted in the statistics of the host it came
+// from. The number of offloads waiting for a worker is bounded: work submitted while the queue is full is rejected and
+// counted instead of being run, so a host that offloads faster than the workers can keep up cannot grow the queue
+// without limit. The bound can be changed at any time (see Host::SetOffloadQueueCapacity()); offloads already queued
+// beyond a lowered bound still run.
+//
+class OffloadPool
+{
+public:
+    class Statistics
+    {
+    public:
+        Statistics();
+        Host::OffloadMetrics GetMetrics() const;
+        void RecordSubmitted();
+        void RecordStarted(std::chrono::steady_clock::duration queueLatency);
+        void RecordFinished(std::chrono::steady_clock::duration offloadLatency);
+        void RecordRejected();
+        void RecordWait(std::chrono::steady_clock::duration waitTime);
+
+    private:
+        mutable std::mutex m_mutex;
+        Host::OffloadMetrics m_metrics;
+    };
+
+    using Work = std::function<std::shared_ptr<IEvent>()>;
+
+    static const size_t DefaultQueueCapacity = 1024;
+
+    explicit OffloadPool(size_t numberOfThreads = 0, size_t queueCapacity = DefaultQueueCapacity); // 0 threads uses one thread per hardware thread
+    size_t GetQueueCapacity() const;
+    void SetQueueCapacity(size_t queueCapacity);
+    std::future<std::shared_ptr<IEvent>> Submit(Work work, std::shared_ptr<Statistics> statistics); // invalid if the queue is full
+
+    static OffloadPool& GetDefault();
+
+private:
+    WorkStealingThreadPool m_threadPool;
+    std::atomic<size_t> m_queueCapacity;
+    std::atomic<size_t> m_queueDepth;
+};
+
+#endif // OFFLOAD_POOL_H
@@ -3,11 +3,23 @@
 
 #include "Port.h"
 #include "AccessorImpl.h"
-#include "PrintDebug.h"
+#include "AllocationAccounting.h"
+#include "EventRecorder.h"
+#include "ExecutionFingerprint.h"
+#include "HostChannel.h"
+#include "LatencyProbe.h"
+#include "Logger.h"
+#include "TraceRecorder.h"
+#include <algorithm>
 
 Port::Port(const std::string& name, Accessor::Impl* owner) :
     BaseObject(name, owner),
-    m_source(nullptr)
+    m_source(nullptr),
+    m_modelIndex(-1),
+    m_fingerprint(nullptr),
+    m_fingerprintKey(0ULL),
+    m_fingerprintTick(0ULL),
+    m_fingerprintSequenceNumber(0ULL)
 {
 }
 
@@ -41,17 +53,84 @@ std::vector<const Port*> Port::GetDestinations() const
     return std::vector<const Port*>(this->m_destinations.begin(), this->m_destinations.end());
 }
 
+int Port::GetModelIndex() const
+{
+    return this->m_modelIndex;
+}
+
+void Port::SetModelIndex(int modelIndex) const
+{
+    this->m_modelIndex = modelIndex;
+}
+
+const Port::Counters& Port::GetCounters() const
+{
+    return this->m_counters;
+}
+
+void Port::ResetCounters()
+{
+    this->m_counters.numberOfEventsSent.Reset();
+    this->m_counters.numberOfEventsReceived.Reset();
+    this->m_counters.maxInputQueueLength.Reset();
+}
+
+void Port::AddLatencyProbe(std::shared_ptr<LatencyProbe> latencyProbe)
+{
+    this->m_latencyProbes.push_back(latencyProbe);
+}
+
+void Port::RemoveLatencyProbe(const LatencyProbe* latencyProbe)
+{
+    this->m_latencyProbes.erase(
+        std::remove_if(
+            this->m_latencyProbes.begin(),
+            this->m_latencyProbes.end(),
+            [latencyProbe](const std::shared_ptr<LatencyProbe>& probe) { return probe.get() == latencyProbe; }),
+        this->m_latencyProbes.end());
+}
+
+const std::vector<std::shared_ptr<LatencyProbe>>& Port::GetLatencyProbes() const
+{
+    return this->m_latencyProbes;
+}
+
+void Port::SetFingerprint(ExecutionFingerprint* fingerprint)
+{
+    this->m_fingerprint = fingerprint;
+    this->m_fingerprintKey = (fingerprint != nullptr ? ExecutionFingerprint::GetPortKey(this->GetFullName()) : 0ULL);
+    this->m_fingerprintTick = 0ULL;
+    this->m_fingerprintSequenceNumber = 0ULL;
+}
+
 void Port::SendData(std::shared_ptr<IEvent> data)
 {
-#ifdef PRINT_VERBOSE
+    AllocationScope allocationScope(AllocationSubsystem::Ports);
+    if (ProfilingCounter::ProfilingIsEnabled())
+    {
+        this->m_counters.numberOfEventsSent.Increment();
+    }
+
+    if (this->m_fingerprint != nullptr)
+    {
+        this->AddToFingerprint(data.get());
+    }
+
+#if ACCESSOR_FRAMEWORK_LOG_LEVEL <= ACCESSOR_FRAMEWORK_LOG_LEVEL_VERBOSE
     if (!(this->m_destinations.empty()))
     {
-        PRINT_VERBOSE("Port %s is sending event data at address %p", this->GetFullName().c_str(), data.get());
+        LOG_VERBOSE("Port %s is sending event data at address %p", this->GetFullName().c_str(), data.get());
     }
 #endif
 
+    const bool isTracing = TraceRecorder::IsRecording();
     for (auto destination : this->m_destinations)
     {
+        if (isTracing)
+        {
+            TraceRecorder::RecordInstant("event", this->GetTraceName(), destination->GetTraceName());
+        }
+
         destination->ReceiveData(data);
     }
 }
@@ -59,7 +138,7 @@ void Port::SendData(std::shared_ptr<IEvent> data)
 void Port::Connect(Port* source, Port* destination)
 {
     ValidateConnection(source, destination);
-    PRINT_VERBOSE("Source port '%s' is connecting to destination port '%s'", source->GetFullName().c_str(), destination->GetFullName().c_str());
+    LOG_VERBOSE("Source port '%s' is connecting to destination port '%s'", source->GetFullName().c_str(), destination->GetFullName().c_str());
     destination->m_source = source;
     source->m_destinations.push_back(destination);
 }
@@ -95,6 +174,19 @@ void Port::DisconnectAll(Port* port)
     }
 }
 
+void Port::AddToFingerprint(const IEvent* data)
+{
+    unsigned long long tick = this->m_fingerprint->GetTickNumber();
+    if (tick != this->m_fingerprintTick)
+    {
+        this->m_fingerprintTick = tick;
+        this->m_fingerprintSequenceNumber = 0ULL;
+    }
+
+    this->m_fingerprint->AddEvent(this->m_fingerprintKey, this->GetOwner()->GetPriority(), this->m_fingerprintSequenceNumber, data);
+    ++(this->m_fingerprintSequenceNumber);
+}
+
 void Port::ValidateConnection(Port* source, Port* destination)
 {
     if (destination->IsConnectedToSource() && destination->GetSource() != source)
@@ -159,14 +251,20 @@ void InputPort::DequeueLatestInput()
 
 void InputPort::ReceiveData(std::shared_ptr<IEvent> input)
 {
+    AllocationScope allocationScope(AllocationSubsystem::Ports);
     auto myParent = static_cast<Accessor::Impl*>(this->GetParent());
     if (!(myParent->IsInitialized()))
     {
-        PRINT_VERBOSE("Input port %s is dropping event data at address %p because its parent has not been initialized", this->GetFullName().c_str(), input.get());
+        LOG_VERBOSE("Input port %s is dropping event data at address %p because its parent has not been initialized", this->GetFullName().c_str(), input.get());
         return;
     }
 
-    PRINT_VERBOSE("Input port %s is receiving event data at address %p", this->GetFullName().c_str(), input.get());
+    LOG_VERBOSE("Input port %s is receiving event data at address %p", this->GetFullName().c_str(), input.get());
+    if (ProfilingCounter::ProfilingIsEnabled())
+    {
+        this->m_counters.numberOfEventsReceived.Increment();
+    }
+
     if (myParent->IsComposite())
     {
         this->SendData(input);
@@ -183,15 +281,35 @@ void InputPort::ReceiveData(std::shared_ptr<IEvent> input)
     }
 }
 
+std::vector<std::shared_ptr<IEvent>> InputPort::GetQueuedInputs() const
+{
+    std::vector<std::shared_ptr<IEvent>> inputs{};
+    auto inputQueue = this->m_inputQueue;
+    while (!(inputQueue.empty()))
+    {
+        inputs.push_back(inputQueue.front());
+        inputQueue.pop();
+    }
+
+    return inputs;
+}
+
 void InputPort::QueueInput(std::shared_ptr<IEvent> input)
 {
     this->m_inputQueue.push(input);
+    if (ProfilingCounter::ProfilingIsEnabled())
+    {
+        this->m_counters.maxInputQueueLength.RaiseTo(this->m_inputQueue.size());
+    }
+
     this->m_waitingForInputHandler = (this->m_inputQueue.front() != nullptr);
 }
 
 OutputPort::OutputPort(const std::string& name, Accessor::Impl* owner, bool spontaneous) :
     Port(name, owner),
-    m_spontaneous(spontaneous)
+    m_spontaneous(spontaneous),
+    m_recorder(nullptr),
+    m_recordingStreamId(0)
 {
 }
 
@@ -202,13 +320,94 @@ bool OutputPort::IsSpontaneous() const
 
 void OutputPort::ReceiveData(std::shared_ptr<IEvent> input)
 {
+    AllocationScope allocationScope(AllocationSubsystem::Ports);
     auto myParent = static_cast<Accessor::Impl*>(this->GetParent());
     if (!(myParent->IsInitialized()))
     {
-        PRINT_VERBOSE("Output port %s is dropping event data at address %p because its parent has not been initialized", this->GetFullName().c_str(), input.get());
+        LOG_VERBOSE("Output port %s is dropping event data at address %p because its parent has not been initialized", this->GetFullName().c_str(), input.get());
         return;
     }
 
-    PRINT_VERBOSE("Output port %s is receiving event data at address %p", this->GetFullName().c_str(), input.get());
+    LOG_VERBOSE("Output port %s is receiving event data at address %p", this->GetFullName().c_str(), input.get());
+    if (ProfilingCounter::ProfilingIsEnabled())
+    {
+        this->m_counters.numberOfEventsReceived.Increment();
+    }
+
     this->SendData(input);
+}
+
+void OutputPort::QueuePendingOutput(int callbackId, std::shared_ptr<IEvent> output)
+{
+    AllocationScope allocationScope(AllocationSubsystem::Ports);
+    this->m_pendingOutputs.push_back({ callbackId, std::move(output) });
+}
+
+// Each callback sends the oldest output, so outputs leave the port in the order in which its owner sent them
+void OutputPort::SendPendingOutput()
+{
+    std::shared_ptr<IEvent> output = std::move(this->m_pendingOutputs.front().output);
+    this->m_pendingOutputs.pop_front();
+    if (this->m_recorder != nullptr)
+    {
+        this->m_recorder->Record(this->m_recordingStreamId, this->GetOwner()->GetDirector()->GetCurrentLogicalTime(), output.get());
+    }
+
+    if (!(this->m_channels.empty()))
+    {
+        long long logicalTime = this->GetOwner()->GetDirector()->GetCurrentLogicalTime();
+        for (auto& channel : this->m_channels)
+        {
+            channel->Send(output, logicalTime);
+        }
+    }
+
+    this->SendData(std::move(output));
+}
+
+bool OutputPort::HasPendingOutput() const
+{
+    return !(this->m_pendingOutputs.empty());
+}
+
+int OutputPort::GetPendingOutputCallbackId() const
+{
+    return this->m_pendingOutputs.front().callbackId;
+}
+
+void OutputPort::DropPendingOutput()
+{
+    this->m_pendingOutputs.pop_front();
+}
+
+std::vector<std::shared_ptr<IEvent>> OutputPort::GetPendingOutputs() const
+{
+    std::vector<std::shared_ptr<IEvent>> outputs{};
+    for (const PendingOutput& pendingOutput : this->m_pendingOutputs)
+    {
+        outputs.push_back(pendingOutput.output);
+    }
+
+    return outputs;
+}
+
+void OutputPort::AddChannel(std::shared_ptr<HostChannel> channel)
+{
+    this->m_channels.push_back(channel);
+}
+
+void OutputPort::RemoveChannel(const HostChannel* channel)
+{
+    this->m_channels.erase(
+        std::remove_if(
+            this->m_channels.begin(),
+            this->m_channels.end(),
+            [channel](const std::shared_ptr<HostChannel>& portChannel) { return portChannel.get() == channel; }),
+        this->m_channels.end());
+}
+
+void OutputPort::SetRecorder(EventRecorder* recorder, uint32_t streamId)
+{
+    this->m_recorder = recorder;
+    this->m_recordingStreamId = streamId;
 }
\ No newline at end of file
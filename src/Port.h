@@ -4,12 +4,22 @@
 #ifndef PORT_H
 #define PORT_H
 
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
 #include <AccessorFramework/Accessor.h>
 #include <AccessorFramework/Event.h>
 #include "BaseObject.h"
+#include "ProfilingCounter.h"
+#include "RecyclingAllocator.h"
+
+class EventRecorder;
+class ExecutionFingerprint;
+class HostChannel;
+class LatencyProbe;
 
 // Description
 // A port sends and receives events. A port that sends an event is called a source, and a port that receives an event is
@@ -23,6 +33,15 @@
 // ports are given a name upon instantiation. The name of a port must be unique among that accessor's ports; no two ports
 // on an accessor can have the same name.
 //
+// Every port counts the events it sends and receives. An input port also records the longest its input queue has been.
+// Input queues and the outputs waiting to be sent recycle their memory, so ports allocate nothing once warmed up.
+// The host attaches latency probes to ports; the accessors that own them stamp and measure the probes (see
+// LatencyProbe). An output port can also have channels to other hosts, each of which is sent every output the port
+// sends, stamped with the logical time of its host (see HostChannel). While its host is recording, a spontaneous output
+// port records every output it sends (see EventRecorder). While its host is fingerprinting, a port of an atomic accessor
+// adds every event it sends to the fingerprint, numbered in the order in which it sent them in the tick (see
+// ExecutionFingerprint).
+//
 class Port : public BaseObject
 {
 public:
@@ -33,6 +52,8 @@ public:
     bool IsConnectedToSource() const;
     const Port* GetSource() const;
     std::vector<const Port*> GetDestinations() const;
+    int GetModelIndex() const;
+    void SetModelIndex(int modelIndex) const; // should only be called by the host when it computes accessor priorities
 
     void SendData(std::shared_ptr<IEvent> data);
     virtual void ReceiveData(std::shared_ptr<IEvent> data) = 0;
@@ -41,11 +62,37 @@ public:
     static void Disconnect(Port* source, Port* destination);
     static void DisconnectAll(Port* port);
 
+    struct Counters
+    {
+        ProfilingCounter numberOfEventsSent;
+        ProfilingCounter numberOfEventsReceived;
+        ProfilingCounter maxInputQueueLength;
+    };
+
+    const Counters& GetCounters() const;
+    void ResetCounters();
+
+    // should only be called by the host while it is not running
+    void AddLatencyProbe(std::shared_ptr<LatencyProbe> latencyProbe);
+    void RemoveLatencyProbe(const LatencyProbe* latencyProbe);
+    const std::vector<std::shared_ptr<LatencyProbe>>& GetLatencyProbes() const;
+    void SetFingerprint(ExecutionFingerprint* fingerprint); // null stops fingerprinting
+
+protected:
+    Counters m_counters;
+
 private:
     static void ValidateConnection(Port* source, Port* destination);
+    void AddToFingerprint(const IEvent* data);
 
     Port* m_source;
     std::vector<Port*> m_destinations;
+    mutable int m_modelIndex;
+    std::vector<std::shared_ptr<LatencyProbe>> m_latencyProbes;
+    ExecutionFingerprint* m_fingerprint;
+    uint64_t m_fingerprintKey;
+    unsigned long long m_fingerprintTick; // in which the port last sent an event
+    unsigned long long m_fingerprintSequenceNumber; // of the next event sent in that tick
 };
 
 class InputPort final : public Port
@@ -57,13 +104,14 @@ public:
     int GetInputQueueLength() const;
     bool IsWaitingForInputHandler() const;
     void DequeueLatestInput(); // should only be called by port's owner in AtomicAccessor::Impl::ProcessInputs()
+    std::vector<std::shared_ptr<IEvent>> GetQueuedInputs() const; // oldest first
     void ReceiveData(std::shared_ptr<IEvent> input) override;
 
 private:
     void QueueInput(std::shared_ptr<IEvent> input);
 
     bool m_waitingForInputHandler;
-    std::queue<std::shared_ptr<IEvent>> m_inputQueue;
+    std::queue<std::shared_ptr<IEvent>, std::deque<std::shared_ptr<IEvent>, RecyclingAllocator<std::shared_ptr<IEvent>>>> m_inputQueue;
 };
 
 class OutputPort final : public Port
@@ -73,8 +121,31 @@ public:
     bool IsSpontaneous() const override;
     void ReceiveData(std::shared_ptr<IEvent> input) override;
 
+    // Outputs sent by the port's owner wait here until the director callback scheduled for each of them sends it
+    void QueuePendingOutput(int callbackId, std::shared_ptr<IEvent> output);
+    void SendPendingOutput();
+    bool HasPendingOutput() const;
+    int GetPendingOutputCallbackId() const;
+    void DropPendingOutput();
+    std::vector<std::shared_ptr<IEvent>> GetPendingOutputs() const; // oldest first
+
+    // should only be called by the host while it is not running
+    void AddChannel(std::shared_ptr<HostChannel> channel);
+    void RemoveChannel(const HostChannel* channel);
+    void SetRecorder(EventRecorder* recorder, uint32_t streamId); // null stops recording
+
 private:
+    struct PendingOutput
+    {
+        int callbackId;
+        std::shared_ptr<IEvent> output;
+    };
+
     const bool m_spontaneous;
+    std::deque<PendingOutput, RecyclingAllocator<PendingOutput>> m_pendingOutputs;
+    std::vector<std::shared_ptr<HostChannel>> m_channels;
+    EventRecorder* m_recorder;
+    uint32_t m_recordingStreamId;
 };
 
 #endif // PORT_H
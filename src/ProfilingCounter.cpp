@@ -0,0 +1,6 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ProfilingCounter.h"
+
+std::atomic<bool> ProfilingCounter::s_profilingIsEnabled(true);
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef PROFILING_COUNTER_H
+#define PROFILING_COUNTER_H
+
+#include <atomic>
+
+// Description
+// A ProfilingCounter holds a statistic that can be updated, read and reset by any thread at any time. Updates are
+// relaxed atomic read-modify-writes, so concurrent updates are never lost and a reset racing with an update leaves the
+// counter either before or after it, never with a stale total written back. Readers always see a recent value.
+// Profiling can be turned off for the whole process, in which case nothing is updated; the switch is checked once per
+// reaction or event.
+//
+class ProfilingCounter
+{
+public:
+    ProfilingCounter() :
+        m_value(0ULL)
+    {
+    }
+
+    unsigned long long Get() const
+    {
+        return this->m_value.load(std::memory_order_relaxed);
+    }
+
+    void Add(unsigned long long amount)
+    {
+        this->m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void Increment()
+    {
+        this->Add(1ULL);
+    }
+
+    void RaiseTo(unsigned long long value)
+    {
+        unsigned long long current = this->m_value.load(std::memory_order_relaxed);
+        while (value > current && !(this->m_value.compare_exchange_weak(current, value, std::memory_order_relaxed)))
+        {
+        }
+    }
+
+    void Reset()
+    {
+        this->m_value.store(0ULL, std::memory_order_relaxed);
+    }
+
+    static bool ProfilingIsEnabled()
+    {
+        return s_profilingIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    static void SetProfilingEnabled(bool enabled)
+    {
+        s_profilingIsEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<unsigned long long> m_value;
+
+    static std::atomic<bool> s_profilingIsEnabled;
+};
+
+#endif // PROFILING_COUNTER_H
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef RECORDING_FORMAT_H
+#define RECORDING_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Description
+// A recording is a file header followed by entries, each of which is an entry header and a payload padded to a multiple
+// of 8 bytes, so that every entry, and every serialized event in one, is 8-byte aligned in a mapping of the file. A
+// stream entry introduces a stream (an output port or a channel's input port) before its first event; its payload is the
+// port's full name. An event entry's payload is an event serialized by an EventSerializer. A fingerprint entry, written
+// at the end of each tick while the host is also fingerprinting, holds the tick's fingerprint. Readers skip entries of
+// kinds they do not know. Numbers are in the native byte order.
+//
+struct RecordingFormat
+{
+    struct FileHeader
+    {
+        uint64_t magic;
+        uint32_t formatVersion;
+        uint32_t reserved;
+        int64_t startLogicalTime; // in milliseconds since the epoch
+    };
+
+    struct EntryHeader
+    {
+        uint32_t kind;
+        uint32_t streamId;
+        int64_t logicalTime; // in milliseconds since the epoch
+        uint64_t size; // of the payload, without its padding
+    };
+
+    struct FingerprintPayload
+    {
+        int64_t relativeLogicalTime; // in milliseconds since the director last started counting time
+        uint64_t numberOfEvents;
+        uint64_t hash;
+    };
+
+    static const uint64_t Magic = 0x31474f4c43455246ULL; // "FRECLOG1"
+    static const uint32_t FormatVersion = 1;
+    static const uint32_t StreamEntry = 1;
+    static const uint32_t EventEntry = 2;
+    static const uint32_t FingerprintEntry = 3;
+    static const size_t EntryAlignment = 8;
+
+    static uint64_t GetPaddingSize(uint64_t payloadSize)
+    {
+        return (EntryAlignment - payloadSize % EntryAlignment) % EntryAlignment;
+    }
+};
+
+static_assert(sizeof(RecordingFormat::FileHeader) == 24 && sizeof(RecordingFormat::EntryHeader) == 24, "Recording headers keep entries 8-byte aligned");
+
+#endif // RECORDING_FORMAT_H
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "RecordingReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+RecordingReader::RecordingReader(const std::string& filePath) :
+    m_data(nullptr),
+    m_size(0),
+    m_position(sizeof(RecordingFormat::FileHeader)),
+    m_startLogicalTime(0)
+{
+#ifdef __linux__
+    int fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat fileStatus{};
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        int error = errno;
+        if (fileDescriptor >= 0)
+        {
+            close(fileDescriptor);
+        }
+
+        throw std::system_error(error, std::generic_category(), "Could not open recording file '" + filePath + "'");
+    }
+
+    this->m_size = static_cast<size_t>(fileStatus.st_size);
+    if (this->m_size != 0)
+    {
+        void* mapping = mmap(nullptr, this->m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED)
+        {
+            int error = errno;
+            close(fileDescriptor);
+            throw std::system_error(error, std::generic_category(), "Could not map recording file '" + filePath + "'");
+        }
+
+        madvise(mapping, this->m_size, MADV_SEQUENTIAL);
+        this->m_data = static_cast<const unsigned char*>(mapping);
+    }
+
+    close(fileDescriptor);
+#else
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open recording file '" + filePath + "'");
+    }
+
+    this->m_contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    this->m_data = this->m_contents.data();
+    this->m_size = this->m_contents.size();
+#endif
+
+    RecordingFormat::FileHeader header{};
+    if (this->m_size >= sizeof(header))
+    {
+        std::memcpy(&header, this->m_data, sizeof(header));
+    }
+
+    if (this->m_size < sizeof(header) || header.magic != RecordingFormat::Magic || header.formatVersion != RecordingFormat::FormatVersion)
+    {
+        this->Unmap();
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "'" << filePath << "' is not a recording";
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+
+    this->m_startLogicalTime = header.startLogicalTime;
+}
+
+RecordingReader::~RecordingReader()
+{
+    this->Unmap();
+}
+
+long long RecordingReader::GetStartLogicalTime() const
+{
+    return this->m_startLogicalTime;
+}
+
+bool RecordingReader::ReadNext(Entry& entry)
+{
+    if (!(this->PeekNext(entry)))
+    {
+        return false;
+    }
+
+    this->m_position += sizeof(RecordingFormat::EntryHeader) + entry.size + static_cast<size_t>(RecordingFormat::GetPaddingSize(entry.size));
+    return true;
+}
+
+bool RecordingReader::PeekNext(Entry& entry) const
+{
+    RecordingFormat::EntryHeader header{};
+    size_t remainingSize = this->m_size - this->m_position;
+    if (remainingSize < sizeof(header))
+    {
+        return false;
+    }
+
+    std::memcpy(&header, this->m_data + this->m_position, sizeof(header));
+    remainingSize -= sizeof(header);
+    if (header.size > remainingSize || header.size + RecordingFormat::GetPaddingSize(header.size) > remainingSize)
+    {
+        return false;
+    }
+
+    entry = Entry{ header.kind, header.streamId, header.logicalTime, this->m_data + this->m_position + sizeof(header), static_cast<size_t>(header.size) };
+    return true;
+}
+
+void RecordingReader::Unmap()
+{
+#ifdef __linux__
+    if (this->m_data != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(this->m_data), this->m_size);
+        this->m_data = nullptr;
+    }
+#endif
+}
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef RECORDING_READER_H
+#define RECORDING_READER_H
+
+#include "RecordingFormat.h"
+#include <string>
+#include <vector>
+
+// Description
+// A RecordingReader reads the entries of a recording (see RecordingFormat.h) one at a time. On Linux, it maps the file
+// into memory and reads the entries in place, advising the kernel that it reads them in order, so that reading a large
+// recording is bounded by the disk rather than by copying; elsewhere, it reads the whole file into memory. The reader
+// checks every entry header against the size of the file, and stops at the first entry that does not fit, which is
+// where a recording that was cut short ends.
+//
+class RecordingReader
+{
+public:
+    struct Entry
+    {
+        uint32_t kind;
+        uint32_t streamId;
+        long long logicalTime;
+        const unsigned char* payload;
+        size_t size;
+    };
+
+    explicit RecordingReader(const std::string& filePath);
+    ~RecordingReader();
+    long long GetStartLogicalTime() const;
+    bool ReadNext(Entry& entry); // returns false at the end of the recording
+    bool PeekNext(Entry& entry) const;
+
+private:
+    void Unmap();
+
+    const unsigned char* m_data;
+    size_t m_size;
+    size_t m_position;
+    long long m_startLogicalTime;
+    std::vector<unsigned char> m_contents; // if the file is not mapped
+};
+
+#endif // RECORDING_READER_H
@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef RECYCLING_ALLOCATOR_H
+#define RECYCLING_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Description
+// A RecyclingAllocator keeps the blocks its containers deallocate and hands them out again rather than returning them to
+// the heap, so a container that stays within the size it has already reached stops allocating. That makes it suited to
+// node-based containers (std::map, std::set) and to std::deque, whose elements come and go on every round but whose size
+// does not grow. A copy of an allocator, including one rebound to another type, shares its pool, which keeps a free list
+// for each of the first few block sizes it sees; blocks of any other size come from the heap as usual. Freed blocks are
+// only returned to the heap when the last allocator sharing the pool is destroyed. A container copied from another gets
+// a pool of its own, so a pool is never shared by more than one container and needs no more thread safety than it.
+//
+class RecyclingBlockPool
+{
+public:
+    ~RecyclingBlockPool()
+    {
+        for (size_t i = 0; i < this->m_numberOfBlockSizes; ++i)
+        {
+            while (this->m_freeLists[i].head != nullptr)
+            {
+                FreeBlock* block = this->m_freeLists[i].head;
+                this->m_freeLists[i].head = block->next;
+                ::operator delete(block);
+            }
+        }
+    }
+
+    void* Allocate(size_t blockSize)
+    {
+        FreeList* freeList = this->GetFreeList(blockSize);
+        if (freeList != nullptr && freeList->head != nullptr)
+        {
+            FreeBlock* block = freeList->head;
+            freeList->head = block->next;
+            return block;
+        }
+
+        return ::operator new(blockSize);
+    }
+
+    void Deallocate(void* block, size_t blockSize) noexcept
+    {
+        FreeList* freeList = this->GetFreeList(blockSize);
+        if (freeList == nullptr)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+        freeBlock->next = freeList->head;
+        freeList->head = freeBlock;
+    }
+
+private:
+    static const size_t MaxNumberOfBlockSizes = 4;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        size_t blockSize;
+        FreeBlock* head;
+    };
+
+    // Blocks too small to hold a free list link are not recycled
+    FreeList* GetFreeList(size_t blockSize) noexcept
+    {
+        if (blockSize < sizeof(FreeBlock))
+        {
+            return nullptr;
+        }
+
+        for (size_t i = 0; i < this->m_numberOfBlockSizes; ++i)
+        {
+            if (this->m_freeLists[i].blockSize == blockSize)
+            {
+                return &(this->m_freeLists[i]);
+            }
+        }
+
+        if (this->m_numberOfBlockSizes == MaxNumberOfBlockSizes)
+        {
+            return nullptr;
+        }
+
+        FreeList& freeList = this->m_freeLists[this->m_numberOfBlockSizes++];
+        freeList.blockSize = blockSize;
+        freeList.head = nullptr;
+        return &freeList;
+    }
+
+    FreeList m_freeLists[MaxNumberOfBlockSizes] = {};
+    size_t m_numberOfBlockSizes = 0;
+};
+
+template<class T>
+class RecyclingAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = RecyclingAllocator<U>;
+    };
+
+    RecyclingAllocator() :
+        m_pool(std::make_shared<RecyclingBlockPool>())
+    {
+    }
+
+    // Moving copies, so that a moved-from container can still allocate
+    RecyclingAllocator(const RecyclingAllocator& other) noexcept = default;
+
+    template<class U>
+    RecyclingAllocator(const RecyclingAllocator<U>& other) noexcept :
+        m_pool(other.m_pool)
+    {
+    }
+
+    RecyclingAllocator select_on_container_copy_construction() const
+    {
+        return RecyclingAllocator();
+    }
+
+    T* allocate(size_t numberOfElements)
+    {
+        return static_cast<T*>(this->m_pool->Allocate(numberOfElements * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t numberOfElements) noexcept
+    {
+        this->m_pool->Deallocate(block, numberOfElements * sizeof(T));
+    }
+
+    template<class U>
+    bool operator==(const RecyclingAllocator<U>& other) const noexcept
+    {
+        return (this->m_pool == other.m_pool);
+    }
+
+    template<class U>
+    bool operator!=(const RecyclingAllocator<U>& other) const noexcept
+    {
+        return (this->m_pool != other.m_pool);
+    }
+
+private:
+    template<class U>
+    friend class RecyclingAllocator;
+
+    std::shared_ptr<RecyclingBlockPool> m_pool;
+};
+
+#endif // RECYCLING_ALLOCATOR_H
@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "AccessorFramework/ReplaySource.h"
+#include "RecordingReader.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+static std::vector<std::string> GetOutputPortNames(const std::map<std::string, std::string>& outputPortNamesByStream)
+{
+    std::vector<std::string> outputPortNames{};
+    for (const auto& entry : outputPortNamesByStream)
+    {
+        if (std::find(outputPortNames.begin(), outputPortNames.end(), entry.second) == outputPortNames.end())
+        {
+            outputPortNames.push_back(entry.second);
+        }
+    }
+
+    return outputPortNames;
+}
+
+ReplaySource::ReplaySource(
+    const std::string& name,
+    const std::string& filePath,
+    std::shared_ptr<const EventSerializer> serializer,
+    const std::map<std::string, std::string>& outputPortNamesByStream) :
+    AtomicAccessor(name, {}, {}, GetOutputPortNames(outputPortNamesByStream)),
+    m_reader(std::make_unique<RecordingReader>(filePath)),
+    m_serializer(std::move(serializer)),
+    m_outputPortNamesByStream(outputPortNamesByStream),
+    m_isFinished(false),
+    m_numberOfEventsReplayed(0ULL),
+    m_numberOfEventsSkipped(0ULL)
+{
+    if (this->m_serializer == nullptr)
+    {
+        throw std::invalid_argument("A replay source needs a serializer");
+    }
+}
+
+ReplaySource::~ReplaySource() = default;
+
+bool ReplaySource::IsFinished() const
+{
+    return this->m_isFinished.load();
+}
+
+unsigned long long ReplaySource::GetNumberOfEventsReplayed() const
+{
+    return this->m_numberOfEventsReplayed.load();
+}
+
+unsigned long long ReplaySource::GetNumberOfEventsSkipped() const
+{
+    return this->m_numberOfEventsSkipped.load();
+}
+
+std::vector<std::string> ReplaySource::GetStreamNames(const std::string& filePath)
+{
+    RecordingReader reader(filePath);
+    std::vector<std::string> streamNames{};
+    RecordingReader::Entry entry{};
+    while (reader.ReadNext(entry))
+    {
+        if (entry.kind == RecordingFormat::StreamEntry)
+        {
+            streamNames.emplace_back(reinterpret_cast<const char*>(entry.payload), entry.size);
+        }
+    }
+
+    return streamNames;
+}
+
+std::vector<Host::FingerprintTick> ReplaySource::GetFingerprint(const std::string& filePath)
+{
+    RecordingReader reader(filePath);
+    std::vector<Host::FingerprintTick> ticks{};
+    RecordingReader::Entry entry{};
+    while (reader.ReadNext(entry))
+    {
+        if (entry.kind == RecordingFormat::FingerprintEntry && entry.size == sizeof(RecordingFormat::FingerprintPayload))
+        {
+            RecordingFormat::FingerprintPayload payload{};
+            std::memcpy(&payload, entry.payload, sizeof(payload));
+            ticks.push_back({ payload.relativeLogicalTime, payload.numberOfEvents, payload.hash });
+        }
+    }
+
+    return ticks;
+}
+
+void ReplaySource::Initialize()
+{
+    // The first event is replayed as long after this accessor is initialized as it was recorded after recording started
+    this->ScheduleNextReplay(this->m_reader->GetStartLogicalTime());
+}
+
+bool ReplaySource::FindNextEvent(long long& logicalTime)
+{
+    RecordingReader::Entry entry{};
+    while (this->m_reader->PeekNext(entry))
+    {
+        if (entry.kind == RecordingFormat::EventEntry)
+        {
+            logicalTime = entry.logicalTime;
+            return true;
+        }
+
+        this->m_reader->ReadNext(entry);
+        if (entry.kind == RecordingFormat::StreamEntry && entry.streamId == this->m_outputPortNames.size())
+        {
+            auto outputPortName = this->m_outputPortNamesByStream.find(std::string(reinterpret_cast<const char*>(entry.payload), entry.size));
+            this->m_outputPortNames.push_back(outputPortName != this->m_outputPortNamesByStream.end() ? &(outputPortName->second) : nullptr);
+        }
+    }
+
+    return false;
+}
+
+void ReplaySource::ReplayEvents(long long logicalTime)
+{
+    RecordingReader::Entry entry{};
+    long long nextLogicalTime = 0;
+    while (this->FindNextEvent(nextLogicalTime) && nextLogicalTime == logicalTime)
+    {
+        this->m_reader->ReadNext(entry);
+        const std::string* outputPortName = (entry.streamId < this->m_outputPortNames.size() ? this->m_outputPortNames[entry.streamId] : nullptr);
+        std::shared_ptr<IEvent> event = (outputPortName != nullptr ? this->m_serializer->Deserialize(entry.payload, entry.size) : nullptr);
+        if (event != nullptr)
+        {
+            this->SendOutput(*outputPortName, std::move(event));
+            ++(this->m_numberOfEventsReplayed);
+        }
+        else
+        {
+            ++(this->m_numberOfEventsSkipped);
+        }
+    }
+
+    this->ScheduleNextReplay(logicalTime);
+}
+
+// Events recorded out of order, which a valid recording never has, are replayed right away
+void ReplaySource::ScheduleNextReplay(long long currentLogicalTime)
+{
+    long long nextLogicalTime = 0;
+    if (!(this->FindNextEvent(nextLogicalTime)))
+    {
+        this->m_isFinished.store(true);
+        return;
+    }
+
+    long long delayInMilliseconds = std::min<long long>(std::max<long long>(nextLogicalTime - currentLogicalTime, 0LL), INT_MAX);
+    this->ScheduleCallback(
+        [this, nextLogicalTime]()
+        {
+            this->ReplayEvents(nextLogicalTime);
+        },
+        static_cast<int>(delayInMilliseconds),
+        false /*repeat*/);
+}
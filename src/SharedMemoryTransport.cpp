@@ -0,0 +1,449 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include "SharedMemoryTransportImpl.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "Shared-memory transports require lock-free atomics");
+
+const uint64_t SharedMemoryTransport::Impl::Magic = 0x4d48535241434346ULL;
+const uint32_t SharedMemoryTransport::Impl::EventRecord;
+const uint32_t SharedMemoryTransport::Impl::PaddingRecord;
+const size_t SharedMemoryTransport::Impl::RecordAlignment;
+constexpr const char* SharedMemorySender::Input;
+constexpr const char* SharedMemoryReceiver::Output;
+
+static const size_t MinCapacity = 64;
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t powerOfTwo = MinCapacity;
+    while (powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+// Takes ownership of the file descriptors. A new transport's memfd is sized and its header written; an existing one's
+// header is checked against the size of the memfd.
+SharedMemoryTransport::Impl::Impl(int memoryFileDescriptor, int wakeFileDescriptor, bool isNew, size_t capacity) :
+    m_memoryFileDescriptor(memoryFileDescriptor),
+    m_wakeFileDescriptor(wakeFileDescriptor),
+    m_mappingSize(0),
+    m_header(nullptr),
+    m_ring(nullptr),
+    m_capacity(capacity),
+    m_tail(0),
+    m_head(0)
+{
+    try
+    {
+        if (isNew)
+        {
+            this->m_mappingSize = sizeof(Header) + capacity;
+            if (ftruncate(this->m_memoryFileDescriptor, static_cast<off_t>(this->m_mappingSize)) != 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Could not size the shared-memory transport");
+            }
+        }
+        else
+        {
+            struct stat status{};
+            if (fstat(this->m_memoryFileDescriptor, &status) != 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Could not open the shared-memory transport");
+            }
+
+            this->m_mappingSize = static_cast<size_t>(status.st_size);
+            if (this->m_mappingSize < sizeof(Header) + MinCapacity)
+            {
+                throw std::invalid_argument("The file descriptor does not hold a shared-memory transport");
+            }
+        }
+
+        void* mapping = mmap(nullptr, this->m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_memoryFileDescriptor, 0);
+        if (mapping == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(), "Could not map the shared-memory transport");
+        }
+
+        this->m_header = static_cast<Header*>(mapping);
+        this->m_ring = static_cast<unsigned char*>(mapping) + sizeof(Header);
+        if (isNew)
+        {
+            new (this->m_header) Header{};
+            this->m_header->magic = Magic;
+            this->m_header->capacity = capacity;
+        }
+        else
+        {
+            this->m_capacity = static_cast<size_t>(this->m_header->capacity);
+            if (this->m_header->magic != Magic || this->m_capacity != this->m_mappingSize - sizeof(Header) || (this->m_capacity & (this->m_capacity - 1)) != 0)
+            {
+                throw std::invalid_argument("The file descriptor does not hold a shared-memory transport");
+            }
+
+            this->m_tail = this->m_header->tail.load(std::memory_order_acquire);
+            this->m_head = this->m_header->head.load(std::memory_order_acquire);
+        }
+    }
+    catch (...)
+    {
+        if (this->m_header != nullptr)
+        {
+            munmap(this->m_header, this->m_mappingSize);
+        }
+
+        close(this->m_memoryFileDescriptor);
+        close(this->m_wakeFileDescriptor);
+        throw;
+    }
+}
+
+SharedMemoryTransport::Impl::~Impl()
+{
+    munmap(this->m_header, this->m_mappingSize);
+    close(this->m_memoryFileDescriptor);
+    close(this->m_wakeFileDescriptor);
+}
+
+int SharedMemoryTransport::Impl::GetMemoryFileDescriptor() const
+{
+    return this->m_memoryFileDescriptor;
+}
+
+int SharedMemoryTransport::Impl::GetWakeFileDescriptor() const
+{
+    return this->m_wakeFileDescriptor;
+}
+
+size_t SharedMemoryTransport::Impl::GetCapacity() const
+{
+    return this->m_capacity;
+}
+
+size_t SharedMemoryTransport::Impl::GetMaxRecordSize() const
+{
+    return this->m_capacity / 4 - sizeof(RecordHeader);
+}
+
+size_t SharedMemoryTransport::Impl::GetRecordLength(size_t payloadSize)
+{
+    return sizeof(RecordHeader) + ((payloadSize + RecordAlignment - 1) & ~(RecordAlignment - 1));
+}
+
+bool SharedMemoryTransport::Impl::Write(const unsigned char* data, size_t size)
+{
+    size_t recordLength = GetRecordLength(size);
+    size_t position = static_cast<size_t>(this->m_tail & (this->m_capacity - 1));
+    size_t spaceBeforeEnd = this->m_capacity - position;
+    size_t neededSpace = (recordLength <= spaceBeforeEnd ? recordLength : spaceBeforeEnd + recordLength);
+    uint64_t head = this->m_header->head.load(std::memory_order_acquire);
+    if (this->m_tail + neededSpace - head > this->m_capacity)
+    {
+        return false;
+    }
+
+    if (recordLength > spaceBeforeEnd)
+    {
+        RecordHeader padding{ static_cast<uint32_t>(spaceBeforeEnd - sizeof(RecordHeader)), PaddingRecord };
+        std::memcpy(this->m_ring + position, &padding, sizeof(padding));
+        this->m_tail += spaceBeforeEnd;
+        position = 0;
+    }
+
+    RecordHeader recordHeader{ static_cast<uint32_t>(size), EventRecord };
+    std::memcpy(this->m_ring + position, &recordHeader, sizeof(recordHeader));
+    std::memcpy(this->m_ring + position + sizeof(recordHeader), data, size);
+    this->m_tail += recordLength;
+    this->m_header->tail.store(this->m_tail, std::memory_order_seq_cst);
+    return true;
+}
+
+void SharedMemoryTransport::Impl::WakeReceiver()
+{
+    if (this->m_header->receiverIsWaiting.load(std::memory_order_seq_cst) != 0 &&
+        this->m_header->receiverIsWaiting.exchange(0, std::memory_order_seq_cst) != 0)
+    {
+        this->Wake();
+    }
+}
+
+void SharedMemoryTransport::Impl::Wake()
+{
+    uint64_t count = 1;
+    ssize_t bytesWritten = write(this->m_wakeFileDescriptor, &count, sizeof(count));
+    (void)bytesWritten;
+}
+
+// Padding records are skipped here, so the caller only sees events. The sender can still write to the ring, so the record
+// header is read into a local copy once, and the payload is copied out before the record is released to the sender.
+SharedMemoryTransport::Impl::ReadResult SharedMemoryTransport::Impl::Read(std::vector<unsigned char>& record)
+{
+    while (true)
+    {
+        uint64_t tail = this->m_header->tail.load(std::memory_order_acquire);
+        if (tail == this->m_head)
+        {
+            return ReadResult::Empty;
+        }
+
+        uint64_t available = tail - this->m_head;
+        size_t position = static_cast<size_t>(this->m_head & (this->m_capacity - 1));
+        size_t spaceBeforeEnd = this->m_capacity - position;
+        if (available > this->m_capacity || available < sizeof(RecordHeader))
+        {
+            return ReadResult::Corrupt;
+        }
+
+        RecordHeader recordHeader{};
+        std::memcpy(&recordHeader, this->m_ring + position, sizeof(recordHeader));
+        size_t recordLength = GetRecordLength(recordHeader.size);
+        if (recordLength > spaceBeforeEnd || recordLength > available)
+        {
+            return ReadResult::Corrupt;
+        }
+
+        if (recordHeader.kind == PaddingRecord)
+        {
+            if (recordLength != spaceBeforeEnd)
+            {
+                return ReadResult::Corrupt;
+            }
+
+            this->m_head += recordLength;
+            this->m_header->head.store(this->m_head, std::memory_order_release);
+            continue;
+        }
+
+        if (recordHeader.kind != EventRecord || recordHeader.size > this->GetMaxRecordSize())
+        {
+            return ReadResult::Corrupt;
+        }
+
+        record.resize(recordHeader.size);
+        std::memcpy(record.data(), this->m_ring + position + sizeof(RecordHeader), recordHeader.size);
+        this->m_head += recordLength;
+        this->m_header->head.store(this->m_head, std::memory_order_release);
+        return ReadResult::Record;
+    }
+}
+
+bool SharedMemoryTransport::Impl::PrepareToWait()
+{
+    this->m_header->receiverIsWaiting.store(1, std::memory_order_seq_cst);
+    if (this->m_header->tail.load(std::memory_order_seq_cst) != this->m_head)
+    {
+        this->m_header->receiverIsWaiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void SharedMemoryTransport::Impl::ClearWake()
+{
+    uint64_t count = 0;
+    ssize_t bytesRead = read(this->m_wakeFileDescriptor, &count, sizeof(count));
+    (void)bytesRead;
+}
+
+SharedMemoryTransport::SharedMemoryTransport(std::unique_ptr<Impl> impl) :
+    m_impl(std::move(impl))
+{
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() = default;
+
+std::shared_ptr<SharedMemoryTransport> SharedMemoryTransport::Create(size_t capacityInBytes)
+{
+    int memoryFileDescriptor = memfd_create("AccessorFrameworkTransport", MFD_CLOEXEC);
+    if (memoryFileDescriptor < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Could not create the shared-memory transport");
+    }
+
+    int wakeFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFileDescriptor < 0)
+    {
+        int error = errno;
+        close(memoryFileDescriptor);
+        throw std::system_error(error, std::generic_category(), "Could not create the shared-memory transport");
+    }
+
+    auto impl = std::make_unique<Impl>(memoryFileDescriptor, wakeFileDescriptor, true /*isNew*/, RoundUpToPowerOfTwo(capacityInBytes));
+    return std::shared_ptr<SharedMemoryTransport>(new SharedMemoryTransport(std::move(impl)));
+}
+
+std::shared_ptr<SharedMemoryTransport> SharedMemoryTransport::Open(int memoryFileDescriptor, int wakeFileDescriptor)
+{
+    int memoryFileDescriptorCopy = fcntl(memoryFileDescriptor, F_DUPFD_CLOEXEC, 0);
+    if (memoryFileDescriptorCopy < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Could not open the shared-memory transport");
+    }
+
+    int wakeFileDescriptorCopy = fcntl(wakeFileDescriptor, F_DUPFD_CLOEXEC, 0);
+    if (wakeFileDescriptorCopy < 0)
+    {
+        int error = errno;
+        close(memoryFileDescriptorCopy);
+        throw std::system_error(error, std::generic_category(), "Could not open the shared-memory transport");
+    }
+
+    auto impl = std::make_unique<Impl>(memoryFileDescriptorCopy, wakeFileDescriptorCopy, false /*isNew*/, 0);
+    return std::shared_ptr<SharedMemoryTransport>(new SharedMemoryTransport(std::move(impl)));
+}
+
+int SharedMemoryTransport::GetMemoryFileDescriptor() const
+{
+    return this->m_impl->GetMemoryFileDescriptor();
+}
+
+int SharedMemoryTransport::GetWakeFileDescriptor() const
+{
+    return this->m_impl->GetWakeFileDescriptor();
+}
+
+size_t SharedMemoryTransport::GetCapacity() const
+{
+    return this->m_impl->GetCapacity();
+}
+
+SharedMemoryTransport::Impl* SharedMemoryTransport::GetImpl() const
+{
+    return this->m_impl.get();
+}
+
+// Events are serialized into a buffer with room for the largest record, allocated up front, and then copied into the ring
+SharedMemorySender::SharedMemorySender(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, std::shared_ptr<const EventSerializer> serializer) :
+    AtomicAccessor(name, { Input }),
+    m_transport(std::move(transport)),
+    m_serializer(std::move(serializer)),
+    m_numberOfEventsSent(0ULL),
+    m_numberOfEventsDropped(0ULL)
+{
+    this->m_buffer.reserve(this->m_transport->GetImpl()->GetMaxRecordSize());
+    this->AddInputHandler(Input,
+        [this](IEvent* event)
+        {
+            this->Send(*event);
+        });
+}
+
+unsigned long long SharedMemorySender::GetNumberOfEventsSent() const
+{
+    return this->m_numberOfEventsSent.load(std::memory_order_relaxed);
+}
+
+unsigned long long SharedMemorySender::GetNumberOfEventsDropped() const
+{
+    return this->m_numberOfEventsDropped.load(std::memory_order_relaxed);
+}
+
+void SharedMemorySender::Send(const IEvent& event)
+{
+    SharedMemoryTransport::Impl* transport = this->m_transport->GetImpl();
+    this->m_buffer.clear();
+    if (!(this->m_serializer->CanSerialize(event)) ||
+        this->m_serializer->Serialize(event, this->m_buffer) > transport->GetMaxRecordSize() ||
+        !(transport->Write(this->m_buffer.data(), this->m_buffer.size())))
+    {
+        this->m_numberOfEventsDropped.store(this->m_numberOfEventsDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    this->m_numberOfEventsSent.store(this->m_numberOfEventsSent.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    transport->WakeReceiver();
+}
+
+// Records are copied into a buffer with room for the largest one, allocated up front, and deserialized from there
+SharedMemoryReceiver::SharedMemoryReceiver(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, std::shared_ptr<const EventSerializer> serializer) :
+    IOAccessor(name, {}, {}, { Output }),
+    m_transport(std::move(transport)),
+    m_serializer(std::move(serializer)),
+    m_isWatching(false),
+    m_numberOfEventsReceived(0ULL),
+    m_numberOfEventsDropped(0ULL)
+{
+    this->m_record.reserve(this->m_transport->GetImpl()->GetMaxRecordSize());
+}
+
+SharedMemoryReceiver::~SharedMemoryReceiver()
+{
+    if (this->m_isWatching)
+    {
+        this->UnwatchFileDescriptor(this->m_transport->GetWakeFileDescriptor());
+    }
+}
+
+unsigned long long SharedMemoryReceiver::GetNumberOfEventsReceived() const
+{
+    return this->m_numberOfEventsReceived.load(std::memory_order_relaxed);
+}
+
+unsigned long long SharedMemoryReceiver::GetNumberOfEventsDropped() const
+{
+    return this->m_numberOfEventsDropped.load(std::memory_order_relaxed);
+}
+
+// Events already in the ring are read as soon as the host starts running
+void SharedMemoryReceiver::Initialize()
+{
+    this->WatchFileDescriptor(
+        this->m_transport->GetWakeFileDescriptor(),
+        IOAccessor::Readable,
+        [this](unsigned int /*ioEvents*/)
+        {
+            this->m_transport->GetImpl()->ClearWake();
+            this->Receive();
+        });
+    this->m_isWatching = true;
+    this->m_transport->GetImpl()->Wake();
+}
+
+void SharedMemoryReceiver::Receive()
+{
+    SharedMemoryTransport::Impl* transport = this->m_transport->GetImpl();
+    do
+    {
+        SharedMemoryTransport::Impl::ReadResult result = SharedMemoryTransport::Impl::ReadResult::Empty;
+        while ((result = transport->Read(this->m_record)) == SharedMemoryTransport::Impl::ReadResult::Record)
+        {
+            ByteReader reader(this->m_record.data(), this->m_record.size());
+            std::shared_ptr<IEvent> event = this->m_serializer->Deserialize(reader);
+            if (event == nullptr || reader.GetRemainingSize() != 0)
+            {
+                this->m_numberOfEventsDropped.store(this->m_numberOfEventsDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                continue;
+            }
+
+            this->m_numberOfEventsReceived.store(this->m_numberOfEventsReceived.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            this->SendOutput(Output, std::move(event));
+        }
+
+        if (result == SharedMemoryTransport::Impl::ReadResult::Corrupt)
+        {
+            LOG_ERROR("Shared-memory transport of %s is corrupt and has been closed", this->GetName().c_str());
+            this->UnwatchFileDescriptor(transport->GetWakeFileDescriptor());
+            this->m_isWatching = false;
+            return;
+        }
+    } while (!(transport->PrepareToWait()));
+}
+
+#endif // __linux__
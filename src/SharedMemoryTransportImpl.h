@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SHARED_MEMORY_TRANSPORT_IMPL_H
+#define SHARED_MEMORY_TRANSPORT_IMPL_H
+
+#ifdef __linux__
+
+#include "AccessorFramework/SharedMemoryTransport.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Description
+// The SharedMemoryTransport::Impl maps the transport's memfd, which holds a header followed by a ring of bytes. The
+// header holds the ring's capacity, the tail (written by the sender), the head (written by the receiver), and the
+// receiver's waiting flag, each on a cache line of its own. Every record in the ring starts with an 8-byte header giving
+// its kind and the size of its payload, and records are 8-byte aligned. A record never wraps around the end of the ring;
+// when one does not fit before the end, the sender fills the rest of the ring with a padding record and starts again at
+// the beginning.
+//
+// Each end keeps its own index in private memory and only publishes it to shared memory, so a misbehaving peer cannot
+// make it write outside the ring. The receiver checks every index and record header it reads against the ring's bounds,
+// and every record's size against the largest record the sender may write, and reports the ring as corrupt if one is out
+// of them. It reads each record header once and copies the payload into private memory before using either.
+//
+// Waking the receiver works like a futex: before the receiver waits on the eventfd, it sets the waiting flag and checks
+// the ring once more, and after the sender publishes a record, it clears the flag and writes to the eventfd only if the
+// flag was set. Sequentially consistent operations on both sides ensure that a record is never left unread while the
+// receiver waits.
+//
+class SharedMemoryTransport::Impl
+{
+public:
+    enum class ReadResult
+    {
+        Record,
+        Empty,
+        Corrupt
+    };
+
+    Impl(int memoryFileDescriptor, int wakeFileDescriptor, bool isNew, size_t capacity);
+    ~Impl();
+    int GetMemoryFileDescriptor() const;
+    int GetWakeFileDescriptor() const;
+    size_t GetCapacity() const;
+    size_t GetMaxRecordSize() const;
+
+    // Sender methods
+    bool Write(const unsigned char* data, size_t size);
+    void WakeReceiver(); // if it is waiting
+    void Wake();
+
+    // Receiver methods; Read() copies the next event's payload into the record, which must have room for the largest one
+    ReadResult Read(std::vector<unsigned char>& record);
+    bool PrepareToWait(); // returns false if the ring is not empty, in which case the receiver should not wait
+    void ClearWake();
+
+private:
+    struct Header
+    {
+        uint64_t magic;
+        uint64_t capacity;
+        char padding0[48];
+        std::atomic<uint64_t> tail;
+        char padding1[56];
+        std::atomic<uint64_t> head;
+        std::atomic<uint32_t> receiverIsWaiting;
+        char padding2[52];
+    };
+
+    struct RecordHeader
+    {
+        uint32_t size;
+        uint32_t kind;
+    };
+
+    static const uint64_t Magic;
+    static const uint32_t EventRecord = 1;
+    static const uint32_t PaddingRecord = 2;
+    static const size_t RecordAlignment = 8;
+
+    static size_t GetRecordLength(size_t payloadSize);
+
+    int m_memoryFileDescriptor;
+    int m_wakeFileDescriptor;
+    size_t m_mappingSize;
+    Header* m_header;
+    unsigned char* m_ring;
+    size_t m_capacity;
+    uint64_t m_tail; // the sender's own copy
+    uint64_t m_head; // the receiver's own copy
+};
+
+#endif // __linux__
+
+#endif // SHARED_MEMORY_TRANSPORT_IMPL_H
@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ThreadConfiguration.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+static const size_t MaxThreadNameLength = 15;
+
+static int GetNativePolicy(Host::SchedulingPolicy schedulingPolicy)
+{
+    switch (schedulingPolicy)
+    {
+    case Host::SchedulingPolicy::Fifo:
+        return SCHED_FIFO;
+    case Host::SchedulingPolicy::RoundRobin:
+        return SCHED_RR;
+    case Host::SchedulingPolicy::Batch:
+        return SCHED_BATCH;
+    default:
+        return SCHED_OTHER;
+    }
+}
+
+static int SetNativeAffinity(pthread_t thread, const std::vector<int>& cpus)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus)
+    {
+        CPU_SET(cpu, &cpuSet);
+    }
+
+    return pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet);
+}
+
+// Parses a list such as "0-3,8,10-11"
+static std::vector<int> ParseCpuList(const std::string& cpuList)
+{
+    std::vector<int> cpus{};
+    std::istringstream ranges(cpuList);
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        int first = 0;
+        int last = 0;
+        char separator = '\0';
+        std::istringstream rangeStream(range);
+        if (!(rangeStream >> first))
+        {
+            continue;
+        }
+
+        last = (rangeStream >> separator >> last && separator == '-' ? last : first);
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+#endif
+
+ThreadConfiguration::ThreadConfiguration() :
+    m_isEmpty(true),
+    m_settings{},
+    m_hasWarned(nullptr)
+{
+}
+
+ThreadConfiguration::ThreadConfiguration(const Host::ThreadSettings& settings, const std::string& defaultName) :
+    m_isEmpty(false),
+    m_settings(settings),
+    m_hasWarned(std::make_shared<std::atomic<bool>>(false))
+{
+    Validate(settings);
+    if (this->m_settings.name.empty())
+    {
+        this->m_settings.name = defaultName;
+    }
+}
+
+void ThreadConfiguration::ApplyToCurrentThread(const std::string& role) const
+{
+#ifdef __linux__
+    if (this->m_isEmpty)
+    {
+        return;
+    }
+
+    pthread_t thread = pthread_self();
+    if (!role.empty())
+    {
+        std::string threadName = this->m_settings.name + "/" + role;
+        pthread_setname_np(thread, threadName.substr(0, MaxThreadNameLength).c_str());
+    }
+    else
+    {
+        pthread_setname_np(thread, this->m_settings.name.substr(0, MaxThreadNameLength).c_str());
+    }
+
+    int error = 0;
+    const char* failedSetting = nullptr;
+    if (!(this->m_settings.cpus.empty()))
+    {
+        error = SetNativeAffinity(thread, this->m_settings.cpus);
+        failedSetting = "CPU affinity";
+    }
+
+    if (error == 0 && this->m_settings.schedulingPolicy != Host::SchedulingPolicy::Default)
+    {
+        sched_param schedulingParameters{};
+        schedulingParameters.sched_priority = this->m_settings.priority;
+        error = pthread_setschedparam(thread, GetNativePolicy(this->m_settings.schedulingPolicy), &schedulingParameters);
+        failedSetting = "scheduling policy";
+    }
+
+    if (error != 0 && !(this->m_hasWarned->exchange(true)))
+    {
+        LOG_WARNING("Threads of %s could not be given their %s: %s", this->m_settings.name.c_str(), failedSetting, std::strerror(error));
+    }
+#else
+    (void)role;
+#endif
+}
+
+void ThreadConfiguration::Validate(const Host::ThreadSettings& settings)
+{
+#ifdef __linux__
+    long numberOfCpus = sysconf(_SC_NPROCESSORS_CONF);
+    for (int cpu : settings.cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE || (numberOfCpus > 0 && cpu >= numberOfCpus))
+        {
+            std::ostringstream exceptionMessage;
+            exceptionMessage << "CPU " << cpu << " does not exist";
+            throw std::invalid_argument(exceptionMessage.str());
+        }
+    }
+
+    bool isRealTime = (settings.schedulingPolicy == Host::SchedulingPolicy::Fifo || settings.schedulingPolicy == Host::SchedulingPolicy::RoundRobin);
+    int nativePolicy = GetNativePolicy(settings.schedulingPolicy);
+    int minPriority = (isRealTime ? sched_get_priority_min(nativePolicy) : 0);
+    int maxPriority = (isRealTime ? sched_get_priority_max(nativePolicy) : 0);
+    if (settings.priority < minPriority || settings.priority > maxPriority)
+    {
+        std::ostringstream exceptionMessage;
+        exceptionMessage << "Priority " << settings.priority << " is not between " << minPriority << " and " << maxPriority << " for the scheduling policy";
+        throw std::invalid_argument(exceptionMessage.str());
+    }
+#else
+    (void)settings;
+#endif
+}
+
+void ThreadConfiguration::SetAffinity(std::thread& thread, const std::vector<int>& cpus)
+{
+#ifdef __linux__
+    int error = SetNativeAffinity(thread.native_handle(), cpus);
+    if (error != 0)
+    {
+        LOG_WARNING("A thread could not be given its CPU affinity: %s", std::strerror(error));
+    }
+#else
+    (void)thread;
+    (void)cpus;
+#endif
+}
+
+// Only the CPUs the process may run on are counted. With fewer than two nodes, there is nothing to spread across, so
+// every such CPU is put in one node.
+std::vector<std::vector<int>> ThreadConfiguration::GetNumaNodeCpus()
+{
+    std::vector<int> allowedCpus{};
+    std::vector<std::vector<int>> numaNodeCpus{};
+#ifdef __linux__
+    cpu_set_t allowedCpuSet;
+    CPU_ZERO(&allowedCpuSet);
+    if (sched_getaffinity(0, sizeof(allowedCpuSet), &allowedCpuSet) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowedCpuSet))
+            {
+                allowedCpus.push_back(cpu);
+            }
+        }
+    }
+
+    // Node numbers need not be contiguous, so the online nodes are listed the same way as their CPUs
+    std::ifstream nodeListFile("/sys/devices/system/node/online");
+    std::string nodeList;
+    std::getline(nodeListFile, nodeList);
+    for (int node : ParseCpuList(nodeList))
+    {
+        std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string cpuList;
+        std::vector<int> cpus{};
+        if (std::getline(cpuListFile, cpuList))
+        {
+            for (int cpu : ParseCpuList(cpuList))
+            {
+                if (std::find(allowedCpus.begin(), allowedCpus.end(), cpu) != allowedCpus.end())
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+
+        if (!cpus.empty())
+        {
+            numaNodeCpus.push_back(std::move(cpus));
+        }
+    }
+#endif
+
+    if (numaNodeCpus.size() < 2)
+    {
+        numaNodeCpus.clear();
+        if (allowedCpus.empty())
+        {
+            for (unsigned int cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1U); ++cpu)
+            {
+                allowedCpus.push_back(static_cast<int>(cpu));
+            }
+        }
+
+        numaNodeCpus.push_back(std::move(allowedCpus));
+    }
+
+    return numaNodeCpus;
+}
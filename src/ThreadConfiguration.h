@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef THREAD_CONFIGURATION_H
+#define THREAD_CONFIGURATION_H
+
+#include "AccessorFramework/Host.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Description
+// A ThreadConfiguration applies a host's thread settings to the threads the framework creates for it: each thread
+// applies them to itself when it starts, naming itself after the host (or the name in the settings) and its role, and
+// taking the CPU affinity, scheduling policy, and priority in the settings. A default-constructed configuration leaves
+// threads as they are. Settings are validated when the configuration is made; a thread that cannot apply them (e.g.
+// without the privilege a real-time policy needs) logs a warning, once per configuration, and runs as it is. Thread
+// names are cut to the 15 characters Linux allows. On other platforms, threads are left as they are.
+//
+class ThreadConfiguration
+{
+public:
+    ThreadConfiguration();
+    ThreadConfiguration(const Host::ThreadSettings& settings, const std::string& defaultName);
+    void ApplyToCurrentThread(const std::string& role) const; // an empty role leaves the name as it is
+
+    static void Validate(const Host::ThreadSettings& settings);
+    static void SetAffinity(std::thread& thread, const std::vector<int>& cpus);
+    static std::vector<std::vector<int>> GetNumaNodeCpus(); // the CPUs the process may run on, by node
+
+private:
+    bool m_isEmpty;
+    Host::ThreadSettings m_settings;
+    std::shared_ptr<std::atomic<bool>> m_hasWarned;
+};
+
+#endif // THREAD_CONFIGURATION_H
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ThreadExecutor.h"
+#include <system_error>
+#include <vector>
+
+ThreadExecutor::ThreadExecutor() :
+    ThreadExecutor(ThreadConfiguration())
+{
+}
+
+ThreadExecutor::ThreadExecutor(ThreadConfiguration threadConfiguration) :
+    m_threadConfiguration(std::move(threadConfiguration)),
+    m_timerQueue(std::make_shared<TimerQueue>())
+{
+}
+
+// The queued tasks are destroyed outside the lock, since one of them may hold the last reference to something that
+// schedules tasks on the executor
+ThreadExecutor::~ThreadExecutor()
+{
+    std::map<TimedTaskKey, std::function<void()>> discardedTasks{};
+    {
+        std::lock_guard<std::mutex> lock(this->m_timerQueue->mutex);
+        this->m_timerQueue->isStopping = true;
+        discardedTasks.swap(this->m_timerQueue->tasks);
+        this->m_timerQueue->deadlines.clear();
+    }
+
+    this->m_timerQueue->changed.notify_one();
+}
+
+void ThreadExecutor::Execute(std::function<void()> task)
+{
+    StartThread(this->m_threadConfiguration, std::move(task));
+}
+
+void ThreadExecutor::ExecuteAfter(long long delayInMilliseconds, std::function<void()> task)
+{
+    this->ExecuteCancelableAfter(delayInMilliseconds, std::move(task));
+}
+
+// A task that is due right away gets its thread without going through the timer thread, and cannot be canceled
+unsigned long long ThreadExecutor::ExecuteCancelableAfter(long long delayInMilliseconds, std::function<void()> task)
+{
+    if (delayInMilliseconds <= 0LL)
+    {
+        this->Execute(std::move(task));
+        return 0ULL;
+    }
+
+    TimerQueue& timerQueue = *(this->m_timerQueue);
+    unsigned long long taskId = 0ULL;
+    bool isEarliest = false;
+    {
+        std::lock_guard<std::mutex> lock(timerQueue.mutex);
+        if (!(timerQueue.hasTimerThread))
+        {
+            std::thread timerThread(&ThreadExecutor::TimerLoop, this->m_timerQueue, this->m_threadConfiguration);
+            timerThread.detach();
+            timerQueue.hasTimerThread = true;
+        }
+
+        taskId = timerQueue.nextTaskId++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayInMilliseconds);
+        auto timedTask = timerQueue.tasks.emplace(TimedTaskKey(deadline, taskId), std::move(task)).first;
+        timerQueue.deadlines.emplace(taskId, deadline);
+        isEarliest = (timedTask == timerQueue.tasks.begin());
+    }
+
+    // The timer thread only needs to wake up if it has to sleep for a shorter time
+    if (isEarliest)
+    {
+        timerQueue.changed.notify_one();
+    }
+
+    return taskId;
+}
+
+// The timer thread is not woken, since it would only find that the earliest deadline is the same or later. Like the
+// discarded tasks, the canceled task is destroyed after the lock is released.
+void ThreadExecutor::Cancel(unsigned long long taskId)
+{
+    std::function<void()> canceledTask = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(this->m_timerQueue->mutex);
+        auto deadline = this->m_timerQueue->deadlines.find(taskId);
+        if (deadline == this->m_timerQueue->deadlines.end())
+        {
+            return;
+        }
+
+        auto timedTask = this->m_timerQueue->tasks.find(TimedTaskKey(deadline->second, taskId));
+        canceledTask = std::move(timedTask->second);
+        this->m_timerQueue->tasks.erase(timedTask);
+        this->m_timerQueue->deadlines.erase(deadline);
+    }
+}
+
+std::shared_ptr<Executor> ThreadExecutor::GetDefault()
+{
+    static std::shared_ptr<Executor> defaultExecutor = std::make_shared<ThreadExecutor>();
+    return defaultExecutor;
+}
+
+void ThreadExecutor::StartThread(const ThreadConfiguration& threadConfiguration, std::function<void()> task)
+{
+    bool retry = false;
+    do
+    {
+        retry = false;
+        try
+        {
+            // The task is copied so that it is still available to retry with if the thread cannot be created
+            std::thread taskThread(
+                [task, threadConfiguration]()
+                {
+                    threadConfiguration.ApplyToCurrentThread("");
+                    task();
+                });
+
+            taskThread.detach();
+        }
+        catch (const std::system_error& e)
+        {
+            if (e.code() == std::errc::resource_unavailable_try_again)
+            {
+                retry = true;
+            }
+            else
+            {
+                throw;
+            }
+        }
+    } while (retry);
+}
+
+// Due tasks are taken off the queue under the lock and given their threads after it is released
+void ThreadExecutor::TimerLoop(std::shared_ptr<TimerQueue> timerQueue, ThreadConfiguration threadConfiguration)
+{
+    threadConfiguration.ApplyToCurrentThread("timer");
+    std::vector<std::function<void()>> dueTasks{};
+    std::unique_lock<std::mutex> lock(timerQueue->mutex);
+    while (!(timerQueue->isStopping))
+    {
+        if (timerQueue->tasks.empty())
+        {
+            timerQueue->changed.wait(lock);
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        while (!(timerQueue->tasks.empty()) && timerQueue->tasks.begin()->first.first <= now)
+        {
+            auto timedTask = timerQueue->tasks.begin();
+            dueTasks.push_back(std::move(timedTask->second));
+            timerQueue->deadlines.erase(timedTask->first.second);
+            timerQueue->tasks.erase(timedTask);
+        }
+
+        if (dueTasks.empty())
+        {
+            timerQueue->changed.wait_until(lock, timerQueue->tasks.begin()->first.first);
+            continue;
+        }
+
+        lock.unlock();
+        for (auto& dueTask : dueTasks)
+        {
+            StartThread(threadConfiguration, std::move(dueTask));
+        }
+
+        dueTasks.clear();
+        lock.lock();
+    }
+}
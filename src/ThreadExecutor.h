@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef THREAD_EXECUTOR_H
+#define THREAD_EXECUTOR_H
+
+#include "AccessorFramework/Executor.h"
+#include "ThreadConfiguration.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+// Description
+// The ThreadExecutor is the default executor. It runs every task on a new detached thread. Delayed tasks wait on a
+// single timer thread per executor, which is started by the first delayed task: it sleeps on a condition variable until
+// the earliest deadline in a queue ordered by deadline, and then starts a thread for each task that is due. Canceling a
+// delayed task removes it from the queue. All hosts without an executor of their own share one instance; a host with
+// thread settings has one of its own, whose threads apply them before anything else. The timer thread shares the queue
+// with the executor rather than being joined, since a task it starts may release the last reference to the executor;
+// when the executor is destroyed, the queued tasks are discarded and the timer thread exits.
+//
+class ThreadExecutor : public Executor
+{
+public:
+    ThreadExecutor();
+    explicit ThreadExecutor(ThreadConfiguration threadConfiguration);
+    ~ThreadExecutor();
+    void Execute(std::function<void()> task) override;
+    void ExecuteAfter(long long delayInMilliseconds, std::function<void()> task) override;
+    unsigned long long ExecuteCancelableAfter(long long delayInMilliseconds, std::function<void()> task) override;
+    void Cancel(unsigned long long taskId) override;
+
+    static std::shared_ptr<Executor> GetDefault();
+
+private:
+    using TimedTaskKey = std::pair<std::chrono::steady_clock::time_point, unsigned long long>; // deadline, then task ID
+
+    struct TimerQueue
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::map<TimedTaskKey, std::function<void()>> tasks;
+        std::unordered_map<unsigned long long, std::chrono::steady_clock::time_point> deadlines; // by task ID
+        unsigned long long nextTaskId = 1ULL;
+        bool hasTimerThread = false;
+        bool isStopping = false;
+    };
+
+    static void StartThread(const ThreadConfiguration& threadConfiguration, std::function<void()> task);
+    static void TimerLoop(std::shared_ptr<TimerQueue> timerQueue, ThreadConfiguration threadConfiguration);
+
+    ThreadConfiguration m_threadConfiguration;
+    std::shared_ptr<TimerQueue> m_timerQueue;
+};
+
+#endif // THREAD_EXECUTOR_H
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t numberOfThreads, ThreadConfiguration threadConfiguration) :
+    m_threadConfiguration(std::move(threadConfiguration)),
+    m_task(nullptr),
+    m_numberOfTasks(0),
+    m_nextTask(0),
+    m_numberOfBusyWorkers(0),
+    m_batch(0),
+    m_stopping(false)
+{
+    for (size_t i = 1; i < numberOfThreads; ++i)
+    {
+        this->m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stopping = true;
+    }
+
+    this->m_batchAvailable.notify_all();
+    for (auto& worker : this->m_workers)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetNumberOfThreads() const
+{
+    return this->m_workers.size() + 1;
+}
+
+void ThreadPool::ParallelFor(size_t numberOfTasks, const std::function<void(size_t)>& task)
+{
+    if (numberOfTasks == 0)
+    {
+        return;
+    }
+    else if (numberOfTasks == 1 || this->m_workers.empty())
+    {
+        for (size_t i = 0; i < numberOfTasks; ++i)
+        {
+            task(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_task = &task;
+        this->m_numberOfTasks = numberOfTasks;
+        this->m_nextTask.store(0);
+        this->m_numberOfBusyWorkers = this->m_workers.size();
+        ++this->m_batch;
+    }
+
+    this->m_batchAvailable.notify_all();
+    this->RunTasks();
+
+    // Every worker checks in once per batch, so the task cannot go out of scope while a worker still refers to it
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    this->m_batchFinished.wait(lock, [this]() { return this->m_numberOfBusyWorkers == 0; });
+    this->m_task = nullptr;
+}
+
+void ThreadPool::WorkerLoop(size_t workerIndex)
+{
+    this->m_threadConfiguration.ApplyToCurrentThread("r" + std::to_string(workerIndex));
+    unsigned long long lastBatch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->m_mutex);
+            this->m_batchAvailable.wait(lock, [this, lastBatch]() { return this->m_stopping || this->m_batch != lastBatch; });
+            if (this->m_stopping)
+            {
+                return;
+            }
+
+            lastBatch = this->m_batch;
+        }
+
+        this->RunTasks();
+
+        bool lastWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            lastWorker = (--this->m_numberOfBusyWorkers == 0);
+        }
+
+        if (lastWorker)
+        {
+            this->m_batchFinished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunTasks()
+{
+    size_t taskIndex = this->m_nextTask.fetch_add(1);
+    while (taskIndex < this->m_numberOfTasks)
+    {
+        (*this->m_task)(taskIndex);
+        taskIndex = this->m_nextTask.fetch_add(1);
+    }
+}
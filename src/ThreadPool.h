@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "ThreadConfiguration.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Description
+// The ThreadPool is a fixed set of worker threads used to run independent pieces of work concurrently. Work is handed
+// to the pool in batches with ParallelFor(), which blocks until every task in the batch has finished. The calling thread
+// takes part in the batch, so a pool of N threads owns N - 1 worker threads. Tasks are claimed from a shared counter,
+// which keeps workers busy when tasks are of uneven size. Tasks must not throw. Workers apply the thread configuration
+// they are given when they start.
+//
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t numberOfThreads, ThreadConfiguration threadConfiguration = ThreadConfiguration());
+    ~ThreadPool();
+    size_t GetNumberOfThreads() const;
+    void ParallelFor(size_t numberOfTasks, const std::function<void(size_t)>& task);
+
+private:
+    void WorkerLoop(size_t workerIndex);
+    void RunTasks();
+
+    ThreadConfiguration m_threadConfiguration;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_batchAvailable;
+    std::condition_variable m_batchFinished;
+    const std::function<void(size_t)>* m_task;
+    size_t m_numberOfTasks;
+    std::atomic<size_t> m_nextTask;
+    size_t m_numberOfBusyWorkers;
+    unsigned long long m_batch;
+    bool m_stopping;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "TraceRecorder.h"
+#include <algorithm>
+
+const size_t TraceRecorder::DefaultEventsPerThread = 16384;
+const long long TraceRecorder::NoLogicalTime = -1LL;
+
+std::atomic<bool> TraceRecorder::s_isRecording(false);
+std::atomic<unsigned long long> TraceRecorder::s_generation(0ULL);
+std::mutex TraceRecorder::s_mutex;
+std::vector<std::unique_ptr<TraceRecorder::ThreadBuffer>> TraceRecorder::s_threadBuffers;
+std::vector<TraceRecorder::ThreadBuffer*> TraceRecorder::s_availableThreadBuffers;
+size_t TraceRecorder::s_eventsPerThread = TraceRecorder::DefaultEventsPerThread;
+std::mutex TraceRecorder::s_namesMutex;
+std::unordered_set<std::string> TraceRecorder::s_names;
+thread_local TraceRecorder::ThreadBufferLease TraceRecorder::s_currentThreadBuffer;
+
+static void WriteEscapedString(std::ostream& stream, const char* value)
+{
+    stream << '"';
+    for (const char* c = value; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            stream << '\\' << *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            stream << ' ';
+        }
+        else
+        {
+            stream << *c;
+        }
+    }
+
+    stream << '"';
+}
+
+// Chrome trace timestamps are in microseconds
+static void WriteMicroseconds(std::ostream& stream, long long nanoseconds)
+{
+    stream << (nanoseconds / 1000LL) << '.';
+    long long fraction = nanoseconds % 1000LL;
+    stream << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + (fraction / 10) % 10) << static_cast<char>('0' + fraction % 10);
+}
+
+void TraceRecorder::Start(size_t eventsPerThread)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_eventsPerThread = std::max<size_t>(eventsPerThread, 1);
+    s_generation.fetch_add(1ULL, std::memory_order_relaxed);
+    s_isRecording.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Stop()
+{
+    s_isRecording.store(false, std::memory_order_relaxed);
+}
+
+void TraceRecorder::WriteChromeTrace(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    stream << "{\"traceEvents\":[";
+    bool isFirstEvent = true;
+    for (const auto& threadBuffer : s_threadBuffers)
+    {
+        threadBuffer->WriteChromeTrace(stream, isFirstEvent);
+    }
+
+    stream << "],\"displayTimeUnit\":\"ms\"}";
+}
+
+const char* TraceRecorder::InternName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(s_namesMutex);
+    return s_names.insert(name).first->c_str();
+}
+
+void TraceRecorder::RecordInstant(const char* category, const char* name, const char* target)
+{
+    Event event{};
+    event.phase = 'i';
+    event.category = category;
+    event.name = name;
+    event.target = target;
+    event.startNanoseconds = GetNanosecondsSinceEpoch(std::chrono::steady_clock::now());
+    event.logicalTime = NoLogicalTime;
+    Record(event);
+}
+
+TraceRecorder::Scope::Scope() :
+    m_category(nullptr),
+    m_name(nullptr),
+    m_logicalTime(NoLogicalTime),
+    m_wallMinusLogicalTime(0LL)
+{
+}
+
+TraceRecorder::Scope::~Scope()
+{
+    if (this->m_category == nullptr)
+    {
+        return;
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    Event event{};
+    event.phase = 'X';
+    event.category = this->m_category;
+    event.name = this->m_name;
+    event.startNanoseconds = GetNanosecondsSinceEpoch(this->m_startTime);
+    event.durationNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - this->m_startTime).count();
+    event.logicalTime = this->m_logicalTime;
+    event.wallMinusLogicalTime = this->m_wallMinusLogicalTime;
+    Record(event);
+}
+
+void TraceRecorder::Scope::Begin(const char* category, const char* name)
+{
+    this->m_category = category;
+    this->m_name = name;
+    this->m_startTime = std::chrono::steady_clock::now();
+}
+
+void TraceRecorder::Scope::SetLogicalTime(long long logicalTimeInMilliseconds, long long wallMinusLogicalTimeInMilliseconds)
+{
+    this->m_logicalTime = logicalTimeInMilliseconds;
+    this->m_wallMinusLogicalTime = wallMinusLogicalTimeInMilliseconds;
+}
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(size_t threadId) :
+    m_threadId(threadId),
+    m_events(),
+    m_generation(0ULL),
+    m_numberOfEventsStarted(0),
+    m_numberOfEventsRecorded(0)
+{
+}
+
+void TraceRecorder::ThreadBuffer::Record(const Event& event)
+{
+    if (this->m_generation.load(std::memory_order_relaxed) != s_generation.load(std::memory_order_relaxed))
+    {
+        this->Restart();
+    }
+
+    size_t eventIndex = this->m_numberOfEventsRecorded.load(std::memory_order_relaxed);
+    this->m_numberOfEventsStarted.store(eventIndex + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    this->m_events[eventIndex % this->m_events.size()] = event;
+    this->m_numberOfEventsRecorded.store(eventIndex + 1, std::memory_order_release);
+}
+
+void TraceRecorder::ThreadBuffer::Restart()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (this->m_events.size() != s_eventsPerThread)
+    {
+        std::vector<Event>(s_eventsPerThread).swap(this->m_events);
+    }
+
+    this->m_numberOfEventsStarted.store(0, std::memory_order_relaxed);
+    this->m_numberOfEventsRecorded.store(0, std::memory_order_relaxed);
+    this->m_generation.store(s_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+// The owner keeps recording while the buffer is copied, so the events whose slots it may have started overwriting in
+// the meantime are left out
+void TraceRecorder::ThreadBuffer::WriteChromeTrace(std::ostream& stream, bool& isFirstEvent) const
+{
+    if (this->m_generation.load(std::memory_order_relaxed) != s_generation.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const size_t capacity = this->m_events.size();
+    size_t numberOfEventsRecorded = this->m_numberOfEventsRecorded.load(std::memory_order_acquire);
+    size_t oldestEvent = numberOfEventsRecorded - std::min(numberOfEventsRecorded, capacity);
+    std::vector<Event> events{};
+    events.reserve(numberOfEventsRecorded - oldestEvent);
+    for (size_t i = oldestEvent; i < numberOfEventsRecorded; ++i)
+    {
+        events.push_back(this->m_events[i % capacity]);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    size_t numberOfEventsStarted = this->m_numberOfEventsStarted.load(std::memory_order_relaxed);
+    size_t oldestIntactEvent = std::max(oldestEvent, numberOfEventsStarted - std::min(numberOfEventsStarted, capacity));
+    for (size_t i = oldestIntactEvent; i < numberOfEventsRecorded; ++i)
+    {
+        const Event& event = events[i - oldestEvent];
+        stream << (isFirstEvent ? "" : ",") << "{\"name\":";
+        WriteEscapedString(stream, event.name);
+        stream << ",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << this->m_threadId << ",\"ts\":";
+        WriteMicroseconds(stream, event.startNanoseconds);
+        if (event.phase == 'X')
+        {
+            stream << ",\"dur\":";
+            WriteMicroseconds(stream, event.durationNanoseconds);
+        }
+        else
+        {
+            stream << ",\"s\":\"t\"";
+        }
+
+        stream << ",\"args\":{";
+        if (event.target != nullptr)
+        {
+            stream << "\"to\":";
+            WriteEscapedString(stream, event.target);
+        }
+        else if (event.logicalTime != NoLogicalTime)
+        {
+            stream << "\"logicalTimeMs\":" << event.logicalTime << ",\"wallMinusLogicalMs\":" << event.wallMinusLogicalTime;
+        }
+
+        stream << "}}";
+        isFirstEvent = false;
+    }
+}
+
+TraceRecorder::ThreadBufferLease::~ThreadBufferLease()
+{
+    if (this->buffer != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_availableThreadBuffers.push_back(this->buffer);
+    }
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::GetCurrentThreadBuffer()
+{
+    if (s_currentThreadBuffer.buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (s_availableThreadBuffers.empty())
+        {
+            s_threadBuffers.push_back(std::make_unique<ThreadBuffer>(s_threadBuffers.size() + 1));
+            s_currentThreadBuffer.buffer = s_threadBuffers.back().get();
+        }
+        else
+        {
+            s_currentThreadBuffer.buffer = s_availableThreadBuffers.back();
+            s_availableThreadBuffers.pop_back();
+        }
+    }
+
+    return s_currentThreadBuffer.buffer;
+}
+
+void TraceRecorder::Record(const Event& event)
+{
+    GetCurrentThreadBuffer()->Record(event);
+}
+
+long long TraceRecorder::GetNanosecondsSinceEpoch(std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Description
+// The TraceRecorder records what the framework does as a timeline that can be opened in chrome://tracing or the
+// Perfetto UI. Every thread records into a ring buffer of its own, allocated in full the first time the thread records
+// an event; once the buffer is full, each new event replaces the oldest one. When a thread exits, its buffer (with the
+// events in it) is handed to the next thread that needs one, so hosts that start a thread for every round do not use
+// more buffers than they have threads at any one time. Each buffer is shown as a thread of its own. Recording is switched
+// on and off for the whole process at run time, and while it is off, every recording site costs a single relaxed load.
+// Names are interned: InternName() copies each distinct name once into storage that is never freed, and events only
+// hold pointers to it, so recording an event neither allocates nor copies a name, and the trace can be written after
+// the accessors that produced it are gone (see BaseObject::GetTraceName(), which interns a name the first time it is
+// traced).
+// Only the owning thread writes to a buffer, and it takes no lock to do so: it counts the event as started, writes it,
+// then counts it as recorded. WriteChromeTrace() can be called at any time; it copies the recorded events of each buffer
+// and then drops the oldest ones, whose slots the owner may have started overwriting while they were copied. Start() does not touch the buffers, which may be
+// in use; it starts a new generation instead, and each owner empties its buffer the next time it records, while the
+// trace leaves out buffers that have not been emptied since.
+//
+class TraceRecorder
+{
+public:
+    static const size_t DefaultEventsPerThread;
+
+    // Discards all recorded events and starts recording
+    static void Start(size_t eventsPerThread);
+    static void Stop();
+    static void WriteChromeTrace(std::ostream& stream);
+
+    static bool IsRecording()
+    {
+        return s_isRecording.load(std::memory_order_relaxed);
+    }
+
+    static const char* InternName(const std::string& name); // takes a lock, so callers keep the result
+    static void RecordInstant(const char* category, const char* name, const char* target); // all interned or literals
+
+    // Records a complete event spanning its lifetime, if Begin() was called while recording
+    class Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+        void Begin(const char* category, const char* name); // interned or a literal
+        void SetLogicalTime(long long logicalTimeInMilliseconds, long long wallMinusLogicalTimeInMilliseconds);
+
+    private:
+        const char* m_category;
+        const char* m_name;
+        std::chrono::steady_clock::time_point m_startTime;
+        long long m_logicalTime;
+        long long m_wallMinusLogicalTime;
+    };
+
+private:
+    static const long long NoLogicalTime;
+
+    struct Event
+    {
+        char phase; // 'X' for a complete event, 'i' for an instant event
+        const char* category;
+        const char* name;
+        const char* target; // of an event sent between ports, otherwise null
+        long long startNanoseconds;
+        long long durationNanoseconds;
+        long long logicalTime;
+        long long wallMinusLogicalTime;
+    };
+
+    class ThreadBuffer
+    {
+    public:
+        explicit ThreadBuffer(size_t threadId);
+        void Record(const Event& event); // only called by the owning thread
+        void WriteChromeTrace(std::ostream& stream, bool& isFirstEvent) const; // only called under s_mutex
+
+    private:
+        void Restart(); // takes s_mutex
+
+        const size_t m_threadId;
+        std::vector<Event> m_events; // only resized under s_mutex
+        std::atomic<unsigned long long> m_generation;
+        std::atomic<size_t> m_numberOfEventsStarted; // since the buffer was last emptied
+        std::atomic<size_t> m_numberOfEventsRecorded;
+    };
+
+    // Returns the current thread's buffer to the pool when the thread exits
+    class ThreadBufferLease
+    {
+    public:
+        ~ThreadBufferLease();
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    static ThreadBuffer* GetCurrentThreadBuffer();
+    static void Record(const Event& event);
+    static long long GetNanosecondsSinceEpoch(std::chrono::steady_clock::time_point time);
+
+    static std::atomic<bool> s_isRecording;
+    static std::atomic<unsigned long long> s_generation; // bumped by every Start()
+    static std::mutex s_mutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+    static std::vector<ThreadBuffer*> s_availableThreadBuffers;
+    static size_t s_eventsPerThread;
+    static std::mutex s_namesMutex;
+    static std::unordered_set<std::string> s_names; // elements never move, so pointers to them stay valid
+    static thread_local ThreadBufferLease s_currentThreadBuffer;
+};
+
+#endif // TRACE_RECORDER_H
@@ -4,12 +4,14 @@
 #ifndef UNIQUE_PRIORITY_QUEUE_H
 #define UNIQUE_PRIORITY_QUEUE_H
 
+#include "RecyclingAllocator.h"
 #include <queue>
 #include <set>
 #include <vector>
 
 // Description
-// A priority_queue<T> that contains at most one instance of a given element
+// A priority_queue<T> that contains at most one instance of a given element. The set of queued elements recycles its
+// nodes, so pushing and popping allocates nothing once the queue has reached its largest size.
 //
 template<class T, class Container = std::vector<T>, class Compare = std::less<typename Container::value_type>>
 class unique_priority_queue
@@ -42,7 +44,7 @@ public:
 
 private:
     std::priority_queue<T, Container, Compare> m_queue;
-    std::set<T> m_elementsInQueue;
+    std::set<T, std::less<T>, RecyclingAllocator<T>> m_elementsInQueue;
 };
 
 #endif // UNIQUE_PRIORITY_QUEUE_H
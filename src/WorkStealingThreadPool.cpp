@@ -0,0 +1,213 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "WorkStealingThreadPool.h"
+#include "ThreadConfiguration.h"
+#include <algorithm>
+
+thread_local const WorkStealingThreadPool* WorkStealingThreadPool::s_currentPool = nullptr;
+thread_local size_t WorkStealingThreadPool::s_currentWorkerIndex = 0;
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t numberOfThreads) :
+    m_nextWorker(0),
+    m_numberOfQueuedTasks(0),
+    m_nextTaskId(1ULL),
+    m_stopping(false)
+{
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    for (size_t i = 0; i < numberOfThreads; ++i)
+    {
+        this->m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (size_t i = 0; i < numberOfThreads; ++i)
+    {
+        this->m_threads.emplace_back(&WorkStealingThreadPool::WorkerLoop, this, i);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_stopping = true;
+    }
+
+    this->m_workAvailable.notify_all();
+    for (auto& thread : this->m_threads)
+    {
+        thread.join();
+    }
+}
+
+size_t WorkStealingThreadPool::GetNumberOfThreads() const
+{
+    return this->m_threads.size();
+}
+
+void WorkStealingThreadPool::SetWorkerAffinity(size_t workerIndex, const std::vector<int>& cpus)
+{
+    ThreadConfiguration::SetAffinity(this->m_threads.at(workerIndex), cpus);
+}
+
+void WorkStealingThreadPool::Execute(std::function<void()> task)
+{
+    size_t workerIndex = (s_currentPool == this ? s_currentWorkerIndex : this->m_nextWorker++ % this->m_workers.size());
+    this->Enqueue(workerIndex, std::move(task));
+
+    // Taking the lock ensures that a worker that has just found no work is already waiting when it is notified
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+    }
+
+    this->m_workAvailable.notify_one();
+}
+
+void WorkStealingThreadPool::ExecuteAfter(long long delayInMilliseconds, std::function<void()> task)
+{
+    this->ExecuteCancelableAfter(delayInMilliseconds, std::move(task));
+}
+
+// A task that is due right away goes straight to a worker's queue, and cannot be canceled
+unsigned long long WorkStealingThreadPool::ExecuteCancelableAfter(long long delayInMilliseconds, std::function<void()> task)
+{
+    if (delayInMilliseconds <= 0LL)
+    {
+        this->Execute(std::move(task));
+        return 0ULL;
+    }
+
+    unsigned long long taskId = 0ULL;
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        taskId = this->m_nextTaskId++;
+        auto dueTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayInMilliseconds);
+        this->m_timedTasks.emplace(TimedTaskKey(dueTime, taskId), std::move(task));
+        this->m_dueTimes.emplace(taskId, dueTime);
+    }
+
+    // A sleeping worker needs to recompute how long to sleep
+    this->m_workAvailable.notify_one();
+    return taskId;
+}
+
+// Sleeping workers are not woken, since the earliest due time can only stay the same or get later. The canceled task
+// is destroyed after the lock is released, since it may hold the last reference to something that submits tasks.
+void WorkStealingThreadPool::Cancel(unsigned long long taskId)
+{
+    std::function<void()> canceledTask = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        auto dueTime = this->m_dueTimes.find(taskId);
+        if (dueTime == this->m_dueTimes.end())
+        {
+            return;
+        }
+
+        auto timedTask = this->m_timedTasks.find(TimedTaskKey(dueTime->second, taskId));
+        canceledTask = std::move(timedTask->second);
+        this->m_timedTasks.erase(timedTask);
+        this->m_dueTimes.erase(dueTime);
+    }
+}
+
+void WorkStealingThreadPool::WorkerLoop(size_t workerIndex)
+{
+    s_currentPool = this;
+    s_currentWorkerIndex = workerIndex;
+    std::function<void()> task = nullptr;
+    while (true)
+    {
+        if (this->TryTakeTask(workerIndex, task) || this->TryStealTask(workerIndex, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        if (this->m_stopping)
+        {
+            return;
+        }
+
+        // Timed tasks that are due become ordinary tasks on this worker's queue
+        auto now = std::chrono::steady_clock::now();
+        size_t numberOfDueTasks = 0;
+        while (!this->m_timedTasks.empty() && this->m_timedTasks.begin()->first.first <= now)
+        {
+            auto timedTask = this->m_timedTasks.begin();
+            this->Enqueue(workerIndex, std::move(timedTask->second));
+            this->m_dueTimes.erase(timedTask->first.second);
+            this->m_timedTasks.erase(timedTask);
+            ++numberOfDueTasks;
+        }
+
+        if (numberOfDueTasks > 1)
+        {
+            this->m_workAvailable.notify_all();
+        }
+
+        if (numberOfDueTasks != 0 || this->m_numberOfQueuedTasks.load() != 0)
+        {
+            continue;
+        }
+
+        if (this->m_timedTasks.empty())
+        {
+            this->m_workAvailable.wait(lock);
+        }
+        else
+        {
+            this->m_workAvailable.wait_until(lock, this->m_timedTasks.begin()->first.first);
+        }
+    }
+}
+
+void WorkStealingThreadPool::Enqueue(size_t workerIndex, std::function<void()> task)
+{
+    Worker& worker = *(this->m_workers[workerIndex]);
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+    ++this->m_numberOfQueuedTasks;
+}
+
+// A worker runs its own tasks in the order in which they were queued, which keeps latency fair across submitters
+bool WorkStealingThreadPool::TryTakeTask(size_t workerIndex, std::function<void()>& task)
+{
+    Worker& worker = *(this->m_workers[workerIndex]);
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    --this->m_numberOfQueuedTasks;
+    return true;
+}
+
+// Thieves take the most recently queued task, which is the one its owner would get to last
+bool WorkStealingThreadPool::TryStealTask(size_t thiefIndex, std::function<void()>& task)
+{
+    const size_t numberOfWorkers = this->m_workers.size();
+    for (size_t offset = 1; offset < numberOfWorkers; ++offset)
+    {
+        Worker& victim = *(this->m_workers[(thiefIndex + offset) % numberOfWorkers]);
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            --this->m_numberOfQueuedTasks;
+            return true;
+        }
+    }
+
+    return false;
+}
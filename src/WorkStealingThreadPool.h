@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef WORK_STEALING_THREAD_POOL_H
+#define WORK_STEALING_THREAD_POOL_H
+
+#include "AccessorFramework/Executor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Description
+// The WorkStealingThreadPool runs many small, independent tasks on a fixed number of threads. Each worker owns a queue
+// of tasks that it runs in order. A task submitted from a worker goes to that worker's own queue, so follow-up work stays
+// on the same thread; tasks submitted from other threads are spread across the workers' queues. An idle worker steals
+// the newest task from another worker's queue before going to sleep. Tasks can also be submitted to run after a delay;
+// these wait on a shared timer queue, ordered by due time, until they are due, without holding a thread. A delayed task
+// can be canceled until it is due, which removes it from the timer queue. Tasks must not throw, and must not block
+// waiting for other tasks in the same pool.
+//
+class WorkStealingThreadPool : public Executor
+{
+public:
+    explicit WorkStealingThreadPool(size_t numberOfThreads = 0); // 0 uses one thread per hardware thread
+    ~WorkStealingThreadPool();
+    size_t GetNumberOfThreads() const;
+    void SetWorkerAffinity(size_t workerIndex, const std::vector<int>& cpus);
+    void Execute(std::function<void()> task) override;
+    void ExecuteAfter(long long delayInMilliseconds, std::function<void()> task) override;
+    unsigned long long ExecuteCancelableAfter(long long delayInMilliseconds, std::function<void()> task) override;
+    void Cancel(unsigned long long taskId) override;
+
+private:
+    using TimedTaskKey = std::pair<std::chrono::steady_clock::time_point, unsigned long long>; // due time, then task ID
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void WorkerLoop(size_t workerIndex);
+    void Enqueue(size_t workerIndex, std::function<void()> task);
+    bool TryTakeTask(size_t workerIndex, std::function<void()>& task);
+    bool TryStealTask(size_t thiefIndex, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_nextWorker;
+    std::atomic<size_t> m_numberOfQueuedTasks;
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::map<TimedTaskKey, std::function<void()>> m_timedTasks;
+    std::unordered_map<unsigned long long, std::chrono::steady_clock::time_point> m_dueTimes; // by task ID
+    unsigned long long m_nextTaskId;
+    bool m_stopping;
+
+    static thread_local const WorkStealingThreadPool* s_currentPool;
+    static thread_local size_t s_currentWorkerIndex;
+};
+
+#endif // WORK_STEALING_THREAD_POOL_H
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace AllocationTests
+{
+    class AllocationTest : public SumVerifierHostTest
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            if (!Host::AllocationAccountingIsEnabled())
+            {
+                GTEST_SKIP() << "The library was built without ALLOCATION_ACCOUNTING";
+            }
+
+            SumVerifierHostTest::SetUp();
+        }
+    };
+
+    TEST_F(AllocationTest, SteadyStateIsAllocationFree)
+    {
+        // Arrange
+        const int WarmUpRounds = 100;
+        const int MeasuredRounds = 500;
+        target->Setup();
+        ExecuteRounds(WarmUpRounds);
+        target->ResetAllocationProfile();
+
+        // Act
+        ExecuteRounds(MeasuredRounds);
+        auto profile = target->GetAllocationProfile();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(0ULL, profile.director.numberOfAllocations);
+        ASSERT_EQ(0ULL, profile.ports.numberOfAllocations);
+        ASSERT_EQ(0ULL, profile.reactions.numberOfAllocations);
+
+        // Only the events created by the accessors remain: one per counter and one for the adder every round
+        unsigned long long accessorAllocations = 0ULL;
+        for (const auto& accessor : profile.accessors)
+        {
+            accessorAllocations += accessor.allocations.numberOfAllocations;
+            if (accessor.name != ".TargetHost.SumVerifier")
+            {
+                ASSERT_LE(static_cast<unsigned long long>(MeasuredRounds), accessor.allocations.numberOfAllocations);
+            }
+        }
+
+        ASSERT_EQ(4U, profile.accessors.size());
+        ASSERT_EQ(profile.total.numberOfAllocations, accessorAllocations);
+    }
+
+    TEST_F(AllocationTest, ResetAllocationProfile)
+    {
+        // Arrange
+        target->Setup();
+        ExecuteRounds(3);
+
+        // Act
+        auto profileBeforeReset = target->GetAllocationProfile();
+        target->ResetAllocationProfile();
+        auto profileAfterReset = target->GetAllocationProfile();
+        target->Exit();
+
+        // Assert
+        ASSERT_LT(0ULL, profileBeforeReset.total.numberOfAllocations);
+        ASSERT_LE(profileBeforeReset.total.numberOfAllocations, profileBeforeReset.total.numberOfBytes);
+        ASSERT_EQ(0ULL, profileAfterReset.total.numberOfAllocations);
+        ASSERT_EQ(0ULL, profileAfterReset.total.numberOfBytes);
+        for (const auto& accessor : profileAfterReset.accessors)
+        {
+            ASSERT_EQ(0ULL, accessor.allocations.numberOfAllocations);
+        }
+    }
+}
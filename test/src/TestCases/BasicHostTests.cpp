@@ -45,6 +45,7 @@ namespace BasicHostTests
         ASSERT_THROW(target->Run(), std::logic_error);
         ASSERT_THROW(target->RunOnCurrentThread(), std::logic_error);
         ASSERT_THROW(target->Iterate(1), std::logic_error);
+        ASSERT_THROW(target->Poll(), std::logic_error);
         ASSERT_THROW(target->Pause(), std::logic_error);
     }
 
@@ -72,6 +73,31 @@ namespace BasicHostTests
         ASSERT_EQ(Host::State::Finished, finalState);
     }
 
+    TEST_F(HostTest, PollEmpty)
+    {
+        // Act
+        target->Setup();
+        auto nextDeadline = target->Poll();
+        Host::State stateAfterPoll = target->GetState();
+        target->Pause();
+        Host::State stateAfterPause = target->GetState();
+
+        // Assert
+        ASSERT_EQ(std::chrono::system_clock::time_point::max(), nextDeadline);
+        ASSERT_EQ(Host::State::Running, stateAfterPoll);
+        ASSERT_EQ(Host::State::Paused, stateAfterPause);
+    }
+
+    TEST_F(HostTest, CannotPollWhileRunning)
+    {
+        // Act
+        target->Setup();
+        target->Run();
+
+        // Assert
+        ASSERT_THROW(target->Poll(), std::logic_error);
+    }
+
     TEST_F(HostTest, CanExitWithoutRunning)
     {
         // Act
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AccessorFramework/EventSerializer.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/CheckpointHost.h"
+#include "../TestClasses/CounterHost.h"
+#include "../TestClasses/EmptyHost.h"
+
+namespace CheckpointTests
+{
+    class CheckpointTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->fastValues = std::make_shared<std::vector<int>>();
+            this->slowValues = std::make_shared<std::vector<int>>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->fastValues.reset();
+            this->slowValues.reset();
+        }
+
+        // Executes the given number of rounds without waiting for wall-clock time
+        static void PollRounds(Host& host, int numberOfRounds)
+        {
+            auto nextRoundTime = host.Poll(std::chrono::system_clock::time_point{});
+            for (int i = 0; i < numberOfRounds; ++i)
+            {
+                nextRoundTime = host.Poll(nextRoundTime);
+            }
+        }
+
+        std::shared_ptr<std::vector<int>> fastValues = nullptr;
+        std::shared_ptr<std::vector<int>> slowValues = nullptr;
+    };
+
+    TEST_F(CheckpointTest, RestoredHostCarriesOn)
+    {
+        // Arrange
+        const int NumberOfRoundsBeforeCheckpoint = 7; // the last at t + 600 ms, when the slow counter is 150 ms from due
+        const int NumberOfRoundsAfterCheckpoint = 12;
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        PollRounds(originalHost, NumberOfRoundsBeforeCheckpoint);
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+        auto restoredFastValues = std::make_shared<std::vector<int>>();
+        auto restoredSlowValues = std::make_shared<std::vector<int>>();
+        CheckpointHost restoredHost("CheckpointHost", restoredFastValues, restoredSlowValues);
+
+        // Act
+        originalHost.StartFingerprinting();
+        fastValues->clear();
+        slowValues->clear();
+        PollRounds(originalHost, NumberOfRoundsAfterCheckpoint);
+        Host::FingerprintReport originalReport = originalHost.GetFingerprintReport();
+        restoredHost.StartFingerprinting();
+        restoredHost.Restore(checkpoint);
+        PollRounds(restoredHost, NumberOfRoundsAfterCheckpoint);
+        Host::FingerprintReport restoredReport = restoredHost.GetFingerprintReport();
+
+        // Assert
+        ASSERT_EQ(*fastValues, *restoredFastValues);
+        ASSERT_EQ(*slowValues, *restoredSlowValues);
+        ASSERT_EQ(6, restoredFastValues->front());
+        ASSERT_EQ(2, restoredSlowValues->front());
+        ASSERT_EQ(static_cast<size_t>(NumberOfRoundsAfterCheckpoint), restoredReport.ticks.size());
+        ASSERT_EQ(originalReport.ticks.size(), restoredReport.ticks.size());
+        long long checkpointTime = originalReport.ticks.front().logicalTime - restoredReport.ticks.front().logicalTime;
+        for (size_t i = 0; i < restoredReport.ticks.size(); ++i)
+        {
+            ASSERT_EQ(originalReport.ticks[i].logicalTime - checkpointTime, restoredReport.ticks[i].logicalTime);
+            ASSERT_EQ(originalReport.ticks[i].numberOfEvents, restoredReport.ticks[i].numberOfEvents);
+        }
+
+        ASSERT_EQ(100LL, restoredReport.ticks[0].logicalTime);
+        ASSERT_EQ(150LL, restoredReport.ticks[1].logicalTime);
+    }
+
+    TEST_F(CheckpointTest, RestoreRejectsDifferentModel)
+    {
+        // Arrange
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+        CounterHost otherHost("CheckpointHost", 100);
+
+        // Act and Assert
+        ASSERT_THROW(otherHost.Restore(checkpoint), std::invalid_argument);
+    }
+
+    TEST_F(CheckpointTest, RestoreRejectsDifferentConnections)
+    {
+        // Arrange
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+        CheckpointHost crossConnectedHost("CheckpointHost", fastValues, slowValues, true /*isCrossConnected*/);
+
+        // Act and Assert
+        ASSERT_THROW(crossConnectedHost.Restore(checkpoint), std::invalid_argument);
+        ASSERT_EQ(Host::State::NeedsSetup, crossConnectedHost.GetState());
+    }
+
+    TEST_F(CheckpointTest, RestoreReadsOnlyTheCheckpoint)
+    {
+        // Arrange
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        PollRounds(originalHost, 3);
+        std::stringstream stream;
+        stream << "Before";
+        originalHost.Checkpoint(stream);
+        stream << "After";
+        auto restoredFastValues = std::make_shared<std::vector<int>>();
+        auto restoredSlowValues = std::make_shared<std::vector<int>>();
+        CheckpointHost restoredHost("CheckpointHost", restoredFastValues, restoredSlowValues);
+        std::string before(6, '\0');
+        std::string after{};
+
+        // Act
+        stream.read(&before[0], static_cast<std::streamsize>(before.size()));
+        restoredHost.Restore(stream);
+        Host::State stateAfterRestore = restoredHost.GetState();
+        stream >> after;
+        PollRounds(restoredHost, 1);
+
+        // Assert
+        ASSERT_EQ(std::string("Before"), before);
+        ASSERT_EQ(std::string("After"), after);
+        ASSERT_EQ(Host::State::ReadyToRun, stateAfterRestore);
+        ASSERT_FALSE(restoredFastValues->empty());
+    }
+
+    TEST_F(CheckpointTest, RestoreRejectsOtherStreams)
+    {
+        // Arrange
+        std::stringstream stream("This is not a host checkpoint");
+        CheckpointHost host("CheckpointHost", fastValues, slowValues);
+
+        // Act and Assert
+        ASSERT_THROW(host.Restore(stream), std::invalid_argument);
+        ASSERT_EQ(Host::State::NeedsSetup, host.GetState());
+    }
+
+    TEST_F(CheckpointTest, CorruptAccessorCheckpointLeavesHostNeedingSetup)
+    {
+        // Arrange
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        PollRounds(originalHost, 7);
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+
+        // The first accessor's checkpoint starts with its number of callbacks, which is made larger than the checkpoint
+        std::string bytes = checkpoint.str();
+        ByteReader reader(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+        uint64_t magic = 0;
+        uint32_t formatVersion = 0;
+        uint64_t checkpointSize = 0;
+        std::map<std::string, int32_t> priorities{};
+        std::map<std::string, std::string> connections{};
+        uint64_t numberOfAccessors = 0;
+        std::string accessorName{};
+        uint64_t size = 0;
+        ASSERT_TRUE(Serializer<uint64_t>::Read(reader, magic));
+        ASSERT_TRUE(Serializer<uint32_t>::Read(reader, formatVersion));
+        ASSERT_TRUE(Serializer<uint64_t>::Read(reader, checkpointSize));
+        ASSERT_TRUE((Serializer<std::map<std::string, int32_t>>::Read(reader, priorities)));
+        ASSERT_TRUE((Serializer<std::map<std::string, std::string>>::Read(reader, connections)));
+        ASSERT_TRUE(Serializer<uint64_t>::Read(reader, numberOfAccessors));
+        ASSERT_TRUE(Serializer<std::string>::Read(reader, accessorName));
+        ASSERT_TRUE(Serializer<uint64_t>::Read(reader, size));
+        std::fill_n(bytes.end() - static_cast<std::ptrdiff_t>(reader.GetRemainingSize()), sizeof(uint64_t), '\xff');
+        std::stringstream corruptCheckpoint(bytes);
+        auto restoredFastValues = std::make_shared<std::vector<int>>();
+        auto restoredSlowValues = std::make_shared<std::vector<int>>();
+        CheckpointHost restoredHost("CheckpointHost", restoredFastValues, restoredSlowValues);
+
+        // Act
+        ASSERT_THROW(restoredHost.Restore(corruptCheckpoint), std::invalid_argument);
+        Host::State stateAfterRestore = restoredHost.GetState();
+        restoredHost.Setup();
+        PollRounds(restoredHost, 1);
+
+        // Assert
+        ASSERT_EQ(Host::State::NeedsSetup, stateAfterRestore);
+        ASSERT_EQ(std::vector<int>{ 0 }, *restoredFastValues);
+    }
+
+    TEST_F(CheckpointTest, RestoreRunsAdditionalSetup)
+    {
+        // Arrange
+        EmptyHost originalHost("EmptyHost");
+        originalHost.Setup();
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+        EmptyHost restoredHost("EmptyHost");
+
+        // Act
+        restoredHost.Restore(checkpoint);
+
+        // Assert
+        ASSERT_TRUE(originalHost.AdditionalSetupWasCalled());
+        ASSERT_TRUE(restoredHost.AdditionalSetupWasCalled());
+        ASSERT_EQ(Host::State::ReadyToRun, restoredHost.GetState());
+    }
+
+    TEST_F(CheckpointTest, CheckpointRequiresSetup)
+    {
+        // Arrange
+        std::stringstream checkpoint;
+        CheckpointHost host("CheckpointHost", fastValues, slowValues);
+
+        // Act and Assert
+        ASSERT_THROW(host.Checkpoint(checkpoint), std::logic_error);
+    }
+
+    TEST_F(CheckpointTest, RestoreReplacesSetup)
+    {
+        // Arrange
+        CheckpointHost originalHost("CheckpointHost", fastValues, slowValues);
+        originalHost.Setup();
+        std::stringstream checkpoint;
+        originalHost.Checkpoint(checkpoint);
+        CheckpointHost restoredHost("CheckpointHost", fastValues, slowValues);
+        restoredHost.Setup();
+
+        // Act and Assert
+        ASSERT_THROW(restoredHost.Restore(checkpoint), std::logic_error);
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace CriticalPathTests
+{
+    class CriticalPathTest : public SumVerifierHostTest
+    {
+    };
+
+    TEST_F(CriticalPathTest, FindCriticalPath)
+    {
+        // Arrange
+        const int NumberOfRounds = 5;
+        target->Setup();
+        target->StartCriticalPathAnalysis();
+
+        // Act
+        ExecuteRounds(NumberOfRounds);
+        auto report = target->GetCriticalPathReport();
+        target->Exit();
+
+        // Assert
+        // The counters send their outputs from callbacks, so only the adder and the verifier react
+        const std::vector<std::string> expectedCriticalPath = { ".TargetHost.IntegerAdder", ".TargetHost.SumVerifier" };
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfRounds), report.numberOfTicks);
+        ASSERT_EQ(static_cast<size_t>(NumberOfRounds), report.recentTicks.size());
+        for (const auto& tick : report.recentTicks)
+        {
+            ASSERT_EQ(expectedCriticalPath, tick.criticalPath);
+            ASSERT_EQ(tick.totalReactionTime, tick.criticalPathTime);
+            ASSERT_EQ(2U, tick.levels.size());
+            ASSERT_LT(tick.levels[0].depth, tick.levels[1].depth);
+            for (const auto& level : tick.levels)
+            {
+                ASSERT_EQ(1U, level.numberOfAccessors);
+                ASSERT_EQ(std::chrono::nanoseconds(0), level.slack);
+            }
+        }
+
+        ASSERT_LT(report.recentTicks[0].logicalTime, report.recentTicks[NumberOfRounds - 1].logicalTime);
+        ASSERT_EQ(expectedCriticalPath, report.longestTick.criticalPath);
+        ASSERT_EQ(2U, report.accessors.size());
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfRounds), report.accessors[0].numberOfTicksOnCriticalPath);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfRounds), report.accessors[1].numberOfTicksOnCriticalPath);
+    }
+
+    TEST_F(CriticalPathTest, KeepMostRecentTicks)
+    {
+        // Arrange
+        target->Setup();
+        target->StartCriticalPathAnalysis(2);
+        ExecuteRounds(3);
+        auto earlierReport = target->GetCriticalPathReport();
+
+        // Act
+        ExecuteRounds(2);
+        auto report = target->GetCriticalPathReport();
+        target->ResetCriticalPathAnalysis();
+        auto resetReport = target->GetCriticalPathReport();
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(3ULL, earlierReport.numberOfTicks);
+        ASSERT_EQ(5ULL, report.numberOfTicks);
+        ASSERT_EQ(2U, report.recentTicks.size());
+        ASSERT_LT(earlierReport.recentTicks[1].logicalTime, report.recentTicks[0].logicalTime);
+        ASSERT_EQ(0ULL, resetReport.numberOfTicks);
+        ASSERT_TRUE(resetReport.recentTicks.empty());
+        ASSERT_TRUE(resetReport.accessors.empty());
+    }
+
+    TEST_F(CriticalPathTest, StopCriticalPathAnalysis)
+    {
+        // Arrange
+        target->StartCriticalPathAnalysis();
+        target->Setup();
+        ExecuteRounds(1);
+
+        // Act
+        auto report = target->GetCriticalPathReport();
+        target->StopCriticalPathAnalysis();
+        ExecuteRounds(1);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(1ULL, report.numberOfTicks);
+        ASSERT_THROW(target->GetCriticalPathReport(), std::logic_error);
+    }
+}
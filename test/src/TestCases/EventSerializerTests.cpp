@@ -0,0 +1,231 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AccessorFramework/EventSerializer.h>
+
+namespace EventSerializerTests
+{
+    struct Reading
+    {
+        int sensor;
+        double value;
+    };
+
+    struct PointV1
+    {
+        int x;
+        int y;
+    };
+
+    struct Point
+    {
+        int x;
+        int y;
+        int z;
+    };
+
+    // Has the same type ID as Reading
+    struct OtherReading
+    {
+        int sensor;
+    };
+}
+
+template<> struct EventTypeId<EventSerializerTests::Reading> : std::integral_constant<IEvent::TypeId, 2> {};
+template<> struct EventTypeId<EventSerializerTests::OtherReading> : std::integral_constant<IEvent::TypeId, 2> {};
+template<> struct EventTypeId<std::vector<double>> : std::integral_constant<IEvent::TypeId, 4> {};
+template<> struct EventTypeId<std::map<std::string, std::vector<int>>> : std::integral_constant<IEvent::TypeId, 5> {};
+template<> struct EventTypeId<EventSerializerTests::PointV1> : std::integral_constant<IEvent::TypeId, 6> {};
+template<> struct EventTypeId<EventSerializerTests::Point> : std::integral_constant<IEvent::TypeId, 6> {};
+
+namespace EventSerializerTests
+{
+    class EventSerializerTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->target = std::make_unique<EventSerializer>();
+            this->target->Register<int>();
+            this->target->Register<Reading>();
+            this->target->Register<std::string>();
+            this->target->Register<std::vector<double>>();
+            this->target->Register<std::map<std::string, std::vector<int>>>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+        }
+
+        template<class T>
+        T RoundTrip(const T& payload)
+        {
+            std::vector<unsigned char> buffer;
+            this->target->Serialize(Event<T>(payload), buffer);
+            std::shared_ptr<IEvent> event = this->target->Deserialize(buffer.data(), buffer.size());
+            EXPECT_NE(nullptr, event);
+            EXPECT_EQ(EventTypeId<T>::value, event->GetTypeId());
+            return static_cast<Event<T>*>(event.get())->payload;
+        }
+
+        std::unique_ptr<EventSerializer> target = nullptr;
+    };
+
+    TEST_F(EventSerializerTest, RoundTripsPayloads)
+    {
+        // Arrange
+        Reading reading{ 7, 2.5 };
+        std::vector<double> values{ 1.0, 2.0, 3.0 };
+        std::map<std::string, std::vector<int>> groups{ { "a", { 1, 2 } }, { "b", {} } };
+
+        // Act and Assert
+        ASSERT_EQ(42, RoundTrip(42));
+        ASSERT_EQ(7, RoundTrip(reading).sensor);
+        ASSERT_EQ(2.5, RoundTrip(reading).value);
+        ASSERT_EQ(std::string("hello"), RoundTrip(std::string("hello")));
+        ASSERT_EQ(values, RoundTrip(values));
+        ASSERT_EQ(groups, RoundTrip(groups));
+    }
+
+    TEST_F(EventSerializerTest, ReadsRecordsOneAfterAnother)
+    {
+        // Arrange
+        std::vector<unsigned char> buffer;
+        size_t firstSize = target->Serialize(Event<std::string>("abc"), buffer);
+        size_t secondSize = target->Serialize(Event<int>(5), buffer);
+        ByteReader reader(buffer.data(), buffer.size());
+
+        // Act
+        auto first = target->Deserialize(reader);
+        auto second = target->Deserialize(reader);
+        auto third = target->Deserialize(reader);
+
+        // Assert
+        ASSERT_EQ(0U, firstSize % 8);
+        ASSERT_EQ(buffer.size(), firstSize + secondSize);
+        ASSERT_EQ(std::string("abc"), static_cast<Event<std::string>*>(first.get())->payload);
+        ASSERT_EQ(5, static_cast<Event<int>*>(second.get())->payload);
+        ASSERT_EQ(nullptr, third);
+        ASSERT_EQ(0U, reader.GetRemainingSize());
+    }
+
+    TEST_F(EventSerializerTest, IdentifiesTypesByDeclaredIds)
+    {
+        // Arrange
+        std::vector<unsigned char> buffer;
+        IEvent::TypeId serializedTypeId = 0;
+
+        // Act
+        target->Serialize(Event<Reading>({ 1, 2.0 }), buffer);
+        std::memcpy(&serializedTypeId, buffer.data(), sizeof(serializedTypeId));
+
+        // Assert
+        ASSERT_EQ(2U, serializedTypeId);
+        ASSERT_EQ(2U, Event<Reading>({ 1, 2.0 }).GetTypeId());
+        ASSERT_EQ(0U, IEvent().GetTypeId());
+    }
+
+    TEST_F(EventSerializerTest, RejectsInvalidBytes)
+    {
+        // Arrange
+        std::vector<unsigned char> buffer;
+        target->Serialize(Event<std::vector<double>>({ 1.0, 2.0 }), buffer);
+        std::vector<unsigned char> truncated(buffer.begin(), buffer.end() - 8);
+        std::vector<unsigned char> badCount = buffer;
+        badCount[16] = 0xff; // the vector's element count
+        std::vector<unsigned char> unknownTypeId = buffer;
+        unknownTypeId[0] = 99;
+        ByteReader reader(truncated.data(), truncated.size());
+
+        // Act and Assert
+        ASSERT_EQ(nullptr, target->Deserialize(reader));
+        ASSERT_EQ(truncated.size(), reader.GetRemainingSize());
+        ASSERT_EQ(nullptr, target->Deserialize(badCount.data(), badCount.size()));
+        ASSERT_EQ(nullptr, target->Deserialize(unknownTypeId.data(), unknownTypeId.size()));
+        ASSERT_EQ(nullptr, target->Deserialize(buffer.data(), 0));
+    }
+
+    TEST_F(EventSerializerTest, RejectsUnregisteredTypes)
+    {
+        // Arrange
+        std::vector<unsigned char> buffer;
+        Event<float> unregisteredEvent(1.0f);
+
+        // Act and Assert
+        ASSERT_FALSE(target->CanSerialize(unregisteredEvent));
+        ASSERT_FALSE(target->CanSerialize(IEvent()));
+        ASSERT_TRUE(target->CanSerialize(Event<int>(1)));
+        ASSERT_THROW(target->Serialize(unregisteredEvent, buffer), std::invalid_argument);
+        ASSERT_THROW(target->Register<OtherReading>(), std::invalid_argument);
+        ASSERT_THROW(target->Register<int>(2), std::invalid_argument);
+        ASSERT_TRUE(buffer.empty());
+    }
+
+    TEST_F(EventSerializerTest, ReadsOlderVersions)
+    {
+        // Arrange
+        EventSerializer oldSerializer;
+        oldSerializer.Register<PointV1>(1);
+        std::vector<unsigned char> buffer;
+        oldSerializer.Serialize(Event<PointV1>({ 1, 2 }), buffer);
+        EventSerializer newSerializer;
+        newSerializer.Register<Point>(2,
+            [](ByteReader& reader, uint32_t version, Point& payload)
+            {
+                PointV1 oldPayload{};
+                if (version != 1 || !Serializer<PointV1>::Read(reader, oldPayload))
+                {
+                    return false;
+                }
+
+                payload = { oldPayload.x, oldPayload.y, 0 };
+                return true;
+            });
+
+        // Act
+        auto event = newSerializer.Deserialize(buffer.data(), buffer.size());
+        std::vector<unsigned char> newBuffer;
+        newSerializer.Serialize(*event, newBuffer);
+
+        // Assert
+        ASSERT_NE(nullptr, event);
+        ASSERT_EQ(1, static_cast<Event<Point>*>(event.get())->payload.x);
+        ASSERT_EQ(2, static_cast<Event<Point>*>(event.get())->payload.y);
+        ASSERT_EQ(0, static_cast<Event<Point>*>(event.get())->payload.z);
+        ASSERT_EQ(nullptr, oldSerializer.Deserialize(newBuffer.data(), newBuffer.size())); // newer than it knows
+    }
+
+    TEST_F(EventSerializerTest, ViewsFlatPayloadsInPlace)
+    {
+        // Arrange
+        std::vector<unsigned char> buffer;
+        target->Serialize(Event<Reading>({ 3, 4.5 }), buffer);
+        size_t arrayOffset = buffer.size();
+        target->Serialize(Event<std::vector<double>>({ 1.0, 2.0, 3.0 }), buffer);
+
+        // Act
+        const Reading* reading = target->View<Reading>(buffer.data(), buffer.size());
+        ArrayView<double> values = target->ViewArray<double>(buffer.data() + arrayOffset, buffer.size() - arrayOffset);
+
+        // Assert
+        ASSERT_NE(nullptr, reading);
+        ASSERT_GT(reinterpret_cast<const unsigned char*>(reading), buffer.data());
+        ASSERT_LT(reinterpret_cast<const unsigned char*>(reading), buffer.data() + arrayOffset);
+        ASSERT_EQ(3, reading->sensor);
+        ASSERT_EQ(4.5, reading->value);
+        ASSERT_TRUE(values.IsValid());
+        ASSERT_EQ(3U, values.GetSize());
+        ASSERT_EQ(2.0, values[1]);
+        ASSERT_EQ(nullptr, target->View<int>(buffer.data(), buffer.size()));
+        ASSERT_FALSE(target->ViewArray<double>(buffer.data(), buffer.size()).IsValid());
+    }
+}
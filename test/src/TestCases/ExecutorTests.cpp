@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "WorkStealingThreadPool.h"
+#include "../TestClasses/EventLoopExecutor.h"
+#include "../TestClasses/SumVerifierHost.h"
+
+namespace ExecutorTests
+{
+    class ExecutorTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->latestSum = std::make_shared<int>(0);
+            this->error = std::make_shared<bool>(false);
+            this->executor = std::make_shared<EventLoopExecutor>();
+            this->target = std::make_unique<SumVerifierHost>(this->TargetName, this->latestSum, this->error);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->executor.reset();
+            this->latestSum.reset();
+            this->error.reset();
+        }
+
+        std::string TargetName = "TargetHost";
+        std::unique_ptr<SumVerifierHost> target = nullptr;
+        std::shared_ptr<EventLoopExecutor> executor = nullptr;
+        std::shared_ptr<int> latestSum = nullptr;
+        std::shared_ptr<bool> error = nullptr;
+    };
+
+    TEST_F(ExecutorTest, RunOnEventLoop)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto runInterval = 3500ms;
+        int expectedSum = (std::floor(std::chrono::duration<double>(runInterval).count()) - 1) * 2;
+
+        // Act
+        target->Setup();
+        target->Run(executor);
+        executor->RunFor(runInterval);
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(expectedSum, *latestSum);
+        ASSERT_LT(0, executor->GetNumberOfTasksRun());
+    }
+
+    TEST_F(ExecutorTest, NothingRunsUntilEventLoopRuns)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto waitInterval = 1500ms;
+
+        // Act
+        target->Setup();
+        target->Run(executor);
+        std::this_thread::sleep_for(waitInterval);
+        Host::State stateWhileWaiting = target->GetState();
+        int sumWhileWaiting = *latestSum;
+        executor->RunFor(waitInterval);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(Host::State::Running, stateWhileWaiting);
+        ASSERT_EQ(0, sumWhileWaiting);
+        ASSERT_LT(0, executor->GetNumberOfTasksRun());
+    }
+
+    TEST_F(ExecutorTest, PolledHostHandsNothingToExecutor)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto pollInterval = 3500ms;
+        int expectedSum = (std::floor(std::chrono::duration<double>(pollInterval).count()) - 1) * 2;
+        SumVerifierHost polledHost(TargetName, latestSum, error, executor);
+
+        // Act
+        polledHost.Setup();
+        polledHost.Poll(std::chrono::system_clock::now() + pollInterval);
+        polledHost.Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(expectedSum, *latestSum);
+        ASSERT_EQ(0, executor->GetNumberOfTasksQueued());
+    }
+
+    TEST(WorkStealingThreadPoolTest, CanceledDelayedTaskDoesNotRun)
+    {
+        // Arrange
+        WorkStealingThreadPool pool(2);
+        std::atomic_bool canceledTaskRan(false);
+        std::promise<void> laterTaskRan{};
+
+        // Act
+        unsigned long long taskId = pool.ExecuteCancelableAfter(50, [&canceledTaskRan]() { canceledTaskRan.store(true); });
+        pool.ExecuteAfter(100, [&laterTaskRan]() { laterTaskRan.set_value(); });
+        pool.Cancel(taskId);
+        std::future_status status = laterTaskRan.get_future().wait_for(std::chrono::seconds(5));
+
+        // Assert
+        ASSERT_NE(0ULL, taskId);
+        ASSERT_EQ(std::future_status::ready, status);
+        ASSERT_FALSE(canceledTaskRan.load());
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AccessorFramework/EventSerializer.h>
+#include <AccessorFramework/Host.h>
+#include <AccessorFramework/ReplaySource.h>
+#include "../TestClasses/CounterHost.h"
+#include "../TestClasses/SkippingCounterHost.h"
+#include "../TestClasses/WideHost.h"
+
+namespace FingerprintTests
+{
+    class FingerprintTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->serializer = std::make_shared<EventSerializer>();
+            this->serializer->Register<int>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->serializer.reset();
+        }
+
+        // Executes the given number of rounds without waiting for wall-clock time
+        static void PollRounds(Host& host, int numberOfRounds)
+        {
+            auto nextRoundTime = host.Poll(std::chrono::system_clock::time_point{});
+            for (int i = 0; i < numberOfRounds; ++i)
+            {
+                nextRoundTime = host.Poll(nextRoundTime);
+            }
+        }
+
+        static Host::FingerprintReport Fingerprint(Host& host, std::shared_ptr<const EventSerializer> hostSerializer, int numberOfRounds)
+        {
+            host.StartFingerprinting(hostSerializer);
+            host.Setup();
+            PollRounds(host, numberOfRounds);
+            host.StopFingerprinting();
+            return host.GetFingerprintReport();
+        }
+
+        int CounterIntervalInMilliseconds = 100;
+        std::shared_ptr<EventSerializer> serializer = nullptr;
+    };
+
+    TEST_F(FingerprintTest, IdenticalRunsMatch)
+    {
+        // Arrange
+        const int NumberOfRounds = 20;
+        CounterHost firstHost("CounterHost", CounterIntervalInMilliseconds);
+        CounterHost secondHost("CounterHost", CounterIntervalInMilliseconds);
+
+        // Act
+        Host::FingerprintReport firstReport = Fingerprint(firstHost, serializer, NumberOfRounds);
+        Host::FingerprintReport secondReport = Fingerprint(secondHost, serializer, NumberOfRounds);
+        size_t tickIndex = 0;
+        bool runsDiverge = Host::FindFirstDivergentTick(firstReport.ticks, secondReport.ticks, tickIndex);
+
+        // Assert
+        ASSERT_FALSE(firstReport.isFingerprinting);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfRounds), firstReport.numberOfTicks);
+        ASSERT_EQ(static_cast<size_t>(NumberOfRounds), firstReport.ticks.size());
+        for (int i = 0; i < NumberOfRounds; ++i)
+        {
+            ASSERT_EQ(static_cast<long long>((i + 1) * CounterIntervalInMilliseconds), firstReport.ticks[i].logicalTime);
+            ASSERT_EQ(1ULL, firstReport.ticks[i].numberOfEvents);
+        }
+
+        ASSERT_EQ(firstReport.ticks.back().hash, firstReport.hash);
+        ASSERT_EQ(firstReport.hash, secondReport.hash);
+        ASSERT_FALSE(runsDiverge);
+    }
+
+    TEST_F(FingerprintTest, FindsFirstDivergentTick)
+    {
+        // Arrange
+        const int NumberOfRounds = 10;
+        const int SkippedValue = 4;
+        CounterHost expectedHost("CounterHost", CounterIntervalInMilliseconds);
+        SkippingCounterHost actualHost("CounterHost", CounterIntervalInMilliseconds, SkippedValue);
+
+        // Act
+        Host::FingerprintReport expectedReport = Fingerprint(expectedHost, serializer, NumberOfRounds);
+        Host::FingerprintReport actualReport = Fingerprint(actualHost, serializer, NumberOfRounds);
+        size_t tickIndex = 0;
+        bool runsDiverge = Host::FindFirstDivergentTick(expectedReport.ticks, actualReport.ticks, tickIndex);
+
+        // Assert
+        ASSERT_TRUE(runsDiverge);
+        ASSERT_EQ(static_cast<size_t>(SkippedValue), tickIndex);
+        for (int i = SkippedValue; i < NumberOfRounds; ++i)
+        {
+            ASSERT_NE(expectedReport.ticks[i].hash, actualReport.ticks[i].hash);
+        }
+    }
+
+    TEST_F(FingerprintTest, OnlyHashesEventsTheSerializerKnows)
+    {
+        // Arrange
+        const int NumberOfRounds = 10;
+        CounterHost expectedHost("CounterHost", CounterIntervalInMilliseconds);
+        SkippingCounterHost actualHost("CounterHost", CounterIntervalInMilliseconds, 4);
+
+        // Act
+        Host::FingerprintReport expectedReport = Fingerprint(expectedHost, nullptr, NumberOfRounds);
+        Host::FingerprintReport actualReport = Fingerprint(actualHost, nullptr, NumberOfRounds);
+
+        // Assert
+        ASSERT_EQ(expectedReport.hash, actualReport.hash);
+    }
+
+    TEST_F(FingerprintTest, FindsShorterRunThatMatches)
+    {
+        // Arrange
+        CounterHost host("CounterHost", CounterIntervalInMilliseconds);
+        Host::FingerprintReport report = Fingerprint(host, serializer, 10);
+        std::vector<Host::FingerprintTick> shorterRun(report.ticks.begin(), report.ticks.begin() + 6);
+
+        // Act
+        size_t tickIndex = 0;
+        bool runsDiverge = Host::FindFirstDivergentTick(report.ticks, shorterRun, tickIndex);
+
+        // Assert
+        ASSERT_TRUE(runsDiverge);
+        ASSERT_EQ(6U, tickIndex);
+    }
+
+    TEST_F(FingerprintTest, ParallelReactionsMatchSequentialReactions)
+    {
+        // Arrange
+        const int NumberOfRounds = 10;
+        const int NumberOfLanes = 8;
+        std::vector<std::shared_ptr<std::vector<int>>> sequentialValues{};
+        std::vector<std::shared_ptr<std::vector<int>>> parallelValues{};
+        for (int i = 0; i < NumberOfLanes; ++i)
+        {
+            sequentialValues.push_back(std::make_shared<std::vector<int>>());
+            parallelValues.push_back(std::make_shared<std::vector<int>>());
+        }
+
+        WideHost sequentialHost("WideHost", 4, CounterIntervalInMilliseconds, sequentialValues);
+        WideHost parallelHost("WideHost", 4, CounterIntervalInMilliseconds, parallelValues);
+        parallelHost.EnableParallelReactions(4);
+
+        // Act
+        Host::FingerprintReport sequentialReport = Fingerprint(sequentialHost, serializer, NumberOfRounds);
+        Host::FingerprintReport parallelReport = Fingerprint(parallelHost, serializer, NumberOfRounds);
+        size_t tickIndex = 0;
+        bool runsDiverge = Host::FindFirstDivergentTick(sequentialReport.ticks, parallelReport.ticks, tickIndex);
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfRounds), sequentialValues[0]->size());
+        ASSERT_FALSE(runsDiverge);
+        ASSERT_EQ(sequentialReport.hash, parallelReport.hash);
+    }
+
+    TEST_F(FingerprintTest, FingerprintIsRecorded)
+    {
+        // Arrange
+        const int NumberOfRounds = 10;
+        std::string filePath = ::testing::TempDir() + "FingerprintIsRecorded.rec";
+        CounterHost host("CounterHost", CounterIntervalInMilliseconds);
+        host.StartRecording(filePath, serializer);
+
+        // Act
+        Host::FingerprintReport report = Fingerprint(host, serializer, NumberOfRounds);
+        host.StopRecording();
+        std::vector<Host::FingerprintTick> recordedTicks = ReplaySource::GetFingerprint(filePath);
+        size_t tickIndex = 0;
+        bool runsDiverge = Host::FindFirstDivergentTick(report.ticks, recordedTicks, tickIndex);
+        std::remove(filePath.c_str());
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfRounds), recordedTicks.size());
+        ASSERT_FALSE(runsDiverge);
+    }
+
+    TEST_F(FingerprintTest, StartWhileRunningThrows)
+    {
+        // Arrange
+        CounterHost host("CounterHost", CounterIntervalInMilliseconds);
+        host.Setup();
+        host.Run();
+
+        // Act and Assert
+        ASSERT_THROW(host.StartFingerprinting(serializer), std::logic_error);
+        host.Exit();
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace GraphExportTests
+{
+    class GraphExportTest : public SumVerifierHostTest
+    {
+    protected:
+        static bool Contains(const std::string& text, const std::string& value)
+        {
+            return (text.find(value) != std::string::npos);
+        }
+    };
+
+    TEST_F(GraphExportTest, ExportDot)
+    {
+        // Arrange
+        target->Setup();
+        std::ostringstream dot{};
+
+        // Act
+        target->ExportGraph(dot, Host::GraphFormat::Dot);
+        target->Exit();
+
+        // Assert
+        std::string graph = dot.str();
+        ASSERT_EQ(0U, graph.find("digraph \"TargetHost\" {"));
+        ASSERT_TRUE(Contains(graph, "subgraph \"cluster_a0\""));
+        ASSERT_TRUE(Contains(graph, "IntegerAdder\\npriority\\ "));
+        ASSERT_TRUE(Contains(graph, "\"a3\":o0 -> \"a4\":i0;"));
+    }
+
+    TEST_F(GraphExportTest, ExportJsonWithTraffic)
+    {
+        // Arrange
+        const int NumberOfRounds = 5;
+        target->Setup();
+        pollTime += std::chrono::seconds(NumberOfRounds);
+        target->Poll(pollTime);
+        std::ostringstream json{};
+
+        // Act
+        target->ExportGraph(json, Host::GraphFormat::Json, true);
+        target->Exit();
+
+        // Assert
+        std::string graph = json.str();
+        ASSERT_FALSE(*error);
+        ASSERT_TRUE(Contains(graph, "{\"name\":\".TargetHost\",\"parent\":null,\"composite\":true,"));
+        ASSERT_TRUE(Contains(graph, "{\"name\":\".TargetHost.IntegerAdder\",\"parent\":\".TargetHost\",\"composite\":false,\"priority\":"));
+        ASSERT_TRUE(Contains(graph, "\"source\":\".TargetHost.IntegerAdder.SumOutput\",\"destination\":\".TargetHost.SumVerifier.Sum\",\"events\":"));
+        ASSERT_FALSE(Contains(graph, "\"events\":0}"));
+    }
+
+    TEST_F(GraphExportTest, ExportFromSeveralThreadsWhilePolling)
+    {
+        // Arrange
+        const int NumberOfThreads = 4;
+        const int ExportsPerThread = 20;
+        target->Setup();
+        std::ostringstream expectedDot{};
+        target->ExportGraph(expectedDot, Host::GraphFormat::Dot);
+        std::vector<std::vector<std::string>> graphs(NumberOfThreads);
+        std::vector<std::thread> exportingThreads{};
+
+        // Act
+        for (int i = 0; i < NumberOfThreads; ++i)
+        {
+            exportingThreads.emplace_back(
+                [this, i, ExportsPerThread, &graphs]()
+                {
+                    for (int j = 0; j < ExportsPerThread; ++j)
+                    {
+                        std::ostringstream dot{};
+                        target->ExportGraph(dot, Host::GraphFormat::Dot);
+                        graphs[i].push_back(dot.str());
+                    }
+                });
+        }
+
+        ExecuteThreeRounds();
+        for (auto& exportingThread : exportingThreads)
+        {
+            exportingThread.join();
+        }
+
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        for (const auto& threadGraphs : graphs)
+        {
+            ASSERT_EQ(static_cast<size_t>(ExportsPerThread), threadGraphs.size());
+            for (const std::string& graph : threadGraphs)
+            {
+                ASSERT_EQ(expectedDot.str(), graph);
+            }
+        }
+    }
+
+    TEST_F(GraphExportTest, CannotExportBeforeSetup)
+    {
+        // Arrange
+        std::ostringstream dot{};
+
+        // Act/Assert
+        ASSERT_THROW(target->ExportGraph(dot, Host::GraphFormat::Dot), std::logic_error);
+    }
+}
@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/CollectorHost.h"
+#include "../TestClasses/CounterHost.h"
+#include "../TestClasses/SumVerifierHost.h"
+
+namespace HostChannelTests
+{
+    class HostChannelTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->receivedValues = std::make_shared<std::vector<int>>();
+            auto counterHost = std::make_unique<CounterHost>("CounterHost", CounterIntervalInMilliseconds);
+            auto collectorHost = std::make_unique<CollectorHost>("CollectorHost", this->receivedValues);
+            this->counterHost = counterHost.get();
+            this->collectorHost = collectorHost.get();
+            this->target = std::make_unique<HostHypervisor>();
+            this->counterHostId = this->target->AddHost(std::move(counterHost));
+            this->collectorHostId = this->target->AddHost(std::move(collectorHost));
+            this->pollTime = std::chrono::system_clock::now() + std::chrono::milliseconds(CounterIntervalInMilliseconds / 2);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->receivedValues.reset();
+        }
+
+        int Connect(size_t capacity = 1024)
+        {
+            return this->target->ConnectHosts(this->counterHostId, CounterOutputName, this->collectorHostId, CollectorInputName, capacity);
+        }
+
+        // The counter sends on its next few rounds, which the collector receives once its logical time reaches them
+        void PollBothHosts(int numberOfCounts)
+        {
+            this->pollTime += std::chrono::milliseconds(numberOfCounts * CounterIntervalInMilliseconds);
+            this->counterHost->Poll(this->pollTime);
+            this->collectorHost->Poll(this->pollTime + std::chrono::milliseconds(CounterIntervalInMilliseconds));
+        }
+
+        int CounterIntervalInMilliseconds = 100;
+        std::string CounterOutputName = ".CounterHost.Counter.CounterValue";
+        std::string CollectorInputName = ".CollectorHost.Collector.Input";
+        std::unique_ptr<HostHypervisor> target = nullptr;
+        CounterHost* counterHost = nullptr;
+        CollectorHost* collectorHost = nullptr;
+        int counterHostId = -1;
+        int collectorHostId = -1;
+        std::shared_ptr<std::vector<int>> receivedValues = nullptr;
+        std::chrono::system_clock::time_point pollTime{};
+    };
+
+    TEST_F(HostChannelTest, DeliversEventsInOrder)
+    {
+        // Arrange
+        const int NumberOfCounts = 20;
+        int channelId = Connect();
+        target->SetupHosts();
+
+        // Act
+        PollBothHosts(NumberOfCounts);
+        auto channels = target->GetChannels();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), receivedValues->size());
+        for (int i = 0; i < NumberOfCounts; ++i)
+        {
+            ASSERT_EQ(i, receivedValues->at(i));
+        }
+
+        ASSERT_EQ(1U, channels.size());
+        ASSERT_EQ(channelId, channels[0].id);
+        ASSERT_EQ(counterHostId, channels[0].sourceHostId);
+        ASSERT_EQ(CounterOutputName, channels[0].outputPortName);
+        ASSERT_EQ(collectorHostId, channels[0].destinationHostId);
+        ASSERT_EQ(CollectorInputName, channels[0].inputPortName);
+        ASSERT_EQ(1024U, channels[0].capacity);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), channels[0].numberOfEventsSent);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), channels[0].numberOfEventsReceived);
+        ASSERT_EQ(0ULL, channels[0].numberOfEventsDropped);
+        ASSERT_LE(0LL, channels[0].maxLogicalLatency);
+    }
+
+    TEST_F(HostChannelTest, DropsEventsWhileFull)
+    {
+        // Arrange
+        const int NumberOfCounts = 10;
+        Connect(3);
+        target->SetupHosts();
+
+        // Act
+        PollBothHosts(NumberOfCounts);
+        auto channels = target->GetChannels();
+
+        // Assert
+        ASSERT_EQ(4U, channels[0].capacity);
+        ASSERT_EQ(4U, receivedValues->size());
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_EQ(i, receivedValues->at(i));
+        }
+
+        ASSERT_EQ(4ULL, channels[0].numberOfEventsSent);
+        ASSERT_EQ(4ULL, channels[0].numberOfEventsReceived);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts - 4), channels[0].numberOfEventsDropped);
+    }
+
+    TEST_F(HostChannelTest, DisconnectHosts)
+    {
+        // Arrange
+        int channelId = Connect();
+        target->SetupHosts();
+        PollBothHosts(5);
+
+        // Act
+        target->DisconnectHosts(channelId);
+        PollBothHosts(5);
+
+        // Assert
+        ASSERT_EQ(5U, receivedValues->size());
+        ASSERT_TRUE(target->GetChannels().empty());
+    }
+
+    TEST_F(HostChannelTest, RemoveHost)
+    {
+        // Arrange
+        Connect();
+        target->SetupHosts();
+        PollBothHosts(5);
+
+        // Act
+        target->RemoveHost(counterHostId);
+        collectorHost->Poll(pollTime + std::chrono::seconds(1));
+
+        // Assert
+        ASSERT_EQ(5U, receivedValues->size());
+        ASSERT_TRUE(target->GetChannels().empty());
+    }
+
+    TEST_F(HostChannelTest, RunHostsOnSharedThreadPool)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        Connect();
+        target->SetupHosts();
+
+        // Act
+        target->RunHosts();
+        std::this_thread::sleep_for(300ms);
+        target->PauseHosts();
+        auto channels = target->GetChannels();
+
+        // Assert
+        ASSERT_LT(0U, receivedValues->size());
+        for (size_t i = 0; i < receivedValues->size(); ++i)
+        {
+            ASSERT_EQ(static_cast<int>(i), receivedValues->at(i));
+        }
+
+        ASSERT_EQ(static_cast<unsigned long long>(receivedValues->size()), channels[0].numberOfEventsReceived);
+        ASSERT_LE(channels[0].numberOfEventsReceived, channels[0].numberOfEventsSent);
+        ASSERT_EQ(0ULL, channels[0].numberOfEventsDropped);
+    }
+
+    TEST_F(HostChannelTest, SenderWakesIdleReceiver)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        // The collector schedules nothing and the channel is not polled, so it only runs when the counter wakes it
+        Connect();
+        target->SetupHosts();
+
+        // Act
+        target->RunHosts();
+        std::this_thread::sleep_for(550ms);
+        target->PauseHosts();
+        auto channels = target->GetChannels();
+
+        // Assert
+        ASSERT_LE(3U, receivedValues->size());
+        ASSERT_LE(channels[0].numberOfEventsSent, channels[0].numberOfEventsReceived + 1);
+        ASSERT_GT(CounterIntervalInMilliseconds, channels[0].maxLogicalLatency);
+    }
+
+    TEST_F(HostChannelTest, ConnectHostsValidatesPorts)
+    {
+        // Arrange
+        auto latestSum = std::make_shared<int>(0);
+        auto error = std::make_shared<bool>(false);
+        int sumVerifierHostId = target->AddHost(std::make_unique<SumVerifierHost>("SumVerifierHost", latestSum, error));
+        target->SetupHost(sumVerifierHostId);
+
+        // Act and Assert
+        ASSERT_THROW(target->ConnectHosts(counterHostId, ".CounterHost.Counter.Missing", collectorHostId, CollectorInputName), std::invalid_argument);
+        ASSERT_THROW(target->ConnectHosts(counterHostId, CounterOutputName, collectorHostId, ".CollectorHost.Collector.Missing"), std::invalid_argument);
+        ASSERT_THROW(target->ConnectHosts(counterHostId, CounterOutputName, counterHostId, CollectorInputName), std::invalid_argument);
+        ASSERT_THROW(target->ConnectHosts(counterHostId, CounterOutputName, collectorHostId, CollectorInputName, 0), std::invalid_argument);
+        ASSERT_THROW(target->ConnectHosts(counterHostId, CounterOutputName, sumVerifierHostId, ".SumVerifierHost.SumVerifier.Sum"), std::invalid_argument);
+        Connect();
+        ASSERT_THROW(Connect(), std::invalid_argument);
+        ASSERT_EQ(1U, target->GetChannels().size());
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/SumVerifierHost.h"
+
+namespace HostHypervisorTests
+{
+    class HostHypervisorTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->target = std::make_unique<HostHypervisor>();
+            for (int i = 0; i < NumberOfHosts; ++i)
+            {
+                this->latestSums.push_back(std::make_shared<int>(0));
+                this->errors.push_back(std::make_shared<bool>(false));
+                std::string hostName = "Host" + std::to_string(i);
+                this->hostIds.push_back(this->target->AddHost(std::make_unique<SumVerifierHost>(hostName, this->latestSums.back(), this->errors.back())));
+            }
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->hostIds.clear();
+            this->latestSums.clear();
+            this->errors.clear();
+        }
+
+        static const int NumberOfHosts = 4;
+        std::unique_ptr<HostHypervisor> target = nullptr;
+        std::vector<int> hostIds;
+        std::vector<std::shared_ptr<int>> latestSums;
+        std::vector<std::shared_ptr<bool>> errors;
+    };
+
+    TEST_F(HostHypervisorTest, GetHostNames)
+    {
+        // Act
+        auto hostNames = target->GetHostNames();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfHosts), hostNames.size());
+        for (int i = 0; i < NumberOfHosts; ++i)
+        {
+            ASSERT_EQ("Host" + std::to_string(i), hostNames.at(hostIds[i]));
+        }
+    }
+
+    TEST_F(HostHypervisorTest, RunHostsOnSharedThreadPool)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto sleepInterval = 3.5s;
+        int expectedSum = (std::floor(sleepInterval.count()) - 1) * 2;
+
+        // Act
+        target->SetupHosts();
+        target->RunHosts();
+        auto runningStates = target->GetHostStates();
+        std::this_thread::sleep_for(sleepInterval);
+        target->PauseHosts();
+        auto pausedStates = target->GetHostStates();
+
+        // Assert
+        for (int i = 0; i < NumberOfHosts; ++i)
+        {
+            ASSERT_EQ(Host::State::Running, runningStates.at(hostIds[i]));
+            ASSERT_EQ(Host::State::Paused, pausedStates.at(hostIds[i]));
+            ASSERT_FALSE(*errors[i]);
+            ASSERT_EQ(expectedSum, *latestSums[i]);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "../TestClasses/EventLoopExecutor.h"
+#include "../TestClasses/PipeReaderHost.h"
+
+namespace IOAccessorTests
+{
+    class IOAccessorTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->receivedValues = std::make_shared<std::vector<int>>();
+            this->target = std::make_unique<PipeReaderHost>(this->TargetName, this->receivedValues);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->receivedValues.reset();
+        }
+
+        std::string TargetName = "TargetHost";
+        std::unique_ptr<PipeReaderHost> target = nullptr;
+        std::shared_ptr<std::vector<int>> receivedValues = nullptr;
+    };
+
+    TEST_F(IOAccessorTest, ReadFromPipe)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        std::vector<int> expectedValues = { 1, 2, 3, 5, 8, 13 };
+
+        // Act
+        target->Setup();
+        target->Run();
+        for (int value : expectedValues)
+        {
+            target->GetReader()->Write(value);
+            std::this_thread::sleep_for(10ms);
+        }
+
+        std::this_thread::sleep_for(100ms);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(expectedValues, *receivedValues);
+    }
+
+    TEST_F(IOAccessorTest, NothingIsReadWhilePaused)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        std::vector<int> expectedValues = { 4, 7 };
+
+        // Act
+        target->Setup();
+        target->GetReader()->Write(4);
+        std::this_thread::sleep_for(100ms);
+        size_t numberOfValuesBeforeRunning = receivedValues->size();
+        target->Run();
+        std::this_thread::sleep_for(100ms);
+        target->Pause();
+        target->GetReader()->Write(7);
+        std::this_thread::sleep_for(100ms);
+        size_t numberOfValuesWhilePaused = receivedValues->size();
+        target->Run();
+        std::this_thread::sleep_for(100ms);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(0U, numberOfValuesBeforeRunning);
+        ASSERT_EQ(1U, numberOfValuesWhilePaused);
+        ASSERT_EQ(expectedValues, *receivedValues);
+    }
+
+    TEST_F(IOAccessorTest, StopWatchingOnHangUp)
+    {
+        using namespace std::chrono_literals;
+
+        // Act
+        target->Setup();
+        target->Run();
+        target->GetReader()->Write(42);
+        target->GetReader()->CloseWriteEnd();
+        std::this_thread::sleep_for(100ms);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(std::vector<int>{ 42 }, *receivedValues);
+    }
+
+    TEST_F(IOAccessorTest, TimersRunOnIOLoop)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        target = std::make_unique<PipeReaderHost>(TargetName, receivedValues, 100 /*counterIntervalInMilliseconds*/);
+
+        // Act
+        target->Setup();
+        target->Run();
+        std::this_thread::sleep_for(550ms);
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ((std::vector<int>{ 0, 1, 2, 3, 4 }), *receivedValues);
+    }
+
+    TEST_F(IOAccessorTest, CannotChangeExecutorOrPoll)
+    {
+        // Arrange
+        auto executor = std::make_shared<EventLoopExecutor>();
+
+        // Act
+        target->Setup();
+
+        // Assert
+        ASSERT_THROW(target->Run(executor), std::logic_error);
+        ASSERT_THROW(target->Poll(), std::logic_error);
+    }
+}
+
+#endif // __linux__
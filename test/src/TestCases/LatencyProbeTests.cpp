@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/BurstHost.h"
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace LatencyProbeTests
+{
+    class LatencyProbeTest : public SumVerifierHostTest
+    {
+    protected:
+        std::string CounterOutputName = ".TargetHost.SpontaneousCounterOne.CounterValue";
+        std::string VerifierInputName = ".TargetHost.SumVerifier.Sum";
+    };
+
+    TEST_F(LatencyProbeTest, MeasureLatencyThroughIntermediateAccessor)
+    {
+        // Arrange
+        target->Setup();
+        int probeId = target->AddLatencyProbe(CounterOutputName, VerifierInputName);
+
+        // Act
+        ExecuteThreeRounds();
+        auto probes = target->GetLatencyProbes();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(1U, probes.size());
+        ASSERT_EQ(probeId, probes.at(0).id);
+        ASSERT_EQ(CounterOutputName, probes.at(0).outputPortName);
+        ASSERT_EQ(VerifierInputName, probes.at(0).inputPortName);
+        const auto& wallClockLatency = probes.at(0).wallClockLatency;
+        ASSERT_EQ(3ULL, wallClockLatency.count);
+        ASSERT_LT(0, wallClockLatency.max.count());
+        ASSERT_LE(wallClockLatency.min, wallClockLatency.p50);
+        ASSERT_LE(wallClockLatency.p50, wallClockLatency.p90);
+        ASSERT_LE(wallClockLatency.p99, wallClockLatency.p999);
+        ASSERT_LE(wallClockLatency.p999, wallClockLatency.max);
+
+        // Events are delivered in the same round in which they are sent
+        const auto& logicalLatency = probes.at(0).logicalLatency;
+        ASSERT_EQ(3ULL, logicalLatency.count);
+        ASSERT_EQ(0, logicalLatency.max.count());
+    }
+
+    TEST_F(LatencyProbeTest, MeasureEveryQueuedSend)
+    {
+        // Arrange
+        const int BurstSize = 3;
+        auto receivedValues = std::make_shared<std::vector<int>>();
+        BurstHost burstHost("BurstHost", BurstSize, receivedValues);
+        burstHost.Setup();
+        burstHost.AddLatencyProbe(".BurstHost.BurstCounter.CounterValue", ".BurstHost.Collector.Input");
+
+        // Act: execute two rounds without waiting for wall-clock time
+        auto nextExecutionTime = burstHost.Poll(std::chrono::system_clock::time_point{});
+        nextExecutionTime = burstHost.Poll(nextExecutionTime);
+        burstHost.Poll(nextExecutionTime);
+        auto probes = burstHost.GetLatencyProbes();
+        burstHost.Exit();
+
+        // Assert
+        // Every send of a burst waits on the relay's input port, and each one is measured against its own stamp
+        ASSERT_EQ(static_cast<size_t>(2 * BurstSize), receivedValues->size());
+        ASSERT_EQ(1U, probes.size());
+        ASSERT_EQ(static_cast<unsigned long long>(2 * BurstSize), probes.at(0).wallClockLatency.count);
+        ASSERT_EQ(static_cast<unsigned long long>(2 * BurstSize), probes.at(0).logicalLatency.count);
+        ASSERT_EQ(0, probes.at(0).logicalLatency.max.count());
+        ASSERT_EQ(0ULL, probes.at(0).numberOfDroppedSamples);
+    }
+
+    TEST_F(LatencyProbeTest, CountSamplesThatCannotBePaired)
+    {
+        // Arrange
+        // The probe holds 256 stamps, so the last sends of a burst of 300 are not stamped, and their arrivals find no
+        // stamp waiting
+        const int BurstSize = 300;
+        const int NumberOfUnpairedSends = BurstSize - 256;
+        auto receivedValues = std::make_shared<std::vector<int>>();
+        BurstHost burstHost("BurstHost", BurstSize, receivedValues);
+        burstHost.Setup();
+        burstHost.AddLatencyProbe(".BurstHost.BurstCounter.CounterValue", ".BurstHost.Collector.Input");
+
+        // Act
+        auto nextExecutionTime = burstHost.Poll(std::chrono::system_clock::time_point{});
+        burstHost.Poll(nextExecutionTime);
+        auto probes = burstHost.GetLatencyProbes();
+        burstHost.Exit();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(BurstSize), receivedValues->size());
+        ASSERT_EQ(1U, probes.size());
+        ASSERT_EQ(static_cast<unsigned long long>(BurstSize - NumberOfUnpairedSends), probes.at(0).wallClockLatency.count);
+        ASSERT_EQ(static_cast<unsigned long long>(2 * NumberOfUnpairedSends), probes.at(0).numberOfDroppedSamples);
+    }
+
+    TEST_F(LatencyProbeTest, ResetAndRemoveProbes)
+    {
+        // Arrange
+        target->Setup();
+        int firstProbeId = target->AddLatencyProbe(CounterOutputName, VerifierInputName);
+        int secondProbeId = target->AddLatencyProbe(".TargetHost.IntegerAdder.SumOutput", VerifierInputName);
+        ExecuteThreeRounds();
+
+        // Act
+        target->ResetLatencyProbes();
+        auto resetProbes = target->GetLatencyProbes();
+        target->RemoveLatencyProbe(firstProbeId);
+        ExecuteThreeRounds();
+        auto remainingProbes = target->GetLatencyProbes();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(2U, resetProbes.size());
+        for (const auto& probe : resetProbes)
+        {
+            ASSERT_EQ(0ULL, probe.wallClockLatency.count);
+            ASSERT_EQ(0ULL, probe.logicalLatency.count);
+            ASSERT_EQ(0ULL, probe.numberOfDroppedSamples);
+        }
+
+        ASSERT_EQ(1U, remainingProbes.size());
+        ASSERT_EQ(secondProbeId, remainingProbes.at(0).id);
+        ASSERT_EQ(3ULL, remainingProbes.at(0).wallClockLatency.count);
+    }
+
+    TEST_F(LatencyProbeTest, RejectInvalidPorts)
+    {
+        // Arrange
+        target->Setup();
+
+        // Act and Assert
+        ASSERT_THROW(target->AddLatencyProbe(".TargetHost.NoSuchAccessor.CounterValue", VerifierInputName), std::invalid_argument);
+        ASSERT_THROW(target->AddLatencyProbe(CounterOutputName, ".TargetHost.SumVerifier.NoSuchPort"), std::invalid_argument);
+        ASSERT_THROW(target->AddLatencyProbe(VerifierInputName, CounterOutputName), std::invalid_argument);
+        ASSERT_THROW(target->AddLatencyProbe(CounterOutputName, ".TargetHost.IntegerAdder.RightInput"), std::invalid_argument);
+        ASSERT_TRUE(target->GetLatencyProbes().empty());
+    }
+}
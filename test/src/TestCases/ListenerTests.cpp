@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/CounterHost.h"
+#include "../TestClasses/EmptyHost.h"
+#include "../TestClasses/EventLoopExecutor.h"
+#include "../TestClasses/OffloadHost.h"
+#include "../TestClasses/RecordingListener.h"
+
+namespace ListenerTests
+{
+    using StateChange = std::pair<Host::State, Host::State>;
+
+    class ListenerTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->listener = std::make_shared<RecordingListener>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->listener->Release();
+            this->listener.reset();
+        }
+
+        const std::vector<StateChange> HostLifetime = {
+            { Host::State::NeedsSetup, Host::State::SettingUp },
+            { Host::State::SettingUp, Host::State::ReadyToRun },
+            { Host::State::ReadyToRun, Host::State::Running },
+            { Host::State::Running, Host::State::Paused },
+            { Host::State::Paused, Host::State::Exiting },
+            { Host::State::Exiting, Host::State::Finished }
+        };
+
+        std::shared_ptr<RecordingListener> listener = nullptr;
+    };
+
+    TEST_F(ListenerTest, NotifiesInOrderOnAnotherThread)
+    {
+        // Arrange
+        CounterHost host("CounterHost", 10);
+        host.AddEventListener(listener);
+
+        // Act
+        host.Setup();
+        host.Iterate(2);
+        host.Exit();
+        host.WaitForEventListeners();
+        Host::ListenerMetrics metrics = host.GetListenerMetrics();
+
+        // Assert
+        ASSERT_EQ(HostLifetime, listener->GetStateChanges());
+        for (std::thread::id threadId : listener->GetThreadIds())
+        {
+            ASSERT_NE(std::this_thread::get_id(), threadId);
+        }
+
+        ASSERT_EQ(6ULL, metrics.numberOfNotificationsPosted);
+        ASSERT_EQ(6ULL, metrics.numberOfNotificationsDelivered);
+        ASSERT_EQ(0ULL, metrics.numberOfNotificationsDropped);
+        ASSERT_EQ(256U, metrics.queueCapacity);
+    }
+
+    TEST_F(ListenerTest, SlowListenerDoesNotHoldUpHost)
+    {
+        // Arrange
+        CounterHost host("CounterHost", 10);
+        host.AddEventListener(listener);
+        listener->Hold();
+
+        // Act
+        host.Setup();
+        host.Iterate(2);
+        host.Exit();
+        std::vector<StateChange> stateChangesWhileHeld = listener->GetStateChanges();
+        listener->Release();
+        host.WaitForEventListeners();
+
+        // Assert
+        ASSERT_TRUE(stateChangesWhileHeld.empty());
+        ASSERT_EQ(HostLifetime, listener->GetStateChanges());
+    }
+
+    TEST_F(ListenerTest, DropsNotificationsWhileQueueIsFull)
+    {
+        // Arrange
+        const unsigned long long NumberOfRuns = 200;
+        EmptyHost host("EmptyHost");
+        host.AddEventListener(listener);
+        listener->Hold();
+        host.Setup();
+
+        // Act
+        for (unsigned long long i = 0; i < NumberOfRuns; ++i)
+        {
+            host.Run();
+            host.Pause();
+        }
+
+        listener->Release();
+        host.WaitForEventListeners();
+        Host::ListenerMetrics metrics = host.GetListenerMetrics();
+        std::vector<StateChange> stateChanges = listener->GetStateChanges();
+
+        // Assert
+        ASSERT_EQ(2 + 2 * NumberOfRuns, metrics.numberOfNotificationsPosted + metrics.numberOfNotificationsDropped);
+        ASSERT_LE(metrics.numberOfNotificationsPosted, metrics.queueCapacity + 1); // the one being delivered is out of the queue
+        ASSERT_EQ(metrics.numberOfNotificationsPosted, metrics.numberOfNotificationsDelivered);
+        ASSERT_EQ(metrics.numberOfNotificationsDelivered, static_cast<unsigned long long>(stateChanges.size()));
+        ASSERT_EQ(HostLifetime[0], stateChanges[0]);
+    }
+
+    TEST_F(ListenerTest, NotifiesOfExceptions)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto receivedValues = std::make_shared<std::vector<int>>();
+        OffloadHost host("OffloadHost", receivedValues, 0ms, 0 /*delayInMilliseconds*/, 2 /*failingValue*/);
+        host.AddEventListener(listener);
+
+        // Act
+        host.Setup();
+        host.Iterate(5);
+        host.WaitForEventListeners();
+
+        // Assert
+        ASSERT_EQ(std::vector<std::string>{ "offloaded work failed" }, listener->GetExceptionMessages());
+        ASSERT_EQ((StateChange{ Host::State::Corrupted, Host::State::Paused }), listener->GetStateChanges().back());
+    }
+
+    TEST_F(ListenerTest, DeliversOnListenerExecutor)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto executor = std::make_shared<EventLoopExecutor>();
+        EmptyHost host("EmptyHost");
+        host.SetListenerExecutor(executor);
+        host.AddEventListener(listener);
+
+        // Act
+        host.Setup();
+        std::vector<StateChange> stateChangesBeforeLoopRuns = listener->GetStateChanges();
+        executor->RunFor(10ms);
+
+        // Assert
+        ASSERT_TRUE(stateChangesBeforeLoopRuns.empty());
+        ASSERT_EQ((std::vector<StateChange>{ HostLifetime[0], HostLifetime[1] }), listener->GetStateChanges());
+        ASSERT_EQ(std::vector<std::thread::id>(2, std::this_thread::get_id()), listener->GetThreadIds());
+    }
+
+    TEST_F(ListenerTest, ListenersCanChangeWhileNotifying)
+    {
+        // Arrange
+        const int NumberOfListeners = 100;
+        EmptyHost host("EmptyHost");
+        host.AddEventListener(listener);
+        host.Setup();
+
+        // Act
+        std::thread listenerThread(
+            [&host]()
+            {
+                auto otherListener = std::make_shared<RecordingListener>();
+                for (int i = 0; i < NumberOfListeners; ++i)
+                {
+                    host.RemoveEventListener(host.AddEventListener(otherListener));
+                }
+            });
+
+        for (int i = 0; i < NumberOfListeners; ++i)
+        {
+            host.Run();
+            host.Pause();
+        }
+
+        listenerThread.join();
+        host.WaitForEventListeners();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(2 + 2 * NumberOfListeners), listener->GetStateChanges().size());
+        ASSERT_TRUE(host.EventListenerIsRegistered(0));
+        ASSERT_FALSE(host.EventListenerIsRegistered(1));
+    }
+}
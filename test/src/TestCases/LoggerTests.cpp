@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// Only messages at INFO and above are compiled into this file, whatever the library's level
+#define ACCESSOR_FRAMEWORK_LOG_LEVEL ACCESSOR_FRAMEWORK_LOG_LEVEL_INFO
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Logger.h"
+
+namespace LoggerTests
+{
+    class LoggerTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            Logger::Flush();
+            this->output = std::tmpfile();
+            ASSERT_NE(nullptr, this->output);
+            Logger::SetOutput(this->output);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            Logger::SetOutput(nullptr);
+            Logger::SetLevel(Logger::Level::Verbose);
+            std::fclose(this->output);
+            this->output = nullptr;
+        }
+
+        // Writes everything buffered and counts the lines written that contain the tag
+        int CountWrittenLines(const std::string& tag)
+        {
+            Logger::Flush();
+            std::rewind(this->output);
+            int numberOfLines = 0;
+            char line[512];
+            while (std::fgets(line, sizeof(line), this->output) != nullptr)
+            {
+                if (std::string(line).find(tag) != std::string::npos)
+                {
+                    ++numberOfLines;
+                }
+            }
+
+            return numberOfLines;
+        }
+
+        FILE* output = nullptr;
+    };
+
+    TEST_F(LoggerTest, MessagesBelowCompileTimeLevelAreElided)
+    {
+        // Arrange
+        int numberOfEvaluations = 0;
+
+        // Act
+        LOG_VERBOSE("compile-time %d", ++numberOfEvaluations);
+        LOG_DEBUG("compile-time %d", ++numberOfEvaluations);
+        LOG_INFO("compile-time %d", ++numberOfEvaluations);
+        LOG_WARNING("compile-time %d", ++numberOfEvaluations);
+
+        // Assert
+        ASSERT_EQ(2, numberOfEvaluations);
+        ASSERT_EQ(2, CountWrittenLines("compile-time"));
+    }
+
+    TEST_F(LoggerTest, MessagesBelowRunTimeLevelAreElided)
+    {
+        // Arrange
+        int numberOfEvaluations = 0;
+        Logger::SetLevel(Logger::Level::Warning);
+
+        // Act
+        LOG_INFO("run-time %d", ++numberOfEvaluations);
+        LOG_WARNING("run-time %d", ++numberOfEvaluations);
+        LOG_ERROR("run-time %d", ++numberOfEvaluations);
+
+        // Assert
+        ASSERT_EQ(2, numberOfEvaluations);
+        ASSERT_EQ(2, CountWrittenLines("run-time"));
+    }
+
+    TEST_F(LoggerTest, FullRingDropsAndCountsMessages)
+    {
+        // Arrange
+        // The background writer drains every 50 ms, far less often than it takes to fill the ring four times over
+        const int NumberOfMessages = static_cast<int>(4 * Logger::MessagesPerThread);
+        unsigned long long numberOfDroppedMessagesBefore = Logger::GetNumberOfDroppedMessages();
+
+        // Act
+        std::thread loggingThread(
+            [NumberOfMessages]()
+            {
+                for (int i = 0; i < NumberOfMessages; ++i)
+                {
+                    LOG_WARNING("full-ring %d", i);
+                }
+            });
+
+        loggingThread.join();
+        int numberOfWrittenMessages = CountWrittenLines("full-ring");
+        unsigned long long numberOfDroppedMessages = Logger::GetNumberOfDroppedMessages() - numberOfDroppedMessagesBefore;
+
+        // Assert
+        ASSERT_LT(0ULL, numberOfDroppedMessages);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfMessages), static_cast<unsigned long long>(numberOfWrittenMessages) + numberOfDroppedMessages);
+        ASSERT_LT(0, CountWrittenLines("log messages were dropped"));
+    }
+
+    TEST_F(LoggerTest, FlushWritesMessagesFromEveryThread)
+    {
+        // Arrange
+        const int NumberOfThreads = 4;
+        const int MessagesPerThread = 10;
+        std::vector<std::thread> loggingThreads{};
+
+        // Act
+        for (int i = 0; i < NumberOfThreads; ++i)
+        {
+            loggingThreads.emplace_back(
+                [i, MessagesPerThread]()
+                {
+                    for (int j = 0; j < MessagesPerThread; ++j)
+                    {
+                        LOG_WARNING("flush %d.%d", i, j);
+                    }
+                });
+        }
+
+        for (auto& loggingThread : loggingThreads)
+        {
+            loggingThread.join();
+        }
+
+        // Assert
+        ASSERT_EQ(NumberOfThreads * MessagesPerThread, CountWrittenLines("flush"));
+    }
+
+    TEST(LoggerDeathTest, ShutdownWritesBufferedMessages)
+    {
+        // The death test runs in a new process, so its logger starts afresh and its output goes to stderr
+        ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+        ASSERT_EXIT(
+            {
+                std::thread loggingThread([]() { LOG_WARNING("written at shutdown"); });
+                loggingThread.join();
+                LOG_ERROR("also written at shutdown");
+                std::exit(0);
+            },
+            ::testing::ExitedWithCode(0),
+            "written at shutdown[^\n]*\n[^\n]*also written at shutdown");
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/OffloadFloodHost.h"
+#include "../TestClasses/OffloadHost.h"
+
+namespace OffloadTests
+{
+    class OffloadTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->receivedValues = std::make_shared<std::vector<int>>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->receivedValues.reset();
+        }
+
+        std::string TargetName = "TargetHost";
+        std::shared_ptr<std::vector<int>> receivedValues = nullptr;
+    };
+
+    TEST_F(OffloadTest, LateResultsArriveWhenTheyAreDue)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        // Each square takes half of the counter's interval and is due at once, so every round waits for its square
+        OffloadHost target(TargetName, receivedValues, 50ms, 0 /*delayInMilliseconds*/);
+        std::vector<int> expectedValues = { 0, 1, 4, 9, 16 };
+
+        // Act
+        target.Setup();
+        target.Iterate(5);
+        auto metrics = target.GetOffloadMetrics();
+        target.Exit();
+
+        // Assert
+        ASSERT_EQ(expectedValues, *receivedValues);
+        ASSERT_EQ(5ULL, metrics.numberOfOffloads);
+        ASSERT_EQ(0ULL, metrics.numberOfRejectedOffloads);
+        ASSERT_EQ(5ULL, metrics.numberOfLateResults);
+        ASSERT_LE(5 * 50ms, metrics.totalOffloadLatency);
+        ASSERT_LT(0us, metrics.totalWaitTime);
+    }
+
+    TEST_F(OffloadTest, OverflowingOffloadsAreRejected)
+    {
+        // Arrange
+        // Every worker may have taken one offload off the queue, and the queue holds 32 more
+        const int queueCapacity = 32;
+        const int numberOfOffloads = queueCapacity + static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U)) + 16;
+        auto numberOfRejectedOffloads = std::make_shared<int>(0);
+        OffloadFloodHost target(TargetName, numberOfOffloads, numberOfRejectedOffloads);
+        Host::SetOffloadQueueCapacity(queueCapacity);
+
+        // Act
+        target.Setup();
+        target.Iterate(1);
+        auto metrics = target.GetOffloadMetrics();
+        target.Exit();
+        Host::SetOffloadQueueCapacity(1024);
+
+        // Assert
+        ASSERT_LE(16, *numberOfRejectedOffloads);
+        ASSERT_EQ(static_cast<unsigned long long>(*numberOfRejectedOffloads), metrics.numberOfRejectedOffloads);
+        ASSERT_EQ(static_cast<unsigned long long>(numberOfOffloads), metrics.numberOfOffloads + metrics.numberOfRejectedOffloads);
+    }
+
+    TEST_F(OffloadTest, ResultsArriveAtLaterLogicalTime)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        // The counter outputs every 100 ms and each square is due 250 ms later, so 10 rounds end with the fourth square
+        OffloadHost target(TargetName, receivedValues, 0ms, 250 /*delayInMilliseconds*/);
+        std::vector<int> expectedValues = { 0, 1, 4, 9 };
+
+        // Act
+        target.Setup();
+        target.Iterate(10);
+        auto metrics = target.GetOffloadMetrics();
+        target.Exit();
+
+        // Assert
+        ASSERT_EQ(expectedValues, *receivedValues);
+        ASSERT_EQ(6ULL, metrics.numberOfOffloads);
+    }
+
+    TEST_F(OffloadTest, ExceptionInWorkStopsHost)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        OffloadHost target(TargetName, receivedValues, 0ms, 0 /*delayInMilliseconds*/, 2 /*failingValue*/);
+        std::vector<int> expectedValues = { 0, 1 };
+
+        // Act
+        target.Setup();
+        target.Iterate(5);
+        target.Exit();
+
+        // Assert
+        ASSERT_EQ(expectedValues, *receivedValues);
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/NestedWideHost.h"
+#include "../TestClasses/WideHost.h"
+
+namespace ParallelReactionTests
+{
+    class ParallelReactionTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            for (int i = 0; i < this->NumberOfLanes; ++i)
+            {
+                this->receivedValues.push_back(std::make_shared<std::vector<int>>());
+            }
+
+            this->target = std::make_unique<WideHost>(this->TargetName, this->NumberOfStages, this->IntervalInMilliseconds, this->receivedValues);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->receivedValues.clear();
+        }
+
+        void AssertEveryLaneReceived(int numberOfValues) const
+        {
+            std::vector<int> expectedValues(numberOfValues);
+            for (int i = 0; i < numberOfValues; ++i)
+            {
+                expectedValues[i] = i;
+            }
+
+            for (const auto& laneValues : this->receivedValues)
+            {
+                ASSERT_EQ(expectedValues, *laneValues);
+            }
+        }
+
+        const std::string TargetName = "TargetHost";
+        const int NumberOfLanes = 8;
+        const int NumberOfStages = 4;
+        const int IntervalInMilliseconds = 200;
+        std::unique_ptr<WideHost> target = nullptr;
+        std::vector<std::shared_ptr<std::vector<int>>> receivedValues;
+    };
+
+    TEST_F(ParallelReactionTest, IterateSequentially)
+    {
+        // Arrange
+        int numberOfIterations = 5;
+
+        // Act
+        target->Setup();
+        target->Iterate(numberOfIterations);
+        target->Exit();
+
+        // Assert
+        AssertEveryLaneReceived(numberOfIterations);
+    }
+
+    TEST_F(ParallelReactionTest, IterateInParallel)
+    {
+        // Arrange
+        int numberOfIterations = 5;
+        target->EnableParallelReactions(4);
+
+        // Act
+        target->Setup();
+        target->Iterate(numberOfIterations);
+        target->Exit();
+
+        // Assert
+        AssertEveryLaneReceived(numberOfIterations);
+    }
+
+    TEST_F(ParallelReactionTest, NestedLanesInParallelMatchSequential)
+    {
+        // Arrange
+        const int NumberOfRounds = 5;
+        auto sequentialLog = std::make_shared<std::vector<std::string>>();
+        auto parallelLog = std::make_shared<std::vector<std::string>>();
+        NestedWideHost sequentialHost(TargetName, NumberOfLanes, NumberOfStages, IntervalInMilliseconds, sequentialLog);
+        NestedWideHost parallelHost(TargetName, NumberOfLanes, NumberOfStages, IntervalInMilliseconds, parallelLog);
+        parallelHost.EnableParallelReactions(4);
+        auto pollTime = std::chrono::system_clock::now() + std::chrono::milliseconds(NumberOfRounds * IntervalInMilliseconds + IntervalInMilliseconds / 2);
+
+        // Act
+        // Polling ahead executes every round due by then right away, in virtual time
+        sequentialHost.Setup();
+        sequentialHost.Poll(pollTime);
+        sequentialHost.Exit();
+        parallelHost.Setup();
+        parallelHost.Poll(pollTime);
+        parallelHost.Exit();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfLanes * NumberOfRounds), sequentialLog->size());
+        ASSERT_EQ(*sequentialLog, *parallelLog);
+    }
+
+    TEST_F(ParallelReactionTest, EnableParallelReactionsAfterSetupThrows)
+    {
+        // Arrange
+        target->Setup();
+
+        // Act & Assert
+        ASSERT_THROW(target->EnableParallelReactions(4), std::logic_error);
+        target->Exit();
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright(c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/FeedbackHost.h"
+#include "../TestClasses/PipelineHost.h"
+
+namespace PipelineTests
+{
+    TEST(PipelineTest, SetupLongPipeline)
+    {
+        // Arrange
+        PipelineHost target("TargetHost", 50000, false /*closed*/);
+
+        // Act
+        target.Setup();
+        Host::State stateAfterSetup = target.GetState();
+        target.Exit();
+
+        // Assert
+        ASSERT_EQ(Host::State::ReadyToRun, stateAfterSetup);
+    }
+
+    TEST(PipelineTest, SetupClosedPipelineDetectsCausalityLoop)
+    {
+        // Arrange
+        PipelineHost target("TargetHost", 3, true /*closed*/);
+
+        // Act & Assert
+        ASSERT_THROW(target.Setup(), std::logic_error);
+        target.Exit();
+    }
+
+    TEST(PipelineTest, SetupFeedbackThroughIndependentLanes)
+    {
+        // Arrange
+        FeedbackHost target("TargetHost");
+
+        // Act
+        target.Setup();
+        Host::State stateAfterSetup = target.GetState();
+        target.Exit();
+
+        // Assert
+        ASSERT_EQ(Host::State::ReadyToRun, stateAfterSetup);
+    }
+}
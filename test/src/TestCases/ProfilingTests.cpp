@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "ProfilingCounter.h"
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace ProfilingTests
+{
+    class ProfilingTest : public SumVerifierHostTest
+    {
+    protected:
+        // Runs after each test case
+        void TearDown() override
+        {
+            Host::SetProfilingEnabled(true);
+            SumVerifierHostTest::TearDown();
+        }
+
+        static const Host::AccessorProfile& FindAccessor(const std::vector<Host::AccessorProfile>& profile, const std::string& name)
+        {
+            auto it = std::find_if(profile.begin(), profile.end(), [&name](const Host::AccessorProfile& p) { return p.name == name; });
+            EXPECT_NE(profile.end(), it);
+            return *it;
+        }
+    };
+
+    TEST_F(ProfilingTest, CountReactionsAndEvents)
+    {
+        // Act
+        target->Setup();
+        ExecuteThreeRounds();
+        auto profile = target->GetProfile();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(4U, profile.size());
+        const auto& adder = FindAccessor(profile, ".TargetHost.IntegerAdder");
+        ASSERT_EQ(3ULL, adder.numberOfReactions);
+        ASSERT_EQ(1ULL, adder.numberOfTimedReactions); // only the first of every 16 reactions is timed
+        ASSERT_LT(0, adder.totalFireTime.count());
+        ASSERT_LE(adder.maxFireTime, adder.totalFireTime);
+        ASSERT_LE(adder.maxInputHandlerTime, adder.totalInputHandlerTime);
+        ASSERT_EQ(2U, adder.inputPorts.size());
+        for (const auto& inputPort : adder.inputPorts)
+        {
+            ASSERT_EQ(3ULL, inputPort.numberOfEventsReceived);
+            ASSERT_EQ(1ULL, inputPort.maxInputQueueLength);
+        }
+
+        ASSERT_EQ(".TargetHost.IntegerAdder.SumOutput", adder.outputPorts.at(0).name);
+        ASSERT_EQ(3ULL, adder.outputPorts.at(0).numberOfEventsSent);
+
+        const auto& verifier = FindAccessor(profile, ".TargetHost.SumVerifier");
+        ASSERT_EQ(3ULL, verifier.numberOfReactions);
+        ASSERT_EQ(3ULL, verifier.inputPorts.at(0).numberOfEventsReceived);
+
+        const auto& counter = FindAccessor(profile, ".TargetHost.SpontaneousCounterOne");
+        ASSERT_EQ(0ULL, counter.numberOfReactions);
+        ASSERT_EQ(3ULL, counter.outputPorts.at(0).numberOfEventsSent);
+    }
+
+    TEST_F(ProfilingTest, ResetProfile)
+    {
+        // Act
+        target->Setup();
+        ExecuteThreeRounds();
+        target->ResetProfile();
+        auto profileAfterReset = target->GetProfile();
+        ExecuteThreeRounds();
+        auto profile = target->GetProfile();
+        target->Exit();
+
+        // Assert
+        const auto& adderAfterReset = FindAccessor(profileAfterReset, ".TargetHost.IntegerAdder");
+        ASSERT_EQ(0ULL, adderAfterReset.numberOfReactions);
+        ASSERT_EQ(0ULL, adderAfterReset.numberOfTimedReactions);
+        ASSERT_EQ(0, adderAfterReset.totalFireTime.count());
+        ASSERT_EQ(0ULL, adderAfterReset.inputPorts.at(0).numberOfEventsReceived);
+        ASSERT_EQ(0ULL, adderAfterReset.inputPorts.at(0).maxInputQueueLength);
+        ASSERT_EQ(3ULL, FindAccessor(profile, ".TargetHost.IntegerAdder").numberOfReactions);
+    }
+
+    TEST_F(ProfilingTest, DisableProfiling)
+    {
+        // Act
+        target->Setup();
+        Host::SetProfilingEnabled(false);
+        ExecuteThreeRounds();
+        auto profile = target->GetProfile();
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(4, *latestSum);
+        const auto& adder = FindAccessor(profile, ".TargetHost.IntegerAdder");
+        ASSERT_EQ(0ULL, adder.numberOfReactions);
+        ASSERT_EQ(0ULL, adder.inputPorts.at(0).numberOfEventsReceived);
+    }
+
+    TEST(ProfilingCounterTest, ConcurrentUpdatesAreNotLost)
+    {
+        // Arrange
+        const unsigned long long numberOfIncrements = 100000ULL;
+        ProfilingCounter counter{};
+        ProfilingCounter maximum{};
+        auto update = [&counter, &maximum, numberOfIncrements]()
+        {
+            for (unsigned long long i = 1ULL; i <= numberOfIncrements; ++i)
+            {
+                counter.Increment();
+                maximum.RaiseTo(i);
+            }
+        };
+
+        // Act
+        std::thread first(update);
+        std::thread second(update);
+        first.join();
+        second.join();
+
+        // Assert
+        ASSERT_EQ(2ULL * numberOfIncrements, counter.Get());
+        ASSERT_EQ(numberOfIncrements, maximum.Get());
+    }
+}
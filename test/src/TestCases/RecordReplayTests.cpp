@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <AccessorFramework/EventSerializer.h>
+#include <AccessorFramework/Host.h>
+#include <AccessorFramework/ReplaySource.h>
+#include "../TestClasses/CollectorHost.h"
+#include "../TestClasses/CounterHost.h"
+#include "../TestClasses/ReplayHost.h"
+
+namespace RecordReplayTests
+{
+    class RecordReplayTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->receivedValues = std::make_shared<std::vector<int>>();
+            this->serializer = std::make_shared<EventSerializer>();
+            this->serializer->Register<int>();
+            this->filePath = ::testing::TempDir() + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".rec";
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            std::remove(this->filePath.c_str());
+            this->receivedValues.reset();
+            this->serializer.reset();
+        }
+
+        // Records the given number of counts, which the counter sends without waiting for wall-clock time
+        Host::RecordingReport RecordCounts(int numberOfCounts, std::shared_ptr<const EventSerializer> recordingSerializer)
+        {
+            CounterHost counterHost("CounterHost", CounterIntervalInMilliseconds);
+            counterHost.StartRecording(this->filePath, recordingSerializer);
+            counterHost.Setup();
+            counterHost.Poll(std::chrono::system_clock::now() + std::chrono::milliseconds(numberOfCounts * CounterIntervalInMilliseconds + CounterIntervalInMilliseconds / 2));
+            counterHost.StopRecording();
+            return counterHost.GetRecordingReport();
+        }
+
+        int CounterIntervalInMilliseconds = 100;
+        std::string CounterStreamName = ".CounterHost.Counter.CounterValue";
+        std::shared_ptr<std::vector<int>> receivedValues = nullptr;
+        std::shared_ptr<EventSerializer> serializer = nullptr;
+        std::string filePath;
+    };
+
+    TEST_F(RecordReplayTest, RecordsSpontaneousOutputs)
+    {
+        // Arrange
+        const int NumberOfCounts = 20;
+
+        // Act
+        Host::RecordingReport report = RecordCounts(NumberOfCounts, serializer);
+        std::vector<std::string> streamNames = ReplaySource::GetStreamNames(filePath);
+
+        // Assert
+        ASSERT_EQ(filePath, report.filePath);
+        ASSERT_FALSE(report.isRecording);
+        ASSERT_EQ(std::vector<std::string>{ CounterStreamName }, report.streams);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), report.numberOfEventsRecorded);
+        ASSERT_EQ(0ULL, report.numberOfEventsSkipped);
+        ASSERT_LT(0ULL, report.numberOfBytesWritten);
+        ASSERT_EQ(report.streams, streamNames);
+    }
+
+    TEST_F(RecordReplayTest, SkipsUnknownPayloadTypes)
+    {
+        // Arrange
+        auto emptySerializer = std::make_shared<EventSerializer>();
+
+        // Act
+        Host::RecordingReport report = RecordCounts(5, emptySerializer);
+
+        // Assert
+        ASSERT_EQ(0ULL, report.numberOfEventsRecorded);
+        ASSERT_EQ(5ULL, report.numberOfEventsSkipped);
+    }
+
+    TEST_F(RecordReplayTest, ReplaysInVirtualTime)
+    {
+        // Arrange
+        const int NumberOfCounts = 50;
+        RecordCounts(NumberOfCounts, serializer);
+        ReplayHost replayHost("ReplayHost", filePath, serializer, receivedValues);
+        replayHost.Setup();
+        std::vector<std::chrono::system_clock::time_point> roundTimes{};
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Act
+        auto nextRoundTime = replayHost.Poll(std::chrono::system_clock::time_point{});
+        while (!(replayHost.GetReplaySource()->IsFinished()) && nextRoundTime != std::chrono::system_clock::time_point::max())
+        {
+            roundTimes.push_back(nextRoundTime);
+            nextRoundTime = replayHost.Poll(nextRoundTime);
+        }
+
+        auto replayTime = std::chrono::steady_clock::now() - startTime;
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), receivedValues->size());
+        for (int i = 0; i < NumberOfCounts; ++i)
+        {
+            ASSERT_EQ(i, receivedValues->at(i));
+        }
+
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), roundTimes.size());
+        for (size_t i = 1; i < roundTimes.size(); ++i)
+        {
+            ASSERT_EQ(std::chrono::milliseconds(CounterIntervalInMilliseconds), roundTimes[i] - roundTimes[i - 1]);
+        }
+
+        ASSERT_LT(replayTime, std::chrono::milliseconds(NumberOfCounts * CounterIntervalInMilliseconds / 2));
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), replayHost.GetReplaySource()->GetNumberOfEventsReplayed());
+        ASSERT_EQ(0ULL, replayHost.GetReplaySource()->GetNumberOfEventsSkipped());
+    }
+
+    TEST_F(RecordReplayTest, RecordsChannelEvents)
+    {
+        // Arrange
+        const int NumberOfCounts = 10;
+        auto pollTime = std::chrono::system_clock::now() + std::chrono::milliseconds(NumberOfCounts * CounterIntervalInMilliseconds + CounterIntervalInMilliseconds / 2);
+        auto counterHost = std::make_unique<CounterHost>("CounterHost", CounterIntervalInMilliseconds);
+        auto collectorHost = std::make_unique<CollectorHost>("CollectorHost", receivedValues);
+        CounterHost* counterHostPointer = counterHost.get();
+        CollectorHost* collectorHostPointer = collectorHost.get();
+        HostHypervisor hypervisor;
+        int counterHostId = hypervisor.AddHost(std::move(counterHost));
+        int collectorHostId = hypervisor.AddHost(std::move(collectorHost));
+        hypervisor.ConnectHosts(counterHostId, CounterStreamName, collectorHostId, ".CollectorHost.Collector.Input");
+        hypervisor.SetupHosts();
+
+        // Act
+        collectorHostPointer->StartRecording(filePath, serializer);
+        counterHostPointer->Poll(pollTime);
+        collectorHostPointer->Poll(pollTime + std::chrono::milliseconds(CounterIntervalInMilliseconds));
+        collectorHostPointer->StopRecording();
+        Host::RecordingReport report = collectorHostPointer->GetRecordingReport();
+
+        // Assert
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), receivedValues->size());
+        ASSERT_EQ(std::vector<std::string>{ ".CollectorHost.Collector.Input" }, report.streams);
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), report.numberOfEventsRecorded);
+    }
+
+    TEST_F(RecordReplayTest, RejectsFilesThatAreNotRecordings)
+    {
+        // Arrange
+        std::ofstream(filePath) << "not a recording";
+
+        // Act and Assert
+        ASSERT_THROW(ReplaySource::GetStreamNames(filePath), std::invalid_argument);
+        ASSERT_THROW(ReplayHost("ReplayHost", filePath, serializer, receivedValues), std::invalid_argument);
+    }
+}
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifdef __linux__
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "SharedMemoryTransportImpl.h"
+#include "../TestClasses/SharedMemoryReceiverHost.h"
+#include "../TestClasses/SharedMemorySenderHost.h"
+
+extern char** environ;
+
+namespace SharedMemoryTransportTests
+{
+    // Set in the environment of the child process started by SenderInAnotherProcess
+    static const char* ChildFileDescriptorsVariable = "ACCESSOR_FRAMEWORK_TEST_TRANSPORT";
+
+    class SharedMemoryTransportTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->receivedValues = std::make_shared<std::vector<int>>();
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->receivedValues.reset();
+        }
+
+        // Polls the sender ahead so that it sends its next few counts right away
+        static void SendCounts(SharedMemorySenderHost& senderHost, int numberOfCounts, std::chrono::system_clock::time_point& pollTime)
+        {
+            if (senderHost.GetState() == Host::State::NeedsSetup)
+            {
+                senderHost.Setup();
+                pollTime = std::chrono::system_clock::now() + std::chrono::milliseconds(CounterIntervalInMilliseconds / 2);
+            }
+
+            pollTime += std::chrono::milliseconds(numberOfCounts * CounterIntervalInMilliseconds);
+            senderHost.Poll(pollTime);
+        }
+
+        static bool WaitForEvents(const SharedMemoryReceiver& receiver, unsigned long long numberOfEvents, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+        {
+            using namespace std::chrono_literals;
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (receiver.GetNumberOfEventsReceived() < numberOfEvents && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+
+            return (receiver.GetNumberOfEventsReceived() >= numberOfEvents);
+        }
+
+        static const int CounterIntervalInMilliseconds = 100;
+        std::shared_ptr<std::vector<int>> receivedValues = nullptr;
+        std::chrono::system_clock::time_point pollTime{};
+    };
+
+    TEST_F(SharedMemoryTransportTest, DeliversEventsInOrder)
+    {
+        // Arrange
+        const int NumberOfBatches = 10;
+        const int BatchSize = 5;
+        const int NumberOfCounts = NumberOfBatches * BatchSize;
+        auto transport = SharedMemoryTransport::Create(200); // room for 8 events, so the ring wraps around
+        SharedMemoryReceiverHost receiverHost("ReceiverHost", transport, receivedValues);
+        SharedMemorySenderHost senderHost("SenderHost", transport, CounterIntervalInMilliseconds);
+        receiverHost.Setup();
+        receiverHost.Run();
+
+        // Act
+        bool allEventsArrived = true;
+        for (int i = 1; i <= NumberOfBatches; ++i)
+        {
+            SendCounts(senderHost, BatchSize, pollTime);
+            allEventsArrived = allEventsArrived && WaitForEvents(*(receiverHost.GetReceiver()), i * BatchSize);
+        }
+
+        receiverHost.Exit();
+
+        // Assert
+        ASSERT_TRUE(allEventsArrived);
+        ASSERT_EQ(256U, transport->GetCapacity());
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), senderHost.GetSender()->GetNumberOfEventsSent());
+        ASSERT_EQ(0ULL, senderHost.GetSender()->GetNumberOfEventsDropped());
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), receivedValues->size());
+        for (int i = 0; i < NumberOfCounts; ++i)
+        {
+            ASSERT_EQ(i, receivedValues->at(i));
+        }
+    }
+
+    TEST_F(SharedMemoryTransportTest, DropsEventsWhileFull)
+    {
+        // Arrange
+        const int NumberOfCounts = 10;
+        auto transport = SharedMemoryTransport::Create(128); // room for four events of 32 bytes each
+        SharedMemoryReceiverHost receiverHost("ReceiverHost", transport, receivedValues);
+        SharedMemorySenderHost senderHost("SenderHost", transport, CounterIntervalInMilliseconds);
+        receiverHost.Setup();
+
+        // Act
+        SendCounts(senderHost, NumberOfCounts, pollTime);
+        receiverHost.Run();
+        bool eventsArrived = WaitForEvents(*(receiverHost.GetReceiver()), 4);
+        receiverHost.Exit();
+
+        // Assert
+        ASSERT_TRUE(eventsArrived);
+        ASSERT_EQ(4ULL, senderHost.GetSender()->GetNumberOfEventsSent());
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts - 4), senderHost.GetSender()->GetNumberOfEventsDropped());
+        ASSERT_EQ((std::vector<int>{ 0, 1, 2, 3 }), *receivedValues);
+    }
+
+    TEST_F(SharedMemoryTransportTest, ClosesTransportWithOversizedRecord)
+    {
+        // Arrange
+        auto transport = SharedMemoryTransport::Create(256);
+        SharedMemoryReceiverHost receiverHost("ReceiverHost", transport, receivedValues);
+        SharedMemorySenderHost senderHost("SenderHost", transport, CounterIntervalInMilliseconds);
+        std::vector<unsigned char> oversizedRecord(transport->GetImpl()->GetMaxRecordSize() + 8);
+        receiverHost.Setup();
+
+        // Act
+        transport->GetImpl()->Write(oversizedRecord.data(), oversizedRecord.size());
+        SendCounts(senderHost, 1, pollTime);
+        receiverHost.Run();
+        bool eventsArrived = WaitForEvents(*(receiverHost.GetReceiver()), 1, std::chrono::milliseconds(500));
+        receiverHost.Exit();
+
+        // Assert
+        ASSERT_FALSE(eventsArrived);
+        ASSERT_EQ(1ULL, senderHost.GetSender()->GetNumberOfEventsSent());
+        ASSERT_EQ(0ULL, receiverHost.GetReceiver()->GetNumberOfEventsDropped());
+        ASSERT_TRUE(receivedValues->empty());
+    }
+
+    TEST_F(SharedMemoryTransportTest, SenderInAnotherProcess)
+    {
+        // Arrange
+        const int NumberOfCounts = 200;
+        auto transport = SharedMemoryTransport::Create(16384);
+        SharedMemoryReceiverHost receiverHost("ReceiverHost", transport, receivedValues);
+        receiverHost.Setup();
+        receiverHost.Run();
+
+        // The child inherits copies of the file descriptors without FD_CLOEXEC
+        int memoryFileDescriptor = fcntl(transport->GetMemoryFileDescriptor(), F_DUPFD, 0);
+        int wakeFileDescriptor = fcntl(transport->GetWakeFileDescriptor(), F_DUPFD, 0);
+        std::string variable = std::string(ChildFileDescriptorsVariable) + "=" + std::to_string(memoryFileDescriptor) + "," + std::to_string(wakeFileDescriptor);
+        std::vector<char*> childEnvironment{ const_cast<char*>(variable.c_str()) };
+        for (char** entry = environ; *entry != nullptr; ++entry)
+        {
+            childEnvironment.push_back(*entry);
+        }
+
+        childEnvironment.push_back(nullptr);
+        std::string filter = "--gtest_filter=SharedMemoryTransportTest.SendFromChildProcess";
+        char* childArguments[] = { const_cast<char*>("/proc/self/exe"), const_cast<char*>(filter.c_str()), nullptr };
+
+        // Act
+        pid_t childId = -1;
+        int spawnResult = posix_spawn(&childId, "/proc/self/exe", nullptr, nullptr, childArguments, childEnvironment.data());
+        close(memoryFileDescriptor);
+        close(wakeFileDescriptor);
+        int childStatus = -1;
+        if (spawnResult == 0)
+        {
+            waitpid(childId, &childStatus, 0);
+        }
+
+        bool allEventsArrived = WaitForEvents(*(receiverHost.GetReceiver()), NumberOfCounts);
+        receiverHost.Exit();
+
+        // Assert
+        ASSERT_EQ(0, spawnResult);
+        ASSERT_TRUE(WIFEXITED(childStatus));
+        ASSERT_EQ(0, WEXITSTATUS(childStatus));
+        ASSERT_TRUE(allEventsArrived);
+        ASSERT_EQ(static_cast<size_t>(NumberOfCounts), receivedValues->size());
+        for (int i = 0; i < NumberOfCounts; ++i)
+        {
+            ASSERT_EQ(i, receivedValues->at(i));
+        }
+    }
+
+    // Only runs as the child process of SenderInAnotherProcess
+    TEST_F(SharedMemoryTransportTest, SendFromChildProcess)
+    {
+        const char* fileDescriptors = std::getenv(ChildFileDescriptorsVariable);
+        if (fileDescriptors == nullptr)
+        {
+            GTEST_SKIP() << "Only runs in a child process started by SenderInAnotherProcess";
+        }
+
+        // Arrange
+        const int NumberOfCounts = 200;
+        std::string value(fileDescriptors);
+        size_t comma = value.find(',');
+        int memoryFileDescriptor = std::stoi(value.substr(0, comma));
+        int wakeFileDescriptor = std::stoi(value.substr(comma + 1));
+        auto transport = SharedMemoryTransport::Open(memoryFileDescriptor, wakeFileDescriptor);
+        close(memoryFileDescriptor);
+        close(wakeFileDescriptor);
+        SharedMemorySenderHost senderHost("SenderHost", transport, CounterIntervalInMilliseconds);
+
+        // Act
+        SendCounts(senderHost, NumberOfCounts, pollTime);
+
+        // Assert
+        ASSERT_EQ(static_cast<unsigned long long>(NumberOfCounts), senderHost.GetSender()->GetNumberOfEventsSent());
+    }
+
+    TEST_F(SharedMemoryTransportTest, OpenRejectsOtherFileDescriptors)
+    {
+        // Arrange
+        int memoryFileDescriptor = eventfd(0, EFD_CLOEXEC);
+        int wakeFileDescriptor = eventfd(0, EFD_CLOEXEC);
+
+        // Act and Assert
+        ASSERT_THROW(SharedMemoryTransport::Open(memoryFileDescriptor, wakeFileDescriptor), std::invalid_argument);
+        close(memoryFileDescriptor);
+        close(wakeFileDescriptor);
+    }
+}
+
+#endif // __linux__
@@ -1,6 +1,7 @@
 // Copyright(c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cmath>
 #include <thread>
 #include <gtest/gtest.h>
@@ -69,4 +70,31 @@ namespace SumVerifierTests
         ASSERT_FALSE(*error);
         ASSERT_EQ(expectedSum, *latestSum);
     }
+
+    TEST_F(SumVerifierTest, SumVerifier_Poll)
+    {
+        using namespace std::chrono_literals;
+
+        // Arrange
+        auto pollInterval = 3.5s;
+        int expectedSum = (std::floor(pollInterval.count()) - 1) * 2;
+
+        // Act
+        target->Setup();
+        auto endTime = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(pollInterval);
+        int numberOfPolls = 0;
+        for (auto now = std::chrono::system_clock::now(); now < endTime; now = std::chrono::system_clock::now())
+        {
+            auto nextDeadline = target->Poll(now);
+            ++numberOfPolls;
+            std::this_thread::sleep_until(std::min(nextDeadline, endTime));
+        }
+
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(expectedSum, *latestSum);
+        ASSERT_GE(numberOfPolls, static_cast<int>(std::floor(pollInterval.count())));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/EmptyHost.h"
+#include "../TestClasses/ThreadRecorderHost.h"
+#include "ThreadConfiguration.h"
+
+namespace ThreadSettingsTests
+{
+    class ThreadSettingsTest : public ::testing::Test
+    {
+    protected:
+        // Runs before each test case
+        void SetUp() override
+        {
+            this->record = std::make_shared<ThreadRecorderHost::Record>();
+            this->target = std::make_unique<ThreadRecorderHost>(this->TargetName, this->record);
+        }
+
+        // Runs after each test case
+        void TearDown() override
+        {
+            this->target.reset(nullptr);
+            this->record.reset();
+        }
+
+        bool WaitForRecord()
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!(this->record->isRecorded.load()) && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            return this->record->isRecorded.load();
+        }
+
+        static std::vector<int> GetAllowedCpus()
+        {
+            std::vector<int> allowedCpus{};
+            for (const std::vector<int>& nodeCpus : ThreadConfiguration::GetNumaNodeCpus())
+            {
+                allowedCpus.insert(allowedCpus.end(), nodeCpus.begin(), nodeCpus.end());
+            }
+
+            return allowedCpus;
+        }
+
+        std::string TargetName = "TargetHost";
+        std::unique_ptr<ThreadRecorderHost> target = nullptr;
+        std::shared_ptr<ThreadRecorderHost::Record> record = nullptr;
+    };
+
+    TEST_F(ThreadSettingsTest, RejectInvalidSettings)
+    {
+        // Arrange
+        Host::ThreadSettings nonexistentCpu{};
+        nonexistentCpu.cpus = { -1 };
+        Host::ThreadSettings missingRealTimePriority{};
+        missingRealTimePriority.schedulingPolicy = Host::SchedulingPolicy::Fifo;
+        Host::ThreadSettings unexpectedPriority{};
+        unexpectedPriority.priority = 10;
+
+        // Act/Assert
+#ifdef __linux__
+        ASSERT_THROW(target->SetThreadSettings(nonexistentCpu), std::invalid_argument);
+        ASSERT_THROW(target->SetThreadSettings(missingRealTimePriority), std::invalid_argument);
+        ASSERT_THROW(target->SetThreadSettings(unexpectedPriority), std::invalid_argument);
+#endif
+        ASSERT_TRUE(target->GetThreadSettings().cpus.empty());
+    }
+
+    TEST_F(ThreadSettingsTest, SetBeforeSetup)
+    {
+        // Arrange
+        Host::ThreadSettings settings{};
+        settings.name = "Control";
+        target->SetThreadSettings(settings);
+        target->Setup();
+
+        // Act/Assert
+        ASSERT_EQ("Control", target->GetThreadSettings().name);
+        ASSERT_THROW(target->SetThreadSettings(settings), std::logic_error);
+    }
+
+#ifdef __linux__
+    TEST_F(ThreadSettingsTest, ApplyToExecutorThreads)
+    {
+        // Arrange
+        Host::ThreadSettings settings{};
+        settings.name = "AVeryLongControlHostName";
+        settings.cpus = { 0 };
+        target->SetThreadSettings(settings);
+        target->Setup();
+
+        // Act
+        target->Run();
+        bool isRecorded = WaitForRecord();
+        target->Exit();
+
+        // Assert
+        std::lock_guard<std::mutex> lock(record->mutex);
+        ASSERT_TRUE(isRecorded);
+        ASSERT_EQ("AVeryLongContro", record->threadName);
+        ASSERT_EQ(std::vector<int>{ 0 }, record->cpus);
+    }
+
+    TEST_F(ThreadSettingsTest, PinnedHostKeepsItsThreadsInHypervisor)
+    {
+        // Arrange
+        std::vector<int> allowedCpus = GetAllowedCpus();
+        if (allowedCpus.size() < 2)
+        {
+            GTEST_SKIP() << "Reserving a CPU needs another one left for the hypervisor's thread pools";
+        }
+
+        Host::ThreadSettings settings{};
+        settings.cpus = { allowedCpus.front() };
+        target->SetThreadSettings(settings);
+        HostHypervisor hypervisor{};
+        hypervisor.AddHost(std::make_unique<EmptyHost>("BulkHost"));
+        int hostId = hypervisor.AddHost(std::move(target));
+
+        // Act
+        hypervisor.SetupHosts();
+        hypervisor.RunHost(hostId);
+        bool isRecorded = WaitForRecord();
+        hypervisor.RemoveAllHosts();
+
+        // Assert
+        std::lock_guard<std::mutex> lock(record->mutex);
+        ASSERT_TRUE(isRecorded);
+        ASSERT_EQ(TargetName, record->threadName);
+        ASSERT_EQ(std::vector<int>{ allowedCpus.front() }, record->cpus);
+    }
+
+    TEST_F(ThreadSettingsTest, NamedHostKeepsItsThreadsInHypervisor)
+    {
+        // Arrange
+        Host::ThreadSettings settings{};
+        settings.name = "Control";
+        target->SetThreadSettings(settings);
+        HostHypervisor hypervisor{};
+        hypervisor.AddHost(std::make_unique<EmptyHost>("BulkHost"));
+        int hostId = hypervisor.AddHost(std::move(target));
+
+        // Act
+        hypervisor.SetupHosts();
+        hypervisor.RunHost(hostId);
+        bool isRecorded = WaitForRecord();
+        hypervisor.RemoveAllHosts();
+
+        // Assert
+        std::lock_guard<std::mutex> lock(record->mutex);
+        ASSERT_TRUE(isRecorded);
+        ASSERT_EQ("Control", record->threadName);
+    }
+
+    TEST_F(ThreadSettingsTest, RejectHostReservingEveryCpuInHypervisor)
+    {
+        // Arrange
+        Host::ThreadSettings settings{};
+        settings.cpus = GetAllowedCpus();
+        target->SetThreadSettings(settings);
+        HostHypervisor hypervisor{};
+
+        // Act/Assert
+        ASSERT_THROW(hypervisor.AddHost(std::move(target)), std::invalid_argument);
+        ASSERT_TRUE(hypervisor.GetHostNames().empty());
+    }
+#endif
+}
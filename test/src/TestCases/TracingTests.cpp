@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include <AccessorFramework/Host.h>
+#include "../TestClasses/SumVerifierHostTest.h"
+
+namespace TracingTests
+{
+    class TracingTest : public SumVerifierHostTest
+    {
+    protected:
+        // Runs after each test case
+        void TearDown() override
+        {
+            Host::StopTracing();
+            SumVerifierHostTest::TearDown();
+        }
+
+        static std::string WriteTrace()
+        {
+            std::ostringstream trace{};
+            Host::WriteTrace(trace);
+            return trace.str();
+        }
+
+        static size_t CountOccurrences(const std::string& text, const std::string& pattern)
+        {
+            size_t count = 0;
+            for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+            {
+                ++count;
+            }
+
+            return count;
+        }
+    };
+
+    TEST_F(TracingTest, RecordRoundsReactionsAndEvents)
+    {
+        // Arrange
+        target->Setup();
+        Host::StartTracing();
+
+        // Act
+        ExecuteThreeRounds();
+        Host::StopTracing();
+        std::string trace = WriteTrace();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(0U, trace.find("{\"traceEvents\":["));
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"name\":\"Round\""));
+        ASSERT_LE(6U, CountOccurrences(trace, "\"cat\":\"callback\"")); // the two counters' timers, plus the reactions
+        ASSERT_EQ(6U, CountOccurrences(trace, "\"name\":\".TargetHost.SpontaneousCounterOne\",\"cat\":\"callback\"")); // timer and output
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"name\":\".TargetHost.IntegerAdder\",\"cat\":\"reaction\""));
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"name\":\".TargetHost.SumVerifier\",\"cat\":\"reaction\""));
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"name\":\".TargetHost.IntegerAdder.SumOutput\",\"cat\":\"event\""));
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"to\":\".TargetHost.SumVerifier.Sum\""));
+        ASSERT_EQ(3U, CountOccurrences(trace, "\"logicalTimeMs\":"));
+    }
+
+    TEST_F(TracingTest, NothingIsRecordedWhileStopped)
+    {
+        // Arrange
+        target->Setup();
+        Host::StartTracing();
+        Host::StopTracing();
+
+        // Act
+        ExecuteThreeRounds();
+        std::string trace = WriteTrace();
+        target->Exit();
+
+        // Assert
+        ASSERT_EQ(4, *latestSum);
+        ASSERT_EQ("{\"traceEvents\":[],\"displayTimeUnit\":\"ms\"}", trace);
+    }
+
+    TEST_F(TracingTest, KeepOnlyTheNewestEvents)
+    {
+        // Arrange
+        target->Setup();
+        Host::StartTracing(4);
+
+        // Act
+        ExecuteThreeRounds();
+        Host::StopTracing();
+        std::string trace = WriteTrace();
+        target->Exit();
+
+        // Assert
+        // The round's own event is recorded last, once every callback and reaction in it has finished
+        ASSERT_EQ(4U, CountOccurrences(trace, "\"ph\":"));
+        ASSERT_EQ(1U, CountOccurrences(trace, "\"name\":\"Round\""));
+    }
+
+    TEST_F(TracingTest, WriteTraceWhileRecording)
+    {
+        // Arrange
+        target->Setup();
+        Host::StartTracing(8);
+        std::atomic_bool isDone(false);
+        size_t numberOfMalformedTraces = 0;
+        std::thread writer(
+            [&isDone, &numberOfMalformedTraces]()
+            {
+                while (!isDone.load())
+                {
+                    std::string trace = WriteTrace();
+                    if (trace.find("{\"traceEvents\":[") != 0 || CountOccurrences(trace, "{\"name\":") != CountOccurrences(trace, "}}"))
+                    {
+                        ++numberOfMalformedTraces;
+                    }
+                }
+            });
+
+        // Act
+        for (int i = 0; i < 20; ++i)
+        {
+            ExecuteThreeRounds();
+        }
+
+        isDone.store(true);
+        writer.join();
+        Host::StopTracing();
+        std::string trace = WriteTrace();
+        target->Exit();
+
+        // Assert
+        ASSERT_FALSE(*error);
+        ASSERT_EQ(0U, numberOfMalformedTraces);
+        ASSERT_EQ(8U, CountOccurrences(trace, "\"ph\":"));
+    }
+}
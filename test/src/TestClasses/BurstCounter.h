@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef BURSTCOUNTER_H
+#define BURSTCOUNTER_H
+
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that outputs the next few values of a counter all at once at regular intervals, so that they queue up on
+// the input ports downstream of it
+//
+class BurstCounter : public AtomicAccessor
+{
+public:
+    BurstCounter(const std::string& name, int burstSize, int intervalInMilliseconds) :
+        AtomicAccessor(name, {}, {}, { CounterValueOutput }),
+        m_burstSize(burstSize),
+        m_intervalInMilliseconds(intervalInMilliseconds),
+        m_count(0)
+    {
+    }
+
+    // Spontaneous Output Port Names
+    static constexpr const char* CounterValueOutput = "CounterValue";
+
+private:
+    void Initialize() override
+    {
+        this->ScheduleCallback(
+            [this]()
+            {
+                for (int i = 0; i < this->m_burstSize; ++i)
+                {
+                    this->SendOutput(CounterValueOutput, std::make_shared<Event<int>>(this->m_count));
+                    ++this->m_count;
+                }
+            },
+            this->m_intervalInMilliseconds,
+            true /*repeat*/);
+    }
+
+    int m_burstSize;
+    int m_intervalInMilliseconds;
+    int m_count;
+};
+
+#endif // BURSTCOUNTER_H
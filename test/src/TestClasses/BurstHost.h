@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef BURSTHOST_H
+#define BURSTHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "BurstCounter.h"
+#include "Collector.h"
+#include "Relay.h"
+
+// Description
+// A host in which a burst counter sends its bursts through a relay to a collector, once per second
+//
+class BurstHost : public Host
+{
+public:
+    BurstHost(const std::string& name, int burstSize, std::shared_ptr<std::vector<int>> receivedValues) : Host(name)
+    {
+        this->AddChild(std::make_unique<BurstCounter>("BurstCounter", burstSize, 1000));
+        this->AddChild(std::make_unique<Relay>("Relay"));
+        this->AddChild(std::make_unique<Collector>("Collector", receivedValues));
+        this->ConnectChildren("BurstCounter", BurstCounter::CounterValueOutput, "Relay", Relay::Input);
+        this->ConnectChildren("Relay", Relay::Output, "Collector", Collector::Input);
+    }
+};
+
+#endif // BURSTHOST_H
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef CHECKPOINTHOST_H
+#define CHECKPOINTHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "CheckpointedCounter.h"
+#include "Collector.h"
+
+// Description
+// A host containing a fast (100 ms) and a slow (250 ms) checkpointed counter, each connected to a collector of its own,
+// or, if cross-connected, to the other's collector
+//
+class CheckpointHost : public Host
+{
+public:
+    CheckpointHost(
+        const std::string& name,
+        std::shared_ptr<std::vector<int>> fastValues,
+        std::shared_ptr<std::vector<int>> slowValues,
+        bool isCrossConnected = false) :
+        Host(name),
+        m_isCrossConnected(isCrossConnected)
+    {
+        this->AddChild(std::make_unique<CheckpointedCounter>(FastCounterName, 100));
+        this->AddChild(std::make_unique<CheckpointedCounter>(SlowCounterName, 250));
+        this->AddChild(std::make_unique<Collector>(FastCollectorName, fastValues));
+        this->AddChild(std::make_unique<Collector>(SlowCollectorName, slowValues));
+    }
+
+protected:
+    void AdditionalSetup() override
+    {
+        this->ConnectChildren(FastCounterName, CheckpointedCounter::CounterValueOutput, this->m_isCrossConnected ? SlowCollectorName : FastCollectorName, Collector::Input);
+        this->ConnectChildren(SlowCounterName, CheckpointedCounter::CounterValueOutput, this->m_isCrossConnected ? FastCollectorName : SlowCollectorName, Collector::Input);
+    }
+
+private:
+    const std::string FastCounterName = "FastCounter";
+    const std::string SlowCounterName = "SlowCounter";
+    const std::string FastCollectorName = "FastCollector";
+    const std::string SlowCollectorName = "SlowCollector";
+    bool m_isCrossConnected;
+};
+
+#endif // CHECKPOINTHOST_H
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef CHECKPOINTEDCOUNTER_H
+#define CHECKPOINTEDCOUNTER_H
+
+#include <istream>
+#include <ostream>
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that, like a spontaneous counter, outputs the value of a counter at regular intervals, and that saves the
+// counter in checkpoints so that a restored counter carries on counting where the original left off
+//
+class CheckpointedCounter : public AtomicAccessor
+{
+public:
+    CheckpointedCounter(const std::string& name, int intervalInMilliseconds) :
+        AtomicAccessor(name, {}, {}, { CounterValueOutput }),
+        m_intervalInMilliseconds(intervalInMilliseconds),
+        m_count(0)
+    {
+    }
+
+    static constexpr const char* CounterValueOutput = "CounterValue";
+
+protected:
+    void SaveState(std::ostream& stream) const override
+    {
+        stream << this->m_count;
+    }
+
+    void RestoreState(std::istream& stream) override
+    {
+        stream >> this->m_count;
+        this->ScheduleCount();
+    }
+
+private:
+    void Initialize() override
+    {
+        this->ScheduleCount();
+    }
+
+    void ScheduleCount()
+    {
+        this->ScheduleCallback(
+            [this]()
+            {
+                this->SendOutput(CounterValueOutput, std::make_shared<Event<int>>(this->m_count));
+                ++this->m_count;
+            },
+            this->m_intervalInMilliseconds,
+            true /*repeat*/);
+    }
+
+    int m_intervalInMilliseconds;
+    int m_count;
+};
+
+#endif // CHECKPOINTEDCOUNTER_H
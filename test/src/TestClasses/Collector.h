@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include <memory>
+#include <vector>
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that records the payload of every event it receives
+//
+class Collector : public AtomicAccessor
+{
+public:
+    Collector(const std::string& name, std::shared_ptr<std::vector<int>> receivedValues) :
+        AtomicAccessor(name, { Input }),
+        m_receivedValues(receivedValues)
+    {
+        this->AddInputHandler(Input,
+            [this](IEvent* event)
+            {
+                this->m_receivedValues->push_back(static_cast<Event<int>*>(event)->payload);
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* Input = "Input";
+
+private:
+    std::shared_ptr<std::vector<int>> m_receivedValues;
+};
+
+#endif // COLLECTOR_H
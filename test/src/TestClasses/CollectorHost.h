@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef COLLECTORHOST_H
+#define COLLECTORHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "Collector.h"
+
+// Description
+// A host containing a single collector, whose input port is left unconnected
+//
+class CollectorHost : public Host
+{
+public:
+    CollectorHost(const std::string& name, std::shared_ptr<std::vector<int>> receivedValues) : Host(name)
+    {
+        this->AddChild(std::make_unique<Collector>("Collector", receivedValues));
+    }
+};
+
+#endif // COLLECTORHOST_H
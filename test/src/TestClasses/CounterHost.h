@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef COUNTERHOST_H
+#define COUNTERHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "SpontaneousCounter.h"
+
+// Description
+// A host containing a single spontaneous counter, whose output port is left unconnected
+//
+class CounterHost : public Host
+{
+public:
+    CounterHost(const std::string& name, int intervalInMilliseconds) : Host(name)
+    {
+        this->AddChild(std::make_unique<SpontaneousCounter>("Counter", intervalInMilliseconds));
+    }
+};
+
+#endif // COUNTERHOST_H
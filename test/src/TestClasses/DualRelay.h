@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef DUALRELAY_H
+#define DUALRELAY_H
+
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor with two independent lanes: events received on the first input are forwarded to the first output, and
+// events received on the second input are forwarded to the second output. Neither output depends on the other lane.
+//
+class DualRelay : public AtomicAccessor
+{
+public:
+    explicit DualRelay(const std::string& name) :
+        AtomicAccessor(name, { FirstInput, SecondInput }, { FirstOutput, SecondOutput })
+    {
+        this->RemoveDependency(FirstInput, SecondOutput);
+        this->RemoveDependency(SecondInput, FirstOutput);
+        this->AddInputHandler(FirstInput,
+            [this](IEvent* event)
+            {
+                this->SendOutput(FirstOutput, std::make_shared<Event<int>>(static_cast<Event<int>*>(event)->payload));
+            });
+
+        this->AddInputHandler(SecondInput,
+            [this](IEvent* event)
+            {
+                this->SendOutput(SecondOutput, std::make_shared<Event<int>>(static_cast<Event<int>*>(event)->payload));
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* FirstInput = "FirstInput";
+    static constexpr const char* SecondInput = "SecondInput";
+
+    // Connected Output Port Names
+    static constexpr const char* FirstOutput = "FirstOutput";
+    static constexpr const char* SecondOutput = "SecondOutput";
+};
+
+#endif // DUALRELAY_H
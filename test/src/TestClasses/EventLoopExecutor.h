@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef EVENTLOOPEXECUTOR_H
+#define EVENTLOOPEXECUTOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <AccessorFramework/Executor.h>
+
+// Description
+// An executor that queues tasks until an application's event loop runs them. RunFor() runs due tasks on the calling
+// thread.
+//
+class EventLoopExecutor : public Executor
+{
+public:
+    void Execute(std::function<void()> task) override
+    {
+        this->ExecuteAfter(0LL, std::move(task));
+    }
+
+    void ExecuteAfter(long long delayInMilliseconds, std::function<void()> task) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_tasks.emplace(std::chrono::steady_clock::now() + std::chrono::milliseconds(delayInMilliseconds), std::move(task));
+            ++this->m_numberOfTasksQueued;
+        }
+
+        this->m_taskAdded.notify_one();
+    }
+
+    void RunFor(std::chrono::milliseconds duration)
+    {
+        auto endTime = std::chrono::steady_clock::now() + duration;
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        while (std::chrono::steady_clock::now() < endTime)
+        {
+            if (this->m_tasks.empty() || this->m_tasks.begin()->first > std::chrono::steady_clock::now())
+            {
+                auto wakeTime = (this->m_tasks.empty() ? endTime : std::min(endTime, this->m_tasks.begin()->first));
+                this->m_taskAdded.wait_until(lock, wakeTime);
+                continue;
+            }
+
+            auto task = std::move(this->m_tasks.begin()->second);
+            this->m_tasks.erase(this->m_tasks.begin());
+            lock.unlock();
+            task();
+            lock.lock();
+            ++this->m_numberOfTasksRun;
+        }
+    }
+
+    int GetNumberOfTasksQueued() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return this->m_numberOfTasksQueued;
+    }
+
+    int GetNumberOfTasksRun() const
+    {
+        return this->m_numberOfTasksRun;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> m_tasks;
+    int m_numberOfTasksQueued = 0;
+    int m_numberOfTasksRun = 0;
+};
+
+#endif // EVENTLOOPEXECUTOR_H
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef FEEDBACKHOST_H
+#define FEEDBACKHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "DualRelay.h"
+#include "Relay.h"
+
+// Description
+// A host in which the first lane of a dual relay feeds back into its second lane through a relay. Because the lanes are
+// independent, this is not a causality loop.
+//
+class FeedbackHost : public Host
+{
+public:
+    explicit FeedbackHost(const std::string& name) : Host(name)
+    {
+        this->AddChild(std::make_unique<DualRelay>(d1));
+        this->AddChild(std::make_unique<Relay>(r1));
+        this->ConnectChildren(d1, DualRelay::FirstOutput, r1, Relay::Input);
+        this->ConnectChildren(r1, Relay::Output, d1, DualRelay::SecondInput);
+    }
+
+private:
+    const std::string d1 = "DualRelay";
+    const std::string r1 = "Relay";
+};
+
+#endif // FEEDBACKHOST_H
@@ -29,11 +29,11 @@ public:
     }
 
     // Input Port Names
-    static const char* LeftInput;
-    static const char* RightInput;
+    static constexpr const char* LeftInput = "LeftInput";
+    static constexpr const char* RightInput = "RightInput";
 
     // Connected Output Port Names
-    static const char* SumOutput;
+    static constexpr const char* SumOutput = "SumOutput";
 
 private:
     void Fire() override
@@ -45,8 +45,4 @@ private:
     int m_latestRightInput = 0;
 };
 
-const char* IntegerAdder::LeftInput = "LeftInput";
-const char* IntegerAdder::RightInput = "RightInput";
-const char* IntegerAdder::SumOutput = "SumOutput";
-
 #endif // INTEGERADDER_H
\ No newline at end of file
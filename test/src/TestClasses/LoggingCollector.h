@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef LOGGINGCOLLECTOR_H
+#define LOGGINGCOLLECTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that, for every event it receives, schedules a callback that appends its name and the event's payload to a
+// log. The log may be shared by collectors that react in parallel, since callbacks only run on the director's thread,
+// and it records the order in which the director executed them.
+//
+class LoggingCollector : public AtomicAccessor
+{
+public:
+    LoggingCollector(const std::string& name, std::shared_ptr<std::vector<std::string>> log) :
+        AtomicAccessor(name, { Input }),
+        m_log(log)
+    {
+        this->AddInputHandler(Input,
+            [this](IEvent* event)
+            {
+                std::string entry = this->GetName() + ":" + std::to_string(static_cast<Event<int>*>(event)->payload);
+                this->ScheduleCallback(
+                    [this, entry]()
+                    {
+                        this->m_log->push_back(entry);
+                    },
+                    0 /*delayInMilliseconds*/,
+                    false /*repeat*/);
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* Input = "Input";
+
+private:
+    std::shared_ptr<std::vector<std::string>> m_log;
+};
+
+#endif // LOGGINGCOLLECTOR_H
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef NESTEDWIDEHOST_H
+#define NESTEDWIDEHOST_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <AccessorFramework/Host.h>
+#include "WideComposite.h"
+
+// Description
+// A host whose only child is a composite accessor containing several independent lanes (see WideComposite)
+//
+class NestedWideHost : public Host
+{
+public:
+    NestedWideHost(
+        const std::string& name,
+        int numberOfLanes,
+        int numberOfStages,
+        int intervalInMilliseconds,
+        std::shared_ptr<std::vector<std::string>> log) :
+        Host(name)
+    {
+        this->AddChild(std::make_unique<WideComposite>("Lanes", numberOfLanes, numberOfStages, intervalInMilliseconds, log));
+    }
+};
+
+#endif // NESTEDWIDEHOST_H
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef OFFLOADFLOODHOST_H
+#define OFFLOADFLOODHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "OffloadFlooder.h"
+
+// Description
+// A host with a single actor that offloads more work at once than the offload pool can queue
+//
+class OffloadFloodHost : public Host
+{
+public:
+    OffloadFloodHost(const std::string& name, int numberOfOffloads, std::shared_ptr<int> numberOfRejectedOffloads) :
+        Host(name)
+    {
+        this->AddChild(std::make_unique<OffloadFlooder>(f1, numberOfOffloads, numberOfRejectedOffloads));
+    }
+
+private:
+    const std::string f1 = "OffloadFlooder";
+};
+
+#endif // OFFLOADFLOODHOST_H
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef OFFLOADFLOODER_H
+#define OFFLOADFLOODER_H
+
+#include <future>
+#include <memory>
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that offloads the given number of pieces of work at once in its first round, and counts how many the pool
+// rejects. The work waits until every piece has been offloaded, so none of it finishes while the queue is filling up.
+//
+class OffloadFlooder : public AtomicAccessor
+{
+public:
+    OffloadFlooder(const std::string& name, int numberOfOffloads, std::shared_ptr<int> numberOfRejectedOffloads) :
+        AtomicAccessor(name, { ResultInput }),
+        m_numberOfOffloads(numberOfOffloads),
+        m_numberOfRejectedOffloads(numberOfRejectedOffloads)
+    {
+        this->AddInputHandler(ResultInput,
+            [](IEvent* /*event*/)
+            {
+                // results are ignored
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* ResultInput = "Result"; // completion port for offloaded work
+
+private:
+    void Initialize() override
+    {
+        this->ScheduleCallback(
+            [this]()
+            {
+                std::promise<void> allOffloaded{};
+                std::shared_future<void> gate = allOffloaded.get_future().share();
+                for (int i = 0; i < this->m_numberOfOffloads; ++i)
+                {
+                    bool isAccepted = this->Offload(
+                        [gate]()
+                        {
+                            gate.wait();
+                            return std::make_shared<Event<int>>(0);
+                        },
+                        ResultInput);
+
+                    if (!isAccepted)
+                    {
+                        ++(*this->m_numberOfRejectedOffloads);
+                    }
+                }
+
+                allOffloaded.set_value();
+            },
+            0 /*delayInMilliseconds*/,
+            false /*repeat*/);
+    }
+
+    int m_numberOfOffloads;
+    std::shared_ptr<int> m_numberOfRejectedOffloads;
+};
+
+#endif // OFFLOADFLOODER_H
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef OFFLOADHOST_H
+#define OFFLOADHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "Collector.h"
+#include "OffloadingSquarer.h"
+#include "SpontaneousCounter.h"
+
+// Description
+// A host in which a spontaneous counter feeds a squarer that offloads its work, which feeds a collector
+//
+class OffloadHost : public Host
+{
+public:
+    OffloadHost(
+        const std::string& name,
+        std::shared_ptr<std::vector<int>> receivedValues,
+        std::chrono::milliseconds workDuration,
+        int delayInMilliseconds,
+        int failingValue = -1) :
+        Host(name)
+    {
+        this->AddChild(std::make_unique<SpontaneousCounter>(s1, 100));
+        this->AddChild(std::make_unique<OffloadingSquarer>(q1, workDuration, delayInMilliseconds, failingValue));
+        this->AddChild(std::make_unique<Collector>(c1, receivedValues));
+        this->ConnectChildren(s1, SpontaneousCounter::CounterValueOutput, q1, OffloadingSquarer::Input);
+        this->ConnectChildren(q1, OffloadingSquarer::Output, c1, Collector::Input);
+    }
+
+private:
+    const std::string s1 = "SpontaneousCounter";
+    const std::string q1 = "OffloadingSquarer";
+    const std::string c1 = "Collector";
+};
+
+#endif // OFFLOADHOST_H
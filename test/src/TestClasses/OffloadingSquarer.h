@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef OFFLOADINGSQUARER_H
+#define OFFLOADINGSQUARER_H
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that squares its input on a worker thread, taking the given time to do so, and outputs the square the given
+// delay later. The work throws when asked to square the given failing value.
+//
+class OffloadingSquarer : public AtomicAccessor
+{
+public:
+    OffloadingSquarer(const std::string& name, std::chrono::milliseconds workDuration, int delayInMilliseconds, int failingValue = -1) :
+        AtomicAccessor(name, { Input, SquareInput }, { Output }),
+        m_workDuration(workDuration),
+        m_delayInMilliseconds(delayInMilliseconds),
+        m_failingValue(failingValue)
+    {
+        this->AddInputHandler(Input,
+            [this](IEvent* event)
+            {
+                int value = static_cast<Event<int>*>(event)->payload;
+                auto workDuration = this->m_workDuration;
+                int failingValue = this->m_failingValue;
+                this->Offload(
+                    [value, workDuration, failingValue]()
+                    {
+                        std::this_thread::sleep_for(workDuration);
+                        if (value == failingValue)
+                        {
+                            throw std::runtime_error("offloaded work failed");
+                        }
+
+                        return std::make_shared<Event<int>>(value * value);
+                    },
+                    SquareInput,
+                    this->m_delayInMilliseconds);
+            });
+
+        this->AddInputHandler(SquareInput,
+            [this](IEvent* event)
+            {
+                this->SendOutput(Output, std::make_shared<Event<int>>(static_cast<Event<int>*>(event)->payload));
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* Input = "Input";
+    static constexpr const char* SquareInput = "Square"; // completion port for offloaded work
+
+    // Connected Output Port Names
+    static constexpr const char* Output = "Output";
+
+private:
+    std::chrono::milliseconds m_workDuration;
+    int m_delayInMilliseconds;
+    int m_failingValue;
+};
+
+#endif // OFFLOADINGSQUARER_H
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef PIPEREADER_H
+#define PIPEREADER_H
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <AccessorFramework/IOAccessor.h>
+
+// Description
+// An I/O accessor that owns a pipe and outputs every integer written to it. It stops watching the pipe once the write
+// end has been closed.
+//
+class PipeReader : public IOAccessor
+{
+public:
+    explicit PipeReader(const std::string& name) :
+        IOAccessor(name, {}, {}, { ValueOutput }),
+        m_fileDescriptors{ -1, -1 }
+    {
+        if (pipe2(this->m_fileDescriptors, O_NONBLOCK | O_CLOEXEC) != 0)
+        {
+            throw std::runtime_error("could not create pipe");
+        }
+    }
+
+    ~PipeReader()
+    {
+        this->UnwatchFileDescriptor(this->m_fileDescriptors[0]);
+        close(this->m_fileDescriptors[0]);
+        this->CloseWriteEnd();
+    }
+
+    // Can be called from any thread
+    void Write(int value)
+    {
+        if (write(this->m_fileDescriptors[1], &value, sizeof(value)) != sizeof(value))
+        {
+            throw std::runtime_error("could not write to pipe");
+        }
+    }
+
+    void CloseWriteEnd()
+    {
+        if (this->m_fileDescriptors[1] != -1)
+        {
+            close(this->m_fileDescriptors[1]);
+            this->m_fileDescriptors[1] = -1;
+        }
+    }
+
+    static constexpr const char* ValueOutput = "Value";
+
+private:
+    void Initialize() override
+    {
+        this->WatchFileDescriptor(
+            this->m_fileDescriptors[0],
+            IOAccessor::Readable,
+            [this](unsigned int ioEvents)
+            {
+                int value = 0;
+                while (read(this->m_fileDescriptors[0], &value, sizeof(value)) == sizeof(value))
+                {
+                    this->SendOutput(ValueOutput, std::make_shared<Event<int>>(value));
+                }
+
+                if ((ioEvents & IOAccessor::HungUp) != 0)
+                {
+                    this->UnwatchFileDescriptor(this->m_fileDescriptors[0]);
+                }
+            });
+    }
+
+    int m_fileDescriptors[2];
+};
+
+#endif // __linux__
+
+#endif // PIPEREADER_H
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef PIPEREADERHOST_H
+#define PIPEREADERHOST_H
+
+#ifdef __linux__
+
+#include <AccessorFramework/Host.h>
+#include "Collector.h"
+#include "PipeReader.h"
+#include "SpontaneousCounter.h"
+
+// Description
+// A host in which a pipe reader feeds a collector. If given an interval, a spontaneous counter also feeds a
+// collector that records into the same list.
+//
+class PipeReaderHost : public Host
+{
+public:
+    PipeReaderHost(const std::string& name, std::shared_ptr<std::vector<int>> receivedValues, int counterIntervalInMilliseconds = 0) :
+        Host(name)
+    {
+        auto reader = std::make_unique<PipeReader>(ReaderName);
+        this->m_reader = reader.get();
+        this->AddChild(std::move(reader));
+        this->AddChild(std::make_unique<Collector>(CollectorName, receivedValues));
+        this->ConnectChildren(ReaderName, PipeReader::ValueOutput, CollectorName, Collector::Input);
+        if (counterIntervalInMilliseconds > 0)
+        {
+            this->AddChild(std::make_unique<SpontaneousCounter>(CounterName, counterIntervalInMilliseconds));
+            this->AddChild(std::make_unique<Collector>(CounterCollectorName, receivedValues));
+            this->ConnectChildren(CounterName, SpontaneousCounter::CounterValueOutput, CounterCollectorName, Collector::Input);
+        }
+    }
+
+    PipeReader* GetReader() const
+    {
+        return this->m_reader;
+    }
+
+private:
+    const std::string ReaderName = "Reader";
+    const std::string CollectorName = "Collector";
+    const std::string CounterName = "Counter";
+    const std::string CounterCollectorName = "CounterCollector";
+    PipeReader* m_reader;
+};
+
+#endif // __linux__
+
+#endif // PIPEREADERHOST_H
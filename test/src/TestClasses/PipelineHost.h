@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef PIPELINEHOST_H
+#define PIPELINEHOST_H
+
+#include <sstream>
+#include <AccessorFramework/Host.h>
+#include "Relay.h"
+
+// Description
+// A host containing a chain of relays. If the pipeline is closed, the last relay feeds back into the first one, which
+// forms a causality loop.
+//
+class PipelineHost : public Host
+{
+public:
+    PipelineHost(const std::string& name, int numberOfStages, bool closed) : Host(name)
+    {
+        for (int i = 0; i < numberOfStages; ++i)
+        {
+            this->AddChild(std::make_unique<Relay>(GetStageName(i)));
+            if (i > 0)
+            {
+                this->ConnectChildren(GetStageName(i - 1), Relay::Output, GetStageName(i), Relay::Input);
+            }
+        }
+
+        if (closed)
+        {
+            this->ConnectChildren(GetStageName(numberOfStages - 1), Relay::Output, GetStageName(0), Relay::Input);
+        }
+    }
+
+    static std::string GetStageName(int stageIndex)
+    {
+        std::ostringstream oss;
+        oss << "Stage-" << stageIndex;
+        return oss.str();
+    }
+};
+
+#endif // PIPELINEHOST_H
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef RECORDINGLISTENER_H
+#define RECORDINGLISTENER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <AccessorFramework/Host.h>
+
+// Description
+// An event listener that records every notification it is given, along with the thread it was given on. While it is
+// held, it blocks in each notification until it is released, like a listener with slow work to do.
+//
+class RecordingListener : public Host::EventListener
+{
+public:
+    void NotifyOfException(const std::exception& e) override
+    {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        this->m_releaseCondition.wait(lock, [this]() { return !(this->m_isHeld); });
+        this->m_exceptionMessages.push_back(e.what());
+        this->m_threadIds.push_back(std::this_thread::get_id());
+    }
+
+    void NotifyOfStateChange(Host::State oldState, Host::State newState) override
+    {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        this->m_releaseCondition.wait(lock, [this]() { return !(this->m_isHeld); });
+        this->m_stateChanges.emplace_back(oldState, newState);
+        this->m_threadIds.push_back(std::this_thread::get_id());
+    }
+
+    void Hold()
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_isHeld = true;
+    }
+
+    void Release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_isHeld = false;
+        }
+
+        this->m_releaseCondition.notify_all();
+    }
+
+    std::vector<std::pair<Host::State, Host::State>> GetStateChanges() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return this->m_stateChanges;
+    }
+
+    std::vector<std::string> GetExceptionMessages() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return this->m_exceptionMessages;
+    }
+
+    std::vector<std::thread::id> GetThreadIds() const
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return this->m_threadIds;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_releaseCondition;
+    bool m_isHeld = false;
+    std::vector<std::pair<Host::State, Host::State>> m_stateChanges;
+    std::vector<std::string> m_exceptionMessages;
+    std::vector<std::thread::id> m_threadIds;
+};
+
+#endif // RECORDINGLISTENER_H
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef RELAY_H
+#define RELAY_H
+
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that forwards every event received on its input port to its output port
+//
+class Relay : public AtomicAccessor
+{
+public:
+    explicit Relay(const std::string& name) :
+        AtomicAccessor(name, { Input }, { Output })
+    {
+        this->AddInputHandler(Input,
+            [this](IEvent* event)
+            {
+                this->SendOutput(Output, std::make_shared<Event<int>>(static_cast<Event<int>*>(event)->payload));
+            });
+    }
+
+    // Input Port Names
+    static constexpr const char* Input = "Input";
+
+    // Connected Output Port Names
+    static constexpr const char* Output = "Output";
+};
+
+#endif // RELAY_H
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef REPLAYHOST_H
+#define REPLAYHOST_H
+
+#include <AccessorFramework/Host.h>
+#include <AccessorFramework/ReplaySource.h>
+#include "Collector.h"
+
+// Description
+// A host in which a replay source feeds the values recorded from a CounterHost's counter to a collector
+//
+class ReplayHost : public Host
+{
+public:
+    ReplayHost(const std::string& name, const std::string& filePath, std::shared_ptr<const EventSerializer> serializer, std::shared_ptr<std::vector<int>> receivedValues) :
+        Host(name)
+    {
+        auto replaySource = std::make_unique<ReplaySource>(ReplaySourceName, filePath, serializer, std::map<std::string, std::string>{ { CounterStreamName, OutputName } });
+        this->m_replaySource = replaySource.get();
+        this->AddChild(std::move(replaySource));
+        this->AddChild(std::make_unique<Collector>(CollectorName, receivedValues));
+        this->ConnectChildren(ReplaySourceName, OutputName, CollectorName, Collector::Input);
+    }
+
+    ReplaySource* GetReplaySource() const
+    {
+        return this->m_replaySource;
+    }
+
+private:
+    const std::string ReplaySourceName = "Replay";
+    const std::string CollectorName = "Collector";
+    const std::string CounterStreamName = ".CounterHost.Counter.CounterValue";
+    const std::string OutputName = "CounterValue";
+    ReplaySource* m_replaySource;
+};
+
+#endif // REPLAYHOST_H
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SHAREDMEMORYRECEIVERHOST_H
+#define SHAREDMEMORYRECEIVERHOST_H
+
+#ifdef __linux__
+
+#include <AccessorFramework/Host.h>
+#include <AccessorFramework/SharedMemoryTransport.h>
+#include "Collector.h"
+
+// Description
+// A host in which the receiving end of a shared-memory transport feeds a collector
+//
+class SharedMemoryReceiverHost : public Host
+{
+public:
+    SharedMemoryReceiverHost(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, std::shared_ptr<std::vector<int>> receivedValues) :
+        Host(name)
+    {
+        auto receiver = std::make_unique<SharedMemoryReceiver>(ReceiverName, transport, CreateSerializer());
+        this->m_receiver = receiver.get();
+        this->AddChild(std::move(receiver));
+        this->AddChild(std::make_unique<Collector>(CollectorName, receivedValues));
+        this->ConnectChildren(ReceiverName, SharedMemoryReceiver::Output, CollectorName, Collector::Input);
+    }
+
+    SharedMemoryReceiver* GetReceiver() const
+    {
+        return this->m_receiver;
+    }
+
+private:
+    static std::shared_ptr<const EventSerializer> CreateSerializer()
+    {
+        auto serializer = std::make_shared<EventSerializer>();
+        serializer->Register<int>();
+        return serializer;
+    }
+
+    const std::string ReceiverName = "Receiver";
+    const std::string CollectorName = "Collector";
+    SharedMemoryReceiver* m_receiver;
+};
+
+#endif // __linux__
+
+#endif // SHAREDMEMORYRECEIVERHOST_H
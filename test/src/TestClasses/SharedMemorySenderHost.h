@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SHAREDMEMORYSENDERHOST_H
+#define SHAREDMEMORYSENDERHOST_H
+
+#ifdef __linux__
+
+#include <AccessorFramework/Host.h>
+#include <AccessorFramework/SharedMemoryTransport.h>
+#include "SpontaneousCounter.h"
+
+// Description
+// A host in which a spontaneous counter feeds the sending end of a shared-memory transport
+//
+class SharedMemorySenderHost : public Host
+{
+public:
+    SharedMemorySenderHost(const std::string& name, std::shared_ptr<SharedMemoryTransport> transport, int counterIntervalInMilliseconds) :
+        Host(name)
+    {
+        auto sender = std::make_unique<SharedMemorySender>(SenderName, transport, CreateSerializer());
+        this->m_sender = sender.get();
+        this->AddChild(std::make_unique<SpontaneousCounter>(CounterName, counterIntervalInMilliseconds));
+        this->AddChild(std::move(sender));
+        this->ConnectChildren(CounterName, SpontaneousCounter::CounterValueOutput, SenderName, SharedMemorySender::Input);
+    }
+
+    SharedMemorySender* GetSender() const
+    {
+        return this->m_sender;
+    }
+
+private:
+    static std::shared_ptr<const EventSerializer> CreateSerializer()
+    {
+        auto serializer = std::make_shared<EventSerializer>();
+        serializer->Register<int>();
+        return serializer;
+    }
+
+    const std::string CounterName = "Counter";
+    const std::string SenderName = "Sender";
+    SharedMemorySender* m_sender;
+};
+
+#endif // __linux__
+
+#endif // SHAREDMEMORYSENDERHOST_H
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SKIPPINGCOUNTER_H
+#define SKIPPINGCOUNTER_H
+
+#include <AccessorFramework/Accessor.h>
+
+// Description
+// An actor that, like a spontaneous counter, outputs the value of a counter at regular intervals, except that it skips
+// one given value, outputting the next value in its place
+//
+class SkippingCounter : public AtomicAccessor
+{
+public:
+    SkippingCounter(const std::string& name, int intervalInMilliseconds, int skippedValue) :
+        AtomicAccessor(name, {}, {}, { CounterValueOutput }),
+        m_intervalInMilliseconds(intervalInMilliseconds),
+        m_skippedValue(skippedValue),
+        m_count(0)
+    {
+    }
+
+    static constexpr const char* CounterValueOutput = "CounterValue";
+
+private:
+    void Initialize() override
+    {
+        this->ScheduleCallback(
+            [this]()
+            {
+                if (this->m_count == this->m_skippedValue)
+                {
+                    ++this->m_count;
+                }
+
+                this->SendOutput(CounterValueOutput, std::make_shared<Event<int>>(this->m_count));
+                ++this->m_count;
+            },
+            this->m_intervalInMilliseconds,
+            true /*repeat*/);
+    }
+
+    int m_intervalInMilliseconds;
+    int m_skippedValue;
+    int m_count;
+};
+
+#endif // SKIPPINGCOUNTER_H
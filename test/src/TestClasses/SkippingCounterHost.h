@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SKIPPINGCOUNTERHOST_H
+#define SKIPPINGCOUNTERHOST_H
+
+#include <AccessorFramework/Host.h>
+#include "SkippingCounter.h"
+
+// Description
+// A host containing a single skipping counter named like the counter of a CounterHost, so that the two hosts only differ
+// in the values their counters send
+//
+class SkippingCounterHost : public Host
+{
+public:
+    SkippingCounterHost(const std::string& name, int intervalInMilliseconds, int skippedValue) : Host(name)
+    {
+        this->AddChild(std::make_unique<SkippingCounter>("Counter", intervalInMilliseconds, skippedValue));
+    }
+};
+
+#endif // SKIPPINGCOUNTERHOST_H
@@ -15,12 +15,13 @@ class SumVerifierHost : public Host
 public:
     explicit SumVerifierHost(const std::string& name, std::shared_ptr<int> latestSum, std::shared_ptr<bool> error) : Host(name)
     {
-        using namespace std::chrono_literals;
-        auto spontaneousInterval = 1000ms;
-        this->AddChild(std::make_unique<SpontaneousCounter>(s1, spontaneousInterval.count()));
-        this->AddChild(std::make_unique<SpontaneousCounter>(s2, spontaneousInterval.count()));
-        this->AddChild(std::make_unique<IntegerAdder>(a1));
-        this->AddChild(std::make_unique<SumVerifier>(v1, latestSum, error));
+        this->AddChildren(latestSum, error);
+    }
+
+    SumVerifierHost(const std::string& name, std::shared_ptr<int> latestSum, std::shared_ptr<bool> error, std::shared_ptr<Executor> executor) :
+        Host(name, std::move(executor))
+    {
+        this->AddChildren(latestSum, error);
     }
 
     void AdditionalSetup() override
@@ -37,6 +38,16 @@ public:
     }
 
 private:
+    void AddChildren(std::shared_ptr<int> latestSum, std::shared_ptr<bool> error)
+    {
+        using namespace std::chrono_literals;
+        auto spontaneousInterval = 1000ms;
+        this->AddChild(std::make_unique<SpontaneousCounter>(s1, spontaneousInterval.count()));
+        this->AddChild(std::make_unique<SpontaneousCounter>(s2, spontaneousInterval.count()));
+        this->AddChild(std::make_unique<IntegerAdder>(a1));
+        this->AddChild(std::make_unique<SumVerifier>(v1, latestSum, error));
+    }
+
     const std::string s1 = "SpontaneousCounterOne";
     const std::string s2 = "SpontaneousCounterTwo";
     const std::string a1 = "IntegerAdder";
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef SUMVERIFIERHOSTTEST_H
+#define SUMVERIFIERHOSTTEST_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include "SumVerifierHost.h"
+
+// Description
+// A test fixture that creates a SumVerifierHost before each test case and polls it in virtual time. The host's counters
+// output once per second, so polling n seconds ahead executes the next n rounds right away. Fixtures that need more
+// set-up or tear-down override SetUp() and TearDown() and call these.
+//
+class SumVerifierHostTest : public ::testing::Test
+{
+protected:
+    // Runs before each test case
+    void SetUp() override
+    {
+        this->latestSum = std::make_shared<int>(0);
+        this->error = std::make_shared<bool>(false);
+        this->target = std::make_unique<SumVerifierHost>(this->TargetName, this->latestSum, this->error);
+    }
+
+    // Runs after each test case
+    void TearDown() override
+    {
+        this->target.reset(nullptr);
+        this->latestSum.reset();
+        this->error.reset();
+    }
+
+    // Executes the next rounds right away by polling ahead
+    void ExecuteRounds(int numberOfRounds)
+    {
+        this->pollTime += std::chrono::seconds(numberOfRounds);
+        this->target->Poll(this->pollTime);
+    }
+
+    void ExecuteThreeRounds()
+    {
+        this->ExecuteRounds(3);
+    }
+
+    std::string TargetName = "TargetHost";
+    std::unique_ptr<SumVerifierHost> target = nullptr;
+    std::shared_ptr<int> latestSum = nullptr;
+    std::shared_ptr<bool> error = nullptr;
+    std::chrono::system_clock::time_point pollTime = std::chrono::system_clock::now() + std::chrono::milliseconds(500);
+};
+
+#endif // SUMVERIFIERHOSTTEST_H
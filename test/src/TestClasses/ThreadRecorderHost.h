@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef THREADRECORDERHOST_H
+#define THREADRECORDERHOST_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <AccessorFramework/Host.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Description
+// A host with one accessor that records the name and CPU affinity of the thread its callback first runs on
+//
+class ThreadRecorderHost : public Host
+{
+public:
+    struct Record
+    {
+        std::mutex mutex;
+        std::atomic<bool> isRecorded{ false };
+        std::string threadName;
+        std::vector<int> cpus;
+    };
+
+    class ThreadRecorder : public AtomicAccessor
+    {
+    public:
+        ThreadRecorder(const std::string& name, std::shared_ptr<Record> record) :
+            AtomicAccessor(name),
+            m_record(record)
+        {
+        }
+
+    private:
+        void Initialize() override
+        {
+            this->ScheduleCallback(
+                [this]()
+                {
+                    if (this->m_record->isRecorded.load())
+                    {
+                        return;
+                    }
+
+                    std::lock_guard<std::mutex> lock(this->m_record->mutex);
+#ifdef __linux__
+                    char threadName[16] = {};
+                    pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+                    this->m_record->threadName = threadName;
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    sched_getaffinity(0, sizeof(cpuSet), &cpuSet);
+                    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                    {
+                        if (CPU_ISSET(cpu, &cpuSet))
+                        {
+                            this->m_record->cpus.push_back(cpu);
+                        }
+                    }
+#endif
+                    this->m_record->isRecorded.store(true);
+                },
+                10 /*delayInMilliseconds*/,
+                true /*repeat*/);
+        }
+
+        std::shared_ptr<Record> m_record;
+    };
+
+    ThreadRecorderHost(const std::string& name, std::shared_ptr<Record> record) :
+        Host(name)
+    {
+        this->AddChild(std::make_unique<ThreadRecorder>("ThreadRecorder", record));
+    }
+};
+
+#endif // THREADRECORDERHOST_H
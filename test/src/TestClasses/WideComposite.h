@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef WIDECOMPOSITE_H
+#define WIDECOMPOSITE_H
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <AccessorFramework/Accessor.h>
+#include "LoggingCollector.h"
+#include "Relay.h"
+#include "SpontaneousCounter.h"
+
+// Description
+// A composite accessor containing several independent lanes. Each lane is a spontaneous counter followed by a chain of
+// relays and a logging collector, and the collectors of all lanes share one log.
+//
+class WideComposite : public CompositeAccessor
+{
+public:
+    WideComposite(
+        const std::string& name,
+        int numberOfLanes,
+        int numberOfStages,
+        int intervalInMilliseconds,
+        std::shared_ptr<std::vector<std::string>> log) :
+        CompositeAccessor(name)
+    {
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            std::string previousName = GetChildName(lane, "Counter", 0);
+            std::string previousOutput = SpontaneousCounter::CounterValueOutput;
+            this->AddChild(std::make_unique<SpontaneousCounter>(previousName, intervalInMilliseconds));
+            for (int stage = 0; stage < numberOfStages; ++stage)
+            {
+                std::string relayName = GetChildName(lane, "Relay", stage);
+                this->AddChild(std::make_unique<Relay>(relayName));
+                this->ConnectChildren(previousName, previousOutput, relayName, Relay::Input);
+                previousName = relayName;
+                previousOutput = Relay::Output;
+            }
+
+            std::string collectorName = GetChildName(lane, "Collector", 0);
+            this->AddChild(std::make_unique<LoggingCollector>(collectorName, log));
+            this->ConnectChildren(previousName, previousOutput, collectorName, LoggingCollector::Input);
+        }
+    }
+
+private:
+    static std::string GetChildName(int lane, const std::string& role, int index)
+    {
+        std::ostringstream oss;
+        oss << "Lane-" << lane << "-" << role << "-" << index;
+        return oss.str();
+    }
+};
+
+#endif // WIDECOMPOSITE_H
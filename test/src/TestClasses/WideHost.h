@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef WIDEHOST_H
+#define WIDEHOST_H
+
+#include <memory>
+#include <sstream>
+#include <vector>
+#include <AccessorFramework/Host.h>
+#include "Collector.h"
+#include "Relay.h"
+#include "SpontaneousCounter.h"
+
+// Description
+// A host containing several independent lanes. Each lane is a spontaneous counter followed by a chain of relays and a
+// collector that records the values that reach the end of the lane.
+//
+class WideHost : public Host
+{
+public:
+    WideHost(
+        const std::string& name,
+        int numberOfStages,
+        int intervalInMilliseconds,
+        const std::vector<std::shared_ptr<std::vector<int>>>& receivedValues) :
+        Host(name)
+    {
+        for (int lane = 0; lane < static_cast<int>(receivedValues.size()); ++lane)
+        {
+            std::string previousName = GetChildName(lane, "Counter", 0);
+            std::string previousOutput = SpontaneousCounter::CounterValueOutput;
+            this->AddChild(std::make_unique<SpontaneousCounter>(previousName, intervalInMilliseconds));
+            for (int stage = 0; stage < numberOfStages; ++stage)
+            {
+                std::string relayName = GetChildName(lane, "Relay", stage);
+                this->AddChild(std::make_unique<Relay>(relayName));
+                this->ConnectChildren(previousName, previousOutput, relayName, Relay::Input);
+                previousName = relayName;
+                previousOutput = Relay::Output;
+            }
+
+            std::string collectorName = GetChildName(lane, "Collector", 0);
+            this->AddChild(std::make_unique<Collector>(collectorName, receivedValues[lane]));
+            this->ConnectChildren(previousName, previousOutput, collectorName, Collector::Input);
+        }
+    }
+
+private:
+    static std::string GetChildName(int lane, const std::string& role, int index)
+    {
+        std::ostringstream oss;
+        oss << "Lane-" << lane << "-" << role << "-" << index;
+        return oss.str();
+    }
+};
+
+#endif // WIDEHOST_H